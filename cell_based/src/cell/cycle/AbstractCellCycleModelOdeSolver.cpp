@@ -121,3 +121,56 @@ bool AbstractCellCycleModelOdeSolver::IsAdaptive()
 #endif //CHASTE_CVODE
     return adaptive;
 }
+
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::CreateIvpOdeSolver()
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>();
+}
+
+bool AbstractCellCycleModelOdeSolver::SetUpThreadOdeSolvers(unsigned numThreads)
+{
+    assert(IsSetUp());
+    assert(numThreads > 0);
+
+    // Start again if the solver has been re-initialised since the copies were made
+    if (mThreadOdeSolvers.empty() || mThreadOdeSolvers[0] != mpOdeSolver)
+    {
+        mThreadOdeSolvers.assign(1, mpOdeSolver);
+    }
+
+    while (mThreadOdeSolvers.size() < numThreads)
+    {
+        boost::shared_ptr<AbstractIvpOdeSolver> p_solver = CreateIvpOdeSolver();
+        if (!p_solver)
+        {
+            return false;
+        }
+#ifdef CHASTE_CVODE
+        if (boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver))
+        {
+            boost::shared_ptr<CvodeAdaptor> p_cvode = boost::static_pointer_cast<CvodeAdaptor>(mpOdeSolver);
+            boost::shared_ptr<CvodeAdaptor> p_copy = boost::dynamic_pointer_cast<CvodeAdaptor>(p_solver);
+            assert(p_copy);
+            p_copy->SetForceReset(true);
+            p_copy->SetTolerances(p_cvode->GetRelativeTolerance(), p_cvode->GetAbsoluteTolerance());
+            p_copy->SetMaxSteps(p_cvode->GetMaxSteps());
+            if (p_cvode->GetCheckForStoppingEvents())
+            {
+                p_copy->CheckForStoppingEvents();
+            }
+        }
+#endif //CHASTE_CVODE
+        mThreadOdeSolvers.push_back(p_solver);
+    }
+    return true;
+}
+
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::GetOdeSolverForThread(unsigned thread)
+{
+    if (thread == 0)
+    {
+        return mpOdeSolver;
+    }
+    assert(thread < mThreadOdeSolvers.size() && mThreadOdeSolvers[0] == mpOdeSolver);
+    return mThreadOdeSolvers[thread];
+}
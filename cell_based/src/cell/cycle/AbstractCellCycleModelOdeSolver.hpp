@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 #include "AbstractIvpOdeSolver.hpp"
 
@@ -80,6 +81,19 @@ protected:
     /** The size of the ODE system to be solved. */
     unsigned mSizeOfOdeSystem;
 
+    /**
+     * Copies of mpOdeSolver for use by other threads when many ODE systems are solved
+     * at once (see SetUpThreadOdeSolvers()).  Entry 0 is mpOdeSolver itself.  Not archived.
+     */
+    std::vector<boost::shared_ptr<AbstractIvpOdeSolver> > mThreadOdeSolvers;
+
+    /**
+     * @return a new solver of the same type as mpOdeSolver, for use by another thread,
+     * or an empty pointer if this is not possible (the default).  Any CVODE settings are
+     * copied over by SetUpThreadOdeSolvers().
+     */
+    virtual boost::shared_ptr<AbstractIvpOdeSolver> CreateIvpOdeSolver();
+
 public:
 
     /**
@@ -186,6 +200,23 @@ public:
      * The base class version just returns true iff the solver is the CvodeAdaptor class.
      */
     virtual bool IsAdaptive();
+
+    /**
+     * Make sure there is a separate solver for each of the given number of threads,
+     * since solvers hold working memory and so cannot be shared between threads.
+     * Must be called before entering a parallel region.
+     *
+     * @param numThreads  the number of threads
+     * @return whether this was possible; if not, only GetOdeSolverForThread(0) may be used
+     */
+    bool SetUpThreadOdeSolvers(unsigned numThreads);
+
+    /**
+     * @return the solver for the given thread; thread 0 uses mpOdeSolver.
+     *
+     * @param thread  the thread number
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> GetOdeSolverForThread(unsigned thread);
 };
 
 #endif /*ABSTRACTCELLCYCLEMODELODESOLVER_HPP_*/
@@ -114,12 +114,17 @@ void AbstractOdeBasedCellCycleModel::ResetForDivision()
 
 double AbstractOdeBasedCellCycleModel::GetOdeStopTime()
 {
-    double stop_time = DOUBLE_UNSET;
-    if (mpOdeSolver->StoppingEventOccurred())
+    return mOdeStopTime;
+}
+
+double AbstractOdeBasedCellCycleModel::GetOdeSolveStartTime(double currentTime)
+{
+    // As in ReadyToDivide()
+    if (mReadyToDivide || currentTime <= mLastTime)
     {
-        stop_time = mpOdeSolver->GetStoppingTime();
+        return DOUBLE_UNSET;
     }
-    return stop_time;
+    return mLastTime;
 }
 
 void AbstractOdeBasedCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
@@ -98,6 +98,14 @@ protected:
      */
     AbstractOdeBasedCellCycleModel(const AbstractOdeBasedCellCycleModel& rModel);
 
+    /**
+     * Overridden GetOdeSolveStartTime() method, which allows the ODEs to be solved ahead of time.
+     *
+     * @param currentTime  the time to which the model will be updated
+     * @return the time from which the ODEs will be solved, or DOUBLE_UNSET if they won't be
+     */
+    double GetOdeSolveStartTime(double currentTime);
+
 public:
 
     /**
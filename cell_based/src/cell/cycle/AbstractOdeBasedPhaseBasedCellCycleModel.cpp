@@ -158,12 +158,28 @@ void AbstractOdeBasedPhaseBasedCellCycleModel::ResetForDivision()
 
 double AbstractOdeBasedPhaseBasedCellCycleModel::GetOdeStopTime()
 {
-    double stop_time = DOUBLE_UNSET;
-    if (mpOdeSolver->StoppingEventOccurred())
+    return mOdeStopTime;
+}
+
+double AbstractOdeBasedPhaseBasedCellCycleModel::GetOdeSolveStartTime(double currentTime)
+{
+    // As in ReadyToDivide() and UpdateCellCyclePhase()
+    if (mReadyToDivide || mFinishedRunningOdes)
+    {
+        return DOUBLE_UNSET;
+    }
+
+    double start_time = mLastTime;
+    if (mCurrentCellCyclePhase == M_PHASE)
     {
-        stop_time = mpOdeSolver->GetStoppingTime();
+        double m_duration = GetMDuration();
+        if (GetAge() < m_duration)
+        {
+            return DOUBLE_UNSET;
+        }
+        start_time = m_duration + mBirthTime;
     }
-    return stop_time;
+    return (currentTime > start_time) ? start_time : DOUBLE_UNSET;
 }
 
 void AbstractOdeBasedPhaseBasedCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
@@ -76,6 +76,11 @@ AbstractCellCycleModel* Alarcon2004OxygenBasedCellCycleModel::CreateCellCycleMod
     return new Alarcon2004OxygenBasedCellCycleModel(*this);
 }
 
+bool Alarcon2004OxygenBasedCellCycleModel::CanSolveOdesOnAnyThread()
+{
+    return true;
+}
+
 void Alarcon2004OxygenBasedCellCycleModel::ResetForDivision()
 {
     AbstractOdeBasedPhaseBasedCellCycleModel::ResetForDivision();
@@ -91,6 +91,14 @@ protected:
      */
     Alarcon2004OxygenBasedCellCycleModel(const Alarcon2004OxygenBasedCellCycleModel& rModel);
 
+    /**
+     * Overridden CanSolveOdesOnAnyThread() method.  The ODEs only depend on their state and on the
+     * oxygen concentration and labelling of the cell, which are set by AdjustOdeParameters().
+     *
+     * @return true
+     */
+    bool CanSolveOdesOnAnyThread();
+
 public:
 
     /**
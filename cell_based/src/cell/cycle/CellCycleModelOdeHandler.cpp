@@ -35,13 +35,23 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellCycleModelOdeHandler.hpp"
 
+#include <map>
+
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif // CHASTE_OPENMP
+
 CellCycleModelOdeHandler::CellCycleModelOdeHandler(double lastTime,
                                                    boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver)
-    : mDt(DOUBLE_UNSET),
+    : mPresolvedEndTime(DOUBLE_UNSET),
+      mPresolvedStartTime(DOUBLE_UNSET),
+      mPresolvedStopTime(DOUBLE_UNSET),
+      mDt(DOUBLE_UNSET),
       mpOdeSystem(nullptr),
       mpOdeSolver(pOdeSolver),
       mLastTime(lastTime),
-      mFinishedRunningOdes(false)
+      mFinishedRunningOdes(false),
+      mOdeStopTime(DOUBLE_UNSET)
 {
 }
 
@@ -54,11 +64,15 @@ CellCycleModelOdeHandler::~CellCycleModelOdeHandler()
 }
 
 CellCycleModelOdeHandler::CellCycleModelOdeHandler(const CellCycleModelOdeHandler& rHandler)
-    : mDt(rHandler.mDt),
+    : mPresolvedEndTime(DOUBLE_UNSET),
+      mPresolvedStartTime(DOUBLE_UNSET),
+      mPresolvedStopTime(DOUBLE_UNSET),
+      mDt(rHandler.mDt),
       mpOdeSystem(rHandler.mpOdeSystem),
       mpOdeSolver(rHandler.mpOdeSolver),
       mLastTime(rHandler.mLastTime),
-      mFinishedRunningOdes(rHandler.mFinishedRunningOdes)
+      mFinishedRunningOdes(rHandler.mFinishedRunningOdes),
+      mOdeStopTime(rHandler.mOdeStopTime)
 {
 }
 
@@ -103,14 +117,27 @@ bool CellCycleModelOdeHandler::SolveOdeToTime(double currentTime)
     bool stopping_event_occurred = false;
     if (mLastTime < currentTime)
     {
-        AdjustOdeParameters(currentTime);
+        if (mPresolvedEndTime == currentTime && mPresolvedStartTime == mLastTime)
+        {
+            // The ODEs have already been solved over this interval by PresolveOdeToTime()
+            mOdeStopTime = mPresolvedStopTime;
+            mPresolvedEndTime = DOUBLE_UNSET;
+            mPresolveInitialState.clear();
+        }
+        else
+        {
+            DiscardPresolvedOdeSolution();
+            AdjustOdeParameters(currentTime);
+
+            mpOdeSolver->SolveAndUpdateStateVariable(mpOdeSystem, mLastTime, currentTime, GetDt());
 
-        mpOdeSolver->SolveAndUpdateStateVariable(mpOdeSystem, mLastTime, currentTime, GetDt());
+            mOdeStopTime = mpOdeSolver->StoppingEventOccurred() ? mpOdeSolver->GetStoppingTime() : DOUBLE_UNSET;
+        }
 
-        stopping_event_occurred = mpOdeSolver->StoppingEventOccurred();
+        stopping_event_occurred = (mOdeStopTime != DOUBLE_UNSET);
         if (stopping_event_occurred)
         {
-            mLastTime = mpOdeSolver->GetStoppingTime();
+            mLastTime = mOdeStopTime;
         }
         else
         {
@@ -124,6 +151,136 @@ void CellCycleModelOdeHandler::AdjustOdeParameters(double currentTime)
 {
 }
 
+double CellCycleModelOdeHandler::GetOdeSolveStartTime(double currentTime)
+{
+    return DOUBLE_UNSET;
+}
+
+void CellCycleModelOdeHandler::DiscardPresolvedOdeSolution()
+{
+    if (mPresolvedEndTime != DOUBLE_UNSET)
+    {
+        mpOdeSystem->SetStateVariables(mPresolveInitialState);
+        mPresolvedEndTime = DOUBLE_UNSET;
+        mPresolveInitialState.clear();
+    }
+}
+
+bool CellCycleModelOdeHandler::CanSolveOdesOnAnyThread()
+{
+    return false;
+}
+
+bool CellCycleModelOdeHandler::StartPresolve(double currentTime)
+{
+    DiscardPresolvedOdeSolution();
+
+    double start_time = GetOdeSolveStartTime(currentTime);
+    if (start_time == DOUBLE_UNSET || start_time >= currentTime)
+    {
+        return false;
+    }
+
+    mPresolveInitialState = mpOdeSystem->rGetStateVariables();
+    try
+    {
+        AdjustOdeParameters(currentTime);
+    }
+    catch (Exception&)
+    {
+        // Adjust again later in SolveOdeToTime(), which will report the error
+        mpOdeSystem->SetStateVariables(mPresolveInitialState);
+        mPresolveInitialState.clear();
+        return false;
+    }
+    mPresolvedStartTime = start_time;
+    return true;
+}
+
+void CellCycleModelOdeHandler::FinishPresolve(double currentTime, boost::shared_ptr<AbstractIvpOdeSolver> pSolver)
+{
+    try
+    {
+        pSolver->SolveAndUpdateStateVariable(mpOdeSystem, mPresolvedStartTime, currentTime, GetDt());
+        mPresolvedStopTime = pSolver->StoppingEventOccurred() ? pSolver->GetStoppingTime() : DOUBLE_UNSET;
+        mPresolvedEndTime = currentTime;
+    }
+    catch (Exception&)
+    {
+        // Solve again later in SolveOdeToTime(), which will report the error
+        mpOdeSystem->SetStateVariables(mPresolveInitialState);
+        mPresolveInitialState.clear();
+    }
+}
+
+void CellCycleModelOdeHandler::PresolveOdeToTime(double currentTime, boost::shared_ptr<AbstractIvpOdeSolver> pSolver)
+{
+    if (StartPresolve(currentTime))
+    {
+        FinishPresolve(currentTime, pSolver);
+    }
+}
+
+void CellCycleModelOdeHandler::PresolveOdesToTime(const std::vector<CellCycleModelOdeHandler*>& rHandlers,
+                                                  double currentTime,
+                                                  unsigned numThreads)
+{
+    /*
+     * Set the ODE parameters of every model on this thread, since they may depend on the cell
+     * or on singletons such as WntConcentration.  Each ODE solver is shared by all the models of
+     * one class, so then solve the ODEs of the models sharing a solver together: on several
+     * threads for the models which opt in with CanSolveOdesOnAnyThread(), and otherwise on this one.
+     */
+    std::map<AbstractCellCycleModelOdeSolver*, std::vector<CellCycleModelOdeHandler*> > concurrent_handlers;
+    std::map<AbstractCellCycleModelOdeSolver*, std::vector<CellCycleModelOdeHandler*> > serial_handlers;
+    for (unsigned i=0; i<rHandlers.size(); i++)
+    {
+        if (rHandlers[i]->mpOdeSystem != nullptr && rHandlers[i]->mpOdeSolver && rHandlers[i]->StartPresolve(currentTime))
+        {
+            if (numThreads > 1u && rHandlers[i]->CanSolveOdesOnAnyThread())
+            {
+                concurrent_handlers[rHandlers[i]->mpOdeSolver.get()].push_back(rHandlers[i]);
+            }
+            else
+            {
+                serial_handlers[rHandlers[i]->mpOdeSolver.get()].push_back(rHandlers[i]);
+            }
+        }
+    }
+
+    for (std::map<AbstractCellCycleModelOdeSolver*, std::vector<CellCycleModelOdeHandler*> >::iterator iter = serial_handlers.begin();
+         iter != serial_handlers.end();
+         ++iter)
+    {
+        for (unsigned i=0; i<iter->second.size(); i++)
+        {
+            iter->second[i]->FinishPresolve(currentTime, iter->first->GetOdeSolverForThread(0u));
+        }
+    }
+
+    for (std::map<AbstractCellCycleModelOdeSolver*, std::vector<CellCycleModelOdeHandler*> >::iterator iter = concurrent_handlers.begin();
+         iter != concurrent_handlers.end();
+         ++iter)
+    {
+        AbstractCellCycleModelOdeSolver* p_solver = iter->first;
+        std::vector<CellCycleModelOdeHandler*>& r_handlers = iter->second;
+
+#ifdef CHASTE_OPENMP
+        // Solvers which can't be copied are only used by one thread
+        int num_threads = p_solver->SetUpThreadOdeSolvers(numThreads) ? numThreads : 1;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 16)
+#endif // CHASTE_OPENMP
+        for (int i=0; i<(int)r_handlers.size(); i++)
+        {
+            unsigned thread = 0u;
+#ifdef CHASTE_OPENMP
+            thread = omp_get_thread_num();
+#endif // CHASTE_OPENMP
+            r_handlers[i]->FinishPresolve(currentTime, p_solver->GetOdeSolverForThread(thread));
+        }
+    }
+}
+
 void CellCycleModelOdeHandler::SetLastTime(double lastTime)
 {
     mLastTime = lastTime;
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
+#include <vector>
 
 #include "ChasteSerialization.hpp"
 #include "AbstractOdeSystem.hpp"
@@ -81,6 +82,44 @@ private:
      */
     CellCycleModelOdeHandler& operator=(const AbstractCellCycleModelOdeSolver&);
 
+    /**
+     * The end time of an ODE solution computed ahead of time by PresolveOdeToTime(), or
+     * DOUBLE_UNSET if there is none.  This and the following members are only used within
+     * a time step, so are not archived.
+     */
+    double mPresolvedEndTime;
+
+    /** The start time of the ODE solution computed ahead of time, if any. */
+    double mPresolvedStartTime;
+
+    /** The time of the stopping event found by the solution computed ahead of time, or DOUBLE_UNSET if none. */
+    double mPresolvedStopTime;
+
+    /** The state variables before the ODEs were solved ahead of time, so that the solution can be discarded. */
+    std::vector<double> mPresolveInitialState;
+
+    /** Discard any ODE solution computed ahead of time, restoring the state variables. */
+    void DiscardPresolvedOdeSolution();
+
+    /**
+     * The first part of PresolveOdeToTime(): find the interval over which the ODEs will be
+     * solved, save the state variables and call AdjustOdeParameters().  Always called on the
+     * thread that owns the cells.
+     *
+     * @param currentTime  the time to which the model will be updated
+     * @return whether the ODEs are to be solved ahead of time
+     */
+    bool StartPresolve(double currentTime);
+
+    /**
+     * The second part of PresolveOdeToTime(): solve the ODEs over the interval found by
+     * StartPresolve().  May be called on another thread if CanSolveOdesOnAnyThread() is true.
+     *
+     * @param currentTime  the time to which the model will be updated
+     * @param pSolver  the solver to use, which must not be in use by another thread
+     */
+    void FinishPresolve(double currentTime, boost::shared_ptr<AbstractIvpOdeSolver> pSolver);
+
 protected:
 
     /**
@@ -110,6 +149,12 @@ protected:
      */
     bool mFinishedRunningOdes;
 
+    /**
+     * The time of the stopping event found the last time the ODEs were solved, or
+     * DOUBLE_UNSET if there was none.  Not archived.
+     */
+    double mOdeStopTime;
+
     /**
      * Solves the ODE system to a given time.
      *
@@ -127,6 +172,29 @@ protected:
      */
     virtual void AdjustOdeParameters(double currentTime);
 
+    /**
+     * @return the time from which SolveOdeToTime() will be asked to solve the ODEs when the
+     * model is next updated to currentTime, or DOUBLE_UNSET if it won't be (or if the model
+     * doesn't support solving its ODEs ahead of time, which is the default).  Used by
+     * PresolveOdesToTime().
+     *
+     * Models which override this must set any ODE parameters which depend on the cell in
+     * AdjustOdeParameters(), since that is all that is called when the ODEs are solved ahead
+     * of time.
+     *
+     * @param currentTime  the time to which the model will be updated
+     */
+    virtual double GetOdeSolveStartTime(double currentTime);
+
+    /**
+     * @return whether PresolveOdesToTime() may solve this model's ODEs on a thread other than
+     * the one that owns the cells.  This is only safe if evaluating the ODE system reads nothing
+     * but its own state variables and parameters (those depending on the cell or on singletons
+     * must be set in AdjustOdeParameters(), which is always called on the owning thread).
+     * Defaults to false; models opt in by overriding this.
+     */
+    virtual bool CanSolveOdesOnAnyThread();
+
 public:
 
     /**
@@ -203,6 +271,35 @@ public:
      *
      */
     void SetProteinConcentrationsForTestsOnly(double lastTime, std::vector<double> proteinConcentrations);
+
+    /**
+     * Solve the ODEs ahead of time over the interval that SolveOdeToTime() will next be asked
+     * for (see GetOdeSolveStartTime()), using the given solver.  The result is used by the next
+     * call of SolveOdeToTime() if it is for the same interval, and otherwise discarded.  Errors
+     * from the solver are not reported here; the ODEs are then solved again as usual, which
+     * reports them.
+     *
+     * @param currentTime  the time to which the model will be updated
+     * @param pSolver  the solver to use, which must not be in use by another thread
+     */
+    void PresolveOdeToTime(double currentTime, boost::shared_ptr<AbstractIvpOdeSolver> pSolver);
+
+    /**
+     * Solve the ODEs of many models ahead of time with PresolveOdeToTime(), so that each
+     * model's lazy update is cheap.  AdjustOdeParameters() is called for every model on the
+     * calling thread.  The ODEs of the models sharing each cell-cycle model ODE solver are then
+     * solved together: on numThreads threads with a copy of the solver each for the models
+     * whose CanSolveOdesOnAnyThread() is true, if Chaste was built with OpenMP and the solver
+     * can be copied, and otherwise on the calling thread.  Since each model's ODEs are solved
+     * exactly as they would have been, the results are identical.
+     *
+     * @param rHandlers  the models to solve
+     * @param currentTime  the time to which the models will be updated
+     * @param numThreads  the number of threads to use
+     */
+    static void PresolveOdesToTime(const std::vector<CellCycleModelOdeHandler*>& rHandlers,
+                                   double currentTime,
+                                   unsigned numThreads);
 };
 
 #endif /*CELLCYCLEMODELODEHANDLER_HPP_*/
@@ -79,6 +79,10 @@ private:
         archive & mpInstance;
     }
 
+protected:
+    /** @return a new ODE_SOLVER, for use by another thread. */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateIvpOdeSolver();
+
 public:
     /** @return a pointer to the singleton instance, creating it if necessary. */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > Instance();
@@ -151,6 +155,12 @@ void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::Initialise()
 #endif //CHASTE_CVODE
 }
 
+template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
+boost::shared_ptr<AbstractIvpOdeSolver> CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::CreateIvpOdeSolver()
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new ODE_SOLVER);
+}
+
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
 bool CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::IsAdaptive()
 {
@@ -192,6 +202,10 @@ private:
         archive & mpInstance;
     }
 
+protected:
+    /** @return a new ODE_SOLVER, for use by another thread. */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateIvpOdeSolver();
+
 public:
     /** @return a pointer to the singleton instance, creating it if necessary. */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> > Instance();
@@ -241,6 +255,13 @@ void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Initi
     mpOdeSolver.reset(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
 }
 
+template<class CELL_CYCLE_MODEL>
+boost::shared_ptr<AbstractIvpOdeSolver> CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::CreateIvpOdeSolver()
+{
+    assert(mSizeOfOdeSystem != UNSIGNED_UNSET);
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
+}
+
 template<class CELL_CYCLE_MODEL>
 void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Reset()
 {
@@ -138,6 +138,11 @@ AbstractCellCycleModel* TysonNovakCellCycleModel::CreateCellCycleModel()
     return new TysonNovakCellCycleModel(*this);
 }
 
+bool TysonNovakCellCycleModel::CanSolveOdesOnAnyThread()
+{
+    return true;
+}
+
 double TysonNovakCellCycleModel::GetAverageTransitCellCycleTime()
 {
     return 1.25;
@@ -85,6 +85,13 @@ protected:
      */
     TysonNovakCellCycleModel(const TysonNovakCellCycleModel& rModel);
 
+    /**
+     * Overridden CanSolveOdesOnAnyThread() method.  The Tyson-Novak ODEs only depend on their state.
+     *
+     * @return true
+     */
+    bool CanSolveOdesOnAnyThread();
+
 public:
 
     /**
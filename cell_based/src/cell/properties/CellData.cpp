@@ -35,45 +35,144 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellData.hpp"
 
+#include <algorithm>
+#include <cassert>
+
+CellData::CellData()
+    : AbstractCellProperty(),
+      mNumItems(0)
+{
+}
+
 CellData::~CellData()
 {
 }
 
+CellData::KeyRegistry::KeyRegistry()
+{
+    KeySnapshot* p_empty = new KeySnapshot;
+    mSnapshots.push_back(p_empty);
+    mpCurrent.store(p_empty);
+}
+
+CellData::KeyRegistry::~KeyRegistry()
+{
+    for (unsigned i=0; i<mSnapshots.size(); i++)
+    {
+        delete mSnapshots[i];
+    }
+}
+
+CellData::KeyRegistry& CellData::rGetKeyRegistry()
+{
+    static KeyRegistry registry;
+    return registry;
+}
+
+unsigned CellData::FindKey(const std::string& rVariableName)
+{
+    const KeySnapshot* p_snapshot = rGetKeyRegistry().mpCurrent.load(std::memory_order_acquire);
+    std::map<std::string, unsigned>::const_iterator it = p_snapshot->mKeys.find(rVariableName);
+    return (it == p_snapshot->mKeys.end()) ? UNSIGNED_UNSET : it->second;
+}
+
+unsigned CellData::GetKey(const std::string& rVariableName)
+{
+    unsigned key = FindKey(rVariableName);
+    if (key != UNSIGNED_UNSET)
+    {
+        return key;
+    }
+
+    KeyRegistry& r_registry = rGetKeyRegistry();
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellDataKeys)
+#endif
+    {
+        // Another thread may have registered the name in the meantime
+        const KeySnapshot* p_snapshot = r_registry.mpCurrent.load(std::memory_order_acquire);
+        std::map<std::string, unsigned>::const_iterator it = p_snapshot->mKeys.find(rVariableName);
+        if (it == p_snapshot->mKeys.end())
+        {
+            KeySnapshot* p_new_snapshot = new KeySnapshot(*p_snapshot);
+            key = p_new_snapshot->mNames.size();
+            p_new_snapshot->mNames.push_back(rVariableName);
+            p_new_snapshot->mKeys[rVariableName] = key;
+            r_registry.mSnapshots.push_back(p_new_snapshot);
+            r_registry.mpCurrent.store(p_new_snapshot, std::memory_order_release);
+        }
+        else
+        {
+            key = it->second;
+        }
+    }
+    return key;
+}
+
+std::string CellData::GetKeyName(unsigned key)
+{
+    const KeySnapshot* p_snapshot = rGetKeyRegistry().mpCurrent.load(std::memory_order_acquire);
+    assert(key < p_snapshot->mNames.size());
+    return p_snapshot->mNames[key];
+}
+
 void CellData::SetItem(const std::string& rVariableName, double data)
 {
-    mCellData[rVariableName] = data;
+    SetItem(GetKey(rVariableName), data);
+}
+
+void CellData::SetItem(unsigned key, double data)
+{
+    if (key >= mValues.size())
+    {
+        mValues.resize(key+1, 0.0);
+        mIsStored.resize(key+1, false);
+    }
+    if (!mIsStored[key])
+    {
+        mIsStored[key] = true;
+        mNumItems++;
+    }
+    mValues[key] = data;
 }
 
 double CellData::GetItem(const std::string& rVariableName) const
 {
-    /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
-     */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
+    unsigned key = FindKey(rVariableName);
+    if (key == UNSIGNED_UNSET)
     {
         EXCEPTION("The item " << rVariableName << " is not stored");
     }
-    return(it->second);
+    return GetItem(key);
+}
+
+double CellData::GetItem(unsigned key) const
+{
+    if (key >= mValues.size() || !mIsStored[key])
+    {
+        EXCEPTION("The item " << GetKeyName(key) << " is not stored");
+    }
+    return mValues[key];
 }
 
 unsigned CellData::GetNumItems() const
 {
-    return mCellData.size();
+    return mNumItems;
 }
 
 std::vector<std::string> CellData::GetKeys() const
 {
     std::vector<std::string> keys;
-    for (std::map<std::string, double>::const_iterator it = mCellData.begin(); it != mCellData.end(); ++it)
+    for (unsigned key=0; key<mValues.size(); key++)
     {
-        keys.push_back(it->first);
+        if (mIsStored[key])
+        {
+            keys.push_back(GetKeyName(key));
+        }
     }
 
-    // From STL documentation we assume that the iterator is returning sorted keys sort(keys.begin(), keys.end());
+    // Keys are numbered in the order in which names were first seen, so sort the names
+    std::sort(keys.begin(), keys.end());
     return keys;
 }
 
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CELLDATA_HPP_
 
 #include <boost/shared_ptr.hpp>
+#include <atomic>
 #include <map>
 #include <string>
 #include <vector>
@@ -45,6 +46,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
 #include "Exception.hpp"
 
 /**
@@ -54,6 +56,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * for example corresponding to the intracellular oxygen concentration. Other classes may interrogate
  * or modify the values stored in this class.
  *
+ * Names are interned: each name is given a 'key', a small integer shared by all cells, and
+ * each cell stores its items in a vector indexed by key.  Code which accesses an item for
+ * every cell should look up the key once using GetKey() and then use the overloads of
+ * GetItem() and SetItem() taking a key, which avoid any string comparison.
+ *
+ * New names are rare once a simulation is under way, so the names are held in immutable
+ * snapshots: looking a name up reads the current snapshot without taking a lock, and only
+ * registering a new name copies it (under a lock).
+ *
  * Within the Cell constructor, an empty CellData object is created and passed to the Cell
  * (unless there is already a CellData object present in mCellPropertyCollection).
  */
@@ -62,33 +73,133 @@ class CellData : public AbstractCellProperty
 private:
 
     /**
-     * The cell data.
+     * The value of each item, indexed by key.
+     */
+    std::vector<double> mValues;
+
+    /**
+     * Whether each item is stored, indexed by key.
+     */
+    std::vector<bool> mIsStored;
+
+    /**
+     * The number of items stored.
      */
-    std::map<std::string, double> mCellData;
+    unsigned mNumItems;
+
+    /** The names of the items known at some point, which is never changed once published. */
+    struct KeySnapshot
+    {
+        /** The key of each name. */
+        std::map<std::string, unsigned> mKeys;
+
+        /** The name of each key. */
+        std::vector<std::string> mNames;
+    };
+
+    /** The names of the items, shared by all cells. */
+    struct KeyRegistry
+    {
+        /** The current snapshot, replaced (never modified) when a name is registered. */
+        std::atomic<const KeySnapshot*> mpCurrent;
+
+        /**
+         * Every snapshot published, which are only deleted with the registry since a reader
+         * may still be using an old one.
+         */
+        std::vector<const KeySnapshot*> mSnapshots;
+
+        /** Constructor, publishing an empty snapshot. */
+        KeyRegistry();
+
+        /** Destructor, deleting the snapshots. */
+        ~KeyRegistry();
+    };
+
+    /**
+     * @return the registry of item names, shared by all cells.
+     */
+    static KeyRegistry& rGetKeyRegistry();
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Archive the member variables.
+     * Save the member variables.  The items are archived as a map from names to values,
+     * since keys may differ between runs.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & boost::serialization::base_object<AbstractCellProperty>(*this);
-        archive & mCellData;
+        std::map<std::string, double> cell_data;
+        for (unsigned key=0; key<mValues.size(); key++)
+        {
+            if (mIsStored[key])
+            {
+                cell_data[GetKeyName(key)] = mValues[key];
+            }
+        }
+        archive & cell_data;
     }
 
+    /**
+     * Load the member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellProperty>(*this);
+        std::map<std::string, double> cell_data;
+        archive & cell_data;
+        for (std::map<std::string, double>::iterator it = cell_data.begin(); it != cell_data.end(); ++it)
+        {
+            SetItem(it->first, it->second);
+        }
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 public:
 
+    /**
+     * Default constructor.
+     */
+    CellData();
+
     /**
      * We need the empty virtual destructor in this class to ensure Boost
      * serialization works correctly with static libraries.
      */
     virtual ~CellData();
 
+    /**
+     * @return the key of an item name, registering the name if it has not been seen before.
+     * Keys are shared by all cells and remain valid for the lifetime of the program.
+     *
+     * @param rVariableName the name of the item
+     */
+    static unsigned GetKey(const std::string& rVariableName);
+
+    /**
+     * @return the key of an item name, or UNSIGNED_UNSET if no cell has used the name.  Unlike
+     * GetKey(), this never registers the name, and never takes a lock.
+     *
+     * @param rVariableName the name of the item
+     */
+    static unsigned FindKey(const std::string& rVariableName);
+
+    /**
+     * @return the name of the item with the given key.
+     *
+     * @param key the key of the item, as returned by GetKey()
+     */
+    static std::string GetKeyName(unsigned key);
+
     /**
      * This assigns the cell data.
      *
@@ -97,14 +208,30 @@ public:
      */
     void SetItem(const std::string& rVariableName, double data);
 
+    /**
+     * This assigns the cell data, given the key of its name.
+     *
+     * @param key the key of the data to be set, as returned by GetKey()
+     * @param data the value to set it to.
+     */
+    void SetItem(unsigned key, double data);
+
     /**
      * @return data.
      *
      * @param rVariableName the index of the data required.
-     * throws if rVariableName has not been stored
+     * throws if rVariableName has not been stored.  Unknown names are not registered.
      */
     double GetItem(const std::string& rVariableName) const;
 
+    /**
+     * @return data, given the key of its name.
+     *
+     * @param key the key of the data required, as returned by GetKey()
+     * throws if the item has not been stored
+     */
+    double GetItem(unsigned key) const;
+
     /**
      * @return number of data items
      */
@@ -113,7 +240,8 @@ public:
     /**
      * @return all keys.
      *
-     * According to STL these are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
+     * These are the names of the items stored, sorted in lexicographical/alphabetic order
+     * (so that the ordering here is predictable).
      */
     std::vector<std::string> GetKeys() const;
 };
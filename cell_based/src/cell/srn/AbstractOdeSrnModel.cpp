@@ -94,6 +94,16 @@ void AbstractOdeSrnModel::SimulateToCurrentTime()
     SetSimulatedToTime(current_time);
 }
 
+double AbstractOdeSrnModel::GetOdeSolveStartTime(double currentTime)
+{
+    // As in SimulateToCurrentTime()
+    if (mFinishedRunningOdes || currentTime <= mLastTime)
+    {
+        return DOUBLE_UNSET;
+    }
+    return mLastTime;
+}
+
 void AbstractOdeSrnModel::Initialise(AbstractOdeSystem* pOdeSystem)
 {
     assert(mpOdeSystem == nullptr);
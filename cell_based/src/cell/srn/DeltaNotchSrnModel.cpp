@@ -80,13 +80,14 @@ AbstractSrnModel* DeltaNotchSrnModel::CreateSrnModel()
     return new DeltaNotchSrnModel(*this);
 }
 
-void DeltaNotchSrnModel::SimulateToCurrentTime()
+void DeltaNotchSrnModel::AdjustOdeParameters(double currentTime)
 {
-    // Custom behaviour
     UpdateDeltaNotch();
+}
 
-    // Run the ODE simulation as needed
-    AbstractOdeSrnModel::SimulateToCurrentTime();
+bool DeltaNotchSrnModel::CanSolveOdesOnAnyThread()
+{
+    return true;
 }
 
 void DeltaNotchSrnModel::Initialise()
@@ -99,7 +100,8 @@ void DeltaNotchSrnModel::UpdateDeltaNotch()
     assert(mpOdeSystem != nullptr);
     assert(mpCell != nullptr);
 
-    double mean_delta = mpCell->GetCellData()->GetItem("mean delta");
+    static const unsigned mean_delta_key = CellData::GetKey("mean delta");
+    double mean_delta = mpCell->GetCellData()->GetItem(mean_delta_key);
     mpOdeSystem->SetParameter("Mean Delta", mean_delta);
 }
 
@@ -80,6 +80,23 @@ protected:
      */
     DeltaNotchSrnModel(const DeltaNotchSrnModel& rModel);
 
+    /**
+     * Overridden AdjustOdeParameters() method, which calls UpdateDeltaNotch() so that the
+     * ODEs see the current mean Delta.  This is the only place it is called when solving the
+     * ODEs, whether they are solved lazily or ahead of time.
+     *
+     * @param currentTime the current time
+     */
+    void AdjustOdeParameters(double currentTime);
+
+    /**
+     * Overridden CanSolveOdesOnAnyThread() method.  The Delta-Notch ODEs only depend on their
+     * state and the mean Delta parameter, which is set by AdjustOdeParameters().
+     *
+     * @return true
+     */
+    bool CanSolveOdesOnAnyThread();
+
 public:
 
     /**
@@ -104,13 +121,6 @@ public:
      */
     void Initialise(); // override
 
-    /**
-     * Overridden SimulateToTime() method for custom behaviour.
-     *
-     * \todo #2752 say what it does in this class
-     */
-    void SimulateToCurrentTime();
-
     /**
      * Update the current levels of Delta and Notch in the cell.
      *
@@ -75,6 +75,11 @@ AbstractSrnModel* Goldbeter1991SrnModel::CreateSrnModel()
     return new Goldbeter1991SrnModel(*this);
 }
 
+bool Goldbeter1991SrnModel::CanSolveOdesOnAnyThread()
+{
+    return true;
+}
+
 void Goldbeter1991SrnModel::SimulateToCurrentTime()
 {
     // Custom behaviour: run the ODE simulation as needed
@@ -81,6 +81,13 @@ protected:
      */
     Goldbeter1991SrnModel(const Goldbeter1991SrnModel& rModel);
 
+    /**
+     * Overridden CanSolveOdesOnAnyThread() method.  The Goldbeter 1991 ODEs only depend on their state.
+     *
+     * @return true
+     */
+    bool CanSolveOdesOnAnyThread();
+
 public:
 
     /**
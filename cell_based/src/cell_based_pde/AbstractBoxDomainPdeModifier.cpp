@@ -134,6 +134,18 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the keys of the cell data items once, rather than for every cell
+    const unsigned variable_key = CellData::GetKey(this->mDependentVariableName);
+    unsigned gradient_keys[3] = {UNSIGNED_UNSET, UNSIGNED_UNSET, UNSIGNED_UNSET};
+    if (this->mOutputGradient)
+    {
+        const char* gradient_suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned i=0; i<DIM; i++)
+        {
+            gradient_keys[i] = CellData::GetKey(this->mDependentVariableName + gradient_suffixes[i]);
+        }
+    }
+
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
          ++cell_iter)
@@ -155,7 +167,7 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
             solution_at_cell += nodal_value * weights(i);
         }
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_cell);
+        cell_iter->GetCellData()->SetItem(variable_key, solution_at_cell);
 
         if (this->mOutputGradient)
         {
@@ -183,16 +195,16 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
             switch (DIM)
             {
                 case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[0], solution_gradient(0));
                     break;
                 case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[0], solution_gradient(0));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[1], solution_gradient(1));
                     break;
                 case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[0], solution_gradient(0));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[1], solution_gradient(1));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[2], solution_gradient(2));
                     break;
                 default:
                     NEVER_REACHED;
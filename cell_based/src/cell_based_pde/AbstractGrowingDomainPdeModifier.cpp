@@ -86,6 +86,18 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the keys of the cell data items once, rather than for every cell
+    const unsigned variable_key = CellData::GetKey(this->mDependentVariableName);
+    unsigned gradient_keys[3] = {UNSIGNED_UNSET, UNSIGNED_UNSET, UNSIGNED_UNSET};
+    if (this->mOutputGradient)
+    {
+        const char* gradient_suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned i=0; i<DIM; i++)
+        {
+            gradient_keys[i] = CellData::GetKey(this->mDependentVariableName + gradient_suffixes[i]);
+        }
+    }
+
     // Local cell index used by the CA simulation
     unsigned cell_index = 0;
 
@@ -116,7 +128,7 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
 
         double solution_at_node = solution_repl[tet_node_index];
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_node);
+        cell_iter->GetCellData()->SetItem(variable_key, solution_at_node);
 
         if (this->mOutputGradient)
         {
@@ -156,16 +168,16 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
             switch (DIM)
             {
                 case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[0], solution_gradient(0));
                     break;
                 case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[0], solution_gradient(0));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[1], solution_gradient(1));
                     break;
                 case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[0], solution_gradient(0));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[1], solution_gradient(1));
+                    cell_iter->GetCellData()->SetItem(gradient_keys[2], solution_gradient(2));
                     break;
                 default:
                     NEVER_REACHED;
@@ -104,6 +104,23 @@ c_vector<double, SPACE_DIM> PopulationTestingForce<ELEMENT_DIM, SPACE_DIM>::GetE
     return result;
 }
 
+template<unsigned  ELEMENT_DIM, unsigned SPACE_DIM>
+c_vector<double, SPACE_DIM> PopulationTestingForce<ELEMENT_DIM, SPACE_DIM>::GetExpectedOneStepLocationRK23(unsigned nodeIndex,
+                                                                                       double damping,
+                                                                                       c_vector<double, SPACE_DIM>& oldLocation,
+                                                                                       double dt)
+{
+    c_vector<double, SPACE_DIM> result;
+    for (unsigned j = 0; j < SPACE_DIM; j++)
+    {
+        double k1 = (j+1)*0.01*nodeIndex * oldLocation[j] / damping;
+        double k2 = (j+1)*0.01*nodeIndex * (oldLocation[j] + 0.5*dt*k1) / damping;
+        double k3 = (j+1)*0.01*nodeIndex * (oldLocation[j] + 0.75*dt*k2) / damping;
+        result[j] = oldLocation[j] + dt*(2.0*k1 + 3.0*k2 + 4.0*k3)/9.0;
+    }
+    return result;
+}
+
 template<unsigned  ELEMENT_DIM, unsigned SPACE_DIM>
 c_vector<double, SPACE_DIM> PopulationTestingForce<ELEMENT_DIM, SPACE_DIM>::GetExpectedOneStepLocationAM2(unsigned nodeIndex,
                                                                                     double damping,
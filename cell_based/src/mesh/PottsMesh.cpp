@@ -134,6 +134,7 @@ void PottsMesh<DIM>::Clear()
     this->mNodes.clear();
 
     mDeletedElementIndices.clear();
+    mMooreNeighbourTableIsUpToDate = false;
 
     // Delete neighbour info
     //mVonNeumannNeighbouringNodeIndices.clear();
@@ -235,6 +236,109 @@ std::set<unsigned> PottsMesh<DIM>::GetMooreNeighbouringNodeIndices(unsigned node
     return mMooreNeighbouringNodeIndices[nodeIndex];
 }
 
+template<unsigned DIM>
+void PottsMesh<DIM>::UpdateMooreNeighbourTable()
+{
+    const unsigned num_nodes = mMooreNeighbouringNodeIndices.size();
+    mMooreNeighbourTable.clear();
+    mMooreNeighbourTableOffsets.resize(num_nodes + 1);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mMooreNeighbourTableOffsets[node_index] = mMooreNeighbourTable.size();
+        mMooreNeighbourTable.insert(mMooreNeighbourTable.end(),
+                                    mMooreNeighbouringNodeIndices[node_index].begin(),
+                                    mMooreNeighbouringNodeIndices[node_index].end());
+    }
+    mMooreNeighbourTableOffsets[num_nodes] = mMooreNeighbourTable.size();
+
+    // Greedily colour the nodes so that no two neighbours share a colour
+    std::vector<unsigned> node_colours(num_nodes, UNSIGNED_UNSET);
+    std::vector<bool> colour_is_used;
+    mCheckerboardNodes.clear();
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        colour_is_used.assign(mCheckerboardNodes.size() + 1, false);
+        for (unsigned i=mMooreNeighbourTableOffsets[node_index]; i<mMooreNeighbourTableOffsets[node_index+1]; i++)
+        {
+            unsigned neighbour_colour = node_colours[mMooreNeighbourTable[i]];
+            if (neighbour_colour != UNSIGNED_UNSET)
+            {
+                colour_is_used[neighbour_colour] = true;
+            }
+        }
+        if (node_index < mVonNeumannNeighbouringNodeIndices.size())
+        {
+            for (std::set<unsigned>::iterator iter = mVonNeumannNeighbouringNodeIndices[node_index].begin();
+                 iter != mVonNeumannNeighbouringNodeIndices[node_index].end();
+                 ++iter)
+            {
+                unsigned neighbour_colour = node_colours[*iter];
+                if (neighbour_colour != UNSIGNED_UNSET)
+                {
+                    colour_is_used[neighbour_colour] = true;
+                }
+            }
+        }
+
+        unsigned colour = 0;
+        while (colour_is_used[colour])
+        {
+            colour++;
+        }
+        if (colour == mCheckerboardNodes.size())
+        {
+            mCheckerboardNodes.push_back(std::vector<unsigned>());
+        }
+        node_colours[node_index] = colour;
+        mCheckerboardNodes[colour].push_back(node_index);
+    }
+
+    mMooreNeighbourTableIsUpToDate = true;
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetNumMooreNeighbours(unsigned nodeIndex)
+{
+    if (!mMooreNeighbourTableIsUpToDate)
+    {
+        UpdateMooreNeighbourTable();
+    }
+    assert(nodeIndex + 1 < mMooreNeighbourTableOffsets.size());
+    return mMooreNeighbourTableOffsets[nodeIndex+1] - mMooreNeighbourTableOffsets[nodeIndex];
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetMooreNeighbour(unsigned nodeIndex, unsigned neighbour)
+{
+    if (!mMooreNeighbourTableIsUpToDate)
+    {
+        UpdateMooreNeighbourTable();
+    }
+    assert(neighbour < mMooreNeighbourTableOffsets[nodeIndex+1] - mMooreNeighbourTableOffsets[nodeIndex]);
+    return mMooreNeighbourTable[mMooreNeighbourTableOffsets[nodeIndex] + neighbour];
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetNumCheckerboardColours()
+{
+    if (!mMooreNeighbourTableIsUpToDate)
+    {
+        UpdateMooreNeighbourTable();
+    }
+    return mCheckerboardNodes.size();
+}
+
+template<unsigned DIM>
+const std::vector<unsigned>& PottsMesh<DIM>::rGetCheckerboardNodes(unsigned colour)
+{
+    if (!mMooreNeighbourTableIsUpToDate)
+    {
+        UpdateMooreNeighbourTable();
+    }
+    assert(colour < mCheckerboardNodes.size());
+    return mCheckerboardNodes[colour];
+}
+
 template<unsigned DIM>
 std::set<unsigned> PottsMesh<DIM>::GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex)
 {
@@ -293,6 +397,7 @@ void PottsMesh<DIM>::DeleteNode(unsigned index)
     }
 
     // Remove from connectivity
+    mMooreNeighbourTableIsUpToDate = false;
     mVonNeumannNeighbouringNodeIndices[index].clear();
     mMooreNeighbouringNodeIndices[index].clear();
 
@@ -626,6 +731,8 @@ void PottsMesh<DIM>::ConstructFromMeshReader(AbstractMeshReader<DIM, DIM>& rMesh
         }
     }
 
+    mMooreNeighbourTableIsUpToDate = false;
+
     // If we are just using a mesh reader, then there is no neighbour information (see #1932)
     if (mVonNeumannNeighbouringNodeIndices.empty())
     {
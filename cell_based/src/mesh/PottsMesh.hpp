@@ -80,6 +80,34 @@ protected:
     /** Vector of set of Moore neighbours for each node. */
     std::vector< std::set<unsigned> > mMooreNeighbouringNodeIndices;
 
+    /**
+     * The Moore neighbours of every node in a single flat array, each node's neighbours
+     * in increasing order as in mMooreNeighbouringNodeIndices.  Built on demand; not archived.
+     */
+    std::vector<unsigned> mMooreNeighbourTable;
+
+    /**
+     * The position in mMooreNeighbourTable of the first Moore neighbour of each node,
+     * followed by the size of the table.
+     */
+    std::vector<unsigned> mMooreNeighbourTableOffsets;
+
+    /**
+     * The nodes of each checkerboard colour, in increasing order of node index.  No two nodes
+     * of the same colour are Moore or Von Neumann neighbours.  Built on demand with
+     * mMooreNeighbourTable; not archived.
+     */
+    std::vector<std::vector<unsigned> > mCheckerboardNodes;
+
+    /** Whether mMooreNeighbourTable is consistent with mMooreNeighbouringNodeIndices. */
+    bool mMooreNeighbourTableIsUpToDate;
+
+    /**
+     * Rebuild mMooreNeighbourTable and mMooreNeighbourTableOffsets from mMooreNeighbouringNodeIndices,
+     * and colour the nodes to give mCheckerboardNodes.
+     */
+    void UpdateMooreNeighbourTable();
+
     /**
      * Solve node mapping method. This overridden method is required
      * as it is pure virtual in the base class.
@@ -276,6 +304,39 @@ public:
      */
     std::set<unsigned> GetMooreNeighbouringNodeIndices(unsigned nodeIndex);
 
+    /**
+     * Given a node, return the number of its Moore neighbouring nodes.  Together with
+     * GetMooreNeighbour() this gives access to the neighbours without copying a set.
+     *
+     * @param nodeIndex global index of the node
+     * @return the number of neighbouring nodes in the Moore neighbourhood
+     */
+    unsigned GetNumMooreNeighbours(unsigned nodeIndex);
+
+    /**
+     * Given a node, return one of its Moore neighbouring nodes.
+     *
+     * @param nodeIndex global index of the node
+     * @param neighbour which neighbour, counting from zero in increasing order of node index
+     * @return the global index of that neighbouring node
+     */
+    unsigned GetMooreNeighbour(unsigned nodeIndex, unsigned neighbour);
+
+    /**
+     * @return the number of colours in the checkerboard decomposition of the mesh.
+     *
+     * The nodes are coloured greedily in index order so that no two nodes of the same colour
+     * are neighbours; on a regular lattice this gives the usual 2^DIM colour checkerboard
+     * (more if a periodic direction has an odd number of nodes).
+     */
+    unsigned GetNumCheckerboardColours();
+
+    /**
+     * @param colour the colour, counting from zero
+     * @return the indices of the nodes of the given checkerboard colour, in increasing order.
+     */
+    const std::vector<unsigned>& rGetCheckerboardNodes(unsigned colour);
+
     /**
      * Given a node, return a set containing the indices of its Von Neumann neighbouring nodes.
      *
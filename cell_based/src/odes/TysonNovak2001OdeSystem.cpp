@@ -98,7 +98,8 @@ void TysonNovak2001OdeSystem::Init()
     mMstar = 10.0;
 }
 
-void TysonNovak2001OdeSystem::EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY)
+template<class IN_VECTOR, class OUT_VECTOR>
+void TysonNovak2001OdeSystem::EvaluateDerivatives(const IN_VECTOR& rY, OUT_VECTOR& rDY)
 {
     double x1 = rY[0];
     double x2 = rY[1];
@@ -158,6 +159,16 @@ void TysonNovak2001OdeSystem::EvaluateYDerivatives(double time, const std::vecto
     rDY[5] = dx6*60.0;
 }
 
+void TysonNovak2001OdeSystem::EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY)
+{
+    EvaluateDerivatives(rY, rDY);
+}
+
+void TysonNovak2001OdeSystem::EvaluateFixedSizeYDerivatives(double time, const c_vector<double, 6>& rY, c_vector<double, 6>& rDY)
+{
+    EvaluateDerivatives(rY, rDY);
+}
+
 void TysonNovak2001OdeSystem::AnalyticJacobian(const std::vector<double>& rSolutionGuess, double** jacobian, double time, double timeStep)
 {
     timeStep *= 60.0; // to scale Jacobian so in hours not minutes
@@ -223,8 +234,8 @@ void TysonNovak2001OdeSystem::AnalyticJacobian(const std::vector<double>& rSolut
 
 bool TysonNovak2001OdeSystem::CalculateStoppingEvent(double time, const std::vector<double>& rY)
 {
-    std::vector<double> dy(rY.size());
-    EvaluateYDerivatives(time, rY, dy);
+    c_vector<double, 6> dy;
+    EvaluateDerivatives(rY, dy);
 
     // Only call this a stopping condition if the mass of the cell is over 0.6
     // (normally cycles from 0.5-1.0 ish!)
@@ -233,8 +244,8 @@ bool TysonNovak2001OdeSystem::CalculateStoppingEvent(double time, const std::vec
 
 double TysonNovak2001OdeSystem::CalculateRootFunction(double time, const std::vector<double>& rY)
 {
-    std::vector<double> dy(rY.size());
-    EvaluateYDerivatives(time, rY, dy);
+    c_vector<double, 6> dy;
+    EvaluateDerivatives(rY, dy);
 
     // Only call this a stopping condition if the mass of the cell is over 0.6
     // (normally cycles from 0.5-1.0 ish!)
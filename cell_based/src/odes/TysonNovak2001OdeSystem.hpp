@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 
 #include "AbstractOdeSystemWithAnalyticJacobian.hpp"
+#include "UblasVectorInclude.hpp"
 
 /**
  * Represents the Tyson & Novak (2001) system of ODEs.
@@ -146,8 +147,20 @@ private:
         archive & boost::serialization::base_object<AbstractOdeSystem>(*this);
     }
 
+    /**
+     * Compute the RHS of the ODEs, for either kind of state vector.
+     *
+     * @param rY value of the solution vector used to evaluate the RHS.
+     * @param rDY filled in with the resulting derivatives.
+     */
+    template<class IN_VECTOR, class OUT_VECTOR>
+    void EvaluateDerivatives(const IN_VECTOR& rY, OUT_VECTOR& rDY);
+
 public:
 
+    /** The number of state variables, for use with FixedSizeOneStepIvpOdeSolver. */
+    static const unsigned NUM_STATE_VARIABLES = 6;
+
     /**
      * Constructor.
      *
@@ -177,6 +190,16 @@ public:
      */
     void EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY);
 
+    /**
+     * Compute the RHS of the ODEs using fixed-size vectors.  This allows the system to be
+     * solved by FixedSizeOneStepIvpOdeSolver without any heap allocation.
+     *
+     * @param time used to evaluate the RHS.
+     * @param rY value of the solution vector used to evaluate the RHS.
+     * @param rDY filled in with the resulting derivatives.
+     */
+    void EvaluateFixedSizeYDerivatives(double time, const c_vector<double, 6>& rY, c_vector<double, 6>& rDY);
+
     /**
      * Calculate whether the conditions for the cell cycle to finish have been met.
      * (Used by Chaste solvers to find whether or not to stop solving)
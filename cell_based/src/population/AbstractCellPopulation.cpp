@@ -43,6 +43,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SmartPointers.hpp"
 #include "CellAncestor.hpp"
 #include "ApoptoticCellProperty.hpp"
+#include "CellCycleModelOdeHandler.hpp"
+#include "ThreadTools.hpp"
 
 // Cell writers
 #include "BoundaryNodeWriter.hpp"
@@ -72,7 +74,9 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
       mCells(rCells.begin(), rCells.end()),
       mCentroid(zero_vector<double>(SPACE_DIM)),
       mpCellPropertyRegistry(CellPropertyRegistry::Instance()->TakeOwnership()),
-      mOutputResultsForChasteVisualizer(true)
+      mOutputResultsForChasteVisualizer(true),
+      mUseBatchedOdeSolving(false),
+      mNumOdeThreads(1)
 {
     /*
      * To avoid double-counting problems, clear the passed-in cells vector.
@@ -104,7 +108,9 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
-    : mrMesh(rMesh)
+    : mrMesh(rMesh),
+      mUseBatchedOdeSolving(false),
+      mNumOdeThreads(1)
 {
 }
 
@@ -319,15 +325,15 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellUsingLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    // Get the set of pointers to cells corresponding to this location index (without inserting one, so this may be called concurrently)
+    typename std::map<unsigned, std::set<CellPtr> >::const_iterator iter = mLocationCellMap.find(index);
 
     // If there is only one cell attached return the cell. Note currently only one cell per index.
-    if (cells.size() == 1)
+    if (iter != mLocationCellMap.end() && iter->second.size() == 1)
     {
-        return *(cells.begin());
+        return *(iter->second.begin());
     }
-    if (cells.empty())
+    if (iter == mLocationCellMap.end() || iter->second.empty())
     {
         EXCEPTION("Location index input argument does not correspond to a Cell");
     }
@@ -773,6 +779,74 @@ bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsRoomToDivide(CellPtr pCel
     return true;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetUseBatchedOdeSolving(bool useBatchedOdeSolving)
+{
+    mUseBatchedOdeSolving = useBatchedOdeSolving;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetUseBatchedOdeSolving() const
+{
+    return mUseBatchedOdeSolving;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetNumberOfOdeThreads(unsigned numThreads)
+{
+    ThreadTools::CheckNumberOfThreads(numThreads, "cell ODEs cannot be solved");
+    mNumOdeThreads = numThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetNumberOfOdeThreads() const
+{
+    return mNumOdeThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SolveCellOdesToCurrentTime()
+{
+    double current_time = SimulationTime::Instance()->GetTime();
+
+    // Find the cells which Cell::ReadyToDivide() will be called on, and which have ODE-based models
+    std::vector<CellPtr> cells;
+    std::vector<CellCycleModelOdeHandler*> srn_models;
+    std::vector<CellCycleModelOdeHandler*> cell_cycle_models;
+    for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter = this->Begin();
+         cell_iter != this->End();
+         ++cell_iter)
+    {
+        if (cell_iter->GetAge() > 0.0
+            && !cell_iter->HasApoptosisBegun()
+            && !cell_iter->template HasCellProperty<ApoptoticCellProperty>())
+        {
+            cells.push_back(*cell_iter);
+
+            CellCycleModelOdeHandler* p_srn_model = dynamic_cast<CellCycleModelOdeHandler*>(cell_iter->GetSrnModel());
+            if (p_srn_model)
+            {
+                srn_models.push_back(p_srn_model);
+            }
+            CellCycleModelOdeHandler* p_cell_cycle_model = dynamic_cast<CellCycleModelOdeHandler*>(cell_iter->GetCellCycleModel());
+            if (p_cell_cycle_model)
+            {
+                cell_cycle_models.push_back(p_cell_cycle_model);
+            }
+        }
+    }
+
+    if (!srn_models.empty())
+    {
+        CellCycleModelOdeHandler::PresolveOdesToTime(srn_models, current_time, mNumOdeThreads);
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            cells[i]->GetSrnModel()->SimulateToCurrentTime();
+        }
+    }
+    CellCycleModelOdeHandler::PresolveOdesToTime(cell_cycle_models, current_time, mNumOdeThreads);
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 c_vector<double,SPACE_DIM> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetSizeOfCellPopulation()
 {
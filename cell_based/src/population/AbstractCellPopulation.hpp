@@ -152,6 +152,16 @@ protected:
     /** A list of cell population count writers. */
     std::vector<boost::shared_ptr<AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> > > mCellPopulationCountWriters;
 
+    /**
+     * Whether to solve the ODEs of all the cells' SRN and cell-cycle models together at the
+     * start of each round of cell division, rather than one cell at a time (defaults to false).
+     * Not archived, so must be set again after loading a checkpoint.
+     */
+    bool mUseBatchedOdeSolving;
+
+    /** The number of threads used when solving the cells' ODEs together (defaults to 1). Not archived. */
+    unsigned mNumOdeThreads;
+
     /**
      * Check consistency of our internal data structures.
      *
@@ -829,6 +839,40 @@ public:
      */
     std::pair<unsigned,unsigned> CreateOrderedPair(unsigned index1, unsigned index2);
 
+    /**
+     * Set whether to solve the ODEs of the cells' SRN and cell-cycle models together, by calling
+     * SolveCellOdesToCurrentTime() before cells are checked for division.  The results are
+     * identical to those obtained by solving each cell's ODEs when it is checked.
+     *
+     * @param useBatchedOdeSolving whether to solve the cells' ODEs together
+     */
+    void SetUseBatchedOdeSolving(bool useBatchedOdeSolving);
+
+    /**
+     * @return mUseBatchedOdeSolving
+     */
+    bool GetUseBatchedOdeSolving() const;
+
+    /**
+     * Set the number of threads used when solving the cells' ODEs together.
+     *
+     * @param numThreads the number of threads (at least one; more than one requires Chaste_USE_OPENMP)
+     */
+    void SetNumberOfOdeThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used when solving the cells' ODEs together
+     */
+    unsigned GetNumberOfOdeThreads() const;
+
+    /**
+     * Solve the ODEs of the SRN and cell-cycle models of all the cells which will be checked for
+     * division at the current time, using CellCycleModelOdeHandler::PresolveOdesToTime().  The SRN
+     * models are solved first and then updated in turn, since the cell-cycle models may depend
+     * on them.  The cell-cycle models then use the solutions when Cell::ReadyToDivide() is called.
+     */
+    void SolveCellOdesToCurrentTime();
+
     /**
      * Iterator class allows one to iterate over cells in the cell population.
      * Dereferencing the iterator will give you the current cell.
@@ -630,10 +630,16 @@ void CaBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirec
     // When outputting any CellData, we assume that the first cell is representative of all cells
     unsigned num_cell_data_items = 0u;
     std::vector<std::string> cell_data_names;
+    std::vector<unsigned> cell_data_keys;
     if (num_cells > 0u)
     {
         num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
         cell_data_names = this->Begin()->GetCellData()->GetKeys();
+        cell_data_keys.resize(cell_data_names.size());
+        for (unsigned var=0; var<cell_data_names.size(); var++)
+        {
+            cell_data_keys[var] = CellData::GetKey(cell_data_names[var]);
+        }
     }
     std::vector<std::vector<double> > cell_data;
     for (unsigned var=0; var<num_cell_data_items; var++)
@@ -730,7 +736,7 @@ void CaBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirec
     {
         for (unsigned var=0; var<num_cell_data_items; var++)
         {
-            cell_data[var][cell_index] = cell_iter->GetCellData()->GetItem(cell_data_names[var]);
+            cell_data[var][cell_index] = cell_iter->GetCellData()->GetItem(cell_data_keys[var]);
         }
         cell_index++;
     }
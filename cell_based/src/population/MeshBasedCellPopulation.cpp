@@ -607,6 +607,11 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
     // When outputting any CellData, we assume that the first cell is representative of all cells
     unsigned num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
     std::vector<std::string> cell_data_names = this->Begin()->GetCellData()->GetKeys();
+    std::vector<unsigned> cell_data_keys(cell_data_names.size());
+    for (unsigned var=0; var<cell_data_names.size(); var++)
+    {
+        cell_data_keys[var] = CellData::GetKey(cell_data_names[var]);
+    }
 
     std::vector<std::vector<double> > cell_data;
     for (unsigned var=0; var<num_cell_data_items; var++)
@@ -661,7 +666,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
 
             for (unsigned var=0; var<num_cell_data_items; var++)
             {
-                cell_data[var][node_index] = cell_iter->GetCellData()->GetItem(cell_data_names[var]);
+                cell_data[var][node_index] = cell_iter->GetCellData()->GetItem(cell_data_keys[var]);
             }
         }
         for (unsigned var=0; var<num_cell_data_items; var++)
@@ -737,7 +742,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
 
             for (unsigned var=0; var<num_cell_data_items; var++)
             {
-                cell_data[var][elem_index] = p_cell->GetCellData()->GetItem(cell_data_names[var]);
+                cell_data[var][elem_index] = p_cell->GetCellData()->GetItem(cell_data_keys[var]);
             }
         }
 
@@ -775,10 +780,8 @@ double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfCell(CellPtr p
         // Try to get the element index of the Voronoi tessellation corresponding to this node index
         try
         {
-            unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(node_index);
-
             // Get the cell's volume from the Voronoi tessellation
-            cell_volume = mpVoronoiTessellation->GetVolumeOfElement(element_index);
+            cell_volume = GetVolumeOfVoronoiElement(node_index);
         }
         catch (Exception&)
         {
@@ -844,6 +847,18 @@ bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetOutputMeshInVtk()
     return mOutputMeshInVtk;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetUseIncrementalReMesh(bool useIncrementalReMesh)
+{
+    mpMutableMesh->SetUseIncrementalReMesh(useIncrementalReMesh);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetUseIncrementalReMesh()
+{
+    return mpMutableMesh->GetUseIncrementalReMesh();
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteDataToVisualizerSetupFile(out_stream& pVizSetupFile)
 {
@@ -947,19 +962,31 @@ typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator MeshBase
 template<>
 void MeshBasedCellPopulation<2>::CreateVoronoiTessellation()
 {
-    delete mpVoronoiTessellation;
-
     // Check if the mesh associated with this cell population is periodic
-    bool is_mesh_periodic = false;
     if (bool(dynamic_cast<Cylindrical2dMesh*>(&mrMesh)))
     {
-        is_mesh_periodic = true;
+        delete mpVoronoiTessellation;
         mpVoronoiTessellation = new Cylindrical2dVertexMesh(static_cast<Cylindrical2dMesh &>(this->mrMesh));
     }
+    else if (mpVoronoiTessellation != nullptr && static_cast<MutableMesh<2, 2>&>(this->mrMesh).GetUseIncrementalReMesh())
+    {
+        /*
+         * Only recreate the Voronoi elements whose neighbourhood in the mesh has changed.
+         * This is not worthwhile after a full remesh, which renumbers every element of the
+         * mesh and hence every node of the tessellation.
+         */
+        mpVoronoiTessellation->UpdateVoronoiTessellation();
+    }
     else
     {
+        delete mpVoronoiTessellation;
+        bool is_mesh_periodic = false;
         mpVoronoiTessellation = new VertexMesh<2, 2>(static_cast<MutableMesh<2, 2> &>((this->mrMesh)), is_mesh_periodic);
     }
+
+    // Any cached volumes and surface areas are now out of date
+    mVoronoiElementVolumes.assign(mpVoronoiTessellation->GetNumAllElements(), DOUBLE_UNSET);
+    mVoronoiElementSurfaceAreas.assign(mpVoronoiTessellation->GetNumAllElements(), DOUBLE_UNSET);
 }
 
 /**
@@ -984,6 +1011,10 @@ void MeshBasedCellPopulation<3>::CreateVoronoiTessellation()
 {
     delete mpVoronoiTessellation;
     mpVoronoiTessellation = new VertexMesh<3, 3>(static_cast<MutableMesh<3, 3> &>((this->mrMesh)));
+
+    // Any cached volumes and surface areas are now out of date
+    mVoronoiElementVolumes.assign(mpVoronoiTessellation->GetNumAllElements(), DOUBLE_UNSET);
+    mVoronoiElementSurfaceAreas.assign(mpVoronoiTessellation->GetNumAllElements(), DOUBLE_UNSET);
 }
 
 /**
@@ -1037,16 +1068,30 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfVoronoiElement(unsigned index)
 {
     unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index);
-    double volume = mpVoronoiTessellation->GetVolumeOfElement(element_index);
-    return volume;
+    if (element_index >= mVoronoiElementVolumes.size())
+    {
+        mVoronoiElementVolumes.resize(mpVoronoiTessellation->GetNumAllElements(), DOUBLE_UNSET);
+    }
+    if (mVoronoiElementVolumes[element_index] == DOUBLE_UNSET)
+    {
+        mVoronoiElementVolumes[element_index] = mpVoronoiTessellation->GetVolumeOfElement(element_index);
+    }
+    return mVoronoiElementVolumes[element_index];
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetSurfaceAreaOfVoronoiElement(unsigned index)
 {
     unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index);
-    double surface_area = mpVoronoiTessellation->GetSurfaceAreaOfElement(element_index);
-    return surface_area;
+    if (element_index >= mVoronoiElementSurfaceAreas.size())
+    {
+        mVoronoiElementSurfaceAreas.resize(mpVoronoiTessellation->GetNumAllElements(), DOUBLE_UNSET);
+    }
+    if (mVoronoiElementSurfaceAreas[element_index] == DOUBLE_UNSET)
+    {
+        mVoronoiElementSurfaceAreas[element_index] = mpVoronoiTessellation->GetSurfaceAreaOfElement(element_index);
+    }
+    return mVoronoiElementSurfaceAreas[element_index];
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -82,6 +82,8 @@ private:
          */
         delete mpVoronoiTessellation;
         mpVoronoiTessellation = nullptr;
+        mVoronoiElementVolumes.clear();
+        mVoronoiElementSurfaceAreas.clear();
 
         archive & mSpringRestLengths;
         archive & mUseAreaBasedDampingConstant;
@@ -111,6 +113,20 @@ protected:
      */
     VertexMesh<ELEMENT_DIM, SPACE_DIM>* mpVoronoiTessellation;
 
+    /**
+     * The volume of each element of mpVoronoiTessellation, or DOUBLE_UNSET if it has not
+     * been computed since the tessellation was last created or updated. Used by
+     * GetVolumeOfVoronoiElement() so that forces and writers needing the same volume
+     * during a time step compute it only once.
+     */
+    std::vector<double> mVoronoiElementVolumes;
+
+    /**
+     * The surface area of each element of mpVoronoiTessellation, cached in the same
+     * way as mVoronoiElementVolumes by GetSurfaceAreaOfVoronoiElement().
+     */
+    std::vector<double> mVoronoiElementSurfaceAreas;
+
     /** Static cast of the mesh from AbstractCellPopulation */
     MutableMesh<ELEMENT_DIM, SPACE_DIM>* mpMutableMesh;
 
@@ -369,6 +385,10 @@ public:
 
     /**
      * Create a Voronoi tessellation of the mesh.
+     *
+     * In 2D, if the mesh is remeshed incrementally (see MutableMesh::SetUseIncrementalReMesh()),
+     * an existing tessellation is updated in place so that only the elements whose neighbourhood
+     * in the mesh has changed are recreated.
      */
     void CreateVoronoiTessellation();
 
@@ -385,6 +405,8 @@ public:
      * because the global indices of Delaunay nodes and Voronoi elements may not match,
      * e.g. if a node is a ghost node or corresponds to a Voronoi face.
      *
+     * The volume is cached until the tessellation is next created or updated.
+     *
      * \todo This method is somewhat redundant following the introduction of the method GetVolumeOfCell() (see #1985).
      *
      * @param index a node global index
@@ -399,6 +421,8 @@ public:
      * because the global indices of Delaunay nodes and Voronoi elements may not match,
      * e.g. if a node is a ghost node or corresponds to a Voronoi face.
      *
+     * The surface area is cached until the tessellation is next created or updated.
+     *
      * @param index a node global index
      */
     double GetSurfaceAreaOfVoronoiElement(unsigned index);
@@ -564,6 +588,23 @@ public:
      */
     bool GetOutputMeshInVtk();
 
+    /**
+     * Set whether the mesh should be remeshed incrementally, by repairing the existing
+     * triangulation rather than rebuilding it, where this is possible (2D only).  This
+     * calls MutableMesh::SetUseIncrementalReMesh(), so should be called before any
+     * cells divide or are removed, and throws if the mesh does not support incremental
+     * remeshing.  Incremental remeshing also allows the Voronoi tessellation to be
+     * updated in place.
+     *
+     * @param useIncrementalReMesh whether to remesh incrementally
+     */
+    void SetUseIncrementalReMesh(bool useIncrementalReMesh);
+
+    /**
+     * @return whether the mesh is remeshed incrementally where possible.
+     */
+    bool GetUseIncrementalReMesh();
+
     /**
      * Overridden GetNeighbouringNodeIndices() method.
      *
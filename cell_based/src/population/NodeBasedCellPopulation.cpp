@@ -47,7 +47,9 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh,
       mDeleteMesh(deleteMesh),
       mUseVariableRadii(false),
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mVerletSkin(0.0),
+      mNumNodePairCalculations(0u)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 
@@ -63,7 +65,9 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh)
       mDeleteMesh(true),
       mUseVariableRadii(false), // will be set by serialize() method
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mVerletSkin(0.0),
+      mNumNodePairCalculations(0u)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 }
@@ -113,6 +117,7 @@ template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::Clear()
 {
     mNodePairs.clear();
+    mNodeLocationsAtLastPairCalculation.clear();
 }
 
 template<unsigned DIM>
@@ -150,27 +155,36 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
     UpdateCellProcessLocation();
 
-    mpNodesOnlyMesh->UpdateBoxCollection();
-
-    if (mLoadBalanceMesh)
+    if (hasHadBirthsOrDeaths || !AreNodePairsValid())
     {
-        if ((SimulationTime::Instance()->GetTimeStepsElapsed() % mLoadBalanceFrequency) == 0)
+        mpNodesOnlyMesh->UpdateBoxCollection();
+
+        if (mLoadBalanceMesh)
         {
-            mpNodesOnlyMesh->LoadBalanceMesh();
+            if ((SimulationTime::Instance()->GetTimeStepsElapsed() % mLoadBalanceFrequency) == 0)
+            {
+                mpNodesOnlyMesh->LoadBalanceMesh();
 
-            UpdateCellProcessLocation();
+                UpdateCellProcessLocation();
 
-            mpNodesOnlyMesh->UpdateBoxCollection();
+                mpNodesOnlyMesh->UpdateBoxCollection();
+            }
         }
-    }
 
-    RefreshHaloCells();
+        RefreshHaloCells();
 
-    mpNodesOnlyMesh->CalculateInteriorNodePairs(mNodePairs);
+        mpNodesOnlyMesh->CalculateInteriorNodePairs(mNodePairs);
 
-    AddReceivedHaloCells();
+        AddReceivedHaloCells();
 
-    mpNodesOnlyMesh->CalculateBoundaryNodePairs(mNodePairs);
+        mpNodesOnlyMesh->CalculateBoundaryNodePairs(mNodePairs);
+
+        mNumNodePairCalculations++;
+        if (mVerletSkin > 0.0)
+        {
+            PruneNodePairsAndRecordLocations();
+        }
+    }
 
     /*
      * Update cell radii based on CellData
@@ -191,6 +205,62 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     PetscTools::Barrier("Update");
 }
 
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::AreNodePairsValid()
+{
+    // Halo nodes are recreated at every step in parallel, so the pairs must be too
+    if (mVerletSkin == 0.0 || PetscTools::IsParallel())
+    {
+        return false;
+    }
+    if (mNodeLocationsAtLastPairCalculation.size() != mpNodesOnlyMesh->GetNumNodes())
+    {
+        return false;
+    }
+
+    const double max_displacement_squared = 0.25*mVerletSkin*mVerletSkin;
+    unsigned i = 0;
+    for (typename AbstractMesh<DIM,DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter, ++i)
+    {
+        c_vector<double, DIM> displacement = mpNodesOnlyMesh->GetVectorFromAtoB(mNodeLocationsAtLastPairCalculation[i], node_iter->rGetLocation());
+        if (inner_prod(displacement, displacement) > max_displacement_squared)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::PruneNodePairsAndRecordLocations()
+{
+    // The box collection returns all pairs in neighbouring boxes; keep only those close enough to interact
+    const double cut_off = mpNodesOnlyMesh->GetMaximumInteractionDistance();
+    const double cut_off_squared = cut_off*cut_off;
+    unsigned num_kept = 0;
+    for (unsigned i=0; i<mNodePairs.size(); i++)
+    {
+        c_vector<double, DIM> node_to_node = mpNodesOnlyMesh->GetVectorFromAtoB(mNodePairs[i].first->rGetLocation(),
+                                                                                mNodePairs[i].second->rGetLocation());
+        if (inner_prod(node_to_node, node_to_node) <= cut_off_squared)
+        {
+            mNodePairs[num_kept++] = mNodePairs[i];
+        }
+    }
+    mNodePairs.resize(num_kept);
+
+    mNodeLocationsAtLastPairCalculation.clear();
+    mNodeLocationsAtLastPairCalculation.reserve(mpNodesOnlyMesh->GetNumNodes());
+    for (typename AbstractMesh<DIM,DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        mNodeLocationsAtLastPairCalculation.push_back(node_iter->rGetLocation());
+    }
+}
+
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
 {
@@ -291,6 +361,31 @@ std::vector< std::pair<Node<DIM>*, Node<DIM>* > >& NodeBasedCellPopulation<DIM>:
     return mNodePairs;
 }
 
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetVerletSkin(double verletSkin)
+{
+    if (verletSkin < 0.0 || verletSkin >= mpNodesOnlyMesh->GetMaximumInteractionDistance())
+    {
+        EXCEPTION("The Verlet skin must be non-negative and smaller than the maximum interaction distance of the mesh.");
+    }
+    mVerletSkin = verletSkin;
+
+    // Make sure the pairs are recalculated (and pruned) at the next update
+    mNodeLocationsAtLastPairCalculation.clear();
+}
+
+template<unsigned DIM>
+double NodeBasedCellPopulation<DIM>::GetVerletSkin() const
+{
+    return mVerletSkin;
+}
+
+template<unsigned DIM>
+unsigned NodeBasedCellPopulation<DIM>::GetNumNodePairCalculations() const
+{
+    return mNumNodePairCalculations;
+}
+
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::OutputCellPopulationParameters(out_stream& rParamsFile)
 {
@@ -377,6 +472,10 @@ std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNodesWithinNeighbourhoodRadi
     {
         EXCEPTION("neighbourhoodRadius should be less than or equal to the  the maximum interaction radius defined on the NodesOnlyMesh");
     }
+    if (neighbourhoodRadius > mpNodesOnlyMesh->GetMaximumInteractionDistance() - mVerletSkin)
+    {
+        EXCEPTION("neighbourhoodRadius should be less than or equal to the maximum interaction radius defined on the NodesOnlyMesh minus the Verlet skin");
+    }
 
     std::set<unsigned> neighbouring_node_indices;
 
@@ -480,6 +579,11 @@ std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNeighbouringNodeIndices(unsi
             {
                 EXCEPTION("mpNodesOnlyMesh::mMaxInteractionDistance is smaller than the sum of radius of cell " << index << " (" << radius_of_cell_i << ") and cell " << (*iter) << " (" << radius_of_cell_j <<"). Make the cut-off larger to avoid errors.");
             }
+            // The neighbour lists may have been kept from an earlier step (see SetVerletSkin())
+            if (!(max_interaction_distance <= mpNodesOnlyMesh->GetMaximumInteractionDistance() - mVerletSkin))
+            {
+                EXCEPTION("mpNodesOnlyMesh::mMaxInteractionDistance minus the Verlet skin is smaller than the sum of radius of cell " << index << " (" << radius_of_cell_i << ") and cell " << (*iter) << " (" << radius_of_cell_j <<"). Make the cut-off larger or the skin smaller to avoid errors.");
+            }
             if (distance_between_nodes <= max_interaction_distance)// + DBL_EPSILSON) //Assumes that max_interaction_distance is of order 1
             {
                 // ...then add this node index to the set of neighbouring node indices
@@ -651,6 +755,11 @@ void NodeBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDir
     {
         auto num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
         std::vector<std::string> cell_data_names = this->Begin()->GetCellData()->GetKeys();
+        std::vector<unsigned> cell_data_keys(cell_data_names.size());
+        for (unsigned var=0; var<cell_data_names.size(); var++)
+        {
+            cell_data_keys[var] = CellData::GetKey(cell_data_names[var]);
+        }
         std::vector<std::vector<double>> cell_data(num_cell_data_items, std::vector<double>(num_nodes));
 
         std::vector<double> rank(num_nodes);
@@ -662,7 +771,7 @@ void NodeBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDir
 
             for (unsigned cell_data_idx = 0; cell_data_idx < num_cell_data_items; ++cell_data_idx)
             {
-                cell_data[cell_data_idx][node_idx] = cell_iter->GetCellData()->GetItem(cell_data_names[cell_data_idx]);
+                cell_data[cell_data_idx][node_idx] = cell_iter->GetCellData()->GetItem(cell_data_keys[cell_data_idx]);
             }
 
             rank[node_idx] = (PetscTools::GetMyRank());
@@ -112,6 +112,36 @@ private:
     /** The frequency at which the mesh is rebalanced */
     unsigned mLoadBalanceFrequency;
 
+    /**
+     * The skin distance used for Verlet neighbour lists, or zero (the default) to recalculate
+     * #mNodePairs at every call to Update().  See SetVerletSkin().
+     */
+    double mVerletSkin;
+
+    /**
+     * The locations of the nodes, in node iterator order, when #mNodePairs was last calculated.
+     * Only used if #mVerletSkin is positive.
+     */
+    std::vector<c_vector<double, DIM> > mNodeLocationsAtLastPairCalculation;
+
+    /** The number of times #mNodePairs has been calculated by Update(). */
+    unsigned mNumNodePairCalculations;
+
+    /**
+     * @return whether #mNodePairs may be reused because Verlet lists are in use and no node
+     * has moved more than half of #mVerletSkin since the pairs were last calculated.
+     *
+     * This is always false in parallel: the halo nodes are deleted and received afresh at
+     * every step, so pairs involving them would refer to deleted nodes.
+     */
+    bool AreNodePairsValid();
+
+    /**
+     * Remove pairs of nodes further apart than the maximum interaction distance of the mesh
+     * from #mNodePairs, and record the current node locations.  Used with Verlet lists.
+     */
+    void PruneNodePairsAndRecordLocations();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -128,6 +158,7 @@ private:
     {
         archive & boost::serialization::base_object<AbstractCentreBasedCellPopulation<DIM> >(*this);
         archive & mUseVariableRadii;
+        archive & mVerletSkin;
 
         this->Validate();
     }
@@ -332,6 +363,9 @@ public:
     /**
      * Remove nodes that have been marked as deleted and update the node cell map.
      *
+     * Also recalculates the node pairs, unless Verlet lists are in use (see SetVerletSkin())
+     * and the existing pairs are still valid.
+     *
      * @param hasHadBirthsOrDeaths whether cell population has had Births Or Deaths
      */
     void Update(bool hasHadBirthsOrDeaths=true);
@@ -407,6 +441,39 @@ public:
      */
     void SetLoadBalanceFrequency(unsigned loadBalanceFrequency);
 
+    /**
+     * Use Verlet neighbour lists for the node pairs.  When the pairs are calculated, only pairs
+     * closer than the maximum interaction distance of the mesh are kept, and the pairs are then
+     * reused by Update() until some node has moved more than half the skin distance.  They are
+     * always recalculated after births or deaths.
+     *
+     * Verlet lists currently only save work in serial.  In parallel the halo nodes are
+     * exchanged afresh at every step, so the pairs are still recalculated at every step.
+     *
+     * The pairs then include every pair of nodes closer than the maximum interaction distance
+     * minus the skin, so forces must have a cut-off length no larger than this.  For example,
+     * for a force cut-off of 1.5 and a skin of 0.3, construct the mesh with a maximum interaction
+     * distance of 1.8.
+     *
+     * The candidate neighbours of each node used by GetNeighbouringNodeIndices() and
+     * GetNodesWithinNeighbourhoodRadius() are recalculated along with the pairs, so those
+     * methods also require the distances they search to be no larger than the maximum
+     * interaction distance minus the skin, and throw otherwise.
+     *
+     * @param verletSkin the skin distance, or zero to recalculate the pairs at every step
+     */
+    void SetVerletSkin(double verletSkin);
+
+    /**
+     * @return the skin distance used for Verlet neighbour lists (zero if they are not used)
+     */
+    double GetVerletSkin() const;
+
+    /**
+     * @return the number of times the node pairs have been calculated by Update()
+     */
+    unsigned GetNumNodePairCalculations() const;
+
     /**
      * Overridden GetWidth() method.
      *
@@ -432,7 +499,8 @@ public:
      *
      * @param index the node index
      * @param neighbourhoodRadius the radius to find neighbours in.
-     * Note must be less than the MaximumInteractionDistance in the NodesOnlyMesh
+     * Note must be less than the MaximumInteractionDistance in the NodesOnlyMesh,
+     * minus the Verlet skin if one is set (see SetVerletSkin())
      *
      * @return the set of neighbouring node indices within neighbourhoodRadius of the specified node.
      */
@@ -442,6 +510,8 @@ public:
      * Overridden GetNeighbouringNodeIndices() method.
      *
      * Not that this method only returns node indices for cells that are strictly touching each other.
+     * If a Verlet skin is set, the sum of the radii of two cells must be no larger than the
+     * MaximumInteractionDistance in the NodesOnlyMesh minus the skin (see SetVerletSkin()).
      *
      * @param index the node index
      * @return the set of neighbouring node indices.
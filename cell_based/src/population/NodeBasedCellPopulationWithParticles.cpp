@@ -230,12 +230,18 @@ void NodeBasedCellPopulationWithParticles<DIM>::WriteVtkResultsToFile(const std:
 
     unsigned num_cell_data_items = 0;
     std::vector<std::string> cell_data_names;
+    std::vector<unsigned> cell_data_keys;
 
     // We assume that the first cell is representative of all cells
     if (num_nodes > 0)
     {
         num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
         cell_data_names = this->Begin()->GetCellData()->GetKeys();
+        cell_data_keys.resize(cell_data_names.size());
+        for (unsigned var=0; var<cell_data_names.size(); var++)
+        {
+            cell_data_keys[var] = CellData::GetKey(cell_data_names[var]);
+        }
     }
 
     std::vector<std::vector<double> > cell_data;
@@ -291,7 +297,7 @@ void NodeBasedCellPopulationWithParticles<DIM>::WriteVtkResultsToFile(const std:
 
         for (unsigned var=0; var<num_cell_data_items; var++)
         {
-            cell_data[var][node_index] = cell_iter->GetCellData()->GetItem(cell_data_names[var]);
+            cell_data[var][node_index] = cell_iter->GetCellData()->GetItem(cell_data_keys[var]);
         }
 
         rank[node_index] = (PetscTools::GetMyRank());
@@ -41,8 +41,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellIdWriter.hpp"
 
 // Needed to convert mesh in order to write nodes to VTK (visualize as glyphs)
+#include "ThreadTools.hpp"
 #include "VtkMeshWriter.hpp"
 
+#include <climits>
+#include <boost/random.hpp>
+
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif // CHASTE_OPENMP
+
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::Validate()
 {
@@ -81,7 +89,9 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh,
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseCheckerboardSweep(false),
+      mNumThreads(1u)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
     // Check each element has only one cell associated with it
@@ -97,7 +107,9 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh)
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseCheckerboardSweep(false),
+      mNumThreads(1u)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
 }
@@ -260,6 +272,29 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
         p_gen->Shuffle(this->mUpdateRuleCollection);
     }
 
+    /*
+     * Record the element containing each node (or UNSIGNED_UNSET for the medium) in a flat
+     * array, kept up to date as nodes are swapped, so that neighbour picks within the same
+     * element can be rejected without copying the nodes' sets of containing elements.
+     */
+    std::vector<unsigned> element_containing_node(num_nodes, UNSIGNED_UNSET);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        // Each node in the mesh must be in at most one element
+        const std::set<unsigned>& r_containing_elements = this->mrMesh.GetNode(node_index)->rGetContainingElementIndices();
+        assert(r_containing_elements.size() <= 1);
+        if (!r_containing_elements.empty())
+        {
+            element_containing_node[node_index] = *(r_containing_elements.begin());
+        }
+    }
+
+    if (mUseCheckerboardSweep)
+    {
+        PerformCheckerboardSweeps(element_containing_node);
+        return;
+    }
+
     for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
     {
         unsigned node_index;
@@ -274,73 +309,168 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
             node_index = i%num_nodes;
         }
 
-        Node<DIM>* p_node = this->mrMesh.GetNode(node_index);
-
-        // Each node in the mesh must be in at most one element
-        assert(p_node->GetNumContainingElements() <= 1);
-
         // Find a random available neighbouring node to overwrite current site
-        std::set<unsigned> neighbouring_node_indices = mpPottsMesh->GetMooreNeighbouringNodeIndices(node_index);
-        unsigned neighbour_location_index;
+        unsigned num_neighbours = mpPottsMesh->GetNumMooreNeighbours(node_index);
 
-        if (!neighbouring_node_indices.empty())
+        if (num_neighbours > 0)
         {
-            unsigned num_neighbours = neighbouring_node_indices.size();
             unsigned chosen_neighbour = p_gen->randMod(num_neighbours);
+            unsigned neighbour_location_index = mpPottsMesh->GetMooreNeighbour(node_index, chosen_neighbour);
 
-            std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-            for (unsigned j=0; j<chosen_neighbour; j++)
-            {
-                neighbour_iter++;
-            }
-
-            neighbour_location_index = *neighbour_iter;
+            unsigned element_index = element_containing_node[node_index];
+            unsigned neighbour_element_index = element_containing_node[neighbour_location_index];
 
-            std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
-            std::set<unsigned> neighbour_containing_elements = GetNode(neighbour_location_index)->rGetContainingElementIndices();
             // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
-            if ((!containing_elements.empty() && neighbour_containing_elements.empty())
-                || (containing_elements.empty() && !neighbour_containing_elements.empty())
-                || (!containing_elements.empty() && !neighbour_containing_elements.empty() && *containing_elements.begin() != *neighbour_containing_elements.begin()))
+            if (element_index != neighbour_element_index)
             {
-                double delta_H = 0.0; // This is H_1-H_0.
-
-                // Now add contributions to the Hamiltonian from each AbstractPottsUpdateRule
-                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
-                     iter != this->mUpdateRuleCollection.end();
-                     ++iter)
-                {
-                    // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
-                    double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbour_location_index, p_node->GetIndex(), *this);
-                    delta_H += dH;
-                }
+                double delta_H = EvaluateHamiltonianChange(neighbour_location_index, node_index); // This is H_1-H_0.
 
                 // Generate a uniform random number to do the random motion
                 double random_number = p_gen->ranf();
 
-                double p = exp(-delta_H/mTemperature);
-                if (delta_H <= 0 || random_number < p)
+                // Only evaluate the Boltzmann factor if the energy increases
+                if (delta_H <= 0 || random_number < exp(-delta_H/mTemperature))
                 {
                     // Do swap
+                    MoveNodeToElement(node_index, element_index, neighbour_element_index);
+                    element_containing_node[node_index] = neighbour_element_index;
+                }
+            }
+        }
+    }
+}
 
-                    // Remove the current node from any elements containing it (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = containing_elements.begin();
-                         iter != containing_elements.end();
-                         ++iter)
-                    {
-                        GetElement(*iter)->DeleteNode(GetElement(*iter)->GetNodeLocalIndex(node_index));
+template<unsigned DIM>
+double PottsBasedCellPopulation<DIM>::EvaluateHamiltonianChange(unsigned currentNodeIndex, unsigned targetNodeIndex)
+{
+    double delta_H = 0.0;
 
-                        ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
-                    }
+    // Add contributions to the Hamiltonian from each AbstractPottsUpdateRule
+    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
+         iter != this->mUpdateRuleCollection.end();
+         ++iter)
+    {
+        // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
+        double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(currentNodeIndex, targetNodeIndex, *this);
+        delta_H += dH;
+    }
+
+    return delta_H;
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::MoveNodeToElement(unsigned nodeIndex, unsigned elementIndex, unsigned newElementIndex)
+{
+    // Remove the node from the element containing it, if any
+    if (elementIndex != UNSIGNED_UNSET)
+    {
+        PottsElement<DIM>* p_element = GetElement(elementIndex);
+        p_element->DeleteNode(p_element->GetNodeLocalIndex(nodeIndex));
+
+        ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
+    }
+
+    // Next add the node to the new element, if any
+    if (newElementIndex != UNSIGNED_UNSET)
+    {
+        GetElement(newElementIndex)->AddNode(this->mrMesh.GetNode(nodeIndex));
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::PerformCheckerboardSweeps(std::vector<unsigned>& rElementContainingNode)
+{
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+
+    // The number of nodes of one colour given their own random number stream
+    const unsigned block_size = 1024;
 
-                    // Next add the current node to any elements containing the neighbouring node (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = neighbour_containing_elements.begin();
-                         iter != neighbour_containing_elements.end();
-                         ++iter)
+    // Build the neighbour table and colouring here, as they must not be built inside the parallel region
+    const unsigned num_colours = mpPottsMesh->GetNumCheckerboardColours();
+    if (num_colours == 0)
+    {
+        return;
+    }
+    std::vector<unsigned> colour_order;
+
+    for (unsigned sweep=0; sweep<mNumSweepsPerTimestep; sweep++)
+    {
+        p_gen->Shuffle(num_colours, colour_order);
+
+        for (unsigned c=0; c<num_colours; c++)
+        {
+            const std::vector<unsigned>& r_nodes = mpPottsMesh->rGetCheckerboardNodes(colour_order[c]);
+            const unsigned num_blocks = (r_nodes.size() + block_size - 1)/block_size;
+
+            // Seed one stream per block in block order, so the results do not depend on the number of threads
+            std::vector<unsigned> block_seeds(num_blocks);
+            for (unsigned block=0; block<num_blocks; block++)
+            {
+                block_seeds[block] = p_gen->randMod(UINT_MAX);
+            }
+
+            // The (node, new element) pairs of the copies accepted in each block
+            std::vector<std::vector<std::pair<unsigned, unsigned> > > block_moves(num_blocks);
+            std::vector<boost::shared_ptr<Exception> > block_exceptions(num_blocks);
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for num_threads(mNumThreads) schedule(dynamic)
+#endif // CHASTE_OPENMP
+            for (int block=0; block<(int)num_blocks; block++)
+            {
+                try
+                {
+                    boost::mt19937 block_generator(block_seeds[block]);
+                    boost::variate_generator<boost::mt19937&, boost::uniform_real<> > unit_real(block_generator, boost::uniform_real<>());
+
+                    const unsigned block_end = std::min<unsigned>((block + 1)*block_size, r_nodes.size());
+                    for (unsigned i=block*block_size; i<block_end; i++)
                     {
-                        GetElement(*iter)->AddNode(this->mrMesh.GetNode(node_index));
+                        const unsigned node_index = r_nodes[i];
+                        const unsigned num_neighbours = mpPottsMesh->GetNumMooreNeighbours(node_index);
+                        if (num_neighbours == 0)
+                        {
+                            continue;
+                        }
+
+                        const unsigned chosen_neighbour = std::min<unsigned>(unit_real()*num_neighbours, num_neighbours - 1);
+                        const unsigned neighbour_location_index = mpPottsMesh->GetMooreNeighbour(node_index, chosen_neighbour);
+
+                        const unsigned element_index = rElementContainingNode[node_index];
+                        const unsigned neighbour_element_index = rElementContainingNode[neighbour_location_index];
+
+                        if (element_index != neighbour_element_index)
+                        {
+                            double delta_H = EvaluateHamiltonianChange(neighbour_location_index, node_index);
+                            double random_number = unit_real();
+
+                            if (delta_H <= 0 || random_number < exp(-delta_H/mTemperature))
+                            {
+                                block_moves[block].push_back(std::make_pair(node_index, neighbour_element_index));
+                            }
+                        }
                     }
                 }
+                catch (Exception& e)
+                {
+                    block_exceptions[block].reset(new Exception(e));
+                }
+            }
+
+            // Apply the accepted copies, synchronising element volumes and surface areas before the next colour
+            for (unsigned block=0; block<num_blocks; block++)
+            {
+                if (block_exceptions[block])
+                {
+                    throw *(block_exceptions[block]);
+                }
+                for (unsigned i=0; i<block_moves[block].size(); i++)
+                {
+                    const unsigned node_index = block_moves[block][i].first;
+                    const unsigned new_element_index = block_moves[block][i].second;
+                    MoveNodeToElement(node_index, rElementContainingNode[node_index], new_element_index);
+                    rElementContainingNode[node_index] = new_element_index;
+                }
             }
         }
     }
@@ -427,6 +557,31 @@ void PottsBasedCellPopulation<DIM>::AddUpdateRule(boost::shared_ptr<AbstractUpda
     this->mUpdateRuleCollection.push_back(pUpdateRule);
 }
 
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUseCheckerboardSweep(bool useCheckerboardSweep)
+{
+    mUseCheckerboardSweep = useCheckerboardSweep;
+}
+
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::GetUseCheckerboardSweep()
+{
+    return mUseCheckerboardSweep;
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetNumberOfThreads(unsigned numThreads)
+{
+    ThreadTools::CheckNumberOfThreads(numThreads, "Monte Carlo sweeps cannot be performed");
+    mNumThreads = numThreads;
+}
+
+template<unsigned DIM>
+unsigned PottsBasedCellPopulation<DIM>::GetNumberOfThreads() const
+{
+    return mNumThreads;
+}
+
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::CreateElementTessellation()
 {
@@ -562,6 +717,11 @@ void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDi
     // When outputting any CellData, we assume that the first cell is representative of all cells
     unsigned num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
     std::vector<std::string> cell_data_names = this->Begin()->GetCellData()->GetKeys();
+    std::vector<unsigned> cell_data_keys(cell_data_names.size());
+    for (unsigned var=0; var<cell_data_names.size(); var++)
+    {
+        cell_data_keys[var] = CellData::GetKey(cell_data_names[var]);
+    }
 
     std::vector<std::vector<double> > cell_data;
     for (unsigned var=0; var<num_cell_data_items; var++)
@@ -595,7 +755,7 @@ void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDi
 
             for (unsigned var=0; var<num_cell_data_items; var++)
             {
-                cell_data[var][node_index] = p_cell->GetCellData()->GetItem(cell_data_names[var]);
+                cell_data[var][node_index] = p_cell->GetCellData()->GetItem(cell_data_keys[var]);
             }
         }
     }
@@ -91,6 +91,19 @@ private:
      */
     unsigned mNumSweepsPerTimestep;
 
+    /**
+     * Whether to update the lattice using checkerboard sub-sweeps rather than the
+     * random-sequential Monte Carlo sweep.  Initialised to false in the constructor.
+     * Not archived, so must be set again after loading a checkpoint.
+     */
+    bool mUseCheckerboardSweep;
+
+    /**
+     * The number of threads used by checkerboard sub-sweeps.  Initialised to 1 in the
+     * constructor.  Not archived.
+     */
+    unsigned mNumThreads;
+
     friend class boost::serialization::access;
     /**
      * Serialize the object and its member variables.
@@ -136,6 +149,58 @@ private:
      */
     virtual void WriteVtkResultsToFile(const std::string& rDirectory);
 
+    /**
+     * Sum the contributions of each update rule to the change in the Hamiltonian
+     * if the current node is added to the element containing the target node.
+     *
+     * @param currentNodeIndex index of the node whose element is copied
+     * @param targetNodeIndex index of the node being overwritten
+     * @return the change in the Hamiltonian, H_1 - H_0
+     */
+    double EvaluateHamiltonianChange(unsigned currentNodeIndex, unsigned targetNodeIndex);
+
+    /**
+     * Move a node from one element to another.
+     *
+     * @param nodeIndex index of the node
+     * @param elementIndex index of the element currently containing the node (UNSIGNED_UNSET for the medium)
+     * @param newElementIndex index of the element to add the node to (UNSIGNED_UNSET for the medium)
+     */
+    void MoveNodeToElement(unsigned nodeIndex, unsigned elementIndex, unsigned newElementIndex);
+
+    /**
+     * Perform mNumSweepsPerTimestep checkerboard Monte Carlo sweeps of the lattice.
+     * Called by UpdateCellLocations() when mUseCheckerboardSweep is true.
+     *
+     * The nodes are split into the colour classes given by PottsMesh::rGetCheckerboardNodes(),
+     * none of which contains a pair of neighbouring nodes.  Each sweep visits the colours in a
+     * random order and, for each colour, proposes one copy into every node of that colour.
+     * Since the nodes of one colour do not neighbour each other, the local terms of each
+     * proposal (the neighbours' elements, and hence adhesion energies) cannot be changed by
+     * any other proposal of the same sub-sweep, so all the proposals are evaluated against the
+     * lattice as it was at the start of the sub-sweep, concurrently if mNumThreads > 1.  The
+     * accepted copies are then applied together, which synchronises the element volumes and
+     * surface areas before the next sub-sweep.
+     *
+     * What the code guarantees is that each sweep proposes exactly one copy into every node,
+     * where the random-sequential sweep draws num_nodes nodes with replacement, and that each
+     * proposal is accepted with the same Metropolis probability as in the random-sequential
+     * sweep given the lattice at the start of its sub-sweep.  The local terms of delta_H are
+     * then evaluated exactly, but global terms (volume and surface area constraints) see element
+     * sizes that are up to one sub-sweep old, with an error of the order of the number of copies
+     * into an element per sub-sweep.  The sweep is not claimed to satisfy detailed balance; it is
+     * a different Monte Carlo dynamics from the default sweep, and results agree only statistically,
+     * to the extent checked by the tests, rather than being identical.
+     *
+     * The nodes of each colour are processed in fixed blocks, each with its own random number
+     * stream seeded from the RandomNumberGenerator, so the results do not depend on the number
+     * of threads.  Update rules must be safe to evaluate concurrently when mNumThreads > 1.
+     *
+     * @param rElementContainingNode the element containing each node (UNSIGNED_UNSET for the medium),
+     *     updated as nodes are moved
+     */
+    void PerformCheckerboardSweeps(std::vector<unsigned>& rElementContainingNode);
+
 public:
 
     /**
@@ -386,6 +451,32 @@ public:
      */
     unsigned GetNumSweepsPerTimestep();
 
+    /**
+     * Set mUseCheckerboardSweep.  See PerformCheckerboardSweeps() for how the checkerboard
+     * sweep relates to the default random-sequential sweep.
+     *
+     * @param useCheckerboardSweep whether to update the lattice using checkerboard sub-sweeps
+     */
+    void SetUseCheckerboardSweep(bool useCheckerboardSweep);
+
+    /**
+     * @return mUseCheckerboardSweep
+     */
+    bool GetUseCheckerboardSweep();
+
+    /**
+     * Set the number of threads used by checkerboard sub-sweeps.  This has no effect on the
+     * default random-sequential sweep, which is inherently serial.
+     *
+     * @param numThreads the number of threads (at least one; more than one requires Chaste_USE_OPENMP)
+     */
+    void SetNumberOfThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used by checkerboard sub-sweeps
+     */
+    unsigned GetNumberOfThreads() const;
+
     /**
      * Create a Element tessellation of the mesh for use in visualising the mesh.
      */
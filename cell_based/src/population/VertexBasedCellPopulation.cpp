@@ -427,6 +427,11 @@ void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rD
     // When outputting any CellData, we assume that the first cell is representative of all cells
     unsigned num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
     std::vector<std::string> cell_data_names = this->Begin()->GetCellData()->GetKeys();
+    std::vector<unsigned> cell_data_keys(cell_data_names.size());
+    for (unsigned var=0; var<cell_data_names.size(); var++)
+    {
+        cell_data_keys[var] = CellData::GetKey(cell_data_names[var]);
+    }
 
     std::vector<std::vector<double> > cell_data;
     for (unsigned var=0; var<num_cell_data_items; var++)
@@ -449,7 +454,7 @@ void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rD
 
         for (unsigned var=0; var<num_cell_data_items; var++)
         {
-            cell_data[var][elem_index] = p_cell->GetCellData()->GetItem(cell_data_names[var]);
+            cell_data[var][elem_index] = p_cell->GetCellData()->GetItem(cell_data_keys[var]);
         }
     }
     for (unsigned var=0; var<num_cell_data_items; var++)
@@ -34,12 +34,18 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractTwoBodyInteractionForce.hpp"
+#include "ThreadTools.hpp"
+
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AbstractTwoBodyInteractionForce()
    : AbstractForce<ELEMENT_DIM,SPACE_DIM>(),
      mUseCutOffLength(false),
-     mMechanicsCutOffLength(DBL_MAX)
+     mMechanicsCutOffLength(DBL_MAX),
+     mNumThreads(1u)
 {
 }
 
@@ -63,6 +69,105 @@ double AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetCutOffLength()
     return mMechanicsCutOffLength;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::SetNumberOfThreads(unsigned numThreads)
+{
+    ThreadTools::CheckNumberOfThreads(numThreads, "forces cannot be calculated");
+    mNumThreads = numThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetNumberOfThreads() const
+{
+    return mNumThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributionsFromNodePairs(const std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >& rNodePairs,
+                                                                                               AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+#ifdef CHASTE_OPENMP
+    if (mNumThreads > 1u)
+    {
+        const int num_pairs = rNodePairs.size();
+        std::vector<c_vector<double, SPACE_DIM> > pair_forces(num_pairs);
+
+        // Per-thread record of the first failed pair, so the serial exception can be reproduced
+        std::vector<unsigned> failed_pair(mNumThreads, UNSIGNED_UNSET);
+        std::vector<boost::shared_ptr<Exception> > thread_exceptions(mNumThreads);
+
+        // Static scheduling gives each thread a contiguous block of pairs
+#pragma omp parallel for num_threads(mNumThreads) schedule(static)
+        for (int i=0; i<num_pairs; i++)
+        {
+            const unsigned thread = omp_get_thread_num();
+            if (thread_exceptions[thread])
+            {
+                continue; // This thread has already failed
+            }
+            try
+            {
+                pair_forces[i] = CalculateForceBetweenNodes(rNodePairs[i].first->GetIndex(), rNodePairs[i].second->GetIndex(), rCellPopulation);
+            }
+            catch (Exception& e)
+            {
+                failed_pair[thread] = i;
+                thread_exceptions[thread].reset(new Exception(e));
+            }
+        }
+
+        // Rethrow the exception for the lowest failed pair, as the serial loop would have done
+        unsigned failed_thread = UNSIGNED_UNSET;
+        for (unsigned thread=0; thread<mNumThreads; thread++)
+        {
+            if (thread_exceptions[thread] && (failed_thread == UNSIGNED_UNSET || failed_pair[thread] < failed_pair[failed_thread]))
+            {
+                failed_thread = thread;
+            }
+        }
+        if (failed_thread != UNSIGNED_UNSET)
+        {
+            throw *(thread_exceptions[failed_thread]);
+        }
+
+        // Accumulate in pair order so the result does not depend on the number of threads
+        for (int i=0; i<num_pairs; i++)
+        {
+            for (unsigned j=0; j<SPACE_DIM; j++)
+            {
+                assert(!std::isnan(pair_forces[i][j]));
+            }
+            c_vector<double, SPACE_DIM> negative_force = -1.0*pair_forces[i];
+            rNodePairs[i].first->AddAppliedForceContribution(pair_forces[i]);
+            rNodePairs[i].second->AddAppliedForceContribution(negative_force);
+        }
+        return;
+    }
+#endif // CHASTE_OPENMP
+
+    for (typename std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >::const_iterator iter = rNodePairs.begin();
+        iter != rNodePairs.end();
+        iter++)
+    {
+        std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > pair = *iter;
+
+        unsigned node_a_index = pair.first->GetIndex();
+        unsigned node_b_index = pair.second->GetIndex();
+
+        // Calculate the force between nodes
+        c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(node_a_index, node_b_index, rCellPopulation);
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            assert(!std::isnan(force[j]));
+        }
+
+        // Add the force contribution to each node
+        c_vector<double, SPACE_DIM> negative_force = -1.0*force;
+        pair.first->AddAppliedForceContribution(force);
+        pair.second->AddAppliedForceContribution(negative_force);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContribution(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
 {
@@ -77,50 +182,22 @@ void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributio
     {
         MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
-        // Iterate over all springs and add force contributions
+        // Gather the springs into a list of node pairs
+        std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > > springs;
         for (typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator spring_iterator = p_static_cast_cell_population->SpringsBegin();
              spring_iterator != p_static_cast_cell_population->SpringsEnd();
              ++spring_iterator)
         {
-            unsigned nodeA_global_index = spring_iterator.GetNodeA()->GetIndex();
-            unsigned nodeB_global_index = spring_iterator.GetNodeB()->GetIndex();
-
-            // Calculate the force between nodes
-            c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(nodeA_global_index, nodeB_global_index, rCellPopulation);
-
-            // Add the force contribution to each node
-            c_vector<double, SPACE_DIM> negative_force = -1.0*force;
-            spring_iterator.GetNodeB()->AddAppliedForceContribution(negative_force);
-            spring_iterator.GetNodeA()->AddAppliedForceContribution(force);
+            springs.push_back(std::make_pair(spring_iterator.GetNodeA(), spring_iterator.GetNodeB()));
         }
+
+        AddForceContributionsFromNodePairs(springs, rCellPopulation);
     }
     else    // This is a NodeBasedCellPopulation
     {
         AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
-        std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >& r_node_pairs = p_static_cast_cell_population->rGetNodePairs();
-
-        for (typename std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >::iterator iter = r_node_pairs.begin();
-            iter != r_node_pairs.end();
-            iter++)
-        {
-            std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > pair = *iter;
-
-            unsigned node_a_index = pair.first->GetIndex();
-            unsigned node_b_index = pair.second->GetIndex();
-
-            // Calculate the force between nodes
-            c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(node_a_index, node_b_index, rCellPopulation);
-            for (unsigned j=0; j<SPACE_DIM; j++)
-            {
-                assert(!std::isnan(force[j]));
-            }
-
-            // Add the force contribution to each node
-            c_vector<double, SPACE_DIM> negative_force = -1.0*force;
-            pair.first->AddAppliedForceContribution(force);
-            pair.second->AddAppliedForceContribution(negative_force);
-        }
+        AddForceContributionsFromNodePairs(p_static_cast_cell_population->rGetNodePairs(), rCellPopulation);
     }
 }
 
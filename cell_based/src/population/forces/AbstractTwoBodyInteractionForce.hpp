@@ -71,6 +71,26 @@ protected:
     /** Mechanics cut off length. */
     double mMechanicsCutOffLength;
 
+    /**
+     * The number of OpenMP threads used to calculate pairwise forces. Defaults to 1.
+     * Not archived, since it is a property of the machine rather than of the model.
+     */
+    unsigned mNumThreads;
+
+    /**
+     * Calculate the force between each pair of nodes in a list and add it to both nodes.
+     *
+     * With more than one thread (see SetNumberOfThreads()) the forces are calculated
+     * concurrently into a buffer with one entry per pair, then added to the nodes in pair
+     * order on a single thread.  The applied forces are therefore bit-for-bit identical to
+     * the serial calculation, whatever the number of threads.
+     *
+     * @param rNodePairs the pairs of interacting nodes
+     * @param rCellPopulation the cell population
+     */
+    void AddForceContributionsFromNodePairs(const std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >& rNodePairs,
+                                            AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
 public:
 
     /**
@@ -100,6 +120,23 @@ public:
      */
     double GetCutOffLength();
 
+    /**
+     * Set the number of threads used to calculate pairwise forces.  Requires Chaste to be
+     * built with OpenMP support (Chaste_USE_OPENMP) for values greater than 1.
+     *
+     * When using more than one thread, CalculateForceBetweenNodes() is called concurrently
+     * for different pairs, so subclasses must not modify shared state in that method without
+     * synchronisation.
+     *
+     * @param numThreads the number of threads
+     */
+    void SetNumberOfThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used to calculate pairwise forces
+     */
+    unsigned GetNumberOfThreads() const;
+
     /**
      * Calculates the force between two nodes.
      *
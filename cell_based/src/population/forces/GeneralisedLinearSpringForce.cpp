@@ -153,16 +153,22 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
 
         std::pair<CellPtr,CellPtr> cell_pair = p_static_cast_cell_population->CreateCellPair(p_cell_A, p_cell_B);
 
-        if (p_static_cast_cell_population->IsMarkedSpring(cell_pair))
+        // The marked springs are shared between pairs, which may be handled on different threads
+#ifdef CHASTE_OPENMP
+#pragma omp critical(GeneralisedLinearSpringForceMarkedSprings)
+#endif // CHASTE_OPENMP
         {
-            // Spring rest length increases from a small value to the normal rest length over 1 hour
-            double lambda = mMeinekeDivisionRestingSpringLength;
-            rest_length = lambda + (rest_length_final - lambda) * ageA/mMeinekeSpringGrowthDuration;
-        }
-        if (ageA + SimulationTime::Instance()->GetTimeStep() >= mMeinekeSpringGrowthDuration)
-        {
-            // This spring is about to go out of scope
-            p_static_cast_cell_population->UnmarkSpring(cell_pair);
+            if (p_static_cast_cell_population->IsMarkedSpring(cell_pair))
+            {
+                // Spring rest length increases from a small value to the normal rest length over 1 hour
+                double lambda = mMeinekeDivisionRestingSpringLength;
+                rest_length = lambda + (rest_length_final - lambda) * ageA/mMeinekeSpringGrowthDuration;
+            }
+            if (ageA + SimulationTime::Instance()->GetTimeStep() >= mMeinekeSpringGrowthDuration)
+            {
+                // This spring is about to go out of scope
+                p_static_cast_cell_population->UnmarkSpring(cell_pair);
+            }
         }
     }
 
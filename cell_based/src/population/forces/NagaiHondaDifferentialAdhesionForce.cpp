@@ -55,30 +55,26 @@ double NagaiHondaDifferentialAdhesionForce<DIM>::GetAdhesionParameter(Node<DIM>*
                                                                       Node<DIM>* pNodeB,
                                                                       VertexBasedCellPopulation<DIM>& rVertexCellPopulation)
 {
-    // Find the indices of the elements owned by each node
-    std::set<unsigned> elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
-    std::set<unsigned> elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
-
-    // Find common elements
-    std::set<unsigned> shared_elements;
-    std::set_intersection(elements_containing_nodeA.begin(),
-                          elements_containing_nodeA.end(),
-                          elements_containing_nodeB.begin(),
-                          elements_containing_nodeB.end(),
-                          std::inserter(shared_elements, shared_elements.begin()));
-
-    // Check that the nodes have a common edge
-    assert(!shared_elements.empty());
-
-    // If the edge corresponds to a single element, then the cell is on the boundary
-    if (shared_elements.size() == 1)
+    // Find the elements containing the edge between the two nodes, and count how many correspond to labelled cells
+    c_vector<unsigned, 2> elem_indices;
+    this->mGeometryCache.GetElementsContainingEdge(pNodeA, pNodeB, elem_indices);
+    unsigned num_shared_elements = (elem_indices[1] == UNSIGNED_UNSET) ? 1 : 2;
+    unsigned num_labelled_cells = 0;
+    for (unsigned i=0; i<num_shared_elements; i++)
     {
-        unsigned element_index = *(shared_elements.begin());
-
         // Get cell associated with this element
-        CellPtr p_cell = rVertexCellPopulation.GetCellUsingLocationIndex(element_index);
+        CellPtr p_cell = rVertexCellPopulation.GetCellUsingLocationIndex(elem_indices[i]);
 
         if (p_cell->template HasCellProperty<CellLabel>())
+        {
+            num_labelled_cells++;
+        }
+    }
+
+    // If the edge corresponds to a single element, then the cell is on the boundary
+    if (num_shared_elements == 1)
+    {
+        if (num_labelled_cells == 1)
         {
             // This cell is labelled
             return this->GetNagaiHondaLabelledCellBoundaryAdhesionEnergyParameter();
@@ -91,23 +87,6 @@ double NagaiHondaDifferentialAdhesionForce<DIM>::GetAdhesionParameter(Node<DIM>*
     }
     else
     {
-        // Work out the number of labelled cells: 0,1 or 2
-        unsigned num_labelled_cells = 0;
-        for (std::set<unsigned>::iterator iter = shared_elements.begin();
-             iter != shared_elements.end();
-             ++iter)
-        {
-            unsigned element_index = *(iter);
-
-            // Get cell associated with this element
-            CellPtr p_cell = rVertexCellPopulation.GetCellUsingLocationIndex(element_index);
-
-            if (p_cell->template HasCellProperty<CellLabel>())
-            {
-                num_labelled_cells++;
-            }
-        }
-
         if (num_labelled_cells == 2)
         {
             // Both cells are labelled
@@ -65,19 +65,14 @@ void NagaiHondaForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
     // Define some helper variables
     VertexBasedCellPopulation<DIM>* p_cell_population = static_cast<VertexBasedCellPopulation<DIM>*>(&rCellPopulation);
     unsigned num_nodes = p_cell_population->GetNumNodes();
-    unsigned num_elements = p_cell_population->GetNumElements();
 
-    // Begin by computing the area and perimeter of each element in the mesh, to avoid having to do this multiple times
-    std::vector<double> element_areas(num_elements);
-    std::vector<double> element_perimeters(num_elements);
+    unsigned num_elements = p_cell_population->rGetMesh().GetNumAllElements();
     std::vector<double> target_areas(num_elements);
     for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = p_cell_population->rGetMesh().GetElementIteratorBegin();
          elem_iter != p_cell_population->rGetMesh().GetElementIteratorEnd();
          ++elem_iter)
     {
         unsigned elem_index = elem_iter->GetIndex();
-        element_areas[elem_index] = p_cell_population->rGetMesh().GetVolumeOfElement(elem_index);
-        element_perimeters[elem_index] = p_cell_population->rGetMesh().GetSurfaceAreaOfElement(elem_index);
         try
         {
             // If we haven't specified a growth modifier, there won't be any target areas in the CellData array and CellData
@@ -92,98 +87,106 @@ void NagaiHondaForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
         }
     }
 
-    // Iterate over vertices in the cell population
-    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    /*
+     * Compute the geometry of each element in the mesh, to avoid having to do this multiple
+     * times. While the cache is up to date, GetAdhesionParameter() uses its edges to find
+     * the elements on either side of each edge.
+     */
+    mGeometryCache.Update(p_cell_population->rGetMesh());
+
+    /*
+     * The force on each Node is given by the gradient of the total free
+     * energy of the CellPopulation, evaluated at the position of the vertex. This
+     * free energy is the sum of the free energies of all CellPtrs in
+     * the cell population. The free energy of each CellPtr is comprised of three
+     * parts - a cell deformation energy, a membrane surface tension energy
+     * and an adhesion energy.
+     *
+     * Note that since the movement of a Node only affects the free energy
+     * of the CellPtrs containing it, we can just consider the contributions
+     * to the free energy gradient from each of these CellPtrs. We therefore
+     * loop over elements and add the contribution of each to its nodes. As the
+     * elements are visited in order of increasing index, the contributions to
+     * each node are summed in the same order as if we looped over its
+     * containing elements.
+     */
+    unsigned num_all_nodes = p_cell_population->rGetMesh().GetNumAllNodes();
+    std::vector<c_vector<double, DIM> > deformation_contributions(num_all_nodes, zero_vector<double>(DIM));
+    std::vector<c_vector<double, DIM> > membrane_surface_tension_contributions(num_all_nodes, zero_vector<double>(DIM));
+    std::vector<c_vector<double, DIM> > adhesion_contributions(num_all_nodes, zero_vector<double>(DIM));
+
+    std::vector<double> edge_adhesion_parameters;
+    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = p_cell_population->rGetMesh().GetElementIteratorBegin();
+         elem_iter != p_cell_population->rGetMesh().GetElementIteratorEnd();
+         ++elem_iter)
     {
-        Node<DIM>* p_this_node = p_cell_population->GetNode(node_index);
-
-        /*
-         * The force on this Node is given by the gradient of the total free
-         * energy of the CellPopulation, evaluated at the position of the vertex. This
-         * free energy is the sum of the free energies of all CellPtrs in
-         * the cell population. The free energy of each CellPtr is comprised of three
-         * parts - a cell deformation energy, a membrane surface tension energy
-         * and an adhesion energy.
-         *
-         * Note that since the movement of this Node only affects the free energy
-         * of the CellPtrs containing it, we can just consider the contributions
-         * to the free energy gradient from each of these CellPtrs.
-         */
-        c_vector<double, DIM> deformation_contribution = zero_vector<double>(DIM);
-        c_vector<double, DIM> membrane_surface_tension_contribution = zero_vector<double>(DIM);
-        c_vector<double, DIM> adhesion_contribution = zero_vector<double>(DIM);
-
-        // Find the indices of the elements owned by this node
-        std::set<unsigned> containing_elem_indices = p_cell_population->GetNode(node_index)->rGetContainingElementIndices();
-
-        // Iterate over these elements
-        for (std::set<unsigned>::iterator iter = containing_elem_indices.begin();
-             iter != containing_elem_indices.end();
-             ++iter)
+        unsigned elem_index = elem_iter->GetIndex();
+        unsigned num_nodes_elem = elem_iter->GetNumNodes();
+        double element_area = mGeometryCache.GetElementArea(elem_index);
+        double element_perimeter = mGeometryCache.GetElementPerimeter(elem_index);
+        double cell_target_perimeter = 2*sqrt(M_PI*target_areas[elem_index]);
+
+        // Compute the adhesion parameter for the edge from each node to the next, which is shared by two nodes
+        edge_adhesion_parameters.resize(num_nodes_elem);
+        for (unsigned local_index=0; local_index<num_nodes_elem; local_index++)
         {
-            // Get this element, its index and its number of nodes
-            VertexElement<DIM, DIM>* p_element = p_cell_population->GetElement(*iter);
-            unsigned elem_index = p_element->GetIndex();
-            unsigned num_nodes_elem = p_element->GetNumNodes();
+            Node<DIM>* p_this_node = elem_iter->GetNode(local_index);
+            Node<DIM>* p_next_node = elem_iter->GetNode((local_index+1)%num_nodes_elem);
+            edge_adhesion_parameters[local_index] = GetAdhesionParameter(p_this_node, p_next_node, *p_cell_population);
+        }
 
-            // Find the local index of this node in this element
-            unsigned local_index = p_element->GetNodeLocalIndex(node_index);
+        for (unsigned local_index=0; local_index<num_nodes_elem; local_index++)
+        {
+            unsigned corner_index = mGeometryCache.GetCornerIndex(elem_index, local_index);
+            unsigned node_index = mGeometryCache.GetNodeGlobalIndex(corner_index);
 
             // Add the force contribution from this cell's deformation energy (note the minus sign)
-            c_vector<double, DIM> element_area_gradient = p_cell_population->rGetMesh().GetAreaGradientOfElementAtNode(p_element, local_index);
-            deformation_contribution -= 2*GetNagaiHondaDeformationEnergyParameter()*(element_areas[elem_index] - target_areas[elem_index])*element_area_gradient;
+            const c_vector<double, DIM>& r_element_area_gradient = mGeometryCache.rGetAreaGradient(corner_index);
+            deformation_contributions[node_index] -= 2*GetNagaiHondaDeformationEnergyParameter()*(element_area - target_areas[elem_index])*r_element_area_gradient;
 
-            // Get the previous and next nodes in this element
+            // Get the previous node in this element
             unsigned previous_node_local_index = (num_nodes_elem+local_index-1)%num_nodes_elem;
-            Node<DIM>* p_previous_node = p_element->GetNode(previous_node_local_index);
-
-            unsigned next_node_local_index = (local_index+1)%num_nodes_elem;
-            Node<DIM>* p_next_node = p_element->GetNode(next_node_local_index);
+            unsigned previous_corner_index = mGeometryCache.GetCornerIndex(elem_index, previous_node_local_index);
 
-            // Compute the adhesion parameter for each of these edges
-            double previous_edge_adhesion_parameter = GetAdhesionParameter(p_previous_node, p_this_node, *p_cell_population);
-            double next_edge_adhesion_parameter = GetAdhesionParameter(p_this_node, p_next_node, *p_cell_population);
+            // Get the adhesion parameter for each of the edges adjacent to this node
+            double previous_edge_adhesion_parameter = edge_adhesion_parameters[previous_node_local_index];
+            double next_edge_adhesion_parameter = edge_adhesion_parameters[local_index];
 
-            // Compute the gradient of each these edges, computed at the present node
-            c_vector<double, DIM> previous_edge_gradient = -p_cell_population->rGetMesh().GetNextEdgeGradientOfElementAtNode(p_element, previous_node_local_index);
-            c_vector<double, DIM> next_edge_gradient = p_cell_population->rGetMesh().GetNextEdgeGradientOfElementAtNode(p_element, local_index);
+            // Get the gradient of each these edges, computed at the present node
+            c_vector<double, DIM> previous_edge_gradient = -mGeometryCache.rGetNextEdgeGradient(previous_corner_index);
+            const c_vector<double, DIM>& r_next_edge_gradient = mGeometryCache.rGetNextEdgeGradient(corner_index);
 
             // Add the force contribution from cell-cell and cell-boundary adhesion (note the minus sign)
-            adhesion_contribution -= previous_edge_adhesion_parameter*previous_edge_gradient + next_edge_adhesion_parameter*next_edge_gradient;
+            adhesion_contributions[node_index] -= previous_edge_adhesion_parameter*previous_edge_gradient + next_edge_adhesion_parameter*r_next_edge_gradient;
 
             // Add the force contribution from this cell's membrane surface tension (note the minus sign)
-            c_vector<double, DIM> element_perimeter_gradient = previous_edge_gradient + next_edge_gradient;
-            double cell_target_perimeter = 2*sqrt(M_PI*target_areas[elem_index]);
-            membrane_surface_tension_contribution -= 2*GetNagaiHondaMembraneSurfaceEnergyParameter()*(element_perimeters[elem_index] - cell_target_perimeter)*element_perimeter_gradient;
+            c_vector<double, DIM> element_perimeter_gradient = previous_edge_gradient + r_next_edge_gradient;
+            membrane_surface_tension_contributions[node_index] -= 2*GetNagaiHondaMembraneSurfaceEnergyParameter()*(element_perimeter - cell_target_perimeter)*element_perimeter_gradient;
         }
+    }
 
-        c_vector<double, DIM> force_on_node = deformation_contribution + membrane_surface_tension_contribution + adhesion_contribution;
+    // Iterate over vertices in the cell population
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        c_vector<double, DIM> force_on_node = deformation_contributions[node_index] + membrane_surface_tension_contributions[node_index] + adhesion_contributions[node_index];
         p_cell_population->GetNode(node_index)->AddAppliedForceContribution(force_on_node);
     }
+
+    // The mesh may change before the next call
+    mGeometryCache.SetOutOfDate();
 }
 
 template<unsigned DIM>
 double NagaiHondaForce<DIM>::GetAdhesionParameter(Node<DIM>* pNodeA, Node<DIM>* pNodeB, VertexBasedCellPopulation<DIM>& rVertexCellPopulation)
 {
-    // Find the indices of the elements owned by each node
-    std::set<unsigned> elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
-    std::set<unsigned> elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
-
-    // Find common elements
-    std::set<unsigned> shared_elements;
-    std::set_intersection(elements_containing_nodeA.begin(),
-                          elements_containing_nodeA.end(),
-                          elements_containing_nodeB.begin(),
-                          elements_containing_nodeB.end(),
-                          std::inserter(shared_elements, shared_elements.begin()));
-
-    // Check that the nodes have a common edge
-    assert(!shared_elements.empty());
+    // Find the elements containing the edge between the two nodes
+    c_vector<unsigned, 2> elem_indices;
+    mGeometryCache.GetElementsContainingEdge(pNodeA, pNodeB, elem_indices);
 
     double adhesion_parameter = GetNagaiHondaCellCellAdhesionEnergyParameter();
 
     // If the edge corresponds to a single element, then the cell is on the boundary
-    if (shared_elements.size() == 1)
+    if (elem_indices[1] == UNSIGNED_UNSET)
     {
         adhesion_parameter = GetNagaiHondaCellBoundaryAdhesionEnergyParameter();
     }
@@ -191,6 +194,18 @@ double NagaiHondaForce<DIM>::GetAdhesionParameter(Node<DIM>* pNodeA, Node<DIM>*
     return adhesion_parameter;
 }
 
+template<unsigned DIM>
+void NagaiHondaForce<DIM>::SetNumberOfThreads(unsigned numThreads)
+{
+    mGeometryCache.SetNumberOfThreads(numThreads);
+}
+
+template<unsigned DIM>
+unsigned NagaiHondaForce<DIM>::GetNumberOfThreads() const
+{
+    return mGeometryCache.GetNumberOfThreads();
+}
+
 template<unsigned DIM>
 double NagaiHondaForce<DIM>::GetNagaiHondaDeformationEnergyParameter()
 {
@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractForce.hpp"
 #include "VertexBasedCellPopulation.hpp"
+#include "VertexMeshGeometryCache.hpp"
 
 #include <iostream>
 
@@ -107,6 +108,13 @@ protected:
      */
     double mNagaiHondaCellBoundaryAdhesionEnergyParameter;
 
+    /**
+     * The areas, perimeters, gradients and edges of the elements, recomputed in each call
+     * to AddForceContribution() and marked as out of date at the end of it. Subclasses
+     * can use GetElementsContainingEdge() on it to find the elements on either side of an
+     * edge. Not archived.
+     */
+    VertexMeshGeometryCache<DIM> mGeometryCache;
 
 public:
 
@@ -141,6 +149,21 @@ public:
      */
     virtual double GetAdhesionParameter(Node<DIM>* pNodeA, Node<DIM>* pNodeB, VertexBasedCellPopulation<DIM>& rVertexCellPopulation);
 
+    /**
+     * Set the number of threads used to compute the geometry of the elements in
+     * AddForceContribution(). Requires Chaste to be built with OpenMP support
+     * (Chaste_USE_OPENMP) for values greater than 1. The forces themselves, and
+     * hence all calls to GetAdhesionParameter(), are still computed on one thread.
+     *
+     * @param numThreads the number of threads
+     */
+    void SetNumberOfThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used to compute the geometry of the elements
+     */
+    unsigned GetNumberOfThreads() const;
+
     /**
      * @return mNagaiHondaDeformationEnergyParameter
      */
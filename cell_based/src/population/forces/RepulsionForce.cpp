@@ -52,6 +52,8 @@ void RepulsionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCel
 
     std::vector< std::pair<Node<DIM>*, Node<DIM>* > >& r_node_pairs = (static_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation))->rGetNodePairs();
 
+    // Only overlapping nodes repel each other
+    std::vector< std::pair<Node<DIM>*, Node<DIM>* > > overlapping_node_pairs;
     for (typename std::vector< std::pair<Node<DIM>*, Node<DIM>* > >::iterator iter = r_node_pairs.begin();
         iter != r_node_pairs.end();
         iter++)
@@ -79,18 +81,12 @@ void RepulsionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCel
 
         if (norm_2(unit_difference) < rest_length)
         {
-            // Calculate the force between nodes
-            c_vector<double, DIM> force = this->CalculateForceBetweenNodes(p_node_a->GetIndex(), p_node_b->GetIndex(), rCellPopulation);
-            c_vector<double, DIM> negative_force = -1.0 * force;
-            for (unsigned j=0; j<DIM; j++)
-            {
-                assert(!std::isnan(force[j]));
-            }
-            // Add the force contribution to each node
-            p_node_a->AddAppliedForceContribution(force);
-            p_node_b->AddAppliedForceContribution(negative_force);
+            overlapping_node_pairs.push_back(pair);
         }
     }
+
+    // Calculate the force between each pair of overlapping nodes and add it to both nodes
+    this->AddForceContributionsFromNodePairs(overlapping_node_pairs, rCellPopulation);
 }
 
 template<unsigned DIM>
@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCellBasedSimulation.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "Profiler.hpp"
 #include "LogFile.hpp"
 #include "ExecutableSupport.hpp"
 #include "AbstractPdeModifier.hpp"
@@ -95,6 +96,12 @@ unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellBirth()
         return 0;
     }
 
+    if (mrCellPopulation.GetUseBatchedOdeSolving())
+    {
+        // Solve the cells' ODEs together, so that ReadyToDivide() can use the solutions
+        mrCellPopulation.SolveCellOdesToCurrentTime();
+    }
+
     unsigned num_births_this_step = 0;
 
     // Iterate over all cells, seeing if each one can be divided
@@ -172,6 +179,7 @@ unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellRemoval()
          killer_iter != mCellKillers.end();
          ++killer_iter)
     {
+        ProfilerScope killer_scope(**killer_iter);
         (*killer_iter)->CheckAndLabelCellsForApoptosisOrDeath();
     }
 
@@ -427,6 +435,7 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
     // Enter main time loop
     while (!( p_simulation_time->IsFinished() || StoppingEventHasOccurred() ) )
     {
+        PROFILE_SCOPE("TimeStep");
         LOG(1, "--TIME = " << p_simulation_time->GetTime() << "\n");
 
         // This function calls DoCellRemoval(), DoCellBirth() and CellPopulation::Update()
@@ -499,6 +508,7 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
              iter != mSimulationModifiers.end();
              ++iter)
         {
+            ProfilerScope modifier_scope(**iter);
             (*iter)->UpdateAtEndOfTimeStep(this->mrCellPopulation);
         }
         CellBasedEventHandler::EndEvent(CellBasedEventHandler::UPDATESIMULATION);
@@ -69,6 +69,10 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
     // Make sure the cell population is updated
     rCellPopulation.Update();
 
+    static const unsigned notch_key = CellData::GetKey("notch");
+    static const unsigned delta_key = CellData::GetKey("delta");
+    static const unsigned mean_delta_key = CellData::GetKey("mean delta");
+
     // First recover each cell's Notch and Delta concentrations from the ODEs and store in CellData
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
@@ -79,8 +83,8 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
         double this_notch = p_model->GetNotch();
 
         // Note that the state variables must be in the same order as listed in DeltaNotchOdeSystem
-        cell_iter->GetCellData()->SetItem("notch", this_notch);
-        cell_iter->GetCellData()->SetItem("delta", this_delta);
+        cell_iter->GetCellData()->SetItem(notch_key, this_notch);
+        cell_iter->GetCellData()->SetItem(delta_key, this_delta);
     }
 
     // Next iterate over the population to compute and store each cell's neighbouring Delta concentration in CellData
@@ -100,15 +104,15 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
                  ++iter)
             {
                 CellPtr p_cell = rCellPopulation.GetCellUsingLocationIndex(*iter);
-                double this_delta = p_cell->GetCellData()->GetItem("delta");
+                double this_delta = p_cell->GetCellData()->GetItem(delta_key);
                 mean_delta += this_delta/neighbour_indices.size();
             }
-            cell_iter->GetCellData()->SetItem("mean delta", mean_delta);
+            cell_iter->GetCellData()->SetItem(mean_delta_key, mean_delta);
         }
         else
         {
             // If this cell has no neighbours, such as an isolated cell in a CaBasedCellPopulation, store 0.0 for the cell data
-            cell_iter->GetCellData()->SetItem("mean delta", 0.0);
+            cell_iter->GetCellData()->SetItem(mean_delta_key, 0.0);
         }
     }
 }
@@ -92,7 +92,8 @@ void VolumeTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,DIM>
         double cell_volume = rCellPopulation.GetVolumeOfCell(*cell_iter);
 
         // Store the cell's volume in CellData
-        cell_iter->GetCellData()->SetItem("volume", cell_volume);
+        static const unsigned volume_key = CellData::GetKey("volume");
+        cell_iter->GetCellData()->SetItem(volume_key, cell_volume);
     }
 }
 
@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NodeBasedCellPopulationWithBuskeUpdate.hpp"
 #include "MeshBasedCellPopulationWithGhostNodes.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "Profiler.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AbstractNumericalMethod()
@@ -101,6 +102,7 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ComputeForcesIncludingDamping()
 {
     CellBasedEventHandler::BeginEvent(CellBasedEventHandler::FORCE);
+    PROFILE_SCOPE("Force");
 
     for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
          node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd(); ++node_iter)
@@ -111,6 +113,7 @@ std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SP
     for (typename std::vector<boost::shared_ptr<AbstractForce<ELEMENT_DIM, SPACE_DIM> > >::iterator iter = mpForceCollection->begin();
         iter != mpForceCollection->end(); ++iter)
     {
+        ProfilerScope force_scope(**iter);
         (*iter)->AddForceContribution(*mpCellPopulation);
     }
 
@@ -164,6 +167,19 @@ void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SafeNodePositionUpdate( uns
     mpCellPopulation->SetNode(nodeIndex, new_point);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::MoveNodesToLocations(const std::vector<c_vector<double, SPACE_DIM> >& rNewLocations)
+{
+    unsigned index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        SafeNodePositionUpdate(node_iter->GetIndex(), rNewLocations[index]);
+    }
+    assert(index == rNewLocations.size());
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::DetectStepSizeExceptions(unsigned nodeIndex, c_vector<double,SPACE_DIM>& displacement, double dt)
 {
@@ -201,6 +217,14 @@ bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetUseUpdateNodeLocation()
     return mUseUpdateNodeLocation;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetNextTimeStep(double presentTimeStep)
+{
+    ///\todo #2087 Make this a settable member variable
+    double timestep_increase = 0.01;
+    return (1+timestep_increase)*presentTimeStep;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodInfo(out_stream& rParamsFile)
 {
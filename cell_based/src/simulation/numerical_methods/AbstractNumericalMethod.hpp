@@ -126,6 +126,14 @@ protected:
      */
      void SafeNodePositionUpdate(unsigned nodeIndex, c_vector<double, SPACE_DIM> newPosition);
 
+    /**
+     * Moves each node to a new location, taking into account periodic boundary conditions.
+     * Used by multi-stage methods to evaluate forces at intermediate locations.
+     *
+     * @param rNewLocations the new location of each node, in node iterator order (as returned by SaveCurrentLocations())
+     */
+    void MoveNodesToLocations(const std::vector<c_vector<double, SPACE_DIM> >& rNewLocations);
+
     /**
      * Detects whether a node has exceeded the acceptable displacement for one timestep.
      * If a step size exception has occurred, it either causes the simulation to terminate or,
@@ -202,6 +210,16 @@ public:
      */
     virtual void UpdateAllNodePositions(double dt)=0;
 
+    /**
+     * Get the size of the next step to attempt after a successful call to UpdateAllNodePositions(),
+     * when using an adaptive time step.  By default the step is increased by 1%; methods with an
+     * error estimate override this.
+     *
+     * @param presentTimeStep the size of the step just taken
+     * @return the suggested size of the next step
+     */
+    virtual double GetNextTimeStep(double presentTimeStep);
+
     /**
      * Saves the name of the numerical method to the parameters file
      *
@@ -0,0 +1,369 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BackwardEulerNumericalMethod.hpp"
+#include "StepSizeException.hpp"
+
+#include <cfloat>
+#include <cmath>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::BackwardEulerNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mTolerance(1e-6),
+      mMaxIterations(20u)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~BackwardEulerNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        std::vector<c_vector<double, SPACE_DIM> > initial_locations = this->SaveCurrentLocations();
+        const unsigned num_nodes = initial_locations.size();
+        const unsigned num_unknowns = num_nodes*SPACE_DIM;
+
+        // Start from the forward Euler prediction
+        std::vector<double> initial(num_unknowns);
+        std::vector<double> positions(num_unknowns);
+        std::vector<c_vector<double, SPACE_DIM> > node_forces = this->ComputeForcesIncludingDamping();
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                initial[SPACE_DIM*i + d] = initial_locations[i][d];
+                positions[SPACE_DIM*i + d] = initial_locations[i][d] + dt*node_forces[i][d];
+            }
+        }
+
+        /*
+         * Newton's method for the residual G(r) = r - r^t - dt F(r).  Each Newton update
+         * solves (I - dt J) delta = -G(r) by GMRES, where the products of the force Jacobian J
+         * with Krylov vectors are approximated by finite differences of the forces.
+         */
+        bool converged = false;
+        std::vector<double> forces = ComputeForcesAtPositions(positions);
+        for (unsigned iteration=0; iteration<mMaxIterations && !converged; iteration++)
+        {
+            std::vector<double> minus_residual(num_unknowns);
+            for (unsigned k=0; k<num_unknowns; k++)
+            {
+                minus_residual[k] = initial[k] + dt*forces[k] - positions[k];
+            }
+
+            std::vector<double> update = SolveLinearisedSystem(positions, forces, minus_residual, dt);
+
+            double largest_change = 0.0;
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                double change_squared = 0.0;
+                for (unsigned d=0; d<SPACE_DIM; d++)
+                {
+                    positions[SPACE_DIM*i + d] += update[SPACE_DIM*i + d];
+                    change_squared += update[SPACE_DIM*i + d]*update[SPACE_DIM*i + d];
+                }
+                largest_change = std::max(largest_change, sqrt(change_squared));
+            }
+            forces = ComputeForcesAtPositions(positions);
+
+            // A NaN change never compares as converged
+            converged = (largest_change <= mTolerance);
+        }
+
+        if (!converged)
+        {
+            if (this->mUseAdaptiveTimestep)
+            {
+                throw StepSizeException(0.5*dt, "Backward Euler iteration did not converge.", false);
+            }
+            EXCEPTION("Backward Euler iteration did not converge in " << mMaxIterations
+                      << " iterations. Reduce the time step or use an adaptive time step.");
+        }
+
+        std::vector<c_vector<double, SPACE_DIM> > displacements(num_nodes);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                displacements[i][d] = positions[SPACE_DIM*i + d] - initial[SPACE_DIM*i + d];
+            }
+        }
+
+        unsigned index = 0;
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacements[index], dt);
+
+            c_vector<double, SPACE_DIM> new_location = initial_locations[index] + displacements[index];
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+    }
+    else
+    {
+        /*
+         * If this type of cell population does not support the new numerical methods, delegate
+         * updating node positions to the population itself.
+         *
+         * This only applies to NodeBasedCellPopulationWithBuskeUpdates.
+         */
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ComputeForcesAtPositions(const std::vector<double>& rPositions)
+{
+    const unsigned num_nodes = rPositions.size()/SPACE_DIM;
+    std::vector<c_vector<double, SPACE_DIM> > locations(num_nodes);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            locations[i][d] = rPositions[SPACE_DIM*i + d];
+        }
+    }
+    this->MoveNodesToLocations(locations);
+
+    std::vector<c_vector<double, SPACE_DIM> > node_forces = this->ComputeForcesIncludingDamping();
+    std::vector<double> forces(rPositions.size());
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            forces[SPACE_DIM*i + d] = node_forces[i][d];
+        }
+    }
+    return forces;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SolveLinearisedSystem(const std::vector<double>& rPositions,
+                                                                                             const std::vector<double>& rForces,
+                                                                                             const std::vector<double>& rRhs,
+                                                                                             double dt)
+{
+    const unsigned size = rRhs.size();
+    std::vector<double> solution(size, 0.0);
+
+    double rhs_norm = 0.0;
+    double largest_position = 0.0;
+    for (unsigned k=0; k<size; k++)
+    {
+        rhs_norm += rRhs[k]*rRhs[k];
+        largest_position = std::max(largest_position, fabs(rPositions[k]));
+    }
+    rhs_norm = sqrt(rhs_norm);
+    if (!(rhs_norm > 0.0))
+    {
+        // Either the residual vanishes, or it is not finite and the Newton iteration cannot converge
+        for (unsigned k=0; k<size; k++)
+        {
+            solution[k] = rRhs[k];
+        }
+        return solution;
+    }
+
+    // Krylov vectors have unit length, so this is the usual finite difference increment
+    const double increment = sqrt(DBL_EPSILON)*(1.0 + largest_position);
+    const unsigned max_krylov_dimension = std::min(size, 50u);
+    const double krylov_tolerance = 1e-8*rhs_norm;
+
+    // Arnoldi basis, Hessenberg matrix and Givens rotations of GMRES
+    std::vector<std::vector<double> > basis(1, rRhs);
+    for (unsigned k=0; k<size; k++)
+    {
+        basis[0][k] /= rhs_norm;
+    }
+    std::vector<std::vector<double> > hessenberg(max_krylov_dimension, std::vector<double>(max_krylov_dimension + 1, 0.0));
+    std::vector<double> cosines(max_krylov_dimension);
+    std::vector<double> sines(max_krylov_dimension);
+    std::vector<double> reduced_rhs(max_krylov_dimension + 1, 0.0);
+    reduced_rhs[0] = rhs_norm;
+
+    unsigned dimension = 0;
+    std::vector<double> perturbed(size);
+    while (dimension < max_krylov_dimension)
+    {
+        const unsigned j = dimension;
+
+        // w = (I - dt J) v_j
+        for (unsigned k=0; k<size; k++)
+        {
+            perturbed[k] = rPositions[k] + increment*basis[j][k];
+        }
+        std::vector<double> w = ComputeForcesAtPositions(perturbed);
+        for (unsigned k=0; k<size; k++)
+        {
+            w[k] = basis[j][k] - dt*(w[k] - rForces[k])/increment;
+        }
+
+        // Modified Gram-Schmidt
+        std::vector<double>& r_column = hessenberg[j];
+        for (unsigned i=0; i<=j; i++)
+        {
+            double projection = 0.0;
+            for (unsigned k=0; k<size; k++)
+            {
+                projection += w[k]*basis[i][k];
+            }
+            r_column[i] = projection;
+            for (unsigned k=0; k<size; k++)
+            {
+                w[k] -= projection*basis[i][k];
+            }
+        }
+        double w_norm = 0.0;
+        for (unsigned k=0; k<size; k++)
+        {
+            w_norm += w[k]*w[k];
+        }
+        w_norm = sqrt(w_norm);
+        r_column[j+1] = w_norm;
+
+        // Reduce the new column to upper triangular form
+        for (unsigned i=0; i<j; i++)
+        {
+            double temp = cosines[i]*r_column[i] + sines[i]*r_column[i+1];
+            r_column[i+1] = -sines[i]*r_column[i] + cosines[i]*r_column[i+1];
+            r_column[i] = temp;
+        }
+        double hypotenuse = sqrt(r_column[j]*r_column[j] + r_column[j+1]*r_column[j+1]);
+        if (!(hypotenuse > 0.0))
+        {
+            break;
+        }
+        cosines[j] = r_column[j]/hypotenuse;
+        sines[j] = r_column[j+1]/hypotenuse;
+        r_column[j] = hypotenuse;
+        r_column[j+1] = 0.0;
+        reduced_rhs[j+1] = -sines[j]*reduced_rhs[j];
+        reduced_rhs[j] *= cosines[j];
+        dimension++;
+
+        if (fabs(reduced_rhs[j+1]) <= krylov_tolerance || !(w_norm > 0.0))
+        {
+            break;
+        }
+        basis.push_back(w);
+        for (unsigned k=0; k<size; k++)
+        {
+            basis[j+1][k] /= w_norm;
+        }
+    }
+
+    // Back substitution for the coefficients of the Krylov basis vectors
+    std::vector<double> coefficients(dimension);
+    for (int i=(int)dimension-1; i>=0; i--)
+    {
+        double sum = reduced_rhs[i];
+        for (unsigned m=i+1; m<dimension; m++)
+        {
+            sum -= hessenberg[m][i]*coefficients[m];
+        }
+        coefficients[i] = sum/hessenberg[i][i];
+    }
+    for (unsigned i=0; i<dimension; i++)
+    {
+        for (unsigned k=0; k<size; k++)
+        {
+            solution[k] += coefficients[i]*basis[i][k];
+        }
+    }
+    return solution;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTolerance(double tolerance)
+{
+    if (tolerance <= 0.0)
+    {
+        EXCEPTION("The tolerance of the backward Euler numerical method must be positive.");
+    }
+    mTolerance = tolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTolerance()
+{
+    return mTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetMaxIterations(unsigned maxIterations)
+{
+    if (maxIterations == 0u)
+    {
+        EXCEPTION("The backward Euler numerical method needs at least one iteration.");
+    }
+    mMaxIterations = maxIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaxIterations()
+{
+    return mMaxIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<Tolerance>" << mTolerance << "</Tolerance> \n";
+    *rParamsFile << "\t\t\t<MaxIterations>" << mMaxIterations << "</MaxIterations> \n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BackwardEulerNumericalMethod<1,1>;
+template class BackwardEulerNumericalMethod<1,2>;
+template class BackwardEulerNumericalMethod<2,2>;
+template class BackwardEulerNumericalMethod<1,3>;
+template class BackwardEulerNumericalMethod<2,3>;
+template class BackwardEulerNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
@@ -0,0 +1,172 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BACKWARDEULERNUMERICALMETHOD_HPP_
+#define BACKWARDEULERNUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements backward Euler time stepping.
+ *
+ * Solves the equations of motion dr/dt = F using the scheme
+ *
+ * r^(t+1) = r^t + dt F^(t+1).
+ *
+ * The implicit equations are solved by Newton's method, starting from the forward Euler
+ * prediction, until no node moves by more than the tolerance in an iteration.  Each Newton
+ * update solves the linearised equations (I - dt J) delta = r^t + dt F(r) - r by GMRES, where
+ * the products of the force Jacobian J with the Krylov vectors are approximated by finite
+ * differences of the forces, so any force can be used and each Krylov iteration costs one
+ * force evaluation.  Unlike a fixed point iteration this converges for time steps longer than
+ * the fastest relaxation time of the forces.  If the iteration does not converge within the
+ * maximum number of iterations, a StepSizeException is thrown when using an adaptive time step,
+ * so that the step is repeated with half the time step; otherwise the simulation stops with an
+ * error.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class BackwardEulerNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mTolerance;
+        archive & mMaxIterations;
+    }
+
+    /**
+     * The iteration is converged when no node moves further than this in an iteration.
+     * Defaults to 1e-6.
+     */
+    double mTolerance;
+
+    /** The maximum number of Newton iterations in a step. Defaults to 20. */
+    unsigned mMaxIterations;
+
+    /**
+     * Move the nodes to the given positions and compute the forces on them.
+     *
+     * @param rPositions the node locations, stored consecutively
+     * @return the forces including damping, stored in the same order
+     */
+    std::vector<double> ComputeForcesAtPositions(const std::vector<double>& rPositions);
+
+    /**
+     * Solve the linearised backward Euler equations (I - dt J) x = rhs by GMRES, approximating
+     * products with the force Jacobian J by finite differences of the forces about rPositions.
+     *
+     * @param rPositions the node locations about which the equations are linearised
+     * @param rForces the forces at rPositions
+     * @param rRhs the right hand side, the negative of the residual at rPositions
+     * @param dt the time step size
+     * @return the Newton update
+     */
+    std::vector<double> SolveLinearisedSystem(const std::vector<double>& rPositions,
+                                              const std::vector<double>& rForces,
+                                              const std::vector<double>& rRhs,
+                                              double dt);
+
+public:
+
+    /**
+     * Constructor.
+     */
+    BackwardEulerNumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~BackwardEulerNumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Set mTolerance.
+     *
+     * @param tolerance the largest node movement in a converged iteration
+     */
+    void SetTolerance(double tolerance);
+
+    /**
+     * @return mTolerance
+     */
+    double GetTolerance();
+
+    /**
+     * Set mMaxIterations.
+     *
+     * @param maxIterations the maximum number of Newton iterations in a step
+     */
+    void SetMaxIterations(unsigned maxIterations);
+
+    /**
+     * @return mMaxIterations
+     */
+    unsigned GetMaxIterations();
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
+
+#endif /*BACKWARDEULERNUMERICALMETHOD_HPP_*/
@@ -0,0 +1,216 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "RK23NumericalMethod.hpp"
+#include "SimulationTime.hpp"
+#include "StepSizeException.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+RK23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::RK23NumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mTolerance(1e-4),
+      mNextTimeStep(0.0),
+      mLastTime(DOUBLE_UNSET)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+RK23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::~RK23NumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void RK23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        std::vector<c_vector<double, SPACE_DIM> > initial_locations = this->SaveCurrentLocations();
+        const unsigned num_nodes = initial_locations.size();
+        std::vector<c_vector<double, SPACE_DIM> > stage_locations(num_nodes);
+
+        /*
+         * First same as last: reuse the force at the end of the previous step if it was taken in
+         * the same simulation time step, so the population has not been updated since, and the
+         * nodes have not moved since.
+         */
+        bool nodes_unmoved = (mLastLocations.size() == num_nodes) && (mLastTime == SimulationTime::Instance()->GetTime());
+        for (unsigned i=0; i<num_nodes && nodes_unmoved; i++)
+        {
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                nodes_unmoved = nodes_unmoved && (mLastLocations[i][d] == initial_locations[i][d]);
+            }
+        }
+
+        std::vector<c_vector<double, SPACE_DIM> > k1;
+        if (nodes_unmoved)
+        {
+            k1.swap(mLastForces);
+        }
+        else
+        {
+            k1 = this->ComputeForcesIncludingDamping();
+        }
+        mLastLocations.clear();
+        mLastForces.clear();
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            stage_locations[i] = initial_locations[i] + 0.5*dt*k1[i];
+        }
+        this->MoveNodesToLocations(stage_locations);
+        std::vector<c_vector<double, SPACE_DIM> > k2 = this->ComputeForcesIncludingDamping();
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            stage_locations[i] = initial_locations[i] + 0.75*dt*k2[i];
+        }
+        this->MoveNodesToLocations(stage_locations);
+        std::vector<c_vector<double, SPACE_DIM> > k3 = this->ComputeForcesIncludingDamping();
+
+        // The third order solution
+        std::vector<c_vector<double, SPACE_DIM> > displacements(num_nodes);
+        std::vector<c_vector<double, SPACE_DIM> > k4;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            displacements[i] = dt*(2.0*k1[i] + 3.0*k2[i] + 4.0*k3[i])/9.0;
+        }
+
+        if (this->mUseAdaptiveTimestep)
+        {
+            // Estimate the local error from the embedded second order solution, which uses the force at the new locations
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                stage_locations[i] = initial_locations[i] + displacements[i];
+            }
+            this->MoveNodesToLocations(stage_locations);
+            k4 = this->ComputeForcesIncludingDamping();
+
+            double error = 0.0;
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                c_vector<double, SPACE_DIM> difference = dt*(-5.0*k1[i]/72.0 + k2[i]/12.0 + k3[i]/9.0 - k4[i]/8.0);
+                error = std::max(error, norm_2(difference));
+            }
+
+            // Standard step size control for a method with local error of order 3, with a safety factor
+            double scaling = (error > 0.0) ? 0.9*pow(mTolerance/error, 1.0/3.0) : 5.0;
+            if (error > mTolerance)
+            {
+                mNextTimeStep = 0.0;
+                throw StepSizeException(std::max(0.2, scaling)*dt, "Estimated local error exceeds the tolerance of the RK23 numerical method.", false);
+            }
+            mNextTimeStep = std::min(5.0, scaling)*dt;
+        }
+
+        unsigned index = 0;
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacements[index], dt);
+
+            c_vector<double, SPACE_DIM> new_location = initial_locations[index] + displacements[index];
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+
+        if (this->mUseAdaptiveTimestep)
+        {
+            // Keep the force at the new locations in case the next step starts from them
+            mLastLocations = this->SaveCurrentLocations();
+            mLastForces.swap(k4);
+            mLastTime = SimulationTime::Instance()->GetTime();
+        }
+    }
+    else
+    {
+        /*
+         * If this type of cell population does not support the new numerical methods, delegate
+         * updating node positions to the population itself.
+         *
+         * This only applies to NodeBasedCellPopulationWithBuskeUpdates.
+         */
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double RK23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetNextTimeStep(double presentTimeStep)
+{
+    if (mNextTimeStep > 0.0)
+    {
+        return mNextTimeStep;
+    }
+    return AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetNextTimeStep(presentTimeStep);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void RK23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTolerance(double tolerance)
+{
+    if (tolerance <= 0.0)
+    {
+        EXCEPTION("The tolerance of the RK23 numerical method must be positive.");
+    }
+    mTolerance = tolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double RK23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTolerance()
+{
+    return mTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void RK23NumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<Tolerance>" << mTolerance << "</Tolerance> \n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class RK23NumericalMethod<1,1>;
+template class RK23NumericalMethod<1,2>;
+template class RK23NumericalMethod<2,2>;
+template class RK23NumericalMethod<1,3>;
+template class RK23NumericalMethod<2,3>;
+template class RK23NumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(RK23NumericalMethod)
@@ -0,0 +1,164 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef RK23NUMERICALMETHOD_HPP_
+#define RK23NUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements the embedded Runge-Kutta method of Bogacki and Shampine, of order 3 with
+ * an embedded order 2 error estimate.
+ *
+ * Solves the equations of motion dr/dt = F using the scheme
+ *
+ * k1 = F(r^t),
+ * k2 = F(r^t + dt k1/2),
+ * k3 = F(r^t + 3 dt k2/4),
+ * r^(t+1) = r^t + dt (2 k1 + 3 k2 + 4 k3)/9.
+ *
+ * When using an adaptive time step, the force at r^(t+1) gives an order 2 solution,
+ * and the largest difference between the two over all nodes is used as an estimate of the
+ * local error.  If this exceeds the tolerance a StepSizeException is thrown so that the
+ * step is repeated with a smaller time step, and otherwise GetNextTimeStep() suggests the
+ * largest step expected to meet the tolerance, so the simulation time step is automatically
+ * subdivided only where it is needed.
+ *
+ * The method has the first same as last property: the force at r^(t+1) used for the error
+ * estimate is the force k1 of the next step.  It is reused if the next step starts with the
+ * same nodes at exactly the locations where it was computed, so an accepted adaptive step
+ * costs three force evaluations rather than four.  The force is only reused by the steps
+ * into which a single simulation time step is subdivided, between which the forces depend
+ * only on the node locations; after remeshing, cell ageing or any simulation modifier, or if
+ * a node is added, removed or moved (for example by a T1 swap), the force is recomputed.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class RK23NumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mTolerance;
+    }
+
+    /**
+     * The tolerance on the estimated local error in any node location in a single step,
+     * used with an adaptive time step.  Defaults to 1e-4.
+     */
+    double mTolerance;
+
+    /** The size of step suggested by the error estimate of the last successful step, or zero if there is none. */
+    double mNextTimeStep;
+
+    /**
+     * The node locations at the end of the last successful adaptive step, or empty if there
+     * is none.  Not archived, so the force is recomputed after loading a simulation.
+     */
+    std::vector<c_vector<double, SPACE_DIM> > mLastLocations;
+
+    /** The forces including damping at mLastLocations. */
+    std::vector<c_vector<double, SPACE_DIM> > mLastForces;
+
+    /** The simulation time at which mLastForces were computed. */
+    double mLastTime;
+
+public:
+
+    /**
+     * Constructor.
+     */
+    RK23NumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~RK23NumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Overridden GetNextTimeStep() method.
+     *
+     * @param presentTimeStep the size of the step just taken
+     * @return the step suggested by the error estimate of the last step
+     */
+    virtual double GetNextTimeStep(double presentTimeStep);
+
+    /**
+     * Set mTolerance.
+     *
+     * @param tolerance the tolerance on the estimated local error in node locations
+     */
+    void SetTolerance(double tolerance);
+
+    /**
+     * @return mTolerance
+     */
+    double GetTolerance();
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(RK23NumericalMethod)
+
+#endif /*RK23NUMERICALMETHOD_HPP_*/
@@ -75,6 +75,11 @@ private:
      */
     std::string mCellDataVariableName;
 
+    /**
+     * The key of the item stored in CellData to output (see CellData::GetKey()).
+     */
+    unsigned mCellDataKey;
+
 public:
 
     /**
@@ -46,7 +46,8 @@ CellDeltaNotchWriter<ELEMENT_DIM, SPACE_DIM>::CellDeltaNotchWriter()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double CellDeltaNotchWriter<ELEMENT_DIM, SPACE_DIM>::GetCellDataForVtkOutput(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
-    double delta = pCell->GetCellData()->GetItem("delta");
+    static const unsigned delta_key = CellData::GetKey("delta");
+    double delta = pCell->GetCellData()->GetItem(delta_key);
     return delta;
 }
 
@@ -68,16 +69,20 @@ void CellDeltaNotchWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, Abst
         *this->mpOutStream << centre_location[i] << " ";
     }
 
+    static const unsigned delta_key = CellData::GetKey("delta");
+    static const unsigned notch_key = CellData::GetKey("notch");
+    static const unsigned mean_delta_key = CellData::GetKey("mean delta");
+
     // Output this cell's level of delta
-    double delta = pCell->GetCellData()->GetItem("delta");
+    double delta = pCell->GetCellData()->GetItem(delta_key);
     *this->mpOutStream << delta << " ";
 
     // Output this cell's level of notch
-    double notch = pCell->GetCellData()->GetItem("notch");
+    double notch = pCell->GetCellData()->GetItem(notch_key);
     *this->mpOutStream << notch << " ";
 
     // Output the mean level of delta among this cell's neighbours
-    double mean_delta = pCell->GetCellData()->GetItem("mean delta");
+    double mean_delta = pCell->GetCellData()->GetItem(mean_delta_key);
     *this->mpOutStream << mean_delta << " ";
 }
 
@@ -82,7 +82,7 @@ void CellPopulationAreaWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopula
             bool cell_is_apoptotic = p_cell->HasCellProperty<ApoptoticCellProperty>();
             if (cell_is_apoptotic)
             {
-                double cell_volume = voronoi_tessellation->GetVolumeOfElement(elem_index);
+                double cell_volume = pCellPopulation->GetVolumeOfVoronoiElement(node_index);
                 apoptotic_area += cell_volume;
             }
         }
@@ -72,8 +72,8 @@ void VoronoiDataWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<EL
             *this->mpOutStream << node_location[i] << " ";
         }
 
-        double cell_volume = voronoi_tesselation->GetVolumeOfElement(elem_index);
-        double cell_surface_area = voronoi_tesselation->GetSurfaceAreaOfElement(elem_index);
+        double cell_volume = pCellPopulation->GetVolumeOfVoronoiElement(node_index);
+        double cell_surface_area = pCellPopulation->GetSurfaceAreaOfVoronoiElement(node_index);
         *this->mpOutStream << cell_volume << " " << cell_surface_area << " ";
     }
 }
@@ -130,6 +130,10 @@ public:
 
         TS_ASSERT_THROWS_THIS(p_cell_data->GetItem("thing1"), "The item thing1 is not stored");
 
+        // Looking up an unknown name does not register it
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem("never stored"), "The item never stored is not stored");
+        TS_ASSERT_EQUALS(CellData::FindKey("never stored"), UNSIGNED_UNSET);
+
         p_cell_data->SetItem("thing1", 1.0);
         p_cell_data->SetItem("thing2", 2.0);
         p_cell_data->SetItem("thing3", 3.0);
@@ -138,6 +142,42 @@ public:
         TS_ASSERT_DELTA(p_cell_data->GetItem("thing2"), 2.0, 1e-8);
         TS_ASSERT_DELTA(p_cell_data->GetItem("thing3"), 3.0, 1e-8);
         TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
+
+        // Items may also be accessed using the key of their name, which is shared by all cells
+        unsigned key = CellData::GetKey("thing2");
+        TS_ASSERT_EQUALS(CellData::GetKey("thing2"), key);
+        TS_ASSERT_EQUALS(CellData::FindKey("thing2"), key);
+        TS_ASSERT_EQUALS(CellData::GetKeyName(key), "thing2");
+        TS_ASSERT_DELTA(p_cell_data->GetItem(key), 2.0, 1e-8);
+        p_cell_data->SetItem(key, 4.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("thing2"), 4.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
+
+        unsigned new_key = CellData::GetKey("a new thing");
+        TS_ASSERT_DIFFERS(new_key, key);
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem(new_key), "The item a new thing is not stored");
+
+        MAKE_PTR(CellData, p_other_cell_data);
+        p_other_cell_data->SetItem(new_key, 5.0);
+        TS_ASSERT_EQUALS(p_other_cell_data->GetNumItems(), 1u);
+        TS_ASSERT_DELTA(p_other_cell_data->GetItem("a new thing"), 5.0, 1e-8);
+        TS_ASSERT_THROWS_THIS(p_other_cell_data->GetItem(key), "The item thing2 is not stored");
+
+        // Keys are sorted by name, whatever the order in which they were first used
+        p_cell_data->SetItem(new_key, 6.0);
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        TS_ASSERT_EQUALS(keys.size(), 4u);
+        TS_ASSERT_EQUALS(keys[0], "a new thing");
+        TS_ASSERT_EQUALS(keys[1], "thing1");
+        TS_ASSERT_EQUALS(keys[2], "thing2");
+        TS_ASSERT_EQUALS(keys[3], "thing3");
+
+        // Copies have their own items
+        CellData cell_data_copy(*p_cell_data);
+        cell_data_copy.SetItem(key, 7.0);
+        TS_ASSERT_DELTA(cell_data_copy.GetItem("thing2"), 7.0, 1e-8);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("thing2"), 4.0, 1e-8);
+        TS_ASSERT_EQUALS(cell_data_copy.GetNumItems(), 4u);
     }
 
     void TestArchiveCellData() throw(Exception)
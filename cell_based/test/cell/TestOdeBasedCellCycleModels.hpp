@@ -61,6 +61,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCellBasedTestSuite.hpp"
 #include "SmartPointers.hpp"
 #include "FileComparison.hpp"
+#include "ThreadedTestHelpers.hpp"
+#include "CellsGenerator.hpp"
+#include "HoneycombMeshGenerator.hpp"
+#include "MeshBasedCellPopulation.hpp"
 //This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
 
@@ -518,6 +522,84 @@ public:
         }
     }
 
+    void TestBatchedOdeSolvingMatchesLazySolving() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel.
+
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        unsigned num_timesteps = 60;
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(3.0, num_timesteps);
+
+        // Create two identical populations of cells with Tyson-Novak cell-cycle models of different ages
+        HoneycombMeshGenerator lazy_generator(3, 3, 0);
+        MutableMesh<2,2>* p_lazy_mesh = lazy_generator.GetMesh();
+        HoneycombMeshGenerator batched_generator(3, 3, 0);
+        MutableMesh<2,2>* p_batched_mesh = batched_generator.GetMesh();
+
+        CellsGenerator<TysonNovakCellCycleModel, 2> cells_generator;
+        std::vector<CellPtr> lazy_cells;
+        cells_generator.GenerateBasic(lazy_cells, p_lazy_mesh->GetNumNodes());
+        std::vector<CellPtr> batched_cells;
+        cells_generator.GenerateBasic(batched_cells, p_batched_mesh->GetNumNodes());
+        for (unsigned i=0; i<lazy_cells.size(); i++)
+        {
+            lazy_cells[i]->SetBirthTime(-0.1*i);
+            batched_cells[i]->SetBirthTime(-0.1*i);
+            static_cast<TysonNovakCellCycleModel*>(lazy_cells[i]->GetCellCycleModel())->SetDt(0.1/60.0);
+            static_cast<TysonNovakCellCycleModel*>(batched_cells[i]->GetCellCycleModel())->SetDt(0.1/60.0);
+        }
+
+        MeshBasedCellPopulation<2> lazy_population(*p_lazy_mesh, lazy_cells);
+        MeshBasedCellPopulation<2> batched_population(*p_batched_mesh, batched_cells);
+
+        // Test the default settings and exceptions
+        TS_ASSERT_EQUALS(batched_population.GetUseBatchedOdeSolving(), false);
+        TS_ASSERT_EQUALS(batched_population.GetNumberOfOdeThreads(), 1u);
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(batched_population.SetNumberOfOdeThreads(2u), "cell ODEs cannot be solved");
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest(2u);
+        if (!numbers_of_threads.empty())
+        {
+            batched_population.SetNumberOfOdeThreads(numbers_of_threads.back());
+            TS_ASSERT_EQUALS(batched_population.GetNumberOfOdeThreads(), 2u);
+        }
+        batched_population.SetUseBatchedOdeSolving(true);
+        TS_ASSERT_EQUALS(batched_population.GetUseBatchedOdeSolving(), true);
+
+        // The cells should divide at exactly the same times and have exactly the same protein concentrations
+        unsigned num_divisions = 0;
+        for (unsigned i=0; i<num_timesteps; i++)
+        {
+            p_simulation_time->IncrementTimeOneStep();
+
+            batched_population.SolveCellOdesToCurrentTime();
+
+            std::list<CellPtr>::iterator lazy_iter = lazy_population.rGetCells().begin();
+            for (std::list<CellPtr>::iterator batched_iter = batched_population.rGetCells().begin();
+                 batched_iter != batched_population.rGetCells().end();
+                 ++batched_iter, ++lazy_iter)
+            {
+                bool lazy_ready = (*lazy_iter)->ReadyToDivide();
+                bool batched_ready = (*batched_iter)->ReadyToDivide();
+                TS_ASSERT_EQUALS(batched_ready, lazy_ready);
+
+                std::vector<double> lazy_concentrations = static_cast<TysonNovakCellCycleModel*>((*lazy_iter)->GetCellCycleModel())->GetProteinConcentrations();
+                std::vector<double> batched_concentrations = static_cast<TysonNovakCellCycleModel*>((*batched_iter)->GetCellCycleModel())->GetProteinConcentrations();
+                for (unsigned j=0; j<lazy_concentrations.size(); j++)
+                {
+                    TS_ASSERT_EQUALS(batched_concentrations[j], lazy_concentrations[j]);
+                }
+
+                if (lazy_ready && batched_ready)
+                {
+                    (*lazy_iter)->GetCellCycleModel()->ResetForDivision();
+                    (*batched_iter)->GetCellCycleModel()->ResetForDivision();
+                    num_divisions++;
+                }
+            }
+        }
+        TS_ASSERT_LESS_THAN(0u, num_divisions);
+    }
+
     void TestCellCycleModelOutputParameters()
     {
         std::string output_directory = "TestCellCycleModelOutputParameters";
@@ -46,6 +46,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractSrnModel.hpp"
 #include "NullSrnModel.hpp"
 #include "DeltaNotchSrnModel.hpp"
+#include "CellCycleModelOdeHandler.hpp"
 #include "Goldbeter1991SrnModel.hpp"
 #include "UniformG1GenerationalCellCycleModel.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
@@ -108,6 +109,49 @@ public:
         TS_ASSERT_DELTA(p_srn_model->GetDelta(), 0.0101, 1e-4);
     }
 
+    void TestDeltaNotchSrnPresolvedMatchesLazy() throw(Exception)
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(2.0, 20);
+
+        MAKE_PTR(WildTypeCellMutationState, p_healthy_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        // Two identical cells, one of whose SRN models is solved ahead of time
+        std::vector<CellPtr> cells;
+        std::vector<DeltaNotchSrnModel*> srn_models;
+        for (unsigned i=0; i<2; i++)
+        {
+            DeltaNotchSrnModel* p_srn_model = new DeltaNotchSrnModel();
+            CellPtr p_cell(new Cell(p_healthy_state, new UniformG1GenerationalCellCycleModel(), p_srn_model, false, CellPropertyCollection()));
+            p_cell->SetCellProliferativeType(p_diff_type);
+            p_cell->GetCellData()->SetItem("mean delta", 1.0);
+            p_cell->InitialiseCellCycleModel();
+            p_cell->InitialiseSrnModel();
+            cells.push_back(p_cell);
+            srn_models.push_back(p_srn_model);
+        }
+        std::vector<CellCycleModelOdeHandler*> presolved_models(1, srn_models[1]);
+
+        for (unsigned step=0; step<20; step++)
+        {
+            p_simulation_time->IncrementTimeOneStep();
+
+            // The mean Delta changes every time step, and both models should see the new value
+            double mean_delta = 1.0 + 0.1*step;
+            cells[0]->GetCellData()->SetItem("mean delta", mean_delta);
+            cells[1]->GetCellData()->SetItem("mean delta", mean_delta);
+
+            CellCycleModelOdeHandler::PresolveOdesToTime(presolved_models, p_simulation_time->GetTime(), 1u);
+            srn_models[0]->SimulateToCurrentTime();
+            srn_models[1]->SimulateToCurrentTime();
+
+            TS_ASSERT_DELTA(srn_models[1]->GetMeanNeighbouringDelta(), mean_delta, 1e-12);
+            TS_ASSERT_EQUALS(srn_models[1]->GetNotch(), srn_models[0]->GetNotch());
+            TS_ASSERT_EQUALS(srn_models[1]->GetDelta(), srn_models[0]->GetDelta());
+        }
+    }
+
     void TestDeltaNotchSrnCreateCopy()
     {
         // Test with DeltaNotchSrnModel
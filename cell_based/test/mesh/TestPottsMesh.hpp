@@ -893,6 +893,89 @@ public:
         }
     }
 
+    void TestMooreNeighbourTable()
+    {
+        // The flat neighbour table gives the same neighbours, in the same order, as the sets
+        PottsMeshGenerator<2> generator(4, 1, 4, 3, 1, 3, 1, 1, 1, false, true, false, false); // Periodic in x
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            std::set<unsigned> neighbouring_sites = p_mesh->GetMooreNeighbouringNodeIndices(node_index);
+            TS_ASSERT_EQUALS(p_mesh->GetNumMooreNeighbours(node_index), neighbouring_sites.size());
+
+            unsigned neighbour = 0;
+            for (std::set<unsigned>::iterator iter = neighbouring_sites.begin();
+                 iter != neighbouring_sites.end();
+                 ++iter, ++neighbour)
+            {
+                TS_ASSERT_EQUALS(p_mesh->GetMooreNeighbour(node_index, neighbour), *iter);
+            }
+        }
+        TS_ASSERT_EQUALS(p_mesh->GetNumMooreNeighbours(0), 5u);
+        TS_ASSERT_EQUALS(p_mesh->GetNumMooreNeighbours(5), 8u);
+
+        // The table is rebuilt when the neighbours change
+        p_mesh->DeleteNode(0);
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            std::set<unsigned> neighbouring_sites = p_mesh->GetMooreNeighbouringNodeIndices(node_index);
+            TS_ASSERT_EQUALS(p_mesh->GetNumMooreNeighbours(node_index), neighbouring_sites.size());
+            if (!neighbouring_sites.empty())
+            {
+                TS_ASSERT_EQUALS(p_mesh->GetMooreNeighbour(node_index, 0), *(neighbouring_sites.begin()));
+            }
+        }
+    }
+
+    void TestCheckerboardColours()
+    {
+        // On a regular lattice the colouring is the usual four colour checkerboard
+        PottsMeshGenerator<2> generator(4, 1, 4, 4, 1, 4);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+        TS_ASSERT_EQUALS(p_mesh->GetNumCheckerboardColours(), 4u);
+
+        const std::vector<unsigned>& r_first_colour = p_mesh->rGetCheckerboardNodes(0);
+        TS_ASSERT_EQUALS(r_first_colour.size(), 4u);
+        TS_ASSERT_EQUALS(r_first_colour[0], 0u);
+        TS_ASSERT_EQUALS(r_first_colour[1], 2u);
+        TS_ASSERT_EQUALS(r_first_colour[2], 8u);
+        TS_ASSERT_EQUALS(r_first_colour[3], 10u);
+
+        // With an odd number of nodes across a periodic mesh more colours are needed
+        PottsMeshGenerator<2> periodic_generator(5, 1, 5, 4, 1, 4, 1, 1, 1, false, true, false, false);
+        PottsMesh<2>* p_periodic_mesh = periodic_generator.GetMesh();
+        TS_ASSERT_LESS_THAN(4u, p_periodic_mesh->GetNumCheckerboardColours());
+
+        // In each case every node has exactly one colour, which none of its neighbours share
+        PottsMesh<2>* meshes[2] = {p_mesh, p_periodic_mesh};
+        for (unsigned m=0; m<2; m++)
+        {
+            std::vector<unsigned> node_colours(meshes[m]->GetNumNodes(), UNSIGNED_UNSET);
+            for (unsigned colour=0; colour<meshes[m]->GetNumCheckerboardColours(); colour++)
+            {
+                const std::vector<unsigned>& r_nodes = meshes[m]->rGetCheckerboardNodes(colour);
+                for (unsigned i=0; i<r_nodes.size(); i++)
+                {
+                    TS_ASSERT_EQUALS(node_colours[r_nodes[i]], UNSIGNED_UNSET);
+                    node_colours[r_nodes[i]] = colour;
+                }
+            }
+            for (unsigned node_index=0; node_index<meshes[m]->GetNumNodes(); node_index++)
+            {
+                TS_ASSERT_DIFFERS(node_colours[node_index], UNSIGNED_UNSET);
+
+                std::set<unsigned> neighbouring_sites = meshes[m]->GetMooreNeighbouringNodeIndices(node_index);
+                for (std::set<unsigned>::iterator iter = neighbouring_sites.begin();
+                     iter != neighbouring_sites.end();
+                     ++iter)
+                {
+                    TS_ASSERT_DIFFERS(node_colours[*iter], node_colours[node_index]);
+                }
+            }
+        }
+    }
+
     void TestGetVonNeumannNeighbouringNodeIndices2d()
     {
         /* * Create a 2 simple Potts mesh with one element, one of which is periodic in all the dimensions.
@@ -48,6 +48,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BackwardEulerIvpOdeSolver.hpp"
 #include "EulerIvpOdeSolver.hpp"
 #include "RungeKutta4IvpOdeSolver.hpp"
+#include "FixedSizeOneStepIvpOdeSolver.hpp"
+#include "FixedSizeRungeKutta4Stepper.hpp"
 #include "ColumnDataWriter.hpp"
 #include "Timer.hpp"
 
@@ -160,6 +162,46 @@ public:
         TS_ASSERT_DELTA(solutions.rGetSolutions()[end][5],0.95328206604519, 2e-2);
     }
 
+    void TestTysonNovakFixedSizeSolver() throw(Exception)
+    {
+        // The fixed-size RK4 solver should give the same results as RungeKutta4IvpOdeSolver
+        FixedSizeOneStepIvpOdeSolver<TysonNovak2001OdeSystem,
+            FixedSizeRungeKutta4Stepper<TysonNovak2001OdeSystem::NUM_STATE_VARIABLES> > fixed_size_solver;
+        RungeKutta4IvpOdeSolver solver;
+
+        double dt = 0.1/60.0;
+
+        TysonNovak2001OdeSystem fixed_size_system;
+        fixed_size_solver.SolveAndUpdateStateVariable(&fixed_size_system, 0.0, 75.8350/60.0, dt);
+
+        TysonNovak2001OdeSystem system;
+        solver.SolveAndUpdateStateVariable(&system, 0.0, 75.8350/60.0, dt);
+
+        TS_ASSERT_EQUALS(fixed_size_solver.StoppingEventOccurred(), solver.StoppingEventOccurred());
+        TS_ASSERT_EQUALS(fixed_size_solver.StoppingEventOccurred(), true);
+        TS_ASSERT_DELTA(fixed_size_solver.GetStoppingTime(), solver.GetStoppingTime(), 1e-12);
+        for (unsigned i=0; i<6; i++)
+        {
+            TS_ASSERT_DELTA(fixed_size_system.rGetStateVariables()[i], system.rGetStateVariables()[i], 1e-10);
+        }
+
+        // The fixed-size derivatives are the same as the usual ones
+        c_vector<double, 6> fixed_size_y;
+        c_vector<double, 6> fixed_size_dy;
+        std::vector<double> y = system.GetInitialConditions();
+        std::vector<double> dy(6);
+        for (unsigned i=0; i<6; i++)
+        {
+            fixed_size_y[i] = y[i];
+        }
+        fixed_size_system.EvaluateFixedSizeYDerivatives(0.0, fixed_size_y, fixed_size_dy);
+        system.EvaluateYDerivatives(0.0, y, dy);
+        for (unsigned i=0; i<6; i++)
+        {
+            TS_ASSERT_EQUALS(fixed_size_dy[i], dy[i]);
+        }
+    }
+
     void TestArchiving()
     {
         OutputFileHandler handler("archive", false);
@@ -64,6 +64,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellLabel.hpp"
 #include "SmartPointers.hpp"
 #include "FileComparison.hpp"
+#include "ThreadedTestHelpers.hpp"
 #include "SimpleTargetAreaModifier.hpp"
 #include "OffLatticeSimulation.hpp"
 
@@ -1002,6 +1003,65 @@ public:
         }
     }
 
+    void TestTwoBodyForcesOnMultipleThreads() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel.
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0,1);
+
+        HoneycombMeshGenerator generator(6, 6, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Perturb the nodes so that the springs are stretched by different amounts
+        for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+        {
+            p_mesh->GetNode(i)->rGetModifiableLocation()[0] += 0.1*RandomNumberGenerator::Instance()->ranf();
+            p_mesh->GetNode(i)->rGetModifiableLocation()[1] += 0.1*RandomNumberGenerator::Instance()->ranf();
+        }
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        GeneralisedLinearSpringForce<2> linear_force;
+        TS_ASSERT_EQUALS(linear_force.GetNumberOfThreads(), 1u);
+
+        for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+        {
+            cell_population.GetNode(i)->ClearAppliedForce();
+        }
+        linear_force.AddForceContribution(cell_population);
+
+        std::vector<c_vector<double, 2> > serial_forces;
+        for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+        {
+            serial_forces.push_back(cell_population.GetNode(i)->rGetAppliedForce());
+        }
+
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest();
+        for (unsigned t=0; t<numbers_of_threads.size(); t++)
+        {
+            const unsigned num_threads = numbers_of_threads[t];
+            linear_force.SetNumberOfThreads(num_threads);
+            TS_ASSERT_EQUALS(linear_force.GetNumberOfThreads(), num_threads);
+
+            for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+            {
+                cell_population.GetNode(i)->ClearAppliedForce();
+            }
+            linear_force.AddForceContribution(cell_population);
+
+            // The forces are accumulated in the same order, so are identical to the serial ones
+            for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+            {
+                TS_ASSERT_EQUALS(cell_population.GetNode(i)->rGetAppliedForce()[0], serial_forces[i][0]);
+                TS_ASSERT_EQUALS(cell_population.GetNode(i)->rGetAppliedForce()[1], serial_forces[i][1]);
+            }
+        }
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(linear_force.SetNumberOfThreads(2u), "forces cannot be calculated");
+    }
+
     void TestNagaiHondaForceMethods() throw (Exception)
     {
         // Construct a 2D vertex mesh consisting of a single element
@@ -1140,6 +1200,73 @@ public:
         }
     }
 
+    void TestVertexForcesOnMultipleThreads() throw (Exception)
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0,1);
+
+        HoneycombVertexMeshGenerator generator(5, 5);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Perturb the nodes so that the cells are deformed by different amounts
+        for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+        {
+            p_mesh->GetNode(i)->rGetModifiableLocation()[0] += 0.1*RandomNumberGenerator::Instance()->ranf();
+            p_mesh->GetNode(i)->rGetModifiableLocation()[1] += 0.1*RandomNumberGenerator::Instance()->ranf();
+        }
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+        p_growth_modifier->UpdateTargetAreas(cell_population);
+
+        NagaiHondaForce<2> nagai_honda_force;
+        TS_ASSERT_EQUALS(nagai_honda_force.GetNumberOfThreads(), 1u);
+
+        FarhadifarForce<2> farhadifar_force;
+        TS_ASSERT_EQUALS(farhadifar_force.GetNumberOfThreads(), 1u);
+
+        for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+        {
+            cell_population.GetNode(i)->ClearAppliedForce();
+        }
+        nagai_honda_force.AddForceContribution(cell_population);
+        farhadifar_force.AddForceContribution(cell_population);
+
+        std::vector<c_vector<double, 2> > serial_forces;
+        for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+        {
+            serial_forces.push_back(cell_population.GetNode(i)->rGetAppliedForce());
+        }
+
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest();
+        for (unsigned t=0; t<numbers_of_threads.size(); t++)
+        {
+            const unsigned num_threads = numbers_of_threads[t];
+            nagai_honda_force.SetNumberOfThreads(num_threads);
+            TS_ASSERT_EQUALS(nagai_honda_force.GetNumberOfThreads(), num_threads);
+            farhadifar_force.SetNumberOfThreads(num_threads);
+            TS_ASSERT_EQUALS(farhadifar_force.GetNumberOfThreads(), num_threads);
+
+            for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+            {
+                cell_population.GetNode(i)->ClearAppliedForce();
+            }
+            nagai_honda_force.AddForceContribution(cell_population);
+            farhadifar_force.AddForceContribution(cell_population);
+
+            // Only the element geometry is computed on multiple threads, so the forces are identical to the serial ones
+            for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+            {
+                TS_ASSERT_EQUALS(cell_population.GetNode(i)->rGetAppliedForce()[0], serial_forces[i][0]);
+                TS_ASSERT_EQUALS(cell_population.GetNode(i)->rGetAppliedForce()[1], serial_forces[i][1]);
+            }
+        }
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(nagai_honda_force.SetNumberOfThreads(2u), "element geometry cannot be calculated");
+    }
+
     void TestNagaiHondaForceArchiving() throw (Exception)
     {
         EXIT_IF_PARALLEL; // Beware of processes overwriting the identical archives of other processes
@@ -1561,6 +1561,52 @@ public:
         }
     }
 
+    void TestVoronoiTessellationUpdatedInPlace() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel
+
+        // Create a simple mesh
+        HoneycombMeshGenerator generator(5, 5, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Set up cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        // Create cell population, which is remeshed incrementally, and Voronoi tessellation
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        TS_ASSERT_EQUALS(cell_population.GetUseIncrementalReMesh(), false);
+        cell_population.SetUseIncrementalReMesh(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseIncrementalReMesh(), true);
+        TS_ASSERT_EQUALS(p_mesh->GetUseIncrementalReMesh(), true);
+        cell_population.CreateVoronoiTessellation();
+        VertexMesh<2,2>* p_tessellation = cell_population.GetVoronoiTessellation();
+
+        // Move an interior node, then remesh and update the tessellation
+        p_mesh->GetNode(12)->rGetModifiableLocation()[0] += 0.1;
+        cell_population.Update();
+        cell_population.CreateVoronoiTessellation();
+
+        // The tessellation has been updated in place rather than recreated
+        TS_ASSERT_EQUALS(cell_population.GetVoronoiTessellation(), p_tessellation);
+
+        // The areas and perimeters agree with those of a tessellation constructed afresh, both when first computed and when cached
+        VertexMesh<2,2> new_tessellation(*p_mesh);
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            if (!p_mesh->GetNode(node_index)->IsBoundaryNode())
+            {
+                unsigned elem_index = new_tessellation.GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(node_index);
+                for (unsigned i=0; i<2; i++)
+                {
+                    TS_ASSERT_DELTA(cell_population.GetVolumeOfVoronoiElement(node_index), new_tessellation.GetVolumeOfElement(elem_index), 1e-12);
+                    TS_ASSERT_DELTA(cell_population.GetSurfaceAreaOfVoronoiElement(node_index), new_tessellation.GetSurfaceAreaOfElement(elem_index), 1e-12);
+                }
+            }
+        }
+    }
+
     void TestGetTetrahedralMeshForPdeModifier() throw(Exception)
     {
         EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel
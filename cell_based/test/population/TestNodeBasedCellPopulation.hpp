@@ -983,6 +983,85 @@ public:
          }
     }
 
+    void TestVerletNeighbourLists() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // Verlet lists are only reused in serial
+
+        std::vector<Node<2>* > nodes;
+        nodes.push_back(new Node<2>(0, false, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, false, 1.0, 0.0));
+        nodes.push_back(new Node<2>(2, false, 2.4, 0.0));
+
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        // Verlet lists are off by default
+        TS_ASSERT_DELTA(cell_population.GetVerletSkin(), 0.0, 1e-12);
+        cell_population.Update(false);
+        cell_population.Update(false);
+        TS_ASSERT_EQUALS(cell_population.GetNumNodePairCalculations(), 2u);
+
+        TS_ASSERT_THROWS_THIS(cell_population.SetVerletSkin(-0.1),
+                              "The Verlet skin must be non-negative and smaller than the maximum interaction distance of the mesh.");
+        TS_ASSERT_THROWS_THIS(cell_population.SetVerletSkin(1.5),
+                              "The Verlet skin must be non-negative and smaller than the maximum interaction distance of the mesh.");
+
+        cell_population.SetVerletSkin(0.5);
+        TS_ASSERT_DELTA(cell_population.GetVerletSkin(), 0.5, 1e-12);
+
+        // Setting the skin forces the pairs to be recalculated; pairs further apart than the cut-off are dropped
+        cell_population.Update(false);
+        TS_ASSERT_EQUALS(cell_population.GetNumNodePairCalculations(), 3u);
+        std::vector< std::pair<Node<2>*, Node<2>* > >& r_node_pairs = cell_population.rGetNodePairs();
+        TS_ASSERT_EQUALS(r_node_pairs.size(), 2u);
+        for (unsigned i=0; i<r_node_pairs.size(); i++)
+        {
+            double distance = norm_2(r_node_pairs[i].first->rGetLocation() - r_node_pairs[i].second->rGetLocation());
+            TS_ASSERT_LESS_THAN_EQUALS(distance, 1.5);
+        }
+
+        // Moving a node by less than half the skin keeps the existing pairs
+        cell_population.GetNode(2)->rGetModifiableLocation()[0] += 0.2;
+        cell_population.Update(false);
+        TS_ASSERT_EQUALS(cell_population.GetNumNodePairCalculations(), 3u);
+        TS_ASSERT_EQUALS(cell_population.rGetNodePairs().size(), 2u);
+
+        // The neighbour lists were kept too, so searches are limited to the cut-off minus the skin
+        std::set<unsigned> neighbours = cell_population.GetNodesWithinNeighbourhoodRadius(1, 1.0);
+        TS_ASSERT_EQUALS(neighbours.size(), 1u);
+        TS_ASSERT_EQUALS(neighbours.count(0), 1u);
+        TS_ASSERT_THROWS_THIS(cell_population.GetNodesWithinNeighbourhoodRadius(1, 1.2),
+                              "neighbourhoodRadius should be less than or equal to the maximum interaction radius defined on the NodesOnlyMesh minus the Verlet skin");
+        cell_population.GetNode(0)->SetRadius(0.6);
+        cell_population.GetNode(1)->SetRadius(0.6);
+        TS_ASSERT_THROWS_CONTAINS(cell_population.GetNeighbouringNodeIndices(1),
+                                  "mpNodesOnlyMesh::mMaxInteractionDistance minus the Verlet skin is smaller than the sum of radius of cell 1");
+        cell_population.GetNode(0)->SetRadius(0.5);
+        cell_population.GetNode(1)->SetRadius(0.5);
+        TS_ASSERT_EQUALS(cell_population.GetNeighbouringNodeIndices(1).size(), 1u);
+
+        // Once the total displacement exceeds half the skin the pairs are recalculated
+        cell_population.GetNode(2)->rGetModifiableLocation()[0] += 0.1;
+        cell_population.Update(false);
+        TS_ASSERT_EQUALS(cell_population.GetNumNodePairCalculations(), 4u);
+        TS_ASSERT_EQUALS(cell_population.rGetNodePairs().size(), 1u);
+
+        // Births or deaths always cause the pairs to be recalculated
+        cell_population.Update(true);
+        TS_ASSERT_EQUALS(cell_population.GetNumNodePairCalculations(), 5u);
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
     void TestSettingCellAncestors() throw (Exception)
     {
         // Create a small node-based cell population
@@ -1510,6 +1589,7 @@ public:
             }
 
             p_cell_population->SetUseVariableRadii(true);
+            p_cell_population->SetVerletSkin(0.3);
 
             // Create an output archive
             ArchiveOpener<boost::archive::text_oarchive, std::ofstream> arch_opener(archive_dir, archive_file);
@@ -1575,6 +1655,7 @@ public:
             // Check the member variables have been restored
             TS_ASSERT_DELTA(p_cell_population->GetMechanicsCutOffLength(), 1.5, 1e-9);
             TS_ASSERT(p_cell_population->GetUseVariableRadii());
+            TS_ASSERT_DELTA(p_cell_population->GetVerletSkin(), 0.3, 1e-12);
 
             // Tidy up
             delete p_cell_population;
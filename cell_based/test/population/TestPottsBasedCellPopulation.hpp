@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellsGenerator.hpp"
 #include "PottsBasedCellPopulation.hpp"
 #include "VolumeConstraintPottsUpdateRule.hpp"
+#include "AdhesionPottsUpdateRule.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
@@ -54,6 +55,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellId.hpp"
 #include "MutableMesh.hpp"
 #include "FileComparison.hpp"
+#include "ThreadedTestHelpers.hpp"
 
 // Cell writers
 #include "CellAgesWriter.hpp"
@@ -71,6 +73,72 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 class TestPottsBasedCellPopulation : public AbstractCellBasedTestSuite
 {
+private:
+
+    /**
+     * Run checkerboard Monte Carlo sweeps on a population of four cells.
+     *
+     * @param numThreads the number of threads to use (zero to return the initial configuration)
+     * @return the element containing each node afterwards (UNSIGNED_UNSET for the medium)
+     */
+    std::vector<unsigned> RunCheckerboardSweeps(unsigned numThreads)
+    {
+        RandomNumberGenerator::Instance()->Reseed(0);
+
+        // Four 4x4 cells in the middle of a 20x20 lattice
+        PottsMeshGenerator<2> generator(20, 2, 4, 20, 2, 4);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        if (numThreads > 0)
+        {
+            cell_population.SetUseCheckerboardSweep(true);
+            cell_population.SetNumberOfThreads(numThreads);
+            cell_population.SetNumSweepsPerTimestep(5);
+            cell_population.SetTemperature(1.0);
+
+            MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+            p_volume_constraint_update_rule->SetMatureCellTargetVolume(16.0);
+            cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+            MAKE_PTR(AdhesionPottsUpdateRule<2>, p_adhesion_update_rule);
+            cell_population.AddUpdateRule(p_adhesion_update_rule);
+
+            cell_population.UpdateCellLocations(1.0);
+        }
+
+        // Each node is in at most one element, and the elements agree with the nodes
+        std::vector<unsigned> element_containing_node(p_mesh->GetNumNodes(), UNSIGNED_UNSET);
+        unsigned num_nodes_in_elements = 0;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            PottsElement<2>* p_element = p_mesh->GetElement(elem_index);
+            TS_ASSERT_LESS_THAN(0u, p_element->GetNumNodes());
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                Node<2>* p_node = p_element->GetNode(local_index);
+                TS_ASSERT_EQUALS(p_node->rGetContainingElementIndices().size(), 1u);
+                element_containing_node[p_node->GetIndex()] = elem_index;
+            }
+            num_nodes_in_elements += p_element->GetNumNodes();
+        }
+        unsigned num_nodes_in_medium = 0;
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            if (p_mesh->GetNode(node_index)->rGetContainingElementIndices().empty())
+            {
+                num_nodes_in_medium++;
+            }
+        }
+        TS_ASSERT_EQUALS(num_nodes_in_elements + num_nodes_in_medium, 400u);
+
+        return element_containing_node;
+    }
+
 public:
 
     void TestConstructor() throw(Exception)
@@ -421,6 +489,40 @@ public:
         TS_ASSERT_EQUALS(cell_population.rGetMesh().GetElement(1)->GetNumNodes(), 4u);
     }
 
+    void TestUpdateCellLocationsUsingCheckerboardSweep()
+    {
+        PottsMeshGenerator<2> generator(4, 2, 2, 2, 1, 2);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Test set and get methods
+        TS_ASSERT_EQUALS(cell_population.GetUseCheckerboardSweep(), false);
+        cell_population.SetUseCheckerboardSweep(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseCheckerboardSweep(), true);
+
+        TS_ASSERT_EQUALS(cell_population.GetNumberOfThreads(), 1u);
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(cell_population.SetNumberOfThreads(2u), "Monte Carlo sweeps cannot be performed");
+
+        // The sweep keeps the population consistent, moves the cells and is reproducible
+        std::vector<unsigned> initial_element_containing_node = RunCheckerboardSweeps(0u);
+        std::vector<unsigned> element_containing_node = RunCheckerboardSweeps(1u);
+        TS_ASSERT_EQUALS(element_containing_node.size(), 400u);
+        TS_ASSERT(element_containing_node != initial_element_containing_node);
+        TS_ASSERT(RunCheckerboardSweeps(1u) == element_containing_node);
+
+        // The results do not depend on the number of threads
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest();
+        for (unsigned t=0; t<numbers_of_threads.size(); t++)
+        {
+            TS_ASSERT(RunCheckerboardSweeps(numbers_of_threads[t]) == element_containing_node);
+        }
+    }
+
     ///\todo implement this test (#1666)
 //    void TestVoronoiMethods()
 //    {
@@ -0,0 +1,190 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLBASEDBENCHMARKS_HPP_
+#define TESTCELLBASEDBENCHMARKS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "BenchmarkReport.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "CellsGenerator.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "OnLatticeSimulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "PottsMeshGenerator.hpp"
+#include "RepulsionForce.hpp"
+#include "SmartPointers.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "VolumeConstraintPottsUpdateRule.hpp"
+#include "AdhesionPottsUpdateRule.hpp"
+
+// Needed for NodesOnlyMesh
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * Benchmarks of representative cell-based simulations at several problem sizes.
+ *
+ * The results are written to CHASTE_TEST_OUTPUT/CellBasedBenchmarks as JSON, with
+ * the CellBasedEventHandler breakdown of each run, and can be compared against a
+ * stored baseline with python/utils/CompareBenchmarks.py.  Run with different
+ * numbers of processes to benchmark the parallel node-based code.
+ */
+class TestCellBasedBenchmarks : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestNodeBased3dBenchmark() throw (Exception)
+    {
+        BenchmarkReport report("NodeBased3d");
+
+        for (unsigned cells_across=6; cells_across<=12; cells_across+=3)
+        {
+            SimulationTime::Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+            CellBasedEventHandler::Reset();
+
+            report.BeginRun("NodeBased3d");
+            report.AddParameter("cells_across", cells_across);
+
+            // Create a cube of cells evenly spaced in a regular grid
+            std::vector<Node<3>*> nodes;
+            unsigned index = 0;
+            for (unsigned i=0; i<cells_across; i++)
+            {
+                for (unsigned j=0; j<cells_across; j++)
+                {
+                    for (unsigned k=0; k<cells_across; k++)
+                    {
+                        nodes.push_back(new Node<3>(index, false, 0.9*i, 0.9*j, 0.9*k));
+                        index++;
+                    }
+                }
+            }
+
+            NodesOnlyMesh<3> mesh;
+            mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+            CellsGenerator<UniformCellCycleModel, 3> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_transit_type);
+
+            NodeBasedCellPopulation<3> cell_population(mesh, cells);
+
+            OffLatticeSimulation<3> simulator(cell_population);
+            simulator.SetOutputDirectory("CellBasedBenchmarks/NodeBased3d");
+            simulator.SetSamplingTimestepMultiple(120);
+            simulator.SetEndTime(5.0);
+
+            MAKE_PTR(RepulsionForce<3>, p_force);
+            p_force->SetCutOffLength(1.5);
+            simulator.AddForce(p_force);
+
+            simulator.Solve();
+
+            report.AddEventTimes("CellBasedEventHandler", CellBasedEventHandler::Instance());
+            report.EndRun();
+
+            for (unsigned i=0; i<nodes.size(); i++)
+            {
+                delete nodes[i];
+            }
+        }
+
+        report.WriteFile("CellBasedBenchmarks");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 3u);
+    }
+
+    void TestPottsBenchmark() throw (Exception)
+    {
+        EXIT_IF_PARALLEL; // Potts simulations don't work in parallel
+
+        BenchmarkReport report("Potts");
+
+        for (unsigned cells_across=5; cells_across<=15; cells_across+=5)
+        {
+            SimulationTime::Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+            CellBasedEventHandler::Reset();
+
+            report.BeginRun("Potts");
+            report.AddParameter("cells_across", cells_across);
+
+            unsigned lattice_width = 6*cells_across;
+            PottsMeshGenerator<2> generator(lattice_width, cells_across, 4, lattice_width, cells_across, 4);
+            PottsMesh<2>* p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumElements(), p_diff_type);
+
+            PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+            OnLatticeSimulation<2> simulator(cell_population);
+            simulator.SetOutputDirectory("CellBasedBenchmarks/Potts");
+            simulator.SetDt(0.1);
+            simulator.SetSamplingTimestepMultiple(100);
+            simulator.SetEndTime(5.0);
+
+            MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+            p_volume_constraint_update_rule->SetMatureCellTargetVolume(16);
+            simulator.AddUpdateRule(p_volume_constraint_update_rule);
+            MAKE_PTR(AdhesionPottsUpdateRule<2>, p_adhesion_update_rule);
+            simulator.AddUpdateRule(p_adhesion_update_rule);
+
+            simulator.Solve();
+
+            report.AddEventTimes("CellBasedEventHandler", CellBasedEventHandler::Instance());
+            report.EndRun();
+        }
+
+        report.WriteFile("CellBasedBenchmarks");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 3u);
+    }
+};
+
+#endif /*TESTCELLBASEDBENCHMARKS_HPP_*/
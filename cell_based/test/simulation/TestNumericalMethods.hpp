@@ -65,6 +65,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "PopulationTestingForce.hpp"
 #include "ForwardEulerNumericalMethod.hpp"
+#include "RK23NumericalMethod.hpp"
+#include "BackwardEulerNumericalMethod.hpp"
+#include "StepSizeException.hpp"
 #include "Warnings.hpp"
 
 
@@ -475,6 +478,138 @@ public:
         }
     }
 
+    void TestRK23AndBackwardEulerWithMeshBased() throw(Exception)
+    {
+        // Create a simple mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        // Create a force collection
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        MAKE_PTR(RK23NumericalMethod<2>, p_rk_method);
+        p_rk_method->SetCellPopulation(&cell_population);
+        p_rk_method->SetForceCollection(&force_collection);
+
+        MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+        p_be_method->SetCellPopulation(&cell_population);
+        p_be_method->SetForceCollection(&force_collection);
+
+        double dt = 0.5;
+
+        // Check the third order step
+        std::vector<c_vector<double, 2> > old_posns = p_rk_method->SaveCurrentLocations();
+        p_rk_method->UpdateAllNodePositions(dt);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationRK23(j, damping, old_posns[j], dt);
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-12);
+        }
+
+        // Check the backward Euler step, which converges to the solution of the implicit equations
+        old_posns = p_be_method->SaveCurrentLocations();
+        p_be_method->UpdateAllNodePositions(dt);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], dt);
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-7);
+        }
+
+        // Newton's method converges in a few iterations, even for a step too long for a fixed point iteration to converge quickly
+        p_be_method->SetMaxIterations(3);
+        old_posns = p_be_method->SaveCurrentLocations();
+        p_be_method->UpdateAllNodePositions(10.0);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], 10.0);
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-7);
+        }
+
+        // If the iteration does not converge the simulation stops, unless the time step is adaptive
+        p_be_method->SetMaxIterations(1);
+        TS_ASSERT_EQUALS(p_be_method->GetMaxIterations(), 1u);
+        TS_ASSERT_THROWS_THIS(p_be_method->UpdateAllNodePositions(dt),
+                              "Backward Euler iteration did not converge in 1 iterations. Reduce the time step or use an adaptive time step.");
+        p_be_method->SetUseAdaptiveTimestep(true);
+        TS_ASSERT_THROWS_ANYTHING(p_be_method->UpdateAllNodePositions(dt));
+        try
+        {
+            p_be_method->UpdateAllNodePositions(dt);
+        }
+        catch (StepSizeException& e)
+        {
+            TS_ASSERT_DELTA(e.GetSuggestedNewStep(), 0.5*dt, 1e-12);
+            TS_ASSERT_EQUALS(e.IsTerminal(), false);
+        }
+
+        // With an adaptive time step, a step whose error estimate is too large is rejected...
+        p_rk_method->SetUseAdaptiveTimestep(true);
+        p_rk_method->SetTolerance(1e-12);
+        TS_ASSERT_DELTA(p_rk_method->GetTolerance(), 1e-12, 1e-20);
+        try
+        {
+            p_rk_method->UpdateAllNodePositions(dt);
+            TS_FAIL("Expected a StepSizeException");
+        }
+        catch (StepSizeException& e)
+        {
+            TS_ASSERT_LESS_THAN(e.GetSuggestedNewStep(), dt);
+            TS_ASSERT_EQUALS(e.IsTerminal(), false);
+        }
+
+        // ...and after an accurate step a larger one is suggested
+        p_rk_method->SetTolerance(1e-2);
+        p_rk_method->UpdateAllNodePositions(dt);
+        TS_ASSERT_LESS_THAN(dt, p_rk_method->GetNextTimeStep(dt));
+        TS_ASSERT_LESS_THAN_EQUALS(p_rk_method->GetNextTimeStep(dt), 5.0*dt);
+
+        // The next step reuses the force at the end of the accepted step as its first stage
+        old_posns = p_rk_method->SaveCurrentLocations();
+        p_rk_method->UpdateAllNodePositions(dt);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationRK23(j, damping, old_posns[j], dt);
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-12);
+        }
+
+        // The force is recomputed in the next simulation time step, as the cells may have changed
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        cell_population.SetDampingConstantNormal(2.2);
+        old_posns = p_rk_method->SaveCurrentLocations();
+        p_rk_method->UpdateAllNodePositions(dt);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            TS_ASSERT_DELTA(damping, 2.2, 1e-12);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationRK23(j, damping, old_posns[j], dt);
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-12);
+        }
+
+        // The forward Euler method increases the step by 1%
+        MAKE_PTR(ForwardEulerNumericalMethod<2>, p_fe_method);
+        TS_ASSERT_DELTA(p_fe_method->GetNextTimeStep(dt), 1.01*dt, 1e-12);
+
+        TS_ASSERT_THROWS_THIS(p_rk_method->SetTolerance(0.0), "The tolerance of the RK23 numerical method must be positive.");
+        TS_ASSERT_THROWS_THIS(p_be_method->SetTolerance(-1.0), "The tolerance of the backward Euler numerical method must be positive.");
+        TS_ASSERT_THROWS_THIS(p_be_method->SetMaxIterations(0), "The backward Euler numerical method needs at least one iteration.");
+    }
+
     void TestSettingAndGettingFlags() throw (Exception)
     {
         // Create numerical methods for testing
@@ -58,6 +58,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MeshBasedCellPopulationWithGhostNodes.hpp"
 #include "NumericFileComparison.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "Profiler.hpp"
 #include "WildTypeCellMutationState.hpp"
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "OffLatticeSimulationWithMyStoppingEvent.hpp"
@@ -380,8 +381,16 @@ public:
         MAKE_PTR(ChemotacticForce<2>, p_chemotactic_force);
         simulator.AddForce(p_chemotactic_force);
 
+        Profiler::Reset();
         simulator.Solve();
 
+        // Each force is profiled separately within each time step
+        unsigned num_time_steps = Profiler::GetNumCalls("TimeStep");
+        TS_ASSERT_EQUALS(num_time_steps, 60u);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("TimeStep/Force"), num_time_steps);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("TimeStep/Force/GeneralisedLinearSpringForce-2-2"), num_time_steps);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("TimeStep/Force/ChemotacticForce-2"), num_time_steps);
+
         // Check that the number of nodes is equal to the number of cells
         TS_ASSERT_EQUALS(simulator.rGetCellPopulation().GetNumNodes(), simulator.rGetCellPopulation().GetNumRealCells());
 
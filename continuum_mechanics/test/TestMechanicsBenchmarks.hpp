@@ -0,0 +1,103 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTMECHANICSBENCHMARKS_HPP_
+#define TESTMECHANICSBENCHMARKS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include "UblasCustomFunctions.hpp"
+#include "IncompressibleNonlinearElasticitySolver.hpp"
+#include "MooneyRivlinMaterialLaw.hpp"
+#include "NonlinearElasticityTools.hpp"
+#include "BenchmarkReport.hpp"
+#include "MechanicsEventHandler.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * Benchmark of an incompressible nonlinear elasticity problem (a cube fixed on one
+ * face and deformed by gravity) at several mesh resolutions.
+ *
+ * The results are written to CHASTE_TEST_OUTPUT/MechanicsBenchmarks as JSON, with
+ * the MechanicsEventHandler breakdown of each run, and can be compared against a
+ * stored baseline with python/utils/CompareBenchmarks.py.
+ */
+class TestMechanicsBenchmarks : public CxxTest::TestSuite
+{
+public:
+
+    void TestIncompressibleCubeBenchmark() throw(Exception)
+    {
+        BenchmarkReport report("IncompressibleCube");
+
+        for (unsigned elements_across=2; elements_across<=6; elements_across+=2)
+        {
+            MechanicsEventHandler::Reset();
+
+            report.BeginRun("IncompressibleCube");
+            report.AddParameter("elements_across", elements_across);
+
+            QuadraticMesh<3> mesh;
+            mesh.ConstructRegularSlabMesh(1.0/elements_across, 1.0, 1.0, 1.0);
+
+            MooneyRivlinMaterialLaw<3> law(1.0, 0.5);
+
+            c_vector<double,3> body_force = zero_vector<double>(3);
+            body_force(2) = -0.5;
+
+            std::vector<unsigned> fixed_nodes = NonlinearElasticityTools<3>::GetNodesByComponentValue(mesh, 2, 1.0);
+
+            SolidMechanicsProblemDefinition<3> problem_defn(mesh);
+            problem_defn.SetMaterialLaw(INCOMPRESSIBLE, &law);
+            problem_defn.SetZeroDisplacementNodes(fixed_nodes);
+            problem_defn.SetBodyForce(body_force);
+
+            IncompressibleNonlinearElasticitySolver<3> solver(mesh, problem_defn, "MechanicsBenchmarks/IncompressibleCube");
+            solver.SetWriteOutput(false);
+            solver.Solve();
+
+            report.AddParameter("num_nodes", mesh.GetNumNodes());
+            report.AddParameter("num_newton_iterations", solver.GetNumNewtonIterations());
+            report.AddEventTimes("MechanicsEventHandler", MechanicsEventHandler::Instance());
+            report.EndRun();
+
+            MechanicsEventHandler::Report();
+        }
+
+        report.WriteFile("MechanicsBenchmarks");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 3u);
+    }
+};
+
+#endif /*TESTMECHANICSBENCHMARKS_HPP_*/
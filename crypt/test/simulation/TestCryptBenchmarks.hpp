@@ -0,0 +1,139 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCRYPTBENCHMARKS_HPP_
+#define TESTCRYPTBENCHMARKS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before any other cell_based or crypt headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "BenchmarkReport.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "CryptSimulation2d.hpp"
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
+#include "NagaiHondaForce.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "SimpleWntCellCycleModel.hpp"
+#include "SloughingCellKiller.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "SmartPointers.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * Benchmarks of a 2D vertex model of a colonic crypt at several crypt sizes, as in
+ * Test2DVertexBasedCryptRepresentativeSimulation.
+ *
+ * The results are written to CHASTE_TEST_OUTPUT/CryptBenchmarks as JSON and can be
+ * compared against a stored baseline with python/utils/CompareBenchmarks.py.
+ */
+class TestCryptBenchmarks : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestVertexCryptBenchmark() throw (Exception)
+    {
+        BenchmarkReport report("VertexCrypt");
+
+        for (unsigned crypt_width=6; crypt_width<=18; crypt_width+=6)
+        {
+            SimulationTime::Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+            CellBasedEventHandler::Reset();
+
+            report.BeginRun("VertexCrypt");
+            report.AddParameter("crypt_width", crypt_width);
+
+            unsigned crypt_height = 25;
+            CylindricalHoneycombVertexMeshGenerator generator(crypt_width, crypt_height, true);
+            Cylindrical2dVertexMesh* p_mesh = generator.GetCylindricalMesh();
+
+            // Make crypt shorter for sloughing
+            double crypt_length = 20.0;
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(WildTypeCellMutationState, p_state);
+            MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                SimpleWntCellCycleModel* p_model = new SimpleWntCellCycleModel;
+                p_model->SetDimension(2);
+
+                double birth_time = - RandomNumberGenerator::Instance()->ranf()*
+                                                 ( p_model->GetTransitCellG1Duration()
+                                                    + p_model->GetSG2MDuration() );
+
+                CellPtr p_cell(new Cell(p_state, p_model));
+                p_cell->SetCellProliferativeType(p_transit_type);
+                p_cell->SetBirthTime(birth_time);
+                cells.push_back(p_cell);
+            }
+
+            VertexBasedCellPopulation<2> crypt(*p_mesh, cells);
+
+            WntConcentration<2>::Instance()->SetType(LINEAR);
+            WntConcentration<2>::Instance()->SetCellPopulation(crypt);
+            WntConcentration<2>::Instance()->SetCryptLength(crypt_length);
+
+            CryptSimulation2d simulator(crypt);
+            simulator.SetSamplingTimestepMultiple(500);
+            simulator.SetEndTime(10.0);
+            simulator.SetOutputDirectory("CryptBenchmarks/VertexCrypt");
+
+            MAKE_PTR(NagaiHondaForce<2>, p_nagai_honda_force);
+            simulator.AddForce(p_nagai_honda_force);
+            MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+            simulator.AddSimulationModifier(p_growth_modifier);
+            MAKE_PTR_ARGS(SloughingCellKiller<2>, p_killer, (&crypt, crypt_length));
+            simulator.AddCellKiller(p_killer);
+
+            simulator.Solve();
+
+            report.AddEventTimes("CellBasedEventHandler", CellBasedEventHandler::Instance());
+            report.EndRun();
+
+            WntConcentration<2>::Destroy();
+        }
+
+        report.WriteFile("CryptBenchmarks");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 3u);
+    }
+};
+
+#endif /*TESTCRYPTBENCHMARKS_HPP_*/
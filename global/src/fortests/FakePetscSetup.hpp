@@ -76,7 +76,7 @@ public:
         // Make sure that only one process proceeds into the test itself
         if (my_rank != 0)
         {
-            PETSCEXCEPT(PetscFinalize());
+            PetscSetupUtils::FinalisePetscAndMpi();
             exit(0);
         }
 
@@ -73,11 +73,49 @@ void FpeSignalToAbort(int sig_num, siginfo_t* info, void* context)
 }
 #endif
 
+bool PetscSetupUtils::mMpiInitialisedHere = false;
+
+void PetscSetupUtils::InitialiseMpiAndPetsc(int* pArgc, char*** pArgv)
+{
+    // Full multi-threading support is only requested if asked for, as it may slow down MPI
+    bool request_thread_multiple = false;
+    if (pArgc != NULL && pArgv != NULL)
+    {
+        for (int i=1; i<*pArgc; i++)
+        {
+            if (strcmp((*pArgv)[i], "-mpi_thread_multiple") == 0)
+            {
+                request_thread_multiple = true;
+            }
+        }
+    }
+
+    int mpi_is_initialised;
+    MPI_Initialized(&mpi_is_initialised);
+    if (request_thread_multiple && !mpi_is_initialised)
+    {
+        int provided_thread_level;
+        MPI_Init_thread(pArgc, pArgv, MPI_THREAD_MULTIPLE, &provided_thread_level);
+        mMpiInitialisedHere = true;
+    }
+    PETSCEXCEPT(PetscInitialize(pArgc, pArgv, PETSC_NULL, PETSC_NULL));
+}
+
+void PetscSetupUtils::FinalisePetscAndMpi()
+{
+    PETSCEXCEPT(PetscFinalize());
+    if (mMpiInitialisedHere)
+    {
+        mMpiInitialisedHere = false;
+        MPI_Finalize();
+    }
+}
+
 void PetscSetupUtils::InitialisePetsc()
 {
     // The CommandLineArguments instance is filled in by the cxxtest test suite runner.
     CommandLineArguments* p_args = CommandLineArguments::Instance();
-    PETSCEXCEPT(PetscInitialize(p_args->p_argc, p_args->p_argv, PETSC_NULL, PETSC_NULL));
+    InitialiseMpiAndPetsc(p_args->p_argc, p_args->p_argv);
     // Work around what seems to be an Intel compiler bug/quirk that makes the cache stale,
     // by using an explicit reset to ensure all code is aware we're running in parallel.
     PetscTools::ResetCache();
@@ -124,7 +162,7 @@ void PetscSetupUtils::CommonFinalize()
     // This does nothing if we are on a new PETSc, just allows Chaste to print citations instead in this case
     Citations::Print();
 
-    PETSCEXCEPT(PetscFinalize());
+    FinalisePetscAndMpi();
 }
 
 void PetscSetupUtils::ResetStatusCache()
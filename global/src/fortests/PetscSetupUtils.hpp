@@ -53,6 +53,26 @@ public:
      */
     static void InitialisePetsc();
 
+    /**
+     * Initialise PETSc, which initialises MPI if it has not been already.
+     *
+     * If the command line option -mpi_thread_multiple is given, MPI is first initialised here
+     * requesting MPI_THREAD_MULTIPLE, so that asynchronous HDF5 output may make collective
+     * MPI-IO calls from its I/O thread (see Hdf5DataWriter::SetAsynchronousWriting()).  This is
+     * opt-in, since full multi-threading support can make MPI slower.  The MPI library may
+     * provide a lower thread level, which callers can check with MPI_Query_thread.
+     *
+     * @param pArgc  pointer to the number of command line arguments (may be NULL)
+     * @param pArgv  pointer to the command line arguments (may be NULL)
+     */
+    static void InitialiseMpiAndPetsc(int* pArgc, char*** pArgv);
+
+    /**
+     * Finalise PETSc, and MPI too if it was initialised by InitialiseMpiAndPetsc().
+     * (PETSc only finalises MPI if it initialised it itself.)
+     */
+    static void FinalisePetscAndMpi();
+
     /**
      * Call PetscTools::ResetCache().
      * Used by FakePetscSetup.hpp to ensure the cache doesn't reflect being run in parallel.
@@ -65,6 +85,9 @@ public:
     static void CommonFinalize();
 
 private:
+
+    /** Whether MPI was initialised by InitialiseMpiAndPetsc(), and so must be finalised by us. */
+    static bool mMpiInitialisedHere;
 };
 
 #endif // PETSCSETUPUTILS_HPP_
@@ -0,0 +1,94 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef THREADEDTESTHELPERS_HPP_
+#define THREADEDTESTHELPERS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+/**
+ * Helpers for tests of classes that can use several OpenMP threads (see ThreadTools).
+ *
+ * A test computes its result on one thread, then repeats the calculation for each number of
+ * threads given by GetNumbersOfThreadsToTest() and checks the result has not changed.  In a
+ * build without OpenMP support there are no such numbers, and TS_ASSERT_THROWS_WITHOUT_OPENMP
+ * checks that asking for more threads fails instead.  The threaded code in the test is
+ * compiled either way.
+ */
+class ThreadedTestHelpers
+{
+public:
+
+    /**
+     * @return the numbers of threads, from 2 to maxThreads, at which to repeat a calculation,
+     *     or none if Chaste has not been built with OpenMP support (Chaste_USE_OPENMP)
+     *
+     * @param maxThreads  the largest number of threads to test (defaults to 4)
+     */
+    static std::vector<unsigned> GetNumbersOfThreadsToTest(unsigned maxThreads=4u)
+    {
+        std::vector<unsigned> numbers_of_threads;
+#ifdef CHASTE_OPENMP
+        for (unsigned num_threads=2; num_threads<=maxThreads; num_threads++)
+        {
+            numbers_of_threads.push_back(num_threads);
+        }
+#endif // CHASTE_OPENMP
+        return numbers_of_threads;
+    }
+};
+
+#ifdef CHASTE_OPENMP
+/**
+ * In a build with OpenMP support, does nothing: the statement is not run.
+ *
+ * @param statement  a statement asking for more than one thread
+ * @param task  part of the expected exception message, as passed to ThreadTools::CheckNumberOfThreads()
+ */
+#define TS_ASSERT_THROWS_WITHOUT_OPENMP(statement, task)
+#else
+/**
+ * In a build without OpenMP support, checks that asking for more than one thread throws
+ * the exception from ThreadTools::CheckNumberOfThreads().
+ *
+ * @param statement  a statement asking for more than one thread
+ * @param task  part of the expected exception message, as passed to ThreadTools::CheckNumberOfThreads()
+ */
+#define TS_ASSERT_THROWS_WITHOUT_OPENMP(statement, task) TS_ASSERT_THROWS_CONTAINS(statement, task)
+#endif // CHASTE_OPENMP
+
+#endif /*THREADEDTESTHELPERS_HPP_*/
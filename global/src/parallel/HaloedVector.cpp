@@ -0,0 +1,209 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "HaloedVector.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+
+HaloedVector::HaloedVector()
+    : mSize(0),
+      mLo(0),
+      mHi(0),
+      mHasHalos(false)
+{
+}
+
+HaloedVector::HaloedVector(unsigned size)
+    : mSize(0),
+      mLo(0),
+      mHi(0),
+      mHasHalos(false)
+{
+    Resize(size);
+}
+
+unsigned HaloedVector::GetSize() const
+{
+    return mSize;
+}
+
+unsigned HaloedVector::GetNumStoredEntries() const
+{
+    return mData.size();
+}
+
+bool HaloedVector::HasHalos() const
+{
+    return mHasHalos;
+}
+
+void HaloedVector::Resize(unsigned size)
+{
+    mSize = size;
+    mLo = 0;
+    mHi = size;
+    mData.assign(size, 0.0);
+    mHaloIndices.clear();
+    mSendPositions.clear();
+    mReceivePositions.clear();
+    mHasHalos = false;
+}
+
+void HaloedVector::SetUpHalos(unsigned size, unsigned lo, unsigned hi,
+                              const std::vector<unsigned>& rHaloIndices,
+                              const std::vector<std::vector<unsigned> >& rIndicesToSendPerProcess,
+                              const std::vector<std::vector<unsigned> >& rIndicesToReceivePerProcess)
+{
+    assert(lo <= hi && hi <= size);
+    mSize = size;
+    mLo = lo;
+    mHi = hi;
+    mHaloIndices = rHaloIndices;
+    std::sort(mHaloIndices.begin(), mHaloIndices.end());
+    mHasHalos = true;
+    // Swap rather than assign, so that memory used when storing every entry is released
+    std::vector<double>((hi - lo) + mHaloIndices.size(), 0.0).swap(mData);
+
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    assert(rIndicesToSendPerProcess.size() == num_procs);
+    assert(rIndicesToReceivePerProcess.size() == num_procs);
+    mSendPositions.assign(num_procs, std::vector<unsigned>());
+    mReceivePositions.assign(num_procs, std::vector<unsigned>());
+    for (unsigned proc=0; proc<num_procs; proc++)
+    {
+        for (unsigned i=0; i<rIndicesToSendPerProcess[proc].size(); i++)
+        {
+            const unsigned global_index = rIndicesToSendPerProcess[proc][i];
+            if (global_index < mLo || global_index >= mHi)
+            {
+                EXCEPTION("Index " << global_index << " is sent to another process, but is not owned by this one.");
+            }
+            mSendPositions[proc].push_back(global_index - mLo);
+        }
+        for (unsigned i=0; i<rIndicesToReceivePerProcess[proc].size(); i++)
+        {
+            mReceivePositions[proc].push_back(GetHaloPosition(rIndicesToReceivePerProcess[proc][i]));
+        }
+    }
+}
+
+unsigned HaloedVector::GetHaloPosition(unsigned globalIndex) const
+{
+    std::vector<unsigned>::const_iterator it = std::lower_bound(mHaloIndices.begin(), mHaloIndices.end(), globalIndex);
+    if (it == mHaloIndices.end() || *it != globalIndex)
+    {
+        EXCEPTION("Index " << globalIndex << " is neither owned by this process nor one of its halo entries.");
+    }
+    return (mHi - mLo) + (it - mHaloIndices.begin());
+}
+
+double& HaloedVector::operator[](unsigned globalIndex)
+{
+    assert(globalIndex < mSize);
+    if (globalIndex >= mLo && globalIndex < mHi)
+    {
+        return mData[globalIndex - mLo];
+    }
+    return mData[GetHaloPosition(globalIndex)];
+}
+
+void HaloedVector::Replicate(unsigned lo, unsigned hi)
+{
+    if (PetscTools::IsSequential())
+    {
+        return;
+    }
+
+    if (mHasHalos)
+    {
+        assert(lo == mLo && hi == mHi);
+        ExchangeHalos();
+        return;
+    }
+
+    // Every process stores every entry, so gather everyone's ownership range
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    int my_count = hi - lo;
+    int my_start = lo;
+    std::vector<int> counts(num_procs);
+    std::vector<int> starts(num_procs);
+    MPI_Allgather(&my_count, 1, MPI_INT, &counts[0], 1, MPI_INT, PETSC_COMM_WORLD);
+    MPI_Allgather(&my_start, 1, MPI_INT, &starts[0], 1, MPI_INT, PETSC_COMM_WORLD);
+    if (mSize > 0)
+    {
+        MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                       &mData[0], &counts[0], &starts[0], MPI_DOUBLE, PETSC_COMM_WORLD);
+    }
+}
+
+void HaloedVector::ExchangeHalos()
+{
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    const unsigned my_rank = PetscTools::GetMyRank();
+
+    for (unsigned rank_offset=1; rank_offset<num_procs; rank_offset++)
+    {
+        const unsigned send_to = (my_rank + rank_offset) % num_procs;
+        const unsigned receive_from = (my_rank + num_procs - rank_offset) % num_procs;
+
+        const std::vector<unsigned>& r_send_positions = mSendPositions[send_to];
+        const std::vector<unsigned>& r_receive_positions = mReceivePositions[receive_from];
+
+        // The buffers are never empty, so that taking the address of the first element is valid
+        mSendBuffer.resize(r_send_positions.size() + 1);
+        mReceiveBuffer.resize(r_receive_positions.size() + 1);
+        for (unsigned i=0; i<r_send_positions.size(); i++)
+        {
+            mSendBuffer[i] = mData[r_send_positions[i]];
+        }
+
+        MPI_Status status;
+        int ret = MPI_Sendrecv(&mSendBuffer[0], r_send_positions.size(), MPI_DOUBLE, send_to, 0,
+                               &mReceiveBuffer[0], r_receive_positions.size(), MPI_DOUBLE, receive_from, 0,
+                               PETSC_COMM_WORLD, &status);
+        UNUSED_OPT(ret);
+        assert(ret == MPI_SUCCESS);
+
+        for (unsigned i=0; i<r_receive_positions.size(); i++)
+        {
+            mData[r_receive_positions[i]] = mReceiveBuffer[i];
+        }
+    }
+}
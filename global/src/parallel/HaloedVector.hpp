@@ -0,0 +1,174 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef HALOEDVECTOR_HPP_
+#define HALOEDVECTOR_HPP_
+
+#include <vector>
+
+/**
+ * A vector indexed by global index, of which each process stores only the entries it
+ * owns plus a set of halo entries owned by other processes.
+ *
+ * By default (after Resize) every entry is stored on every process, and Replicate()
+ * behaves just like ReplicatableVector::Replicate().  After SetUpHalos() has been called
+ * only the owned and halo entries are stored, and Replicate() just sends owned entries to
+ * the processes which have them as halos.  This saves both memory and communication when
+ * a process only ever reads values at nodes of the elements it owns, as with the caches
+ * used for state variable interpolation.
+ */
+class HaloedVector
+{
+private:
+
+    /** The global size of the vector. */
+    unsigned mSize;
+
+    /** The first global index stored contiguously at the start of #mData. */
+    unsigned mLo;
+
+    /** One past the last global index stored contiguously at the start of #mData. */
+    unsigned mHi;
+
+    /**
+     * The stored values: entries mLo to mHi-1 in order, followed by the halo entries
+     * in the order of #mHaloIndices.
+     */
+    std::vector<double> mData;
+
+    /** Sorted global indices of the halo entries. Empty unless SetUpHalos has been called. */
+    std::vector<unsigned> mHaloIndices;
+
+    /** Whether SetUpHalos has been called since the last Resize. */
+    bool mHasHalos;
+
+    /** For each process, the positions in #mData of the values to send to it. */
+    std::vector<std::vector<unsigned> > mSendPositions;
+
+    /** For each process, the positions in #mData of the values to receive from it. */
+    std::vector<std::vector<unsigned> > mReceivePositions;
+
+    /** Buffer for outgoing values during Replicate(). */
+    std::vector<double> mSendBuffer;
+
+    /** Buffer for incoming values during Replicate(). */
+    std::vector<double> mReceiveBuffer;
+
+    /**
+     * @return the position of a halo entry in #mData.
+     *
+     * @param globalIndex  the global index of the entry, which must be a halo entry
+     */
+    unsigned GetHaloPosition(unsigned globalIndex) const;
+
+    /** Send owned values to the processes which hold them as halo entries. */
+    void ExchangeHalos();
+
+public:
+
+    /**
+     * Default constructor.
+     * Note that the vector will need to be resized before it can be used.
+     */
+    HaloedVector();
+
+    /**
+     * Constructor to make a vector of given size, with every entry stored on every process.
+     *
+     * @param size the size of the vector
+     */
+    HaloedVector(unsigned size);
+
+    /**
+     * @return the global size of the vector.
+     */
+    unsigned GetSize() const;
+
+    /**
+     * @return the number of entries stored on this process.
+     */
+    unsigned GetNumStoredEntries() const;
+
+    /**
+     * @return whether only owned and halo entries are stored (i.e. SetUpHalos has been called).
+     */
+    bool HasHalos() const;
+
+    /**
+     * Resize the vector, storing every entry on every process.
+     *
+     * @param size  the global size of the vector
+     */
+    void Resize(unsigned size);
+
+    /**
+     * Store only the entries owned by this process and the given halo entries.  This must be
+     * called collectively, and the send and receive lists must match up between processes:
+     * the entries process i sends to process j must be those process j receives from process i,
+     * in the same order.  Stored values are reset to zero.
+     *
+     * @param size  the global size of the vector
+     * @param lo  the start of our ownership range
+     * @param hi  one past the end of our ownership range
+     * @param rHaloIndices  global indices of the entries owned by other processes that we need
+     * @param rIndicesToSendPerProcess  for each process, the owned global indices to send to it
+     * @param rIndicesToReceivePerProcess  for each process, the halo global indices to receive from it
+     */
+    void SetUpHalos(unsigned size, unsigned lo, unsigned hi,
+                    const std::vector<unsigned>& rHaloIndices,
+                    const std::vector<std::vector<unsigned> >& rIndicesToSendPerProcess,
+                    const std::vector<std::vector<unsigned> >& rIndicesToReceivePerProcess);
+
+    /**
+     * Access the vector.  Throws if the entry is not stored on this process.
+     *
+     * @param globalIndex the global index of the entry
+     * @return reference to the entry
+     */
+    double& operator[](unsigned globalIndex);
+
+    /**
+     * Share the owned entries of this vector with the other processes.  If SetUpHalos has been
+     * called, each process receives just its halo entries; otherwise every process receives
+     * every entry.
+     *
+     * @param lo  the start of our ownership range
+     * @param hi  one past the end of our ownership range
+     */
+    void Replicate(unsigned lo, unsigned hi);
+};
+
+#endif /*HALOEDVECTOR_HPP_*/
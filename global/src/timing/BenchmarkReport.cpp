@@ -0,0 +1,279 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BenchmarkReport.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifndef _MSC_VER
+#include <sys/resource.h> // For memory profiling
+#endif //_MSC_VER
+
+#include "Exception.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+#include "Timer.hpp"
+
+BenchmarkReport::BenchmarkReport(const std::string& rName)
+    : mName(rName),
+      mRunStartTime(0.0),
+      mRunStartMemory(0.0),
+      mMemoryPerRun(false)
+{
+}
+
+void BenchmarkReport::BeginRun(const std::string& rRunName)
+{
+    if (!mRunName.empty())
+    {
+        EXCEPTION("The benchmark run '" + mRunName + "' has not ended.");
+    }
+    if (rRunName.empty())
+    {
+        EXCEPTION("A benchmark run must have a name.");
+    }
+    mRunName = rRunName;
+    mParameters.clear();
+    mEventTimes.clear();
+
+    mMemoryPerRun = ResetPeakMemoryUsage();
+    mRunStartMemory = mMemoryPerRun ? GetMemoryUsage() : GetPeakMemoryUsage();
+
+    PetscTools::Barrier("BenchmarkReport::BeginRun");
+    mRunStartTime = Timer::GetWallTime();
+}
+
+void BenchmarkReport::AddParameter(const std::string& rName, double value)
+{
+    if (mRunName.empty())
+    {
+        EXCEPTION("Parameters can only be added to a benchmark run in progress.");
+    }
+    mParameters.push_back(std::make_pair(rName, value));
+}
+
+void BenchmarkReport::AddEventTimes(const std::string& rHandlerName,
+                                    const std::vector<std::string>& rEventNames,
+                                    const std::vector<double>& rEventTimes)
+{
+    if (mRunName.empty())
+    {
+        EXCEPTION("Event times can only be added to a benchmark run in progress.");
+    }
+
+    const unsigned num_procs = PetscTools::IsIsolated() ? 1u : PetscTools::GetNumProcs();
+    std::ostringstream json;
+    json << std::setprecision(10) << "{";
+    for (unsigned event=0; event<rEventNames.size(); event++)
+    {
+        double max_time = ReduceOverProcesses(rEventTimes[event], true);
+        double mean_time = ReduceOverProcesses(rEventTimes[event], false)/num_procs;
+        json << (event == 0 ? "" : ", ") << Quote(rEventNames[event])
+             << ": {\"max\": " << max_time << ", \"mean\": " << mean_time << "}";
+    }
+    json << "}";
+    mEventTimes.push_back(std::make_pair(rHandlerName, json.str()));
+}
+
+void BenchmarkReport::EndRun()
+{
+    if (mRunName.empty())
+    {
+        EXCEPTION("There is no benchmark run in progress.");
+    }
+    double wall_time = ReduceOverProcesses(Timer::GetWallTime() - mRunStartTime, true);
+    double local_peak_memory = GetPeakMemoryUsage();
+    double peak_memory = ReduceOverProcesses(local_peak_memory, true);
+    double memory_increase = ReduceOverProcesses(std::max(0.0, local_peak_memory - mRunStartMemory), true);
+    bool memory_per_run = (ReduceOverProcesses(mMemoryPerRun ? 0.0 : 1.0, true) == 0.0);
+
+    std::ostringstream json;
+    json << std::setprecision(10);
+    json << "    {\n";
+    json << "      \"name\": " << Quote(mRunName) << ",\n";
+    json << "      \"parameters\": {";
+    for (unsigned i=0; i<mParameters.size(); i++)
+    {
+        json << (i == 0 ? "" : ", ") << Quote(mParameters[i].first) << ": " << mParameters[i].second;
+    }
+    json << "},\n";
+    json << "      \"num_processes\": " << (PetscTools::IsIsolated() ? 1u : PetscTools::GetNumProcs()) << ",\n";
+    json << "      \"wall_time\": " << wall_time << ",\n";
+    json << "      \"peak_memory\": " << peak_memory << ",\n";
+    json << "      \"memory_increase\": " << memory_increase << ",\n";
+    json << "      \"memory_per_run\": " << (memory_per_run ? "true" : "false") << ",\n";
+    json << "      \"events\": {";
+    for (unsigned i=0; i<mEventTimes.size(); i++)
+    {
+        json << (i == 0 ? "\n" : ",\n") << "        " << Quote(mEventTimes[i].first) << ": " << mEventTimes[i].second;
+    }
+    json << (mEventTimes.empty() ? "" : "\n      ") << "}\n";
+    json << "    }";
+    mRuns.push_back(json.str());
+
+    mRunName.clear();
+}
+
+unsigned BenchmarkReport::GetNumRuns() const
+{
+    return mRuns.size();
+}
+
+std::string BenchmarkReport::GetJson() const
+{
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"benchmark\": " << Quote(mName) << ",\n";
+    json << "  \"runs\": [";
+    for (unsigned i=0; i<mRuns.size(); i++)
+    {
+        json << (i == 0 ? "\n" : ",\n") << mRuns[i];
+    }
+    json << (mRuns.empty() ? "" : "\n  ") << "]\n";
+    json << "}\n";
+    return json.str();
+}
+
+void BenchmarkReport::WriteFile(const std::string& rDirectory) const
+{
+    OutputFileHandler handler(rDirectory, false);
+    if (PetscTools::AmMaster())
+    {
+        out_stream p_file = handler.OpenOutputFile(mName + ".json");
+        (*p_file) << GetJson();
+        p_file->close();
+    }
+    PetscTools::Barrier("BenchmarkReport::WriteFile");
+}
+
+double BenchmarkReport::GetPeakMemoryUsage()
+{
+    double peak_memory = 0.0;
+#ifdef __linux__
+    // The high water mark in /proc is the one reset by ResetPeakMemoryUsage()
+    peak_memory = GetProcStatusMemory("VmHWM:");
+    if (peak_memory > 0.0)
+    {
+        return peak_memory;
+    }
+#endif // __linux__
+#ifndef _MSC_VER
+    struct rusage rusage;
+    getrusage(RUSAGE_SELF, &rusage);
+#ifdef __APPLE__
+    peak_memory = double(rusage.ru_maxrss)/(1024.0*1024.0); // Bytes on Mac OS X
+#else
+    peak_memory = double(rusage.ru_maxrss)/1024.0; // Kilobytes on Linux
+#endif // __APPLE__
+#endif //_MSC_VER
+    return peak_memory;
+}
+
+double BenchmarkReport::GetMemoryUsage()
+{
+    return GetProcStatusMemory("VmRSS:");
+}
+
+double BenchmarkReport::GetProcStatusMemory(const std::string& rField)
+{
+    double memory = 0.0;
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, rField.size(), rField) == 0)
+        {
+            memory = atof(line.c_str() + rField.size())/1024.0; // Kilobytes
+            break;
+        }
+    }
+#endif // __linux__
+    return memory;
+}
+
+bool BenchmarkReport::ResetPeakMemoryUsage()
+{
+    bool reset = false;
+#ifdef __linux__
+    // Writing 5 resets the peak resident set size (Linux 4.0 onwards)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs.is_open())
+    {
+        clear_refs << "5";
+        clear_refs.close();
+        reset = clear_refs.good();
+    }
+#endif // __linux__
+    return reset;
+}
+
+double BenchmarkReport::ReduceOverProcesses(double value, bool maximum)
+{
+    double result = value;
+    if (PetscTools::IsParallel() && !PetscTools::IsIsolated())
+    {
+        MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, maximum ? MPI_MAX : MPI_SUM, PetscTools::GetWorld());
+    }
+    return result;
+}
+
+std::string BenchmarkReport::Quote(const std::string& rString)
+{
+    std::string quoted = "\"";
+    for (unsigned i=0; i<rString.size(); i++)
+    {
+        const char c = rString[i];
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if (c == '\n')
+        {
+            quoted += "\\n";
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    quoted += "\"";
+    return quoted;
+}
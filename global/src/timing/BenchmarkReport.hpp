@@ -0,0 +1,227 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BENCHMARKREPORT_HPP_
+#define BENCHMARKREPORT_HPP_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GenericEventHandler.hpp"
+
+/**
+ * Collects the results of benchmark runs and writes them to a JSON file, so that
+ * performance can be tracked across commits (see python/utils/CompareBenchmarks.py).
+ *
+ * Each run records its name and problem size parameters, the number of processes,
+ * its wall time, its memory use and the times of the events of any
+ * GenericEventHandler subclasses, e.g.
+ *
+ *     BenchmarkReport report("CellBasedBenchmarks");
+ *     report.BeginRun("NodeBased3d");
+ *     report.AddParameter("num_cells", num_cells);
+ *     // ... run the simulation ...
+ *     report.AddEventTimes("CellBasedEventHandler", CellBasedEventHandler::Instance());
+ *     report.EndRun();
+ *     report.WriteFile("CellBasedBenchmarks");
+ *
+ * Times and memory use are the maximum over all processes; event times also include
+ * the mean.  Apart from the constructor, all the methods must be called collectively.
+ *
+ * Since several runs usually share a process, the memory use is measured per run:
+ * "peak_memory" is the peak resident set size during the run and "memory_increase" is
+ * how far it rose above the resident set size when the run began.  This relies on
+ * BeginRun() resetting the peak with ResetPeakMemoryUsage(), which is only possible on
+ * Linux.  Elsewhere "peak_memory" is the peak over the life of the process, and
+ * "memory_increase" is how much that grew during the run, so a run which uses less
+ * memory than an earlier run in the same process records no increase; the JSON field
+ * "memory_per_run" says which of these applies.
+ */
+class BenchmarkReport
+{
+private:
+
+    /** The name of the benchmark, used as the name of the JSON file. */
+    std::string mName;
+
+    /** The JSON objects describing the completed runs. */
+    std::vector<std::string> mRuns;
+
+    /** The name of the run in progress; empty if there is none. */
+    std::string mRunName;
+
+    /** The parameters of the run in progress. */
+    std::vector<std::pair<std::string, double> > mParameters;
+
+    /** The JSON objects describing the event times of the run in progress, one per event handler. */
+    std::vector<std::pair<std::string, std::string> > mEventTimes;
+
+    /** The wall time at which the run in progress began. */
+    double mRunStartTime;
+
+    /**
+     * The memory use (in megabytes) from which the memory increase of the run in progress is
+     * measured: the resident set size when it began if mMemoryPerRun, and otherwise the peak
+     * resident set size of this process when it began.
+     */
+    double mRunStartMemory;
+
+    /** Whether the peak memory use was reset when the run in progress began. */
+    bool mMemoryPerRun;
+
+    /**
+     * Add the event times of an event handler to the run in progress.
+     *
+     * @param rHandlerName  the name of the event handler
+     * @param rEventNames  the names of its events
+     * @param rEventTimes  the time (in milliseconds) of each event on this process
+     */
+    void AddEventTimes(const std::string& rHandlerName,
+                       const std::vector<std::string>& rEventNames,
+                       const std::vector<double>& rEventTimes);
+
+    /**
+     * @return the maximum or sum of a value over all processes.
+     *
+     * @param value  the value on this process
+     * @param maximum  whether to take the maximum, rather than the sum
+     */
+    static double ReduceOverProcesses(double value, bool maximum);
+
+    /**
+     * @return a memory use from /proc/self/status, in megabytes (or zero if it can't be read).
+     *
+     * @param rField  the field, e.g. "VmRSS:"
+     */
+    static double GetProcStatusMemory(const std::string& rField);
+
+    /**
+     * @return a string as a JSON string literal.
+     *
+     * @param rString  the string
+     */
+    static std::string Quote(const std::string& rString);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rName  the name of the benchmark
+     */
+    BenchmarkReport(const std::string& rName);
+
+    /**
+     * Begin a run, which ends with EndRun().
+     *
+     * @param rRunName  the name of the run, which together with its parameters and the
+     *     number of processes identifies it when comparing results
+     */
+    void BeginRun(const std::string& rRunName);
+
+    /**
+     * Record a parameter, such as the problem size, of the run in progress.
+     *
+     * @param rName  the name of the parameter
+     * @param value  its value
+     */
+    void AddParameter(const std::string& rName, double value);
+
+    /**
+     * Record the times of the events of an event handler in the run in progress.  This
+     * must be called before the handler is reset (note that Report() resets it).
+     *
+     * @param rHandlerName  the name of the event handler
+     * @param pHandler  the event handler, e.g. HeartEventHandler::Instance()
+     */
+    template<unsigned NUM_EVENTS, class CONCRETE>
+    void AddEventTimes(const std::string& rHandlerName, GenericEventHandler<NUM_EVENTS, CONCRETE>* pHandler)
+    {
+        std::vector<std::string> event_names(NUM_EVENTS);
+        std::vector<double> event_times(NUM_EVENTS);
+        for (unsigned event=0; event<NUM_EVENTS; event++)
+        {
+            event_names[event] = CONCRETE::EventName[event];
+            event_times[event] = pHandler->GetElapsedTime(event);
+        }
+        AddEventTimes(rHandlerName, event_names, event_times);
+    }
+
+    /**
+     * End the run in progress, recording its wall time and memory use.
+     */
+    void EndRun();
+
+    /**
+     * @return the number of completed runs.
+     */
+    unsigned GetNumRuns() const;
+
+    /**
+     * @return the JSON document describing the completed runs.
+     */
+    std::string GetJson() const;
+
+    /**
+     * Write the JSON document describing the completed runs to the file
+     * <name>.json in the given output directory.
+     *
+     * @param rDirectory  the output directory, relative to CHASTE_TEST_OUTPUT
+     */
+    void WriteFile(const std::string& rDirectory) const;
+
+    /**
+     * @return the peak resident set size of this process since it started or since
+     * ResetPeakMemoryUsage() was last called, in megabytes (or zero if this can't be
+     * determined on this platform).
+     */
+    static double GetPeakMemoryUsage();
+
+    /**
+     * @return the current resident set size of this process, in megabytes (or zero if
+     * this can't be determined on this platform).
+     */
+    static double GetMemoryUsage();
+
+    /**
+     * Reset the peak resident set size of this process to its current resident set size.
+     *
+     * @return whether this was possible (it is on Linux, through /proc/self/clear_refs)
+     */
+    static bool ResetPeakMemoryUsage();
+};
+
+#endif /*BENCHMARKREPORT_HPP_*/
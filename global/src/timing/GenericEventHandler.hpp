@@ -36,8 +36,13 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef GENERICEVENTHANDLER_HPP_
 #define GENERICEVENTHANDLER_HPP_
 
+#include <algorithm>
 #include <cassert>
+#include <cfloat>
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "Exception.hpp"
 #include "PetscTools.hpp"
@@ -68,19 +73,28 @@ private:
     bool mEnabled; /**< Whether the event handler is recording event times */
     bool mInUse; /**< Determines if any of the event have begun */
 
+    /**
+     * Wall time assigned to each thread within each event, for events whose work is
+     * shared between threads (see AddThreadTime).  Empty for events without thread data.
+     */
+    std::vector<std::vector<double> > mThreadWallTime;
+
     /**
      * Sleep for a specified number of milliseconds.
      * Used in testing.
-     * Ought to be more portable than sleep() or usleep().
+     * Ought to be more portable than sleep() or usleep(), and yields the processor
+     * rather than busy-waiting.
      *
      * @param milliseconds  minimum number of milliseconds for which to sleep (ought to be a multiple of 10)
      */
     static inline void MilliSleep(unsigned milliseconds)
     {
         double min_Wtime = milliseconds/1000.0 + Timer::GetElapsedTime();
-        while (Timer::GetElapsedTime() < min_Wtime)
+        double remaining;
+        while ((remaining = min_Wtime - Timer::GetElapsedTime()) > 0.0)
         {
-            //pause;
+            // Loop in case the sleep ends early according to the timer's clock
+            std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
         }
     }
 
@@ -157,6 +171,33 @@ public:
         return Instance()->GetElapsedTimeImpl(event);
     }
 
+    /**
+     * Add to the time spent by a single thread on the given event.
+     *
+     * This is used by code which shares the work of an event between threads, so that
+     * load imbalance between the threads can be seen in the report.  It does not affect
+     * the wall time recorded for the event itself.  Must not be called concurrently.
+     *
+     * @param event  the index of an event (this must be less than NUM_EVENTS)
+     * @param thread  the index of the thread
+     * @param wallTime  the wall time (in seconds) spent by this thread
+     */
+    static void AddThreadTime(unsigned event, unsigned thread, double wallTime)
+    {
+        Instance()->AddThreadTimeImpl(event, thread, wallTime);
+    }
+
+    /**
+     * @return The time (in milliseconds) accounted so far to each thread for the given event.
+     * Empty if no thread times have been recorded for this event.
+     *
+     * @param event  the index of an event (this must be less than NUM_EVENTS)
+     */
+    static std::vector<double> GetThreadTimes(unsigned event)
+    {
+        return Instance()->GetThreadTimesImpl(event);
+    }
+
     /**
      * Print a report on the timed events and reset the handler.
      *
@@ -211,6 +252,7 @@ protected:
         mInUse = false;
         mWallTime.resize(NUM_EVENTS, 0.0);
         mHasBegun.resize(NUM_EVENTS, false);
+        mThreadWallTime.resize(NUM_EVENTS);
     }
 
 private:
@@ -224,6 +266,7 @@ private:
         {
             mWallTime[event] = 0.0;
             mHasBegun[event] = false;
+            mThreadWallTime[event].clear();
         }
         Enable();
         mInUse = false;
@@ -323,6 +366,43 @@ private:
         return ConvertWallTimeToMilliseconds(time);
     }
 
+    /**
+     * Add to the time spent by a single thread on the given event.
+     *
+     * @param event  the index of an event (this must be less than NUM_EVENTS)
+     * @param thread  the index of the thread
+     * @param wallTime  the wall time (in seconds) spent by this thread
+     */
+    void AddThreadTimeImpl(unsigned event, unsigned thread, double wallTime)
+    {
+        assert(event<NUM_EVENTS);
+        if (!mEnabled)
+        {
+            return;
+        }
+        if (thread >= mThreadWallTime[event].size())
+        {
+            mThreadWallTime[event].resize(thread+1, 0.0);
+        }
+        mThreadWallTime[event][thread] += wallTime;
+    }
+
+    /**
+     * @return The time (in milliseconds) accounted so far to each thread for the given event.
+     *
+     * @param event  the index of an event (this must be less than NUM_EVENTS)
+     */
+    std::vector<double> GetThreadTimesImpl(unsigned event)
+    {
+        assert(event<NUM_EVENTS);
+        std::vector<double> times(mThreadWallTime[event].size());
+        for (unsigned thread=0; thread<times.size(); thread++)
+        {
+            times[thread] = ConvertWallTimeToMilliseconds(mThreadWallTime[event][thread]);
+        }
+        return times;
+    }
+
     /**
      * Print a report on the timed events and reset the handler.
      *
@@ -383,6 +463,36 @@ private:
                 printf("(%3.0f%%)  ", total == 0.0 ? 0.0 : (secs/total*100.0));
             }
             std::cout << "(seconds) \n";
+
+            // Report load balance for any events whose work was shared between threads
+            for (unsigned event=0; event<NUM_EVENTS; event++)
+            {
+                const std::vector<double>& r_thread_times = mThreadWallTime[event];
+                if (!r_thread_times.empty())
+                {
+                    double min_secs = DBL_MAX;
+                    double max_secs = 0.0;
+                    double sum_secs = 0.0;
+                    for (unsigned thread=0; thread<r_thread_times.size(); thread++)
+                    {
+                        const double secs = ConvertWallTimeToSeconds(r_thread_times[thread]);
+                        min_secs = std::min(min_secs, secs);
+                        max_secs = std::max(max_secs, secs);
+                        sum_secs += secs;
+                    }
+                    if (PetscTools::IsParallel())
+                    {
+                        printf("%3u: ", PetscTools::GetMyRank());
+                    }
+                    printf("%s over %u threads: min ", CONCRETE::EventName[event], (unsigned)r_thread_times.size());
+                    printf(format, min_secs);
+                    printf("avg ");
+                    printf(format, sum_secs/r_thread_times.size());
+                    printf("max ");
+                    printf(format, max_secs);
+                    std::cout << "(seconds) \n";
+                }
+            }
         }
         PetscTools::EndRoundRobin();
 
@@ -0,0 +1,540 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+#include "Timer.hpp"
+
+bool Profiler::msEnabled = true;
+
+namespace
+{
+    /**
+     * @return a string as a JSON string literal.
+     *
+     * @param rString  the string
+     */
+    std::string QuoteJson(const std::string& rString)
+    {
+        std::string quoted = "\"";
+        for (unsigned i=0; i<rString.size(); i++)
+        {
+            if (rString[i] == '"' || rString[i] == '\\')
+            {
+                quoted += '\\';
+            }
+            quoted += rString[i];
+        }
+        return quoted + "\"";
+    }
+}
+
+void Profiler::Enable()
+{
+    msEnabled = true;
+}
+
+void Profiler::Disable()
+{
+    msEnabled = false;
+}
+
+void Profiler::EnableTracing(unsigned maxEventsPerThread)
+{
+    ProfilerData& r_data = rGetData();
+    r_data.mTracing = true;
+    r_data.mMaxTraceEventsPerThread = maxEventsPerThread;
+}
+
+void Profiler::DisableTracing()
+{
+    rGetData().mTracing = false;
+}
+
+void Profiler::Reset()
+{
+    ProfilerData& r_data = rGetData();
+    for (unsigned thread=0; thread<r_data.mThreadData.size(); thread++)
+    {
+        ThreadData& r_thread_data = r_data.mThreadData[thread];
+        r_thread_data.mNodes.resize(1);
+        r_thread_data.mNodes[0].mChildren.clear();
+        r_thread_data.mCurrentNode = 0;
+        r_thread_data.mTraceEvents.clear();
+        r_thread_data.mNumDroppedTraceEvents = 0;
+    }
+    r_data.mStartTime = Timer::GetWallTime();
+}
+
+unsigned Profiler::GetRegionId(const std::string& rName)
+{
+    ProfilerData& r_data = rGetData();
+    unsigned region_id;
+#ifdef CHASTE_OPENMP
+#pragma omp critical(ProfilerRegions)
+#endif
+    {
+        std::map<std::string, unsigned>::iterator it = r_data.mRegionIds.find(rName);
+        if (it == r_data.mRegionIds.end())
+        {
+            region_id = r_data.mRegionNames.size();
+            r_data.mRegionNames.push_back(rName);
+            r_data.mRegionIds[rName] = region_id;
+        }
+        else
+        {
+            region_id = it->second;
+        }
+    }
+    return region_id;
+}
+
+unsigned Profiler::GetRegionId(const Identifiable& rObject)
+{
+    ProfilerData& r_data = rGetData();
+    const std::type_info* p_type = &typeid(rObject);
+    unsigned region_id = UNSIGNED_UNSET;
+#ifdef CHASTE_OPENMP
+#pragma omp critical(ProfilerTypes)
+#endif
+    {
+        std::map<const std::type_info*, unsigned>::iterator it = r_data.mTypeRegionIds.find(p_type);
+        if (it != r_data.mTypeRegionIds.end())
+        {
+            region_id = it->second;
+        }
+    }
+    if (region_id == UNSIGNED_UNSET)
+    {
+        // Computing the identifier is relatively expensive, so is only done once per type
+        region_id = GetRegionId(rObject.GetIdentifier());
+#ifdef CHASTE_OPENMP
+#pragma omp critical(ProfilerTypes)
+#endif
+        {
+            r_data.mTypeRegionIds[p_type] = region_id;
+        }
+    }
+    return region_id;
+}
+
+std::string Profiler::GetRegionName(unsigned regionId)
+{
+    ProfilerData& r_data = rGetData();
+    std::string name;
+#ifdef CHASTE_OPENMP
+#pragma omp critical(ProfilerRegions)
+#endif
+    {
+        assert(regionId < r_data.mRegionNames.size());
+        name = r_data.mRegionNames[regionId];
+    }
+    return name;
+}
+
+std::vector<std::string> Profiler::GetRegionPaths(unsigned thread)
+{
+    std::vector<std::string> paths;
+    ProfilerData& r_data = rGetData();
+    if (thread < r_data.mThreadData.size())
+    {
+        const ThreadData& r_thread_data = r_data.mThreadData[thread];
+        for (unsigned node=1; node<r_thread_data.mNodes.size(); node++)
+        {
+            paths.push_back(GetPath(r_thread_data, node));
+        }
+    }
+    return paths;
+}
+
+unsigned Profiler::GetNumCalls(const std::string& rPath, unsigned thread)
+{
+    unsigned node = FindNode(rPath, thread);
+    return (node == UNSIGNED_UNSET) ? 0u : rGetData().mThreadData[thread].mNodes[node].mNumCalls;
+}
+
+double Profiler::GetTotalTime(const std::string& rPath, unsigned thread)
+{
+    unsigned node = FindNode(rPath, thread);
+    return (node == UNSIGNED_UNSET) ? 0.0 : 1000.0*rGetData().mThreadData[thread].mNodes[node].mTotalTime;
+}
+
+std::vector<unsigned> Profiler::GetCallHistogram(const std::string& rPath, unsigned thread)
+{
+    std::vector<unsigned> histogram(NUM_HISTOGRAM_BINS, 0u);
+    unsigned node = FindNode(rPath, thread);
+    if (node != UNSIGNED_UNSET)
+    {
+        const RegionNode& r_node = rGetData().mThreadData[thread].mNodes[node];
+        std::copy(r_node.mHistogram, r_node.mHistogram + NUM_HISTOGRAM_BINS, histogram.begin());
+    }
+    return histogram;
+}
+
+unsigned Profiler::GetNumDroppedTraceEvents()
+{
+    unsigned num_dropped = 0;
+    ProfilerData& r_data = rGetData();
+    for (unsigned thread=0; thread<r_data.mThreadData.size(); thread++)
+    {
+        num_dropped += r_data.mThreadData[thread].mNumDroppedTraceEvents;
+    }
+    return num_dropped;
+}
+
+void Profiler::Report()
+{
+    // Combine the threads of this process: calls are summed and the time is the maximum
+    ProfilerData& r_data = rGetData();
+    std::map<std::string, std::pair<unsigned, double> > local_stats;
+    for (unsigned thread=0; thread<r_data.mThreadData.size(); thread++)
+    {
+        const ThreadData& r_thread_data = r_data.mThreadData[thread];
+        for (unsigned node=1; node<r_thread_data.mNodes.size(); node++)
+        {
+            std::pair<unsigned, double>& r_stats = local_stats[GetPath(r_thread_data, node)];
+            r_stats.first += r_thread_data.mNodes[node].mNumCalls;
+            r_stats.second = std::max(r_stats.second, r_thread_data.mNodes[node].mTotalTime);
+        }
+    }
+
+    std::ostringstream local_summary;
+    local_summary << std::setprecision(17);
+    for (std::map<std::string, std::pair<unsigned, double> >::iterator it = local_stats.begin();
+         it != local_stats.end();
+         ++it)
+    {
+        local_summary << it->first << '\t' << it->second.first << '\t' << it->second.second << '\n';
+    }
+    std::vector<std::string> summaries = GatherOnMaster(local_summary.str());
+
+    if (PetscTools::AmMaster())
+    {
+        // The calls and times of each path on each process
+        const unsigned num_procs = summaries.size();
+        std::map<std::string, std::pair<unsigned, std::vector<double> > > stats;
+        for (unsigned proc=0; proc<num_procs; proc++)
+        {
+            std::istringstream summary(summaries[proc]);
+            std::string line;
+            while (std::getline(summary, line))
+            {
+                std::string::size_type tab1 = line.find('\t');
+                std::string::size_type tab2 = line.find('\t', tab1+1);
+                std::pair<unsigned, std::vector<double> >& r_stats = stats[line.substr(0, tab1)];
+                r_stats.second.resize(num_procs, 0.0);
+                r_stats.first += atoi(line.substr(tab1+1, tab2-tab1-1).c_str());
+                r_stats.second[proc] = atof(line.substr(tab2+1).c_str());
+            }
+        }
+
+        printf("%-60s %10s %12s %12s %12s\n", "Region", "Calls", "Min (s)", "Mean (s)", "Max (s)");
+        for (std::map<std::string, std::pair<unsigned, std::vector<double> > >::iterator it = stats.begin();
+             it != stats.end();
+             ++it)
+        {
+            const std::vector<double>& r_times = it->second.second;
+            double min_time = DBL_MAX;
+            double max_time = 0.0;
+            double sum_time = 0.0;
+            for (unsigned proc=0; proc<num_procs; proc++)
+            {
+                min_time = std::min(min_time, r_times[proc]);
+                max_time = std::max(max_time, r_times[proc]);
+                sum_time += r_times[proc];
+            }
+            printf("%-60s %10u %12.6f %12.6f %12.6f\n", it->first.c_str(), it->second.first,
+                   min_time, sum_time/num_procs, max_time);
+        }
+        std::cout.flush();
+    }
+    PetscTools::Barrier("Profiler::Report");
+}
+
+void Profiler::WriteTrace(const std::string& rDirectory, const std::string& rFileName)
+{
+    // Times in the trace event format are in microseconds
+    ProfilerData& r_data = rGetData();
+    const unsigned rank = PetscTools::GetMyRank();
+    std::ostringstream local_events;
+    local_events << std::fixed << std::setprecision(3);
+    local_events << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << rank
+                 << ", \"args\": {\"name\": \"Process " << rank << "\"}}";
+    for (unsigned thread=0; thread<r_data.mThreadData.size(); thread++)
+    {
+        const std::vector<TraceEvent>& r_events = r_data.mThreadData[thread].mTraceEvents;
+        for (unsigned i=0; i<r_events.size(); i++)
+        {
+            local_events << ",\n{\"name\": " << QuoteJson(GetRegionName(r_events[i].mRegionId))
+                         << ", \"ph\": \"X\", \"pid\": " << rank << ", \"tid\": " << thread
+                         << ", \"ts\": " << 1e6*(r_events[i].mStartTime - r_data.mStartTime)
+                         << ", \"dur\": " << 1e6*r_events[i].mDuration << "}";
+        }
+    }
+    std::vector<std::string> events = GatherOnMaster(local_events.str());
+
+    OutputFileHandler handler(rDirectory, false);
+    if (PetscTools::AmMaster())
+    {
+        out_stream p_file = handler.OpenOutputFile(rFileName);
+        (*p_file) << "{\"traceEvents\": [\n";
+        for (unsigned proc=0; proc<events.size(); proc++)
+        {
+            (*p_file) << (proc == 0 ? "" : ",\n") << events[proc];
+        }
+        (*p_file) << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+        p_file->close();
+    }
+    PetscTools::Barrier("Profiler::WriteTrace");
+}
+
+double Profiler::BeginRegion(unsigned regionId)
+{
+    ThreadData& r_thread_data = rGetThreadData();
+    std::vector<RegionNode>& r_nodes = r_thread_data.mNodes;
+    const unsigned parent = r_thread_data.mCurrentNode;
+
+    // Find the node for this region below the current one, adding it if this path is new
+    unsigned node = UNSIGNED_UNSET;
+    const std::vector<unsigned>& r_children = r_nodes[parent].mChildren;
+    for (unsigned i=0; i<r_children.size(); i++)
+    {
+        if (r_nodes[r_children[i]].mRegionId == regionId)
+        {
+            node = r_children[i];
+            break;
+        }
+    }
+    if (node == UNSIGNED_UNSET)
+    {
+        node = r_nodes.size();
+        r_nodes.push_back(RegionNode());
+        r_nodes[node].mRegionId = regionId;
+        r_nodes[node].mParent = parent;
+        r_nodes[node].mNumCalls = 0;
+        r_nodes[node].mTotalTime = 0.0;
+        std::fill(r_nodes[node].mHistogram, r_nodes[node].mHistogram + NUM_HISTOGRAM_BINS, 0u);
+        r_nodes[parent].mChildren.push_back(node);
+    }
+    r_thread_data.mCurrentNode = node;
+
+    return Timer::GetWallTime();
+}
+
+void Profiler::EndRegion(double startTime)
+{
+    const double duration = Timer::GetWallTime() - startTime;
+
+    ProfilerData& r_data = rGetData();
+    ThreadData& r_thread_data = rGetThreadData();
+    RegionNode& r_node = r_thread_data.mNodes[r_thread_data.mCurrentNode];
+    r_node.mNumCalls++;
+    r_node.mTotalTime += duration;
+
+    // Bin i (for i>0) holds durations in [2^(i-1), 2^i) microseconds, which frexp gives cheaply
+    const double microseconds = 1e6*duration;
+    unsigned bin = 0;
+    if (microseconds >= 1.0)
+    {
+        int exponent;
+        frexp(microseconds, &exponent);
+        bin = std::min((unsigned)exponent, NUM_HISTOGRAM_BINS-1);
+    }
+    r_node.mHistogram[bin]++;
+
+    if (r_data.mTracing)
+    {
+        if (r_thread_data.mTraceEvents.size() < r_data.mMaxTraceEventsPerThread)
+        {
+            TraceEvent event;
+            event.mRegionId = r_node.mRegionId;
+            event.mStartTime = startTime;
+            event.mDuration = duration;
+            r_thread_data.mTraceEvents.push_back(event);
+        }
+        else
+        {
+            r_thread_data.mNumDroppedTraceEvents++;
+        }
+    }
+
+    r_thread_data.mCurrentNode = r_node.mParent;
+}
+
+Profiler::ProfilerData& Profiler::rGetData()
+{
+    static ProfilerData data;
+    return data;
+}
+
+Profiler::ThreadData& Profiler::rGetThreadData()
+{
+    static thread_local ThreadData* p_thread_data = nullptr;
+    if (p_thread_data == nullptr)
+    {
+        ProfilerData& r_data = rGetData();
+#ifdef CHASTE_OPENMP
+#pragma omp critical(ProfilerThreads)
+#endif
+        {
+            r_data.mThreadData.push_back(ThreadData());
+            p_thread_data = &(r_data.mThreadData.back());
+        }
+        p_thread_data->mNodes.resize(1);
+        p_thread_data->mNodes[0].mRegionId = UNSIGNED_UNSET;
+        p_thread_data->mNodes[0].mParent = UNSIGNED_UNSET;
+        p_thread_data->mCurrentNode = 0;
+        p_thread_data->mNumDroppedTraceEvents = 0;
+    }
+    return *p_thread_data;
+}
+
+Profiler::ProfilerData::ProfilerData()
+    : mTracing(false),
+      mMaxTraceEventsPerThread(0),
+      mStartTime(Timer::GetWallTime())
+{
+}
+
+unsigned Profiler::FindNode(const std::string& rPath, unsigned thread)
+{
+    ProfilerData& r_data = rGetData();
+    if (thread >= r_data.mThreadData.size())
+    {
+        return UNSIGNED_UNSET;
+    }
+    const ThreadData& r_thread_data = r_data.mThreadData[thread];
+    for (unsigned node=1; node<r_thread_data.mNodes.size(); node++)
+    {
+        if (GetPath(r_thread_data, node) == rPath)
+        {
+            return node;
+        }
+    }
+    return UNSIGNED_UNSET;
+}
+
+std::string Profiler::GetPath(const ThreadData& rThreadData, unsigned node)
+{
+    std::string path = GetRegionName(rThreadData.mNodes[node].mRegionId);
+    for (unsigned parent = rThreadData.mNodes[node].mParent; parent != 0; parent = rThreadData.mNodes[parent].mParent)
+    {
+        path = GetRegionName(rThreadData.mNodes[parent].mRegionId) + "/" + path;
+    }
+    return path;
+}
+
+std::vector<std::string> Profiler::GatherOnMaster(const std::string& rString)
+{
+    std::vector<std::string> strings;
+    if (!PetscTools::IsParallel() || PetscTools::IsIsolated())
+    {
+        strings.push_back(rString);
+        return strings;
+    }
+
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    int length = rString.size();
+    std::vector<int> lengths(num_procs);
+    MPI_Gather(&length, 1, MPI_INT, &lengths[0], 1, MPI_INT, 0, PetscTools::GetWorld());
+
+    std::vector<int> offsets(num_procs, 0);
+    for (unsigned proc=1; proc<num_procs; proc++)
+    {
+        offsets[proc] = offsets[proc-1] + lengths[proc-1];
+    }
+    std::vector<char> buffer(PetscTools::AmMaster() ? offsets[num_procs-1] + lengths[num_procs-1] + 1 : 1);
+    MPI_Gatherv(const_cast<char*>(rString.data()), length, MPI_CHAR,
+                &buffer[0], &lengths[0], &offsets[0], MPI_CHAR, 0, PetscTools::GetWorld());
+
+    if (PetscTools::AmMaster())
+    {
+        for (unsigned proc=0; proc<num_procs; proc++)
+        {
+            strings.push_back(std::string(&buffer[offsets[proc]], lengths[proc]));
+        }
+    }
+    return strings;
+}
+
+ProfilerScope::ProfilerScope(unsigned regionId)
+    : mActive(Profiler::IsEnabled()),
+      mStartTime(0.0)
+{
+    if (mActive)
+    {
+        mStartTime = Profiler::BeginRegion(regionId);
+    }
+}
+
+ProfilerScope::ProfilerScope(const std::string& rName)
+    : mActive(Profiler::IsEnabled()),
+      mStartTime(0.0)
+{
+    if (mActive)
+    {
+        mStartTime = Profiler::BeginRegion(Profiler::GetRegionId(rName));
+    }
+}
+
+ProfilerScope::ProfilerScope(const Identifiable& rObject)
+    : mActive(Profiler::IsEnabled()),
+      mStartTime(0.0)
+{
+    if (mActive)
+    {
+        mStartTime = Profiler::BeginRegion(Profiler::GetRegionId(rObject));
+    }
+}
+
+ProfilerScope::~ProfilerScope()
+{
+    if (mActive)
+    {
+        Profiler::EndRegion(mStartTime);
+    }
+}
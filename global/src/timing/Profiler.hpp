@@ -0,0 +1,386 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#include <deque>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "Exception.hpp"
+#include "Identifiable.hpp"
+
+/**
+ * A lightweight hierarchical profiler, complementing the fixed events of the
+ * GenericEventHandler subclasses with named regions which may be created at run
+ * time (e.g. one per force class) and nested arbitrarily.
+ *
+ * Regions are timed by creating a ProfilerScope, which ends the region when it goes
+ * out of scope:
+ *
+ *     {
+ *         PROFILE_SCOPE("UpdateCellPopulation"); // Cheapest form, for a fixed name
+ *         ...
+ *         for (each force)
+ *         {
+ *             ProfilerScope force_scope(*p_force); // One region per class
+ *             ...
+ *         }
+ *     }
+ *
+ * Each thread records its own tree of regions, so that a region's statistics are
+ * kept separately for each path from the top of the tree (e.g. "Simulation/Force").
+ * For each path we record the number of calls, the total time and a histogram of the
+ * call durations.  Threads are numbered in the order in which they first begin a
+ * region (so the main thread is normally thread 0), and on other threads paths start
+ * at the first region opened by that thread.  Optionally, every call may also be recorded for export in the
+ * Chrome trace event format, which can be viewed in chrome://tracing or Perfetto.
+ *
+ * Beginning and ending a region involves no memory allocation once a path has been
+ * seen, so the profiler is enabled by default.
+ */
+class Profiler
+{
+public:
+
+    /**
+     * The number of bins in the histogram of call durations.  The first bin counts
+     * calls shorter than a microsecond, bin i counts calls lasting [2^(i-1), 2^i)
+     * microseconds and the last bin also counts any longer calls.
+     */
+    static const unsigned NUM_HISTOGRAM_BINS = 24;
+
+    /** Enable the profiler so that it records regions. */
+    static void Enable();
+
+    /** Disable the profiler, so that regions are no longer recorded (regions in progress will still end). */
+    static void Disable();
+
+    /** @return whether the profiler is enabled. */
+    static inline bool IsEnabled()
+    {
+        return msEnabled;
+    }
+
+    /**
+     * Record every call to every region, so that they can be written by WriteTrace().
+     *
+     * @param maxEventsPerThread  the maximum number of calls to record on each thread;
+     *     any further calls are counted but not recorded
+     */
+    static void EnableTracing(unsigned maxEventsPerThread=1000000u);
+
+    /** Stop recording calls for the trace (calls already recorded are kept). */
+    static void DisableTracing();
+
+    /**
+     * Discard all recorded data.  Must not be called while any region is in progress.
+     * Region names (and so region ids) are kept.
+     */
+    static void Reset();
+
+    /**
+     * @return the id of the region with the given name, registering it if necessary.
+     *
+     * @param rName  the name of the region
+     */
+    static unsigned GetRegionId(const std::string& rName);
+
+    /**
+     * @return the id of the region named after the class of the given object (see
+     * Identifiable::GetIdentifier()), registering it if necessary.  Ids are cached by
+     * type, so this is much cheaper than computing the identifier.
+     *
+     * @param rObject  the object
+     */
+    static unsigned GetRegionId(const Identifiable& rObject);
+
+    /**
+     * @return the name of a region.
+     *
+     * @param regionId  the id of the region
+     */
+    static std::string GetRegionName(unsigned regionId);
+
+    /**
+     * @return the paths of all the regions recorded on the given thread of this process,
+     * in the order in which they were first seen.  Region names are separated by '/'.
+     *
+     * @param thread  the index of the thread (defaults to 0)
+     */
+    static std::vector<std::string> GetRegionPaths(unsigned thread=0u);
+
+    /**
+     * @return the number of calls to the region with the given path on the given
+     * thread of this process (zero if it has not been recorded).
+     *
+     * @param rPath  the path of the region, e.g. "Simulation/Force"
+     * @param thread  the index of the thread (defaults to 0)
+     */
+    static unsigned GetNumCalls(const std::string& rPath, unsigned thread=0u);
+
+    /**
+     * @return the total time (in milliseconds) spent in completed calls to the region
+     * with the given path on the given thread of this process.
+     *
+     * @param rPath  the path of the region, e.g. "Simulation/Force"
+     * @param thread  the index of the thread (defaults to 0)
+     */
+    static double GetTotalTime(const std::string& rPath, unsigned thread=0u);
+
+    /**
+     * @return the histogram of the durations of calls to the region with the given path
+     * on the given thread of this process (see NUM_HISTOGRAM_BINS).
+     *
+     * @param rPath  the path of the region, e.g. "Simulation/Force"
+     * @param thread  the index of the thread (defaults to 0)
+     */
+    static std::vector<unsigned> GetCallHistogram(const std::string& rPath, unsigned thread=0u);
+
+    /**
+     * @return the number of calls which were not recorded in the trace because the
+     * limit given to EnableTracing() was reached, summed over threads of this process.
+     */
+    static unsigned GetNumDroppedTraceEvents();
+
+    /**
+     * Print a summary of every region path to std::cout.  On each process, the time of
+     * a path is its maximum over threads and its calls are summed over threads; the
+     * summary gives the total number of calls and the minimum, mean and maximum time
+     * over processes.  Must be called collectively.
+     */
+    static void Report();
+
+    /**
+     * Write the calls recorded since tracing was enabled on all processes to a single
+     * file in the Chrome trace event format, with one trace process per MPI process
+     * and one trace thread per thread.  Must be called collectively.
+     *
+     * @param rDirectory  the output directory, relative to CHASTE_TEST_OUTPUT
+     * @param rFileName  the name of the file, e.g. "profile.json"
+     */
+    static void WriteTrace(const std::string& rDirectory, const std::string& rFileName);
+
+    /**
+     * Begin a region on the calling thread.  Used by ProfilerScope.
+     *
+     * @param regionId  the id of the region
+     * @return the start time of the call
+     */
+    static double BeginRegion(unsigned regionId);
+
+    /**
+     * End the innermost region on the calling thread.  Used by ProfilerScope.
+     *
+     * @param startTime  the start time of the call, as returned by BeginRegion()
+     */
+    static void EndRegion(double startTime);
+
+private:
+
+    /** Whether the profiler is recording regions. */
+    static bool msEnabled;
+
+    /** A region on a particular path in the tree of regions of a thread. */
+    struct RegionNode
+    {
+        /** The id of the region (UNSIGNED_UNSET for the root of the tree). */
+        unsigned mRegionId;
+
+        /** The index of the parent node. */
+        unsigned mParent;
+
+        /** The indices of the child nodes. */
+        std::vector<unsigned> mChildren;
+
+        /** The number of completed calls. */
+        unsigned mNumCalls;
+
+        /** The total time of the completed calls, in seconds. */
+        double mTotalTime;
+
+        /** The histogram of the durations of the completed calls. */
+        unsigned mHistogram[NUM_HISTOGRAM_BINS];
+    };
+
+    /** A call recorded for the trace. */
+    struct TraceEvent
+    {
+        /** The id of the region. */
+        unsigned mRegionId;
+
+        /** The start time of the call, in seconds. */
+        double mStartTime;
+
+        /** The duration of the call, in seconds. */
+        double mDuration;
+    };
+
+    /** The data recorded by a thread. */
+    struct ThreadData
+    {
+        /** The tree of regions; the first node is the root. */
+        std::vector<RegionNode> mNodes;
+
+        /** The index of the node of the innermost region in progress. */
+        unsigned mCurrentNode;
+
+        /** The calls recorded for the trace. */
+        std::vector<TraceEvent> mTraceEvents;
+
+        /** The number of calls not recorded for the trace. */
+        unsigned mNumDroppedTraceEvents;
+    };
+
+    /** The state of the profiler. */
+    struct ProfilerData
+    {
+        /** The name of each region. */
+        std::vector<std::string> mRegionNames;
+
+        /** The id of each region, by name. */
+        std::map<std::string, unsigned> mRegionIds;
+
+        /** The id of the region for each class of Identifiable object. */
+        std::map<const std::type_info*, unsigned> mTypeRegionIds;
+
+        /** The data recorded by each thread (a deque, so that each thread's data stays in place). */
+        std::deque<ThreadData> mThreadData;
+
+        /** Whether calls are recorded for the trace. */
+        bool mTracing;
+
+        /** The maximum number of calls to record for the trace on each thread. */
+        unsigned mMaxTraceEventsPerThread;
+
+        /** The wall time at which the profiler was last reset; trace times are relative to this. */
+        double mStartTime;
+
+        /** Constructor. */
+        ProfilerData();
+    };
+
+    /** @return the state of the profiler. */
+    static ProfilerData& rGetData();
+
+    /** @return the data recorded by the calling thread, which is added when a thread first calls this. */
+    static ThreadData& rGetThreadData();
+
+    /**
+     * @return the node index of the region with the given path on the given thread,
+     * or UNSIGNED_UNSET if it has not been recorded.
+     *
+     * @param rPath  the path of the region
+     * @param thread  the index of the thread
+     */
+    static unsigned FindNode(const std::string& rPath, unsigned thread);
+
+    /**
+     * @return the path of a node.
+     *
+     * @param rThreadData  the data of the thread owning the node
+     * @param node  the index of the node
+     */
+    static std::string GetPath(const ThreadData& rThreadData, unsigned node);
+
+    /**
+     * @return the strings from all processes, on the master process (and an empty vector elsewhere).
+     *
+     * @param rString  the string from this process
+     */
+    static std::vector<std::string> GatherOnMaster(const std::string& rString);
+};
+
+/**
+ * Times a region of the Profiler from its construction until it goes out of scope.
+ */
+class ProfilerScope
+{
+private:
+
+    /** Whether the region is being recorded. */
+    bool mActive;
+
+    /** The start time of the call. */
+    double mStartTime;
+
+public:
+
+    /**
+     * Begin a region given its id (see Profiler::GetRegionId()).
+     *
+     * @param regionId  the id of the region
+     */
+    ProfilerScope(unsigned regionId);
+
+    /**
+     * Begin a region given its name.
+     *
+     * @param rName  the name of the region
+     */
+    ProfilerScope(const std::string& rName);
+
+    /**
+     * Begin a region named after the class of an object.
+     *
+     * @param rObject  the object
+     */
+    ProfilerScope(const Identifiable& rObject);
+
+    /**
+     * Destructor, which ends the region.
+     */
+    ~ProfilerScope();
+};
+
+/** Helper for PROFILE_SCOPE. */
+#define PROFILE_SCOPE_CONCAT2(a, b) a ## b
+/** Helper for PROFILE_SCOPE. */
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT2(a, b)
+
+/**
+ * Time the rest of the enclosing scope as a region of the Profiler with a fixed name.
+ * The region id is looked up only once.
+ *
+ * @param name  the name of the region
+ */
+#define PROFILE_SCOPE(name) \
+    static const unsigned PROFILE_SCOPE_CONCAT(profiler_region_, __LINE__) = Profiler::GetRegionId(name); \
+    ProfilerScope PROFILE_SCOPE_CONCAT(profiler_scope_, __LINE__)(PROFILE_SCOPE_CONCAT(profiler_region_, __LINE__))
+
+#endif /*PROFILER_HPP_*/
@@ -0,0 +1,135 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTBENCHMARKREPORT_HPP_
+#define TESTBENCHMARKREPORT_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "BenchmarkReport.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "FileFinder.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestBenchmarkReport : public CxxTest::TestSuite
+{
+public:
+
+    void TestBenchmarkReportJson() throw(Exception)
+    {
+        BenchmarkReport report("TestBenchmark");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 0u);
+        TS_ASSERT_EQUALS(report.GetJson(), "{\n  \"benchmark\": \"TestBenchmark\",\n  \"runs\": []\n}\n");
+
+        // Record a run with some event times
+        CellBasedEventHandler::Reset();
+        report.BeginRun("Run \"one\"");
+        report.AddParameter("num_cells", 125);
+        CellBasedEventHandler::BeginEvent(CellBasedEventHandler::FORCE);
+        CellBasedEventHandler::EndEvent(CellBasedEventHandler::FORCE);
+        CellBasedEventHandler::EndEvent(CellBasedEventHandler::EVERYTHING);
+        report.AddEventTimes("CellBasedEventHandler", CellBasedEventHandler::Instance());
+        report.EndRun();
+        CellBasedEventHandler::Reset();
+
+        // And one without
+        report.BeginRun("Run two");
+        report.EndRun();
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 2u);
+
+        std::string json = report.GetJson();
+        TS_ASSERT_DIFFERS(json.find("\"name\": \"Run \\\"one\\\"\""), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"parameters\": {\"num_cells\": 125}"), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"CellBasedEventHandler\": {\"Setup\": {\"max\": "), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"Total\": {\"max\": "), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"name\": \"Run two\",\n      \"parameters\": {},"), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"peak_memory\": "), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"memory_increase\": "), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"memory_per_run\": "), std::string::npos);
+        TS_ASSERT_DIFFERS(json.find("\"wall_time\": "), std::string::npos);
+
+        // The peak memory use is at least non-negative (and positive where supported)
+        TS_ASSERT_LESS_THAN_EQUALS(0.0, BenchmarkReport::GetPeakMemoryUsage());
+
+        // Write the results to file
+        report.WriteFile("TestBenchmarkReport");
+        FileFinder file("TestBenchmarkReport/TestBenchmark.json", RelativeTo::ChasteTestOutput);
+        TS_ASSERT(file.IsFile());
+    }
+
+    void TestPeakMemoryIsPerRun() throw(Exception)
+    {
+        // Use 100MB of memory and release it again
+        {
+            std::vector<char> memory(100u*1024u*1024u, 1);
+            TS_ASSERT_EQUALS(memory.back(), 1);
+        }
+        double lifetime_peak = BenchmarkReport::GetPeakMemoryUsage();
+
+        if (BenchmarkReport::ResetPeakMemoryUsage())
+        {
+            // The peak now only covers what has been used since the reset
+            double peak = BenchmarkReport::GetPeakMemoryUsage();
+            TS_ASSERT_LESS_THAN(peak, lifetime_peak - 50.0);
+            TS_ASSERT_LESS_THAN(0.0, BenchmarkReport::GetMemoryUsage());
+            TS_ASSERT_LESS_THAN_EQUALS(BenchmarkReport::GetMemoryUsage(), peak);
+
+            BenchmarkReport report("TestBenchmark");
+            report.BeginRun("Run");
+            report.EndRun();
+            TS_ASSERT_DIFFERS(report.GetJson().find("\"memory_per_run\": true"), std::string::npos);
+        }
+    }
+
+    void TestBenchmarkReportExceptions() throw(Exception)
+    {
+        BenchmarkReport report("TestBenchmark");
+        TS_ASSERT_THROWS_THIS(report.EndRun(), "There is no benchmark run in progress.");
+        TS_ASSERT_THROWS_THIS(report.AddParameter("size", 1.0),
+                              "Parameters can only be added to a benchmark run in progress.");
+        TS_ASSERT_THROWS_THIS(report.AddEventTimes("CellBasedEventHandler", CellBasedEventHandler::Instance()),
+                              "Event times can only be added to a benchmark run in progress.");
+        TS_ASSERT_THROWS_THIS(report.BeginRun(""), "A benchmark run must have a name.");
+
+        report.BeginRun("Run");
+        TS_ASSERT_THROWS_THIS(report.BeginRun("Another run"), "The benchmark run 'Run' has not ended.");
+        report.EndRun();
+    }
+};
+
+#endif /*TESTBENCHMARKREPORT_HPP_*/
@@ -186,6 +186,35 @@ public:
         AnEventHandler::EndEvent(AnEventHandler::TEST3);
         AnEventHandler::Report();
     }
+
+    void TestThreadTimes()
+    {
+        AnEventHandler::Reset();
+        TS_ASSERT(AnEventHandler::GetThreadTimes(AnEventHandler::TEST1).empty());
+
+        AnEventHandler::BeginEvent(AnEventHandler::TEST1);
+        AnEventHandler::AddThreadTime(AnEventHandler::TEST1, 0, 0.002);
+        AnEventHandler::AddThreadTime(AnEventHandler::TEST1, 2, 0.001);
+        AnEventHandler::AddThreadTime(AnEventHandler::TEST1, 2, 0.003);
+        AnEventHandler::EndEvent(AnEventHandler::TEST1);
+
+        std::vector<double> thread_times = AnEventHandler::GetThreadTimes(AnEventHandler::TEST1);
+        TS_ASSERT_EQUALS(thread_times.size(), 3u);
+        TS_ASSERT_DELTA(thread_times[0], 2.0, 1e-12);
+        TS_ASSERT_DELTA(thread_times[1], 0.0, 1e-12);
+        TS_ASSERT_DELTA(thread_times[2], 4.0, 1e-12);
+        TS_ASSERT(AnEventHandler::GetThreadTimes(AnEventHandler::TEST2).empty());
+
+        // The per-thread breakdown is included in the report, which then resets it
+        AnEventHandler::Report();
+        TS_ASSERT(AnEventHandler::GetThreadTimes(AnEventHandler::TEST1).empty());
+
+        // Thread times are not recorded when the handler is disabled
+        AnEventHandler::Disable();
+        AnEventHandler::AddThreadTime(AnEventHandler::TEST1, 0, 1.0);
+        AnEventHandler::Enable();
+        TS_ASSERT(AnEventHandler::GetThreadTimes(AnEventHandler::TEST1).empty());
+    }
 };
 
 #endif /*TESTGENERICEVENTHANDLER_HPP_*/
@@ -0,0 +1,149 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTHALOEDVECTOR_HPP_
+#define TESTHALOEDVECTOR_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <sstream>
+#include <vector>
+
+#include "PetscSetupAndFinalize.hpp"
+#include "HaloedVector.hpp"
+#include "DistributedVectorFactory.hpp"
+#include "PetscTools.hpp"
+
+class TestHaloedVector : public CxxTest::TestSuite
+{
+public:
+
+    void TestReplicateEverything()
+    {
+        const unsigned size = 3*PetscTools::GetNumProcs() + 1;
+        DistributedVectorFactory factory(size);
+        const unsigned lo = factory.GetLow();
+        const unsigned hi = factory.GetHigh();
+
+        HaloedVector vector(size);
+        TS_ASSERT_EQUALS(vector.GetSize(), size);
+        TS_ASSERT_EQUALS(vector.GetNumStoredEntries(), size);
+        TS_ASSERT(!vector.HasHalos());
+
+        for (unsigned global_index=lo; global_index<hi; global_index++)
+        {
+            vector[global_index] = 10.0*global_index;
+        }
+        vector.Replicate(lo, hi);
+
+        for (unsigned global_index=0; global_index<size; global_index++)
+        {
+            TS_ASSERT_EQUALS(vector[global_index], 10.0*global_index);
+        }
+    }
+
+    void TestReplicateHalos()
+    {
+        // Each process has its neighbours' nearest entries as halos, as for a 1D mesh
+        const unsigned num_procs = PetscTools::GetNumProcs();
+        const unsigned my_rank = PetscTools::GetMyRank();
+        const unsigned size = 4*num_procs;
+        DistributedVectorFactory factory(size, 4u);
+        const unsigned lo = factory.GetLow();
+        const unsigned hi = factory.GetHigh();
+
+        std::vector<unsigned> halos;
+        std::vector<std::vector<unsigned> > to_send(num_procs);
+        std::vector<std::vector<unsigned> > to_receive(num_procs);
+        if (my_rank > 0)
+        {
+            halos.push_back(lo-1);
+            to_send[my_rank-1].push_back(lo);
+            to_receive[my_rank-1].push_back(lo-1);
+        }
+        if (my_rank+1 < num_procs)
+        {
+            halos.push_back(hi);
+            to_send[my_rank+1].push_back(hi-1);
+            to_receive[my_rank+1].push_back(hi);
+        }
+
+        HaloedVector vector;
+        vector.SetUpHalos(size, lo, hi, halos, to_send, to_receive);
+        TS_ASSERT(vector.HasHalos());
+        TS_ASSERT_EQUALS(vector.GetSize(), size);
+        TS_ASSERT_EQUALS(vector.GetNumStoredEntries(), 4u + halos.size());
+
+        for (unsigned global_index=lo; global_index<hi; global_index++)
+        {
+            vector[global_index] = 10.0*global_index;
+        }
+        vector.Replicate(lo, hi);
+
+        for (unsigned global_index=lo; global_index<hi; global_index++)
+        {
+            TS_ASSERT_EQUALS(vector[global_index], 10.0*global_index);
+        }
+        for (unsigned i=0; i<halos.size(); i++)
+        {
+            TS_ASSERT_EQUALS(vector[halos[i]], 10.0*halos[i]);
+        }
+
+        // Entries which are neither owned nor halos are not stored
+        if (num_procs > 2u)
+        {
+            unsigned not_stored = (hi + 4u) % size;
+            std::stringstream message;
+            message << "Index " << not_stored << " is neither owned by this process nor one of its halo entries.";
+            TS_ASSERT_THROWS_THIS(vector[not_stored], message.str());
+        }
+
+        // Owned entries must be sent from the process which owns them
+        if (num_procs > 1u)
+        {
+            std::vector<std::vector<unsigned> > bad_send(num_procs);
+            bad_send[(my_rank+1) % num_procs].push_back((hi + 1u) % size);
+            TS_ASSERT_THROWS_CONTAINS(vector.SetUpHalos(size, lo, hi, halos, bad_send, to_receive), "is sent to another process, but is not owned by this one.");
+        }
+
+        // Going back to storing everything
+        vector.Resize(size);
+        TS_ASSERT(!vector.HasHalos());
+        TS_ASSERT_EQUALS(vector.GetNumStoredEntries(), size);
+    }
+};
+
+#endif /*TESTHALOEDVECTOR_HPP_*/
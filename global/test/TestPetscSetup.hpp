@@ -147,6 +147,17 @@ public:
         TS_ASSERT(std::isnan(ans));
 #endif
     }
+
+    void TestMpiThreadLevel()
+    {
+        // Full multi-threading support is only requested with -mpi_thread_multiple, and need not be provided
+        int initialised;
+        MPI_Initialized(&initialised);
+        TS_ASSERT(initialised);
+        int thread_level;
+        MPI_Query_thread(&thread_level);
+        TS_ASSERT_LESS_THAN_EQUALS(MPI_THREAD_SINGLE, thread_level);
+    }
 };
 
 #endif // _TESTPETSCSETUP_HPP_
@@ -0,0 +1,179 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTPROFILER_HPP_
+#define TESTPROFILER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "FileFinder.hpp"
+#include "Profiler.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestProfiler : public CxxTest::TestSuite
+{
+private:
+
+    /** Sleep for the given number of milliseconds. */
+    void Sleep(unsigned milliseconds)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    }
+
+public:
+
+    void TestNestedRegions() throw(Exception)
+    {
+        Profiler::Reset();
+        TS_ASSERT(Profiler::IsEnabled());
+        TS_ASSERT(Profiler::GetRegionPaths().empty());
+
+        {
+            PROFILE_SCOPE("Outer");
+            for (unsigned i=0; i<3; i++)
+            {
+                ProfilerScope inner_scope("Inner");
+                Sleep(10);
+            }
+            {
+                ProfilerScope other_scope(Profiler::GetRegionId("Other"));
+                ProfilerScope inner_scope("Inner");
+            }
+        }
+
+        // Each path through the tree of regions is recorded separately
+        std::vector<std::string> paths = Profiler::GetRegionPaths();
+        TS_ASSERT_EQUALS(paths.size(), 4u);
+        TS_ASSERT_EQUALS(paths[0], "Outer");
+        TS_ASSERT_EQUALS(paths[1], "Outer/Inner");
+        TS_ASSERT_EQUALS(paths[2], "Outer/Other");
+        TS_ASSERT_EQUALS(paths[3], "Outer/Other/Inner");
+
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("Outer"), 1u);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("Outer/Inner"), 3u);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("Outer/Other/Inner"), 1u);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("Inner"), 0u);
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("Outer", 1000u), 0u);
+
+        TS_ASSERT_LESS_THAN_EQUALS(30.0, Profiler::GetTotalTime("Outer/Inner"));
+        TS_ASSERT_LESS_THAN_EQUALS(Profiler::GetTotalTime("Outer/Inner"), Profiler::GetTotalTime("Outer"));
+        TS_ASSERT_EQUALS(Profiler::GetTotalTime("Inner"), 0.0);
+
+        // Calls of at least 10ms fall in bin 14 ([8192, 16384) microseconds) or above
+        std::vector<unsigned> histogram = Profiler::GetCallHistogram("Outer/Inner");
+        TS_ASSERT_EQUALS(histogram.size(), Profiler::NUM_HISTOGRAM_BINS);
+        unsigned num_long_calls = 0;
+        for (unsigned bin=14; bin<Profiler::NUM_HISTOGRAM_BINS; bin++)
+        {
+            num_long_calls += histogram[bin];
+        }
+        TS_ASSERT_EQUALS(num_long_calls, 3u);
+        TS_ASSERT_EQUALS(Profiler::GetCallHistogram("Inner")[0], 0u);
+
+        // Region names are kept by Reset()
+        TS_ASSERT_EQUALS(Profiler::GetRegionName(Profiler::GetRegionId("Outer")), "Outer");
+        Profiler::Reset();
+        TS_ASSERT(Profiler::GetRegionPaths().empty());
+        TS_ASSERT_EQUALS(Profiler::GetRegionName(Profiler::GetRegionId("Outer")), "Outer");
+    }
+
+    void TestDisable() throw(Exception)
+    {
+        Profiler::Reset();
+        Profiler::Disable();
+        TS_ASSERT(!Profiler::IsEnabled());
+        {
+            ProfilerScope scope("Disabled");
+        }
+        TS_ASSERT(Profiler::GetRegionPaths().empty());
+
+        // A region which began while enabled still ends after the profiler is disabled
+        Profiler::Enable();
+        {
+            ProfilerScope scope("Enabled");
+            Profiler::Disable();
+        }
+        Profiler::Enable();
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("Enabled"), 1u);
+        {
+            ProfilerScope scope("AfterEnabled");
+        }
+        TS_ASSERT_EQUALS(Profiler::GetNumCalls("AfterEnabled"), 1u);
+    }
+
+    void TestReportAndTrace() throw(Exception)
+    {
+        Profiler::Reset();
+        Profiler::EnableTracing(2u);
+        {
+            PROFILE_SCOPE("Traced \"region\"");
+            for (unsigned i=0; i<2; i++)
+            {
+                ProfilerScope scope("Child");
+            }
+        }
+        Profiler::DisableTracing();
+        {
+            ProfilerScope scope("Untraced");
+        }
+
+        // Only two calls are recorded on this process
+        TS_ASSERT_EQUALS(Profiler::GetNumDroppedTraceEvents(), 1u);
+
+        Profiler::Report();
+
+        Profiler::WriteTrace("TestProfiler", "trace.json");
+        FileFinder file("TestProfiler/trace.json", RelativeTo::ChasteTestOutput);
+        TS_ASSERT(file.IsFile());
+
+        std::ifstream trace_file(file.GetAbsolutePath().c_str());
+        std::stringstream trace;
+        trace << trace_file.rdbuf();
+        TS_ASSERT_EQUALS(trace.str().find("{\"traceEvents\": [\n"), 0u);
+        TS_ASSERT_DIFFERS(trace.str().find("\"name\": \"Child\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"), std::string::npos);
+        TS_ASSERT_EQUALS(trace.str().find("Traced \\\"region\\\""), std::string::npos);
+        TS_ASSERT_EQUALS(trace.str().find("Untraced"), std::string::npos);
+
+        Profiler::Reset();
+        TS_ASSERT_EQUALS(Profiler::GetNumDroppedTraceEvents(), 0u);
+    }
+};
+
+#endif /*TESTPROFILER_HPP_*/
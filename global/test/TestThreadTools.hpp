@@ -0,0 +1,83 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTTHREADTOOLS_HPP_
+#define TESTTHREADTOOLS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "ThreadTools.hpp"
+#include "ThreadedTestHelpers.hpp"
+#include "FakePetscSetup.hpp"
+
+class TestThreadTools : public CxxTest::TestSuite
+{
+public:
+
+    void TestCheckNumberOfThreads() throw(Exception)
+    {
+        TS_ASSERT_THROWS_NOTHING(ThreadTools::CheckNumberOfThreads(1u, "cell ODEs cannot be solved"));
+
+        TS_ASSERT_THROWS_THIS(ThreadTools::CheckNumberOfThreads(0u, "cell ODEs cannot be solved"),
+                              "The number of threads must be at least one.");
+        TS_ASSERT_THROWS_THIS(ThreadTools::CheckNumberOfThreads(0u, "cell models cannot be solved", "ODE threads"),
+                              "The number of ODE threads must be at least one.");
+
+#ifdef CHASTE_OPENMP
+        TS_ASSERT_THROWS_NOTHING(ThreadTools::CheckNumberOfThreads(4u, "cell ODEs cannot be solved"));
+#else
+        TS_ASSERT_THROWS_THIS(ThreadTools::CheckNumberOfThreads(2u, "cell ODEs cannot be solved"),
+                              "Chaste has not been built with OpenMP support (Chaste_USE_OPENMP), so cell ODEs cannot be solved on multiple threads.");
+#endif // CHASTE_OPENMP
+    }
+
+    void TestThreadedTestHelpers() throw(Exception)
+    {
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest(3u);
+#ifdef CHASTE_OPENMP
+        TS_ASSERT_EQUALS(numbers_of_threads.size(), 2u);
+        TS_ASSERT_EQUALS(numbers_of_threads[0], 2u);
+        TS_ASSERT_EQUALS(numbers_of_threads[1], 3u);
+#else
+        TS_ASSERT(numbers_of_threads.empty());
+#endif // CHASTE_OPENMP
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(ThreadTools::CheckNumberOfThreads(2u, "tests cannot be run"), "tests cannot be run");
+    }
+};
+
+#endif /*TESTTHREADTOOLS_HPP_*/
@@ -0,0 +1,328 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "AbstractBatchedCardiacCells.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "Exception.hpp"
+#include "HeartConfig.hpp"
+#include "TimeStepper.hpp"
+
+AbstractBatchedCardiacCells::AbstractBatchedCardiacCells(boost::shared_ptr<AbstractOdeSystemInformation> pSystemInfo,
+                                                         unsigned voltageIndex,
+                                                         const std::vector<double>& rDefaultParameters)
+    : mIsUsedInTissue(false),
+      mpSystemInfo(pSystemInfo),
+      mVoltageIndex(voltageIndex),
+      mDt(HeartConfig::Instance()->GetOdeTimeStep()),
+      mDefaultParameters(rDefaultParameters)
+{
+    assert(mpSystemInfo);
+    const unsigned num_state_vars = mpSystemInfo->rGetStateVariableNames().size();
+    assert(mVoltageIndex < num_state_vars);
+    mStateVariables.resize(num_state_vars);
+    mDerivatives.resize(num_state_vars);
+    mParameters.resize(mDefaultParameters.size());
+}
+
+AbstractBatchedCardiacCells::~AbstractBatchedCardiacCells()
+{
+}
+
+unsigned AbstractBatchedCardiacCells::AddCell(boost::shared_ptr<AbstractStimulusFunction> pIntracellularStimulus)
+{
+    const unsigned index = GetNumCells();
+    const std::vector<double> initial_conditions = mpSystemInfo->GetInitialConditions();
+    assert(initial_conditions.size() == mStateVariables.size());
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        mStateVariables[i].push_back(initial_conditions[i]);
+    }
+    AddCellWorkingMemory();
+    for (unsigned p=0; p<mParameters.size(); p++)
+    {
+        mParameters[p].push_back(mDefaultParameters[p]);
+    }
+    mAreaStimulus.push_back(0.0);
+    mStimuli.push_back(pIntracellularStimulus);
+    return index;
+}
+
+unsigned AbstractBatchedCardiacCells::GetNumCells() const
+{
+    return mStimuli.size();
+}
+
+boost::shared_ptr<const AbstractOdeSystemInformation> AbstractBatchedCardiacCells::GetSystemInformation() const
+{
+    return mpSystemInfo;
+}
+
+unsigned AbstractBatchedCardiacCells::GetNumberOfStateVariables() const
+{
+    return mStateVariables.size();
+}
+
+unsigned AbstractBatchedCardiacCells::GetNumberOfParameters() const
+{
+    return mParameters.size();
+}
+
+unsigned AbstractBatchedCardiacCells::GetVoltageIndex() const
+{
+    return mVoltageIndex;
+}
+
+void AbstractBatchedCardiacCells::SetTimestep(double dt)
+{
+    mDt = dt;
+}
+
+double AbstractBatchedCardiacCells::GetTimestep() const
+{
+    return mDt;
+}
+
+void AbstractBatchedCardiacCells::SetUsedInTissueSimulation(bool tissue)
+{
+    mIsUsedInTissue = tissue;
+}
+
+void AbstractBatchedCardiacCells::SetStimulusFunction(unsigned cell, boost::shared_ptr<AbstractStimulusFunction> pStimulus)
+{
+    assert(cell < GetNumCells());
+    mStimuli[cell] = pStimulus;
+}
+
+boost::shared_ptr<AbstractStimulusFunction> AbstractBatchedCardiacCells::GetStimulusFunction(unsigned cell)
+{
+    assert(cell < GetNumCells());
+    return mStimuli[cell];
+}
+
+double AbstractBatchedCardiacCells::GetStateVariable(unsigned cell, unsigned index) const
+{
+    if (index >= mStateVariables.size())
+    {
+        EXCEPTION("The index passed in must be less than the number of state variables.");
+    }
+    assert(cell < GetNumCells());
+    return mStateVariables[index][cell];
+}
+
+void AbstractBatchedCardiacCells::SetStateVariable(unsigned cell, unsigned index, double value)
+{
+    if (index >= mStateVariables.size())
+    {
+        EXCEPTION("The index passed in must be less than the number of state variables.");
+    }
+    assert(cell < GetNumCells());
+    mStateVariables[index][cell] = value;
+}
+
+std::vector<double> AbstractBatchedCardiacCells::GetStdVecStateVariables(unsigned cell) const
+{
+    assert(cell < GetNumCells());
+    std::vector<double> state_variables(mStateVariables.size());
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        state_variables[i] = mStateVariables[i][cell];
+    }
+    return state_variables;
+}
+
+void AbstractBatchedCardiacCells::SetStateVariables(unsigned cell, const std::vector<double>& rVariables)
+{
+    if (rVariables.size() != mStateVariables.size())
+    {
+        EXCEPTION(mStateVariables.size() << " state variables expected, but " << rVariables.size() << " were given.");
+    }
+    assert(cell < GetNumCells());
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        mStateVariables[i][cell] = rVariables[i];
+    }
+}
+
+double AbstractBatchedCardiacCells::GetParameter(unsigned cell, unsigned index) const
+{
+    if (index >= mParameters.size())
+    {
+        EXCEPTION("The index passed in must be less than the number of parameters.");
+    }
+    assert(cell < GetNumCells());
+    return mParameters[index][cell];
+}
+
+void AbstractBatchedCardiacCells::SetParameter(unsigned cell, unsigned index, double value)
+{
+    if (index >= mParameters.size())
+    {
+        EXCEPTION("The index passed in must be less than the number of parameters.");
+    }
+    assert(cell < GetNumCells());
+    mParameters[index][cell] = value;
+}
+
+double AbstractBatchedCardiacCells::GetVoltage(unsigned cell) const
+{
+    assert(cell < GetNumCells());
+    return mStateVariables[mVoltageIndex][cell];
+}
+
+void AbstractBatchedCardiacCells::SetVoltage(unsigned cell, double voltage)
+{
+    assert(cell < GetNumCells());
+    mStateVariables[mVoltageIndex][cell] = voltage;
+}
+
+double AbstractBatchedCardiacCells::GetIIonic(unsigned cell)
+{
+    assert(cell < GetNumCells());
+    double i_ionic;
+    ComputeIIonic(cell, cell+1, &i_ionic);
+    return i_ionic;
+}
+
+double AbstractBatchedCardiacCells::GetIIonic(unsigned cell, const std::vector<double>& rStateVariables)
+{
+    assert(cell < GetNumCells());
+    assert(rStateVariables.size() == GetNumberOfStateVariables());
+    std::vector<double> own_state_variables = GetStdVecStateVariables(cell);
+    SetStateVariables(cell, rStateVariables);
+    double i_ionic;
+    ComputeIIonic(cell, cell+1, &i_ionic);
+    SetStateVariables(cell, own_state_variables);
+    return i_ionic;
+}
+
+void AbstractBatchedCardiacCells::ComputeExceptVoltage(unsigned begin, unsigned end, double tStart, double tEnd)
+{
+    Solve(begin, end, tStart, tEnd, false);
+}
+
+void AbstractBatchedCardiacCells::SolveAndUpdateState(unsigned begin, unsigned end, double tStart, double tEnd)
+{
+    Solve(begin, end, tStart, tEnd, true);
+}
+
+void AbstractBatchedCardiacCells::Solve(unsigned begin, unsigned end, double tStart, double tEnd, bool updateVoltage)
+{
+    assert(begin <= end && end <= GetNumCells());
+    if (begin == end)
+    {
+        return;
+    }
+    TimeStepper stepper(tStart, tEnd, mDt);
+    while (!stepper.IsTimeAtEnd())
+    {
+        EvaluateAreaStimulus(stepper.GetTime(), begin, end);
+        EvaluateYDerivatives(stepper.GetTime(), begin, end);
+        UpdateStateVariables(stepper.GetNextTimeStep(), begin, end, updateVoltage);
+        stepper.AdvanceOneTimeStep();
+    }
+    VerifyStateVariables(tEnd, begin, end);
+}
+
+void AbstractBatchedCardiacCells::EvaluateAreaStimulus(double time, unsigned begin, unsigned end)
+{
+    // Convert from uA/cm^3 to uA/cm^2 by dividing by Am if in a tissue
+    const double scale = mIsUsedInTissue ? 1.0/HeartConfig::Instance()->GetSurfaceAreaToVolumeRatio() : 1.0;
+    for (unsigned c=begin; c<end; c++)
+    {
+        mAreaStimulus[c] = scale*mStimuli[c]->GetStimulus(time);
+    }
+}
+
+void AbstractBatchedCardiacCells::UpdateStateVariables(double dt, unsigned begin, unsigned end, bool updateVoltage)
+{
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        if (i == mVoltageIndex && !updateVoltage)
+        {
+            continue;
+        }
+        double* p_y = &(mStateVariables[i][0]);
+        const double* p_dy = &(mDerivatives[i][0]);
+        for (unsigned c=begin; c<end; c++)
+        {
+            p_y[c] += dt*p_dy[c];
+        }
+    }
+}
+
+void AbstractBatchedCardiacCells::AddCellWorkingMemory()
+{
+    for (unsigned i=0; i<mDerivatives.size(); i++)
+    {
+        mDerivatives[i].push_back(0.0);
+    }
+}
+
+void AbstractBatchedCardiacCells::VerifyStateVariables(double time, unsigned begin, unsigned end)
+{
+    const unsigned cell = FindFirstInvalidCell(begin, end);
+    if (cell < end)
+    {
+        for (unsigned i=0; i<mStateVariables.size(); i++)
+        {
+            if (std::isnan(mStateVariables[i][cell]))
+            {
+                EXCEPTION("State variable " << mpSystemInfo->rGetStateVariableNames()[i] << " of batched cell "
+                          << cell << " is not a number at t = " << time << ".");
+            }
+        }
+    }
+}
+
+unsigned AbstractBatchedCardiacCells::FindFirstInvalidCell(unsigned begin, unsigned end) const
+{
+    unsigned first_invalid = end;
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        for (unsigned c=begin; c<first_invalid; c++)
+        {
+            if (std::isnan(mStateVariables[i][c]))
+            {
+                first_invalid = c;
+                break;
+            }
+        }
+    }
+    return first_invalid;
+}
@@ -0,0 +1,359 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef ABSTRACTBATCHEDCARDIACCELLS_HPP_
+#define ABSTRACTBATCHEDCARDIACCELLS_HPP_
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractOdeSystemInformation.hpp"
+#include "AbstractStimulusFunction.hpp"
+
+/**
+ * Base class for a block of cardiac cells which all use the same cell model.
+ *
+ * Rather than each cell being its own object with its own state variable vector, the
+ * state of all the cells is stored in structure-of-arrays layout: one contiguous array
+ * per state variable (and per parameter), indexed by cell.  Concrete subclasses evaluate
+ * the model right-hand side for a whole range of cells in a single loop, without a
+ * virtual call per cell, so that the compiler can vectorise the cell loop.
+ *
+ * Individual cells are exposed to the rest of Chaste through BatchedCardiacCellView,
+ * which implements AbstractCardiacCellInterface by forwarding to this class.  A cell
+ * factory can return such views from CreateCardiacCellForTissueNode, and
+ * AbstractCardiacTissue will then solve all its cells with a single call to this class.
+ *
+ * The default time-stepping scheme is forward Euler, matching AbstractCardiacCell with
+ * an EulerIvpOdeSolver.  Subclasses may override UpdateStateVariables to implement
+ * other explicit schemes, such as Rush-Larsen updates of gating variables.
+ *
+ * Note that batched cells cannot be checkpointed.
+ */
+class AbstractBatchedCardiacCells
+{
+private:
+
+    /** Whether the cells are used in a tissue simulation (affects the stimulus units). */
+    bool mIsUsedInTissue;
+
+    /** Per-cell intracellular stimulus functions. */
+    std::vector<boost::shared_ptr<AbstractStimulusFunction> > mStimuli;
+
+    /**
+     * Evaluate the stimulus (in uA/cm^2) applied to each cell in a range at the given time,
+     * storing it in #mAreaStimulus.
+     *
+     * @param time  the current time
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     */
+    void EvaluateAreaStimulus(double time, unsigned begin, unsigned end);
+
+    /**
+     * Advance the cells in a range from tStart to tEnd with timestep #mDt.
+     *
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     * @param updateVoltage  whether to update the transmembrane potential
+     */
+    void Solve(unsigned begin, unsigned end, double tStart, double tEnd, bool updateVoltage);
+
+protected:
+
+    /** Information about the cell model (state variable names, initial conditions etc.). */
+    boost::shared_ptr<AbstractOdeSystemInformation> mpSystemInfo;
+
+    /** The index of the transmembrane potential within the state variables. */
+    unsigned mVoltageIndex;
+
+    /** The ODE timestep. */
+    double mDt;
+
+    /** The state variables: mStateVariables[i][c] is state variable i of cell c. */
+    std::vector<std::vector<double> > mStateVariables;
+
+    /** Working memory for the derivatives, in the same layout as #mStateVariables. */
+    std::vector<std::vector<double> > mDerivatives;
+
+    /** The parameters: mParameters[p][c] is parameter p of cell c. */
+    std::vector<std::vector<double> > mParameters;
+
+    /** Default values of the parameters, given to each new cell. */
+    std::vector<double> mDefaultParameters;
+
+    /** The stimulus current (in uA/cm^2) for each cell, at the time derivatives are evaluated. */
+    std::vector<double> mAreaStimulus;
+
+    /**
+     * Evaluate the derivatives of the state variables for a range of cells, storing them
+     * in #mDerivatives.  The stimulus for each cell is available in #mAreaStimulus.
+     *
+     * Cells in different ranges may be evaluated concurrently, so implementations must
+     * only write to entries for cells in [begin, end).
+     *
+     * @param time  the current time
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     */
+    virtual void EvaluateYDerivatives(double time, unsigned begin, unsigned end)=0;
+
+    /**
+     * Update the state variables of a range of cells by one timestep, given the
+     * derivatives in #mDerivatives.  This default implementation uses forward Euler.
+     *
+     * @param dt  the timestep
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param updateVoltage  whether to update the transmembrane potential
+     */
+    virtual void UpdateStateVariables(double dt, unsigned begin, unsigned end, bool updateVoltage);
+
+    /**
+     * Extend the per-cell working memory (#mDerivatives) for a newly added cell.
+     * Subclasses with further working memory should override this, calling the
+     * base class method.
+     */
+    virtual void AddCellWorkingMemory();
+
+    /**
+     * Check that the state variables of a range of cells are valid, throwing an exception
+     * if any is NaN.
+     *
+     * @param time  the time reached, for the error message
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     */
+    void VerifyStateVariables(double time, unsigned begin, unsigned end);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pSystemInfo  information about the cell model
+     * @param voltageIndex  the index of the transmembrane potential within the state variables
+     * @param rDefaultParameters  default values of the model parameters (may be empty)
+     */
+    AbstractBatchedCardiacCells(boost::shared_ptr<AbstractOdeSystemInformation> pSystemInfo,
+                                unsigned voltageIndex,
+                                const std::vector<double>& rDefaultParameters=std::vector<double>());
+
+    /** Virtual destructor. */
+    virtual ~AbstractBatchedCardiacCells();
+
+    /**
+     * Add a cell, with the model's default initial conditions and parameters.
+     *
+     * @param pIntracellularStimulus  the intracellular stimulus for the new cell
+     * @return the index of the new cell
+     */
+    unsigned AddCell(boost::shared_ptr<AbstractStimulusFunction> pIntracellularStimulus);
+
+    /** @return the number of cells. */
+    unsigned GetNumCells() const;
+
+    /** @return information about the cell model. */
+    boost::shared_ptr<const AbstractOdeSystemInformation> GetSystemInformation() const;
+
+    /** @return the number of state variables in the cell model. */
+    unsigned GetNumberOfStateVariables() const;
+
+    /** @return the number of parameters in the cell model. */
+    unsigned GetNumberOfParameters() const;
+
+    /** @return the index of the transmembrane potential within the state variables. */
+    unsigned GetVoltageIndex() const;
+
+    /**
+     * Set the ODE timestep for all cells.
+     *
+     * @param dt  the timestep
+     */
+    void SetTimestep(double dt);
+
+    /** @return the ODE timestep. */
+    double GetTimestep() const;
+
+    /**
+     * Set whether the cells are used in a tissue simulation, in which case the stimulus
+     * is converted from uA/cm^3 to uA/cm^2 using the surface-area-to-volume ratio.
+     *
+     * @param tissue  whether the cells are used in a tissue simulation
+     */
+    void SetUsedInTissueSimulation(bool tissue=true);
+
+    /**
+     * Set the intracellular stimulus for a cell.
+     *
+     * @param cell  the index of the cell
+     * @param pStimulus  the new stimulus
+     */
+    void SetStimulusFunction(unsigned cell, boost::shared_ptr<AbstractStimulusFunction> pStimulus);
+
+    /**
+     * @return the intracellular stimulus for a cell.
+     *
+     * @param cell  the index of the cell
+     */
+    boost::shared_ptr<AbstractStimulusFunction> GetStimulusFunction(unsigned cell);
+
+    /**
+     * @return the value of a state variable of a cell.
+     *
+     * @param cell  the index of the cell
+     * @param index  the index of the state variable
+     */
+    double GetStateVariable(unsigned cell, unsigned index) const;
+
+    /**
+     * Set the value of a state variable of a cell.
+     *
+     * @param cell  the index of the cell
+     * @param index  the index of the state variable
+     * @param value  the new value
+     */
+    void SetStateVariable(unsigned cell, unsigned index, double value);
+
+    /**
+     * @return all the state variables of a cell.
+     *
+     * @param cell  the index of the cell
+     */
+    std::vector<double> GetStdVecStateVariables(unsigned cell) const;
+
+    /**
+     * Set all the state variables of a cell.
+     *
+     * @param cell  the index of the cell
+     * @param rVariables  the new values
+     */
+    void SetStateVariables(unsigned cell, const std::vector<double>& rVariables);
+
+    /**
+     * @return the value of a parameter of a cell.
+     *
+     * @param cell  the index of the cell
+     * @param index  the index of the parameter
+     */
+    double GetParameter(unsigned cell, unsigned index) const;
+
+    /**
+     * Set the value of a parameter of a cell.
+     *
+     * @param cell  the index of the cell
+     * @param index  the index of the parameter
+     * @param value  the new value
+     */
+    void SetParameter(unsigned cell, unsigned index, double value);
+
+    /**
+     * @return the transmembrane potential of a cell.
+     *
+     * @param cell  the index of the cell
+     */
+    double GetVoltage(unsigned cell) const;
+
+    /**
+     * Set the transmembrane potential of a cell.
+     *
+     * @param cell  the index of the cell
+     * @param voltage  the new value
+     */
+    void SetVoltage(unsigned cell, double voltage);
+
+    /**
+     * Compute the total ionic current (excluding the stimulus) for a range of cells.
+     *
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param pIIonic  array in which to store the ionic current of cell c at position c-begin
+     */
+    virtual void ComputeIIonic(unsigned begin, unsigned end, double* pIIonic)=0;
+
+    /**
+     * @return the total ionic current (excluding the stimulus) for a single cell.
+     *
+     * @param cell  the index of the cell
+     */
+    double GetIIonic(unsigned cell);
+
+    /**
+     * @return the total ionic current (excluding the stimulus) of a cell with the given state
+     * variables in place of its own, as needed for state variable interpolation.  The cell's
+     * own state is restored afterwards.
+     *
+     * @param cell  the index of the cell, whose parameters are used
+     * @param rStateVariables  the state variables at which to evaluate the current
+     */
+    double GetIIonic(unsigned cell, const std::vector<double>& rStateVariables);
+
+    /**
+     * @return the index of the first cell in a range with a state variable that is NaN, or
+     * end if all are valid.  Used to report which cell failed after a solve throws.
+     *
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     */
+    unsigned FindFirstInvalidCell(unsigned begin, unsigned end) const;
+
+    /**
+     * Simulate a range of cells between tStart and tEnd with timestep #mDt, keeping
+     * the transmembrane potential fixed.
+     *
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void ComputeExceptVoltage(unsigned begin, unsigned end, double tStart, double tEnd);
+
+    /**
+     * Simulate a range of cells between tStart and tEnd with timestep #mDt, including
+     * the transmembrane potential.
+     *
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void SolveAndUpdateState(unsigned begin, unsigned end, double tStart, double tEnd);
+};
+
+#endif /*ABSTRACTBATCHEDCARDIACCELLS_HPP_*/
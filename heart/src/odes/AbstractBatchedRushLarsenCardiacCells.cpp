@@ -0,0 +1,112 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "AbstractBatchedRushLarsenCardiacCells.hpp"
+
+#include <cassert>
+#include <cmath>
+
+AbstractBatchedRushLarsenCardiacCells::AbstractBatchedRushLarsenCardiacCells(boost::shared_ptr<AbstractOdeSystemInformation> pSystemInfo,
+                                                                             unsigned voltageIndex,
+                                                                             const std::vector<double>& rDefaultParameters)
+    : AbstractBatchedCardiacCells(pSystemInfo, voltageIndex, rDefaultParameters),
+      mUpdateTypes(mStateVariables.size(), FORWARD_EULER),
+      mTimeConversionFactors(mStateVariables.size(), 1.0),
+      mAlphaOrTau(mStateVariables.size()),
+      mBetaOrInf(mStateVariables.size())
+{
+}
+
+AbstractBatchedRushLarsenCardiacCells::~AbstractBatchedRushLarsenCardiacCells()
+{
+}
+
+void AbstractBatchedRushLarsenCardiacCells::SetRushLarsenVariable(unsigned index, bool alphaBetaForm, double timeConversionFactor)
+{
+    assert(index < mStateVariables.size());
+    assert(index != mVoltageIndex);
+    mUpdateTypes[index] = alphaBetaForm ? ALPHA_BETA : TAU_INF;
+    mTimeConversionFactors[index] = timeConversionFactor;
+}
+
+void AbstractBatchedRushLarsenCardiacCells::AddCellWorkingMemory()
+{
+    AbstractBatchedCardiacCells::AddCellWorkingMemory();
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        mAlphaOrTau[i].push_back(0.0);
+        mBetaOrInf[i].push_back(0.0);
+    }
+}
+
+void AbstractBatchedRushLarsenCardiacCells::UpdateStateVariables(double dt, unsigned begin, unsigned end, bool updateVoltage)
+{
+    for (unsigned i=0; i<mStateVariables.size(); i++)
+    {
+        if (i == mVoltageIndex && !updateVoltage)
+        {
+            continue;
+        }
+        double* p_y = &(mStateVariables[i][0]);
+        const double* p_alpha_or_tau = &(mAlphaOrTau[i][0]);
+        const double* p_beta_or_inf = &(mBetaOrInf[i][0]);
+        const double scaled_dt = dt*mTimeConversionFactors[i];
+        switch (mUpdateTypes[i])
+        {
+            case ALPHA_BETA:
+                for (unsigned c=begin; c<end; c++)
+                {
+                    const double tau_inv = p_alpha_or_tau[c] + p_beta_or_inf[c];
+                    const double y_inf = p_alpha_or_tau[c]/tau_inv;
+                    p_y[c] = y_inf + (p_y[c] - y_inf)*exp(-scaled_dt*tau_inv);
+                }
+                break;
+            case TAU_INF:
+                for (unsigned c=begin; c<end; c++)
+                {
+                    p_y[c] = p_beta_or_inf[c] + (p_y[c] - p_beta_or_inf[c])*exp(-scaled_dt/p_alpha_or_tau[c]);
+                }
+                break;
+            default:
+            {
+                const double* p_dy = &(mDerivatives[i][0]);
+                for (unsigned c=begin; c<end; c++)
+                {
+                    p_y[c] += dt*p_dy[c];
+                }
+            }
+        }
+    }
+}
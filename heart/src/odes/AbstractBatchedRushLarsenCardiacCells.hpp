@@ -0,0 +1,133 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ABSTRACTBATCHEDRUSHLARSENCARDIACCELLS_HPP_
+#define ABSTRACTBATCHEDRUSHLARSENCARDIACCELLS_HPP_
+
+#include "AbstractBatchedCardiacCells.hpp"
+
+/**
+ * Base class for a block of cardiac cells solved using the Rush-Larsen method.
+ *
+ * Concrete subclasses mark the gating variables (or similar) eligible for a Rush-Larsen
+ * update with SetRushLarsenVariable, and their EvaluateYDerivatives fills in
+ * #mAlphaOrTau and #mBetaOrInf for those variables, and #mDerivatives for the others.
+ * Each timestep then:
+ *  \li updates any eligible gating variables with the Rush-Larsen scheme;
+ *  \li updates the other state variables with forward Euler.
+ *
+ * This is the batched equivalent of AbstractRushLarsenCardiacCell, and is the base class
+ * of cell models generated by PyCml with "-t BatchedChaste --rush-larsen".
+ */
+class AbstractBatchedRushLarsenCardiacCells : public AbstractBatchedCardiacCells
+{
+private:
+
+    /** How each state variable is updated. */
+    typedef enum
+    {
+        FORWARD_EULER=0,
+        ALPHA_BETA,
+        TAU_INF
+    } UpdateType;
+
+    /** How each state variable is updated. */
+    std::vector<UpdateType> mUpdateTypes;
+
+    /**
+     * For each Rush-Larsen variable, the factor converting the model's time units to
+     * those of the timestep (usually 1).
+     */
+    std::vector<double> mTimeConversionFactors;
+
+protected:
+
+    /**
+     * For each Rush-Larsen variable, the opening rate alpha or time constant tau, in the
+     * same layout as #mStateVariables.
+     */
+    std::vector<std::vector<double> > mAlphaOrTau;
+
+    /**
+     * For each Rush-Larsen variable, the closing rate beta or steady-state value, in the
+     * same layout as #mStateVariables.
+     */
+    std::vector<std::vector<double> > mBetaOrInf;
+
+    /**
+     * Mark a state variable as eligible for a Rush-Larsen update.
+     *
+     * @param index  the index of the state variable
+     * @param alphaBetaForm  true if the ODE is given by opening and closing rates,
+     *     false if it is given by a time constant and steady-state value
+     * @param timeConversionFactor  factor converting the model's time units to those of the timestep
+     */
+    void SetRushLarsenVariable(unsigned index, bool alphaBetaForm, double timeConversionFactor=1.0);
+
+    /**
+     * Update the state variables of a range of cells by one timestep, using Rush-Larsen
+     * for the eligible variables and forward Euler for the others.
+     *
+     * @param dt  the timestep
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param updateVoltage  whether to update the transmembrane potential
+     */
+    void UpdateStateVariables(double dt, unsigned begin, unsigned end, bool updateVoltage);
+
+    /**
+     * Extend the per-cell working memory, including #mAlphaOrTau and #mBetaOrInf,
+     * for a newly added cell.
+     */
+    void AddCellWorkingMemory();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pSystemInfo  information about the cell model
+     * @param voltageIndex  the index of the transmembrane potential within the state variables
+     * @param rDefaultParameters  default values of the model parameters (may be empty)
+     */
+    AbstractBatchedRushLarsenCardiacCells(boost::shared_ptr<AbstractOdeSystemInformation> pSystemInfo,
+                                          unsigned voltageIndex,
+                                          const std::vector<double>& rDefaultParameters=std::vector<double>());
+
+    /** Virtual destructor. */
+    virtual ~AbstractBatchedRushLarsenCardiacCells();
+};
+
+#endif /*ABSTRACTBATCHEDRUSHLARSENCARDIACCELLS_HPP_*/
@@ -292,9 +292,13 @@ public:
      * Set the intracellular stimulus.
      * This should have units of uA/cm^2 for single-cell problems,
      * or uA/cm^3 in a tissue simulation.
+     *
+     * Virtual so that cells which keep their stimulus elsewhere (e.g. BatchedCardiacCellView)
+     * can update it there too.
+     *
      * @param pStimulus  new stimulus function
      */
-    void SetIntracellularStimulusFunction(boost::shared_ptr<AbstractStimulusFunction> pStimulus);
+    virtual void SetIntracellularStimulusFunction(boost::shared_ptr<AbstractStimulusFunction> pStimulus);
 
     /**
      * @return the value of the intracellular stimulus.
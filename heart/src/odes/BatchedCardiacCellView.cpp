@@ -0,0 +1,193 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BatchedCardiacCellView.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "Exception.hpp"
+#include "OdeSolution.hpp"
+
+BatchedCardiacCellView::BatchedCardiacCellView(boost::shared_ptr<AbstractBatchedCardiacCells> pBatch,
+                                               boost::shared_ptr<AbstractStimulusFunction> pIntracellularStimulus)
+    : AbstractCardiacCellInterface(boost::shared_ptr<AbstractIvpOdeSolver>(),
+                                   pBatch->GetVoltageIndex(),
+                                   pIntracellularStimulus),
+      mpBatch(pBatch)
+{
+    mIndex = mpBatch->AddCell(pIntracellularStimulus);
+}
+
+BatchedCardiacCellView::~BatchedCardiacCellView()
+{
+}
+
+boost::shared_ptr<AbstractBatchedCardiacCells> BatchedCardiacCellView::GetBatch()
+{
+    return mpBatch;
+}
+
+unsigned BatchedCardiacCellView::GetIndexInBatch() const
+{
+    return mIndex;
+}
+
+void BatchedCardiacCellView::SetIntracellularStimulusFunction(boost::shared_ptr<AbstractStimulusFunction> pStimulus)
+{
+    AbstractCardiacCellInterface::SetIntracellularStimulusFunction(pStimulus);
+    mpBatch->SetStimulusFunction(mIndex, pStimulus);
+}
+
+void BatchedCardiacCellView::SetTimestep(double dt)
+{
+    mpBatch->SetTimestep(dt);
+}
+
+unsigned BatchedCardiacCellView::GetNumberOfStateVariables() const
+{
+    return mpBatch->GetNumberOfStateVariables();
+}
+
+unsigned BatchedCardiacCellView::GetNumberOfParameters() const
+{
+    return mpBatch->GetNumberOfParameters();
+}
+
+std::vector<double> BatchedCardiacCellView::GetStdVecStateVariables()
+{
+    return mpBatch->GetStdVecStateVariables(mIndex);
+}
+
+const std::vector<std::string>& BatchedCardiacCellView::rGetStateVariableNames() const
+{
+    return mpBatch->GetSystemInformation()->rGetStateVariableNames();
+}
+
+void BatchedCardiacCellView::SetStateVariables(const std::vector<double>& rVariables)
+{
+    mpBatch->SetStateVariables(mIndex, rVariables);
+}
+
+void BatchedCardiacCellView::SetStateVariable(unsigned index, double newValue)
+{
+    mpBatch->SetStateVariable(mIndex, index, newValue);
+}
+
+void BatchedCardiacCellView::SetStateVariable(const std::string& rName, double newValue)
+{
+    mpBatch->SetStateVariable(mIndex, mpBatch->GetSystemInformation()->GetStateVariableIndex(rName), newValue);
+}
+
+double BatchedCardiacCellView::GetAnyVariable(const std::string& rName, double time)
+{
+    boost::shared_ptr<const AbstractOdeSystemInformation> p_info = mpBatch->GetSystemInformation();
+    if (p_info->HasStateVariable(rName))
+    {
+        return mpBatch->GetStateVariable(mIndex, p_info->GetStateVariableIndex(rName));
+    }
+    return GetParameter(rName);
+}
+
+double BatchedCardiacCellView::GetParameter(const std::string& rParameterName)
+{
+    return mpBatch->GetParameter(mIndex, mpBatch->GetSystemInformation()->GetParameterIndex(rParameterName));
+}
+
+double BatchedCardiacCellView::GetParameter(unsigned parameterIndex)
+{
+    return mpBatch->GetParameter(mIndex, parameterIndex);
+}
+
+void BatchedCardiacCellView::SetParameter(const std::string& rParameterName, double value)
+{
+    mpBatch->SetParameter(mIndex, mpBatch->GetSystemInformation()->GetParameterIndex(rParameterName), value);
+}
+
+void BatchedCardiacCellView::SolveAndUpdateState(double tStart, double tEnd)
+{
+    mpBatch->SolveAndUpdateState(mIndex, mIndex+1, tStart, tEnd);
+}
+
+OdeSolution BatchedCardiacCellView::Compute(double tStart, double tEnd, double tSamp)
+{
+    const double dt = mpBatch->GetTimestep();
+    if (tSamp < dt)
+    {
+        tSamp = dt;
+    }
+    const unsigned n_steps = (unsigned) floor((tEnd - tStart)/tSamp + 0.5);
+    assert(fabs(tStart+n_steps*tSamp - tEnd) < 1e-12);
+
+    OdeSolution solutions;
+    solutions.SetNumberOfTimeSteps(n_steps);
+    solutions.rGetSolutions().push_back(GetStdVecStateVariables());
+    solutions.rGetTimes().push_back(tStart);
+    solutions.SetOdeSystemInformation(mpBatch->GetSystemInformation());
+
+    for (unsigned i=0; i<n_steps; i++)
+    {
+        const double t_start = tStart + i*tSamp;
+        mpBatch->SolveAndUpdateState(mIndex, mIndex+1, t_start, t_start + tSamp);
+        solutions.rGetSolutions().push_back(GetStdVecStateVariables());
+        solutions.rGetTimes().push_back(t_start + tSamp);
+    }
+    return solutions;
+}
+
+void BatchedCardiacCellView::ComputeExceptVoltage(double tStart, double tEnd)
+{
+    mpBatch->ComputeExceptVoltage(mIndex, mIndex+1, tStart, tEnd);
+}
+
+double BatchedCardiacCellView::GetIIonic(const std::vector<double>* pStateVariables)
+{
+    if (pStateVariables != NULL)
+    {
+        return mpBatch->GetIIonic(mIndex, *pStateVariables);
+    }
+    return mpBatch->GetIIonic(mIndex);
+}
+
+void BatchedCardiacCellView::SetVoltage(double voltage)
+{
+    mpBatch->SetVoltage(mIndex, voltage);
+}
+
+double BatchedCardiacCellView::GetVoltage()
+{
+    return mpBatch->GetVoltage(mIndex);
+}
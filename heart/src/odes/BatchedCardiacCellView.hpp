@@ -0,0 +1,212 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BATCHEDCARDIACCELLVIEW_HPP_
+#define BATCHEDCARDIACCELLVIEW_HPP_
+
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractCardiacCellInterface.hpp"
+#include "AbstractBatchedCardiacCells.hpp"
+
+/**
+ * A single cell within an AbstractBatchedCardiacCells object, presented through the
+ * usual AbstractCardiacCellInterface.  The view stores no state of its own; all
+ * methods forward to the batch.
+ *
+ * Constructing a view adds a new cell to the batch.  Cell factories which want tissue
+ * simulations to use batched cells should return views onto a single batch from
+ * CreateCardiacCellForTissueNode.  AbstractCardiacTissue detects this, and solves all
+ * its cells with one call to the batch instead of one call per cell.
+ *
+ * The batch holds the stimulus used in its solves; SetIntracellularStimulusFunction
+ * updates it there as well as in the view.  Views cannot be checkpointed.
+ */
+class BatchedCardiacCellView : public AbstractCardiacCellInterface
+{
+private:
+
+    /** The batch containing this cell. */
+    boost::shared_ptr<AbstractBatchedCardiacCells> mpBatch;
+
+    /** The index of this cell within the batch. */
+    unsigned mIndex;
+
+public:
+
+    /**
+     * Constructor.  Adds a new cell to the batch.
+     *
+     * @param pBatch  the batch to add the cell to
+     * @param pIntracellularStimulus  the intracellular stimulus for the cell
+     */
+    BatchedCardiacCellView(boost::shared_ptr<AbstractBatchedCardiacCells> pBatch,
+                           boost::shared_ptr<AbstractStimulusFunction> pIntracellularStimulus);
+
+    /** Destructor. */
+    virtual ~BatchedCardiacCellView();
+
+    /** @return the batch containing this cell. */
+    boost::shared_ptr<AbstractBatchedCardiacCells> GetBatch();
+
+    /** @return the index of this cell within its batch. */
+    unsigned GetIndexInBatch() const;
+
+    /**
+     * Set the intracellular stimulus of this cell, both in the view and in the batch.
+     *
+     * @param pStimulus  new stimulus function
+     */
+    void SetIntracellularStimulusFunction(boost::shared_ptr<AbstractStimulusFunction> pStimulus);
+
+    /**
+     * Set the ODE timestep.  Note that this is shared by all cells in the batch.
+     *
+     * @param dt  the timestep
+     */
+    void SetTimestep(double dt);
+
+    /** @return the number of state variables. */
+    unsigned GetNumberOfStateVariables() const;
+
+    /** @return the number of parameters. */
+    unsigned GetNumberOfParameters() const;
+
+    /** @return a copy of the state variables of this cell. */
+    std::vector<double> GetStdVecStateVariables();
+
+    /** @return the names of the state variables. */
+    const std::vector<std::string>& rGetStateVariableNames() const;
+
+    /**
+     * Set the state variables of this cell.
+     *
+     * @param rVariables  the new values
+     */
+    void SetStateVariables(const std::vector<double>& rVariables);
+
+    /**
+     * Set a state variable of this cell.
+     *
+     * @param index  the index of the state variable
+     * @param newValue  the new value
+     */
+    void SetStateVariable(unsigned index, double newValue);
+
+    /**
+     * Set a state variable of this cell.
+     *
+     * @param rName  the name of the state variable
+     * @param newValue  the new value
+     */
+    void SetStateVariable(const std::string& rName, double newValue);
+
+    /**
+     * @return the value of a state variable or parameter of this cell.
+     *
+     * @param rName  the name of the variable
+     * @param time  the current time (unused)
+     */
+    double GetAnyVariable(const std::string& rName, double time=0.0);
+
+    /**
+     * @return the value of a parameter of this cell.
+     *
+     * @param rParameterName  the name of the parameter
+     */
+    double GetParameter(const std::string& rParameterName);
+
+    /**
+     * @return the value of a parameter of this cell.
+     *
+     * @param parameterIndex  the index of the parameter
+     */
+    double GetParameter(unsigned parameterIndex);
+
+    /**
+     * Set a parameter of this cell.
+     *
+     * @param rParameterName  the name of the parameter
+     * @param value  the new value
+     */
+    void SetParameter(const std::string& rParameterName, double value);
+
+    /**
+     * Simulate this cell between tStart and tEnd, including the transmembrane potential.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void SolveAndUpdateState(double tStart, double tEnd);
+
+    /**
+     * Simulate this cell between tStart and tEnd, recording the state at intervals of tSamp.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     * @param tSamp  sampling interval for returned results (defaults to the ODE timestep)
+     * @return the values of each state variable at intervals of tSamp
+     */
+    OdeSolution Compute(double tStart, double tEnd, double tSamp=0.0);
+
+    /**
+     * Simulate this cell between tStart and tEnd, keeping the transmembrane potential fixed.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void ComputeExceptVoltage(double tStart, double tEnd);
+
+    /**
+     * @return the total ionic current of this cell.
+     *
+     * @param pStateVariables  optional state at which to compute the current (as used for state
+     *     variable interpolation); if NULL, the current state of the cell is used
+     */
+    double GetIIonic(const std::vector<double>* pStateVariables=NULL);
+
+    /**
+     * Set the transmembrane potential of this cell.
+     *
+     * @param voltage  the new value
+     */
+    void SetVoltage(double voltage);
+
+    /** @return the transmembrane potential of this cell. */
+    double GetVoltage();
+};
+
+#endif /*BATCHEDCARDIACCELLVIEW_HPP_*/
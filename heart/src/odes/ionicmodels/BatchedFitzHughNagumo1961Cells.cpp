@@ -0,0 +1,106 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BatchedFitzHughNagumo1961Cells.hpp"
+#include "OdeSystemInformation.hpp"
+
+//
+// Model-scope constant parameters
+//
+const double BatchedFitzHughNagumo1961Cells::mAlpha = -0.08;
+const double BatchedFitzHughNagumo1961Cells::mGamma = 3.00;
+const double BatchedFitzHughNagumo1961Cells::mEpsilon = 0.005;
+
+BatchedFitzHughNagumo1961Cells::BatchedFitzHughNagumo1961Cells()
+    : AbstractBatchedCardiacCells(OdeSystemInformation<BatchedFitzHughNagumo1961Cells>::Instance(), 0)
+{
+}
+
+BatchedFitzHughNagumo1961Cells::~BatchedFitzHughNagumo1961Cells()
+{
+}
+
+void BatchedFitzHughNagumo1961Cells::EvaluateYDerivatives(double time, unsigned begin, unsigned end)
+{
+    const double* p_membrane_V = &(mStateVariables[0][0]); // v
+    const double* p_recovery_variable = &(mStateVariables[1][0]); // w
+    const double* p_i_stim = &(mAreaStimulus[0]);
+    double* p_membrane_V_prime = &(mDerivatives[0][0]);
+    double* p_recovery_variable_prime = &(mDerivatives[1][0]);
+
+    for (unsigned c=begin; c<end; c++)
+    {
+        const double membrane_V = p_membrane_V[c];
+        const double recovery_variable = p_recovery_variable[c];
+
+        // dV/dt
+        p_membrane_V_prime[c] = membrane_V*(membrane_V-mAlpha)*(1-membrane_V)-recovery_variable+p_i_stim[c];
+
+        // dw/dt
+        p_recovery_variable_prime[c] = mEpsilon*(membrane_V-mGamma*recovery_variable);
+    }
+}
+
+void BatchedFitzHughNagumo1961Cells::ComputeIIonic(unsigned begin, unsigned end, double* pIIonic)
+{
+    const double* p_membrane_V = &(mStateVariables[0][0]);
+    const double* p_recovery_variable = &(mStateVariables[1][0]);
+
+    for (unsigned c=begin; c<end; c++)
+    {
+        const double membrane_V = p_membrane_V[c];
+        pIIonic[c-begin] = membrane_V*(membrane_V-mAlpha)*(1-membrane_V)-p_recovery_variable[c];
+    }
+}
+
+template<>
+void OdeSystemInformation<BatchedFitzHughNagumo1961Cells>::Initialise(void)
+{
+    /*
+     * State variables
+     */
+    this->mVariableNames.push_back("V");
+    this->mVariableUnits.push_back("mV");
+    this->mInitialConditions.push_back(0.0);
+
+    this->mVariableNames.push_back("w");
+    this->mVariableUnits.push_back("");
+    this->mInitialConditions.push_back(0.0);
+
+    this->mSystemName = "FitzHughNagumo1961";
+
+    this->mInitialised = true;
+}
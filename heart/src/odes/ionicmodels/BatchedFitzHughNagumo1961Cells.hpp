@@ -0,0 +1,88 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BATCHEDFITZHUGHNAGUMO1961CELLS_HPP_
+#define BATCHEDFITZHUGHNAGUMO1961CELLS_HPP_
+
+#include "AbstractBatchedCardiacCells.hpp"
+
+/**
+ * The FitzHugh-Nagumo system of ODEs (see FitzHughNagumo1961OdeSystem), for a batch
+ * of cells stored in structure-of-arrays layout.
+ *
+ * This is a hand-written example of the batched cell model interface
+ * AbstractBatchedCardiacCells, and gives the same results as FitzHughNagumo1961OdeSystem
+ * solved with an EulerIvpOdeSolver.
+ */
+class BatchedFitzHughNagumo1961Cells : public AbstractBatchedCardiacCells
+{
+private:
+    static const double mAlpha; /**< Constant parameter alpha */
+    static const double mGamma; /**< Constant parameter gamma */
+    static const double mEpsilon; /**< Constant parameter epsilon */
+
+protected:
+    /**
+     * Compute the RHS of the FitHugh-Nagumo system of ODEs for a range of cells.
+     *
+     * @param time  the current time, in milliseconds
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     */
+    void EvaluateYDerivatives(double time, unsigned begin, unsigned end);
+
+public:
+    /**
+     * Constructor.  Cells are added with AddCell.
+     */
+    BatchedFitzHughNagumo1961Cells();
+
+    /**
+     * Destructor
+     */
+    ~BatchedFitzHughNagumo1961Cells();
+
+    /**
+     * Calculate the ionic current for a range of cells.
+     *
+     * @param begin  index of the first cell
+     * @param end  one past the index of the last cell
+     * @param pIIonic  array in which to store the ionic current of cell c at position c-begin
+     */
+    void ComputeIIonic(unsigned begin, unsigned end, double* pIIonic);
+};
+
+#endif //BATCHEDFITZHUGHNAGUMO1961CELLS_HPP_
@@ -76,34 +76,29 @@ void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WritePostProcessingFiles()
 
     // Please note that only the master processor should write to file.
     // Each of the private methods called here takes care of checking.
+
+    // Maps which only need the voltages at each node are calculated together in one pass through the data
+    std::vector<std::pair<double,double> > apd_maps;
     if (HeartConfig::Instance()->IsApdMapsRequested())
     {
-        std::vector<std::pair<double,double> > apd_maps;
         HeartConfig::Instance()->GetApdMaps(apd_maps);
-        for (unsigned i=0; i<apd_maps.size(); i++)
-        {
-            WriteApdMapFile(apd_maps[i].first, apd_maps[i].second);
-        }
     }
 
+    std::vector<double> upstroke_time_maps;
     if (HeartConfig::Instance()->IsUpstrokeTimeMapsRequested())
     {
-        std::vector<double> upstroke_time_maps;
         HeartConfig::Instance()->GetUpstrokeTimeMaps(upstroke_time_maps);
-        for (unsigned i=0; i<upstroke_time_maps.size(); i++)
-        {
-            WriteUpstrokeTimeMap(upstroke_time_maps[i]);
-        }
     }
 
+    std::vector<double> upstroke_velocity_maps;
     if (HeartConfig::Instance()->IsMaxUpstrokeVelocityMapRequested())
     {
-        std::vector<double> upstroke_velocity_maps;
         HeartConfig::Instance()->GetMaxUpstrokeVelocityMaps(upstroke_velocity_maps);
-        for (unsigned i=0; i<upstroke_velocity_maps.size(); i++)
-        {
-            WriteMaxUpstrokeVelocityMap(upstroke_velocity_maps[i]);
-        }
+    }
+
+    if (!apd_maps.empty() || !upstroke_time_maps.empty() || !upstroke_velocity_maps.empty())
+    {
+        WriteNodeMaps(apd_maps, upstroke_time_maps, upstroke_velocity_maps);
     }
 
     if (HeartConfig::Instance()->IsConductionVelocityMapsRequested())
@@ -247,67 +242,109 @@ void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteOutputDataToHdf5(const s
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteApdMapFile(double repolarisationPercentage, double threshold)
 {
-    std::vector<std::vector<double> > local_output_data = mpCalculator->CalculateAllActionPotentialDurationsForNodeRange(repolarisationPercentage, mLo, mHi, threshold);
-
-    // HDF5 shouldn't have minus signs in the data names..
-    std::stringstream hdf5_dataset_name;
-    hdf5_dataset_name << "Apd_" << repolarisationPercentage;
-
-    WriteOutputDataToHdf5(local_output_data,
-                          hdf5_dataset_name.str() + ConvertToHdf5FriendlyString(threshold) + "_Map",
-                          "msec");
+    std::vector<std::pair<double,double> > apd_maps(1, std::make_pair(repolarisationPercentage, threshold));
+    WriteNodeMaps(apd_maps, std::vector<double>(), std::vector<double>());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteUpstrokeTimeMap(double threshold)
 {
-    std::vector<std::vector<double> > output_data;
-    //Fill in data
-    for (unsigned node_index = mLo; node_index < mHi; node_index++)
-    {
-        std::vector<double> upstroke_times;
-        try
-        {
-            upstroke_times = mpCalculator->CalculateUpstrokeTimes(node_index, threshold);
-            assert(upstroke_times.size() != 0);
-        }
-        catch(Exception&)
-        {
-            upstroke_times.push_back(0);
-            assert(upstroke_times.size() == 1);
-        }
-        output_data.push_back(upstroke_times);
-    }
-
-    WriteOutputDataToHdf5(output_data,
-                          "UpstrokeTimeMap" + ConvertToHdf5FriendlyString(threshold),
-                          "msec");
+    WriteNodeMaps(std::vector<std::pair<double,double> >(), std::vector<double>(1, threshold), std::vector<double>());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteMaxUpstrokeVelocityMap(double threshold)
 {
-    std::vector<std::vector<double> > output_data;
-    //Fill in data
+    WriteNodeMaps(std::vector<std::pair<double,double> >(), std::vector<double>(), std::vector<double>(1, threshold));
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteNodeMaps(const std::vector<std::pair<double,double> >& rApdMaps,
+                                                                 const std::vector<double>& rUpstrokeTimeMaps,
+                                                                 const std::vector<double>& rUpstrokeVelocityMaps)
+{
+    std::vector<std::vector<std::vector<double> > > apd_data(rApdMaps.size());
+    std::vector<std::vector<std::vector<double> > > upstroke_time_data(rUpstrokeTimeMaps.size());
+    std::vector<std::vector<std::vector<double> > > upstroke_velocity_data(rUpstrokeVelocityMaps.size());
+
+    //Fill in data, visiting nodes in order so that the calculator reads each block of voltages once
     for (unsigned node_index = mLo; node_index < mHi; node_index++)
     {
-        std::vector<double> upstroke_velocities;
-        try
+        for (unsigned i=0; i<rApdMaps.size(); i++)
         {
-            upstroke_velocities = mpCalculator->CalculateAllMaximumUpstrokeVelocities(node_index, threshold);
-            assert(upstroke_velocities.size() != 0);
+            std::vector<double> apds;
+            try
+            {
+                apds = mpCalculator->CalculateAllActionPotentialDurations(rApdMaps[i].first, node_index, rApdMaps[i].second);
+                assert(apds.size() != 0);
+            }
+            catch (Exception& e)
+            {
+                assert(e.GetShortMessage()=="No full action potential was recorded" ||
+                       e.GetShortMessage()=="AP did not occur, never exceeded threshold voltage.");
+                apds.push_back(0);
+                assert(apds.size() == 1);
+            }
+            apd_data[i].push_back(apds);
         }
-        catch(Exception&)
+
+        for (unsigned i=0; i<rUpstrokeTimeMaps.size(); i++)
         {
-            upstroke_velocities.push_back(0);
-            assert(upstroke_velocities.size() ==1);
+            std::vector<double> upstroke_times;
+            try
+            {
+                upstroke_times = mpCalculator->CalculateUpstrokeTimes(node_index, rUpstrokeTimeMaps[i]);
+                assert(upstroke_times.size() != 0);
+            }
+            catch(Exception&)
+            {
+                upstroke_times.push_back(0);
+                assert(upstroke_times.size() == 1);
+            }
+            upstroke_time_data[i].push_back(upstroke_times);
+        }
+
+        for (unsigned i=0; i<rUpstrokeVelocityMaps.size(); i++)
+        {
+            std::vector<double> upstroke_velocities;
+            try
+            {
+                upstroke_velocities = mpCalculator->CalculateAllMaximumUpstrokeVelocities(node_index, rUpstrokeVelocityMaps[i]);
+                assert(upstroke_velocities.size() != 0);
+            }
+            catch(Exception&)
+            {
+                upstroke_velocities.push_back(0);
+                assert(upstroke_velocities.size() ==1);
+            }
+            upstroke_velocity_data[i].push_back(upstroke_velocities);
         }
-        output_data.push_back(upstroke_velocities);
     }
 
-    WriteOutputDataToHdf5(output_data,
-                          "MaxUpstrokeVelocityMap" + ConvertToHdf5FriendlyString(threshold),
-                          "mV_per_msec");
+    for (unsigned i=0; i<rApdMaps.size(); i++)
+    {
+        // HDF5 shouldn't have minus signs in the data names..
+        std::stringstream hdf5_dataset_name;
+        hdf5_dataset_name << "Apd_" << rApdMaps[i].first;
+
+        WriteOutputDataToHdf5(apd_data[i],
+                              hdf5_dataset_name.str() + ConvertToHdf5FriendlyString(rApdMaps[i].second) + "_Map",
+                              "msec");
+    }
+
+    for (unsigned i=0; i<rUpstrokeTimeMaps.size(); i++)
+    {
+        WriteOutputDataToHdf5(upstroke_time_data[i],
+                              "UpstrokeTimeMap" + ConvertToHdf5FriendlyString(rUpstrokeTimeMaps[i]),
+                              "msec");
+    }
+
+    for (unsigned i=0; i<rUpstrokeVelocityMaps.size(); i++)
+    {
+        WriteOutputDataToHdf5(upstroke_velocity_data[i],
+                              "MaxUpstrokeVelocityMap" + ConvertToHdf5FriendlyString(rUpstrokeVelocityMaps[i]),
+                              "mV_per_msec");
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -185,6 +185,21 @@ private:
      */
     void WriteMaxUpstrokeVelocityMap(double threshold);
 
+    /**
+     * Calculate any number of APD, upstroke time and maximum upstroke velocity maps in a single
+     * pass over this process's nodes, and write them out as in WriteApdMapFile(),
+     * WriteUpstrokeTimeMap() and WriteMaxUpstrokeVelocityMap().  The voltages are streamed
+     * from the HDF5 file in blocks of nodes (see PropagationPropertiesCalculator::GetNumNodesPerBlock),
+     * so each chunk of the dataset is read only once however many maps are requested.
+     *
+     * @param rApdMaps  pairs of (repolarisation percentage, threshold) for the APD maps
+     * @param rUpstrokeTimeMaps  thresholds for the upstroke time maps
+     * @param rUpstrokeVelocityMaps  thresholds for the maximum upstroke velocity maps
+     */
+    void WriteNodeMaps(const std::vector<std::pair<double,double> >& rApdMaps,
+                       const std::vector<double>& rUpstrokeTimeMaps,
+                       const std::vector<double>& rUpstrokeVelocityMaps);
+
     /**
      * Write out conduction velocity map from the given node the rest of the mesh:
      *
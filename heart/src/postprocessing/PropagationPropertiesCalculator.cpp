@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PropagationPropertiesCalculator.hpp"
 #include "CellProperties.hpp"
 #include "Exception.hpp"
+#include <algorithm>
 #include <sstream>
 #include "HeartEventHandler.hpp"
 
@@ -45,7 +46,9 @@ PropagationPropertiesCalculator::PropagationPropertiesCalculator(Hdf5DataReader*
     : mpDataReader(pDataReader),
       mVoltageName(voltageName),
       mTimes(mpDataReader->GetUnlimitedDimensionValues()),
-      mCachedNodeGlobalIndex(UNSIGNED_UNSET)
+      mCachedNodeGlobalIndex(UNSIGNED_UNSET),
+      mCachedBlockLowIndex(UNSIGNED_UNSET),
+      mNumNodesPerBlock(0u)
 {}
 
 PropagationPropertiesCalculator::~PropagationPropertiesCalculator()
@@ -103,53 +106,26 @@ std::vector<std::vector<double> > PropagationPropertiesCalculator::CalculateAllA
 {
     std::vector<std::vector<double> > output_data;
     output_data.reserve(upperNodeIndex-lowerNodeIndex+1);
-    unsigned num_nodes_per_data_block = 100; // number of nodes
-    unsigned num_complete_blocks = (upperNodeIndex-lowerNodeIndex) / num_nodes_per_data_block;
-    unsigned size_last_block = (upperNodeIndex-lowerNodeIndex) % num_nodes_per_data_block;
 
-    for (unsigned block_num=0;
-         block_num<num_complete_blocks+1;
-         block_num++)
+    // Voltages are read in whole blocks of nodes by rGetCachedVoltages()
+    for (unsigned node_index=lowerNodeIndex; node_index<upperNodeIndex; node_index++)
     {
-        unsigned num_nodes_to_read;
-        if (block_num != num_complete_blocks)
+        std::vector<double>& r_voltages = rGetCachedVoltages(node_index);
+        CellProperties cell_props(r_voltages, mTimes, threshold);
+        std::vector<double> apds;
+        try
         {
-            num_nodes_to_read = num_nodes_per_data_block;
+            apds = cell_props.GetAllActionPotentialDurations(percentage);
+            assert(apds.size() != 0);
         }
-        else
+        catch (Exception& e)
         {
-            num_nodes_to_read = size_last_block;
-        }
-
-        if (num_nodes_to_read > 0)
-        {
-            // Read a big block of data
-            unsigned low_node = lowerNodeIndex + block_num*num_nodes_per_data_block;
-            unsigned high_node = low_node + num_nodes_to_read;
-            std::vector<std::vector<double> > voltages = mpDataReader->GetVariableOverTimeOverMultipleNodes(mVoltageName, low_node, high_node);
-
-            for (unsigned node_within_block=0;
-                 node_within_block < num_nodes_to_read;
-                 node_within_block++)
-            {
-                std::vector<double>& r_voltages = voltages[node_within_block];
-                CellProperties cell_props(r_voltages, mTimes, threshold);
-                std::vector<double> apds;
-                try
-                {
-                    apds = cell_props.GetAllActionPotentialDurations(percentage);
-                    assert(apds.size() != 0);
-                }
-                catch (Exception& e)
-                {
-                    assert(e.GetShortMessage()=="No full action potential was recorded" ||
-                           e.GetShortMessage()=="AP did not occur, never exceeded threshold voltage.");
-                    apds.push_back(0);
-                    assert(apds.size() == 1);
-                }
-                output_data.push_back(apds);
-            }
+            assert(e.GetShortMessage()=="No full action potential was recorded" ||
+                   e.GetShortMessage()=="AP did not occur, never exceeded threshold voltage.");
+            apds.push_back(0);
+            assert(apds.size() == 1);
         }
+        output_data.push_back(apds);
     }
     return output_data;
 }
@@ -174,11 +150,11 @@ double PropagationPropertiesCalculator::CalculateConductionVelocity(unsigned glo
 {
     double t_near = 0;
     double t_far = 0;
-    std::vector<double>& r_near_voltages = rGetCachedVoltages(globalNearNodeIndex);
-    std::vector<double> far_voltages = mpDataReader->GetVariableOverTime(mVoltageName, globalFarNodeIndex);
+    std::vector<double>& r_near_voltages = rGetCachedNodeVoltages(globalNearNodeIndex);
+    std::vector<double>& r_far_voltages = rGetCachedVoltages(globalFarNodeIndex);
 
     CellProperties near_cell_props(r_near_voltages, mTimes);
-    CellProperties far_cell_props(far_voltages, mTimes);
+    CellProperties far_cell_props(r_far_voltages, mTimes);
 
     //The size of each vector is the number of APs that reached that node
     unsigned aps_near_node = near_cell_props.GetMaxUpstrokeVelocities().size();
@@ -234,11 +210,11 @@ std::vector<double> PropagationPropertiesCalculator::CalculateAllConductionVeloc
     std::vector<double> t_far;
     unsigned number_of_aps = 0;
 
-    std::vector<double>& r_near_voltages = rGetCachedVoltages(globalNearNodeIndex);
-    std::vector<double> far_voltages = mpDataReader->GetVariableOverTime(mVoltageName, globalFarNodeIndex);
+    std::vector<double>& r_near_voltages = rGetCachedNodeVoltages(globalNearNodeIndex);
+    std::vector<double>& r_far_voltages = rGetCachedVoltages(globalFarNodeIndex);
 
     CellProperties near_cell_props(r_near_voltages, mTimes);
-    CellProperties far_cell_props(far_voltages, mTimes);
+    CellProperties far_cell_props(r_far_voltages, mTimes);
 
     t_near = near_cell_props.GetTimesAtMaxUpstrokeVelocity();
     t_far = far_cell_props.GetTimesAtMaxUpstrokeVelocity();
@@ -306,6 +282,34 @@ unsigned PropagationPropertiesCalculator::CalculateAboveThresholdDepolarisations
 
 
 std::vector<double>& PropagationPropertiesCalculator::rGetCachedVoltages(unsigned globalNodeIndex)
+{
+    if (mCachedBlockLowIndex != UNSIGNED_UNSET
+        && globalNodeIndex >= mCachedBlockLowIndex
+        && globalNodeIndex < mCachedBlockLowIndex + mCachedVoltageBlock.size())
+    {
+        return mCachedVoltageBlock[globalNodeIndex - mCachedBlockLowIndex];
+    }
+
+    // Incomplete datasets can only be read one node at a time (as can nodes which aren't there,
+    // so that the reader reports the error)
+    if (!mpDataReader->IsDataComplete() || globalNodeIndex >= mpDataReader->GetNumberOfRows())
+    {
+        return rGetCachedNodeVoltages(globalNodeIndex);
+    }
+
+    // Start the block on a chunk boundary, so that it covers whole chunks
+    unsigned num_nodes_per_block = GetNumNodesPerBlock();
+    unsigned rows_per_chunk = mpDataReader->GetNumberOfRowsPerChunk();
+    unsigned alignment = (num_nodes_per_block % rows_per_chunk == 0u) ? rows_per_chunk : 1u;
+    unsigned low_index = globalNodeIndex - globalNodeIndex % alignment;
+    unsigned high_index = std::min(low_index + num_nodes_per_block, mpDataReader->GetNumberOfRows());
+
+    mCachedVoltageBlock = mpDataReader->GetVariableOverTimeOverMultipleNodes(mVoltageName, low_index, high_index);
+    mCachedBlockLowIndex = low_index;
+    return mCachedVoltageBlock[globalNodeIndex - mCachedBlockLowIndex];
+}
+
+std::vector<double>& PropagationPropertiesCalculator::rGetCachedNodeVoltages(unsigned globalNodeIndex)
 {
     if (globalNodeIndex != mCachedNodeGlobalIndex)
     {
@@ -315,9 +319,40 @@ std::vector<double>& PropagationPropertiesCalculator::rGetCachedVoltages(unsigne
     return mCachedVoltages;
 }
 
+void PropagationPropertiesCalculator::ClearCaches()
+{
+    mCachedNodeGlobalIndex = UNSIGNED_UNSET;
+    mCachedVoltages.clear();
+    mCachedBlockLowIndex = UNSIGNED_UNSET;
+    mCachedVoltageBlock.clear();
+}
+
 void PropagationPropertiesCalculator::SetHdf5DataReader(Hdf5DataReader* pDataReader)
 {
     mpDataReader = pDataReader;
+    ClearCaches();
+}
+
+void PropagationPropertiesCalculator::SetNumNodesPerBlock(unsigned numNodes)
+{
+    mNumNodesPerBlock = numNodes;
+    mCachedBlockLowIndex = UNSIGNED_UNSET;
+    mCachedVoltageBlock.clear();
+}
+
+unsigned PropagationPropertiesCalculator::GetNumNodesPerBlock()
+{
+    if (mNumNodesPerBlock > 0u)
+    {
+        return mNumNodesPerBlock;
+    }
+
+    // Read as many whole chunks as fit in about 32 MB of voltages
+    const unsigned max_bytes_per_block = 32u*1024u*1024u;
+    unsigned rows_per_chunk = mpDataReader->GetNumberOfRowsPerChunk();
+    unsigned bytes_per_node = std::max(1u, (unsigned) mTimes.size()) * sizeof(double);
+    unsigned num_chunks = std::max(1u, max_bytes_per_block / bytes_per_node / rows_per_chunk);
+    return std::min(num_chunks*rows_per_chunk, std::max(1u, mpDataReader->GetNumberOfRows()));
 }
 
 
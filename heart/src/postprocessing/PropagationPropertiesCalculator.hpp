@@ -63,18 +63,41 @@ private:
     unsigned mCachedNodeGlobalIndex;
     /** The cached voltages vector */
     std::vector<double> mCachedVoltages;
+    /** The index of the first node in #mCachedVoltageBlock */
+    unsigned mCachedBlockLowIndex;
+    /** Voltages for a contiguous block of nodes, one vector per node */
+    std::vector<std::vector<double> > mCachedVoltageBlock;
+    /** How many nodes to read at once, or zero to choose from the dataset's chunk size */
+    unsigned mNumNodesPerBlock;
+
+    /** Forget all cached voltages, e.g. when the reader changes. */
+    void ClearCaches();
 
 protected:
+    /**
+     * @return the voltages vector for the given node, returning a reference to a cached vector.
+     *
+     * For complete datasets the voltages are read for a whole block of nodes (see
+     * GetNumNodesPerBlock()) aligned to the dataset's chunks, so that looping over nodes in
+     * order reads each chunk from disk only once.  The reference is only valid until a node
+     * outside the block is requested.
+     *
+     * @param globalNodeIndex  the index of the node to cache voltages for
+     */
+    std::vector<double>& rGetCachedVoltages(unsigned globalNodeIndex);
+
     /**
      * @return the voltages vector for the given node and cache it, returning a reference
      * to the cached vector.  If subsequently called with the same index, will return
-     * the cached vector without re-reading from file.
+     * the cached vector without re-reading from file.  Unlike rGetCachedVoltages() this is
+     * not affected by reading other blocks of nodes, so is used for the near node of
+     * conduction velocity calculations.
      *
      * Note: will only cache the last node index used.
      *
      * @param globalNodeIndex  the index of the node to cache voltages for
      */
-    std::vector<double>& rGetCachedVoltages(unsigned globalNodeIndex);
+    std::vector<double>& rGetCachedNodeVoltages(unsigned globalNodeIndex);
 
 public:
     /**
@@ -213,6 +236,19 @@ public:
      * @param pDataReader  An HDF5 data reader to use (needed if the existing one is deleted and a new one opened)
      */
     void SetHdf5DataReader(Hdf5DataReader* pDataReader);
+
+    /**
+     * Set how many nodes' voltages are read from file at once when looping over nodes.
+     *
+     * @param numNodes  the number of nodes per block, or zero (the default) to use whole
+     *     chunks of the dataset, up to about 32 MB of voltages
+     */
+    void SetNumNodesPerBlock(unsigned numNodes);
+
+    /**
+     * @return the number of nodes whose voltages are read from file at once.
+     */
+    unsigned GetNumNodesPerBlock();
 };
 
 #endif //_PROPAGATIONPROPERTIESCALCULATOR_HPP_
@@ -66,7 +66,9 @@ AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::AbstractCardiacProble
       mpTimeAdaptivityController(NULL),
       mpWriter(NULL),
       mUseHdf5DataWriterCache(false),
-      mHdf5DataWriterChunkSizeAndAlignment(0)
+      mHdf5DataWriterChunkSizeAndAlignment(0),
+      mHdf5DataWriterNumStagingBuffers(0u),
+      mHdf5DataWriterBlockWhenStagingFull(true)
 {
     assert(mNodesToOutput.empty());
     if (!mpCellFactory)
@@ -96,7 +98,9 @@ AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::AbstractCardiacProble
       mpTimeAdaptivityController(NULL),
       mpWriter(NULL),
       mUseHdf5DataWriterCache(false),
-      mHdf5DataWriterChunkSizeAndAlignment(0)
+      mHdf5DataWriterChunkSizeAndAlignment(0),
+      mHdf5DataWriterNumStagingBuffers(0u),
+      mHdf5DataWriterBlockWhenStagingFull(true)
 {
 }
 
@@ -843,7 +847,7 @@ bool AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::InitialiseWriter
                                   !extend_file, // don't clear directory if extension requested
                                   extend_file,
                                   "Data",
-                                  mUseHdf5DataWriterCache);
+                                  mUseHdf5DataWriterCache || mHdf5DataWriterNumStagingBuffers > 0u);
 
     /* If user has specified a chunk size and alignment parameter, pass it
      * through. We set them to the same value as we think this is the most
@@ -877,6 +881,11 @@ bool AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::InitialiseWriter
         mpWriter->EndDefineMode();
     }
 
+    if (mHdf5DataWriterNumStagingBuffers > 0u)
+    {
+        mpWriter->SetAsynchronousWriting(mHdf5DataWriterNumStagingBuffers, mHdf5DataWriterBlockWhenStagingFull);
+    }
+
     return extend_file;
 }
 
@@ -892,6 +901,13 @@ void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetHdf5DataWrite
     mHdf5DataWriterChunkSizeAndAlignment = size;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetHdf5DataWriterAsynchronousWriting(unsigned numStagingBuffers, bool blockWhenFull)
+{
+    mHdf5DataWriterNumStagingBuffers = numStagingBuffers;
+    mHdf5DataWriterBlockWhenStagingFull = blockWhenFull;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
 void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetOutputNodes(std::vector<unsigned> &nodesToOutput)
 {
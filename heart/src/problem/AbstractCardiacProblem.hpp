@@ -481,6 +481,17 @@ protected:
      */
     hsize_t mHdf5DataWriterChunkSizeAndAlignment;
 
+    /**
+     * The number of staging buffers for asynchronous HDF5 output (zero means write synchronously).
+     * Like the other output performance settings of a run this is not archived.
+     */
+    unsigned mHdf5DataWriterNumStagingBuffers;
+
+    /**
+     * Whether the solver should wait for a write to finish when all the staging buffers are in use.
+     */
+    bool mHdf5DataWriterBlockWhenStagingFull;
+
     /**
      * A vector of user-defined output modifiers which may be used to produce lightweight on the fly output
      */
@@ -700,6 +711,21 @@ public:
      */
     void SetHdf5DataWriterTargetChunkSizeAndAlignment(hsize_t size);
 
+    /**
+     * Write output asynchronously: the Hdf5DataWriter caches each chunk of time steps in a
+     * staging buffer, which a dedicated I/O thread writes out while the solver carries on.
+     * This implies SetUseHdf5DataWriterCache(), and needs MPI initialised with
+     * MPI_THREAD_MULTIPLE by running with the -mpi_thread_multiple command line option
+     * (otherwise output is written synchronously, with a warning).
+     * See Hdf5DataWriter::SetAsynchronousWriting().
+     *
+     * @param numStagingBuffers  the number of staging buffers which may be waiting to be written
+     *     (zero turns asynchronous writing off)
+     * @param blockWhenFull  whether the solver waits for a write to finish when all the staging
+     *     buffers are in use (otherwise more staging buffers are allocated)
+     */
+    void SetHdf5DataWriterAsynchronousWriting(unsigned numStagingBuffers=2u, bool blockWhenFull=true);
+
     /**
      * Specifies which nodes in the mesh to output. This method must be called before InitialiseWriter,
      * otherwise all nodes will still be output. If this method is called when extending an existing
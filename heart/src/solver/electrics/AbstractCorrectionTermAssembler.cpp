@@ -117,7 +117,7 @@ bool AbstractCorrectionTermAssembler<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::Element
 
     //The criterion and the correction both need the ionic cache, so we better make sure that it's up-to-date
     assert(this->mpCardiacTissue->GetDoCacheReplication());
-    ReplicatableVector& r_cache = this->mpCardiacTissue->rGetIionicCacheReplicated();
+    HaloedVector& r_cache = this->mpCardiacTissue->rGetIionicCacheReplicated();
 
     double diionic = fabs(r_cache[rElement.GetNodeGlobalIndex(0)] - r_cache[rElement.GetNodeGlobalIndex(1)]);
 
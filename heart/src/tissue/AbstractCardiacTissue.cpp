@@ -35,6 +35,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCardiacTissue.hpp"
 
+#include <algorithm>
 #include <boost/scoped_array.hpp>
 
 #include "DistributedVector.hpp"
@@ -47,8 +48,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscTools.hpp"
 #include "PetscVecTools.hpp"
 #include "AbstractCvodeCell.hpp"
+#include "BatchedCardiacCellView.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "ThreadTools.hpp"
 #include "Warnings.hpp"
 
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
             AbstractCardiacCellFactory<ELEMENT_DIM,SPACE_DIM>* pCellFactory,
@@ -58,6 +66,7 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
       mpConductivityModifier(NULL),
       mHasPurkinje(false),
       mDoCacheReplication(true),
+      mNumOdeThreads(1u),
       mMeshUnarchived(false),
       mExchangeHalos(exchangeHalos)
 {
@@ -153,15 +162,16 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
     // Halo nodes (if required)
     SetUpHaloCells(pCellFactory);
 
-    HeartEventHandler::BeginEvent(HeartEventHandler::COMMUNICATION);
-    mIionicCacheReplicated.Resize( pCellFactory->GetNumberOfCells() );
-    mIntracellularStimulusCacheReplicated.Resize( pCellFactory->GetNumberOfCells() );
+    // After the halo cells, since a batched cell factory adds them to the same batch
+    DetectBatchedCells();
 
+    HeartEventHandler::BeginEvent(HeartEventHandler::COMMUNICATION);
     if (mHasPurkinje)
     {
         mPurkinjeIionicCacheReplicated.Resize( pCellFactory->GetNumberOfCells() );
         mPurkinjeIntracellularStimulusCacheReplicated.Resize( pCellFactory->GetNumberOfCells() );
     }
+    SetUpCacheStorage();
     HeartEventHandler::EndEvent(HeartEventHandler::COMMUNICATION);
 
     if (HeartConfig::Instance()->IsMeshProvided() && HeartConfig::Instance()->GetLoadMesh())
@@ -183,6 +193,7 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(AbstractTetr
       mpDistributedVectorFactory(mpMesh->GetDistributedVectorFactory()),
       mHasPurkinje(false),
       mDoCacheReplication(true),
+      mNumOdeThreads(1u),
       mMeshUnarchived(true),
       mExchangeHalos(false)
 {
@@ -352,7 +363,11 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::CreateIntracellularConductivi
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetCacheReplication(bool doCacheReplication)
 {
-    mDoCacheReplication = doCacheReplication;
+    if (mDoCacheReplication != doCacheReplication)
+    {
+        mDoCacheReplication = doCacheReplication;
+        SetUpCacheStorage();
+    }
 }
 
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
@@ -361,6 +376,46 @@ bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetDoCacheReplication()
     return mDoCacheReplication;
 }
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetNumberOfOdeThreads(unsigned numThreads)
+{
+    ThreadTools::CheckNumberOfThreads(numThreads, "cell models cannot be solved", "ODE threads");
+
+    if (numThreads > 1u)
+    {
+        /*
+         * One-step ODE solvers keep working memory in the solver object, so cells solved
+         * concurrently must not share a solver.  EulerIvpOdeSolver has no other state, so
+         * we can safely give each cell its own copy; other shared solvers are an error.
+         */
+        std::set<AbstractIvpOdeSolver*> solvers_seen;
+        for (unsigned local_index=0; local_index<mCellsDistributed.size(); local_index++)
+        {
+            AbstractCardiacCellInterface* p_cell = mCellsDistributed[local_index];
+            AbstractIvpOdeSolver* p_solver = p_cell->GetSolver().get();
+            if (p_solver != NULL && !solvers_seen.insert(p_solver).second)
+            {
+                if (dynamic_cast<EulerIvpOdeSolver*>(p_solver))
+                {
+                    p_cell->SetSolver(boost::shared_ptr<AbstractIvpOdeSolver>(new EulerIvpOdeSolver));
+                }
+                else
+                {
+                    EXCEPTION("Cell models which share an ODE solver other than EulerIvpOdeSolver cannot be solved "
+                              "on multiple threads. Give each cell its own solver in your cell factory.");
+                }
+            }
+        }
+    }
+    mNumOdeThreads = numThreads;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+unsigned AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetNumberOfOdeThreads() const
+{
+    return mNumOdeThreads;
+}
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 const c_matrix<double, SPACE_DIM, SPACE_DIM>& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIntracellularConductivityTensor(unsigned elementIndex)
 {
@@ -483,87 +538,95 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existing
     DistributedVector::Stripe voltage(dist_solution, 0);
     try
     {
-        double voltage_before_update;
-        for (DistributedVector::Iterator index = dist_solution.Begin();
-             index != dist_solution.End();
-             ++index)
+        if (mpBatchedCells)
+        {
+            SolveBatchedCellSystems(voltage, time, nextTime, updateVoltage);
+        }
+        else
+#ifdef CHASTE_OPENMP
+        if (mNumOdeThreads > 1u)
         {
-            voltage_before_update = voltage[index];
-            mCellsDistributed[index.Local]->SetVoltage( voltage_before_update );
+            const unsigned lo = dist_solution.GetLow();
+            const int num_local_nodes = dist_solution.GetHigh() - lo;
 
-            // Added a try-catch here to provide more output to screen when an error occurs.
-            /// \todo This may want to go to std::cerr ??
-            try
+            // Per-thread record of the first failed node, so the serial diagnostics can be reproduced
+            std::vector<unsigned> failed_global_index(mNumOdeThreads, UNSIGNED_UNSET);
+            std::vector<double> failed_voltage_before_update(mNumOdeThreads, 0.0);
+            std::vector<boost::shared_ptr<Exception> > thread_exceptions(mNumOdeThreads);
+            std::vector<double> thread_times(mNumOdeThreads, 0.0);
+
+#pragma omp parallel num_threads(mNumOdeThreads)
             {
-                if (!updateVoltage)
+                const unsigned thread = omp_get_thread_num();
+                const double start_time = omp_get_wtime();
+
+                // Dynamic scheduling since cost per cell varies, e.g. with adaptive solvers or during upstroke
+#pragma omp for schedule(dynamic, 16) nowait
+                for (int local_index=0; local_index<num_local_nodes; local_index++)
                 {
-                    // solve ODE system at this node.
-                    // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
-#ifndef CHASTE_CVODE
-                    mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-#else
-                    // If CVODE is enabled, and this is a CVODE cell
-                    // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
+                    if (thread_exceptions[thread])
+                    {
+                        continue; // This thread has already failed; stop solving
+                    }
+                    const unsigned global_index = lo + local_index;
+                    const double voltage_before_update = voltage[global_index];
                     try
                     {
-                        mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
+                        SolveCellSystemAtNode(global_index, local_index, voltage[global_index], time, nextTime, updateVoltage);
                     }
                     catch (Exception &e)
                     {
-                        // Try an 'emergency' reset if this is a CVODE cell.
-                        // See #2594 for why we think this may be necessary.
-                        if (dynamic_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local]))
-                        {
-                            // Reset the CVODE cell, this leads to a call to CVodeReInit.
-                            static_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local])->ResetSolver();
-                            mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-                            WARNING("Global node " << index.Global << " had an ODE solving problem in t = [" << time <<
-                                    ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
-                                    " step should be reduced, or CVODE tolerances relaxed.");
-                        }
-                        else
-                        {
-                            throw e;
-                        }
+                        failed_global_index[thread] = global_index;
+                        failed_voltage_before_update[thread] = voltage_before_update;
+                        thread_exceptions[thread].reset(new Exception(e));
                     }
-#endif // CHASTE_CVODE
                 }
-                else
+                thread_times[thread] = omp_get_wtime() - start_time;
+            }
+
+            for (unsigned thread=0; thread<mNumOdeThreads; thread++)
+            {
+                HeartEventHandler::AddThreadTime(HeartEventHandler::SOLVE_ODES, thread, thread_times[thread]);
+            }
+
+            // Report the failure at the lowest global index, as the serial loop would have done
+            unsigned failed_thread = UNSIGNED_UNSET;
+            for (unsigned thread=0; thread<mNumOdeThreads; thread++)
+            {
+                if (thread_exceptions[thread] &&
+                    (failed_thread == UNSIGNED_UNSET || failed_global_index[thread] < failed_global_index[failed_thread]))
                 {
-                    // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
-                    mCellsDistributed[index.Local]->SolveAndUpdateState(time, nextTime);
-                    voltage[index] = mCellsDistributed[index.Local]->GetVoltage();
+                    failed_thread = thread;
                 }
             }
-            catch (Exception &e)
+            if (failed_thread != UNSIGNED_UNSET)
             {
-                std::cout << std::setprecision(16);
-                std::cout << "Global node " << index.Global << " had problems with ODE solve between "
-                        "t = " << time << " and " << nextTime << "ms.\n";
-
-                std::cout << "Voltage at this node before solve was " << voltage_before_update << "mV\n"
-                        "(this SHOULD NOT necessarily be the same as the one in the state variables,\n"
-                        "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
-
-                std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
-
-                std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(mCellsDistributed[index.Local])->GetSystemName() << "\n";
+                const unsigned global_index = failed_global_index[failed_thread];
+                ReportCellSystemSolveFailure(global_index, global_index - lo, failed_voltage_before_update[failed_thread], time, nextTime);
+                throw *(thread_exceptions[failed_thread]);
+            }
+        }
+        else
+#endif // CHASTE_OPENMP
+        {
+            for (DistributedVector::Iterator index = dist_solution.Begin();
+                 index != dist_solution.End();
+                 ++index)
+            {
+                const double voltage_before_update = voltage[index];
 
-                std::cout << "All state variables are now:\n";
-                std::vector<double> state_vars = mCellsDistributed[index.Local]->GetStdVecStateVariables();
-                std::vector<std::string> state_var_names = mCellsDistributed[index.Local]->rGetStateVariableNames();
-                for (unsigned i=0; i<state_vars.size(); i++)
+                // Added a try-catch here to provide more output to screen when an error occurs.
+                /// \todo This may want to go to std::cerr ??
+                try
                 {
-                    std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
+                    SolveCellSystemAtNode(index.Global, index.Local, voltage[index], time, nextTime, updateVoltage);
+                }
+                catch (Exception &e)
+                {
+                    ReportCellSystemSolveFailure(index.Global, index.Local, voltage_before_update, time, nextTime);
+                    throw e;
                 }
-                std::cout << std::flush;
-
-                throw e;
             }
-            // update the Iionic and stimulus caches
-            UpdateCaches(index.Global, index.Local, nextTime);
         }
 
         if (updateVoltage)
@@ -701,13 +764,13 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existing
 }
 
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
-ReplicatableVector& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIionicCacheReplicated()
+HaloedVector& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIionicCacheReplicated()
 {
     return mIionicCacheReplicated;
 }
 
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
-ReplicatableVector& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIntracellularStimulusCacheReplicated()
+HaloedVector& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIntracellularStimulusCacheReplicated()
 {
     return mIntracellularStimulusCacheReplicated;
 }
@@ -726,6 +789,248 @@ ReplicatableVector& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetPurkinjeIn
     return mPurkinjeIntracellularStimulusCacheReplicated;
 }
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystemAtNode(unsigned globalIndex, unsigned localIndex, double& rVoltage,
+                                                                         double time, double nextTime, bool updateVoltage)
+{
+    AbstractCardiacCellInterface* p_cell = mCellsDistributed[localIndex];
+    p_cell->SetVoltage(rVoltage);
+
+    if (!updateVoltage)
+    {
+        // solve ODE system at this node.
+        // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
+#ifndef CHASTE_CVODE
+        p_cell->ComputeExceptVoltage(time, nextTime);
+#else
+        // If CVODE is enabled, and this is a CVODE cell
+        // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
+        try
+        {
+            p_cell->ComputeExceptVoltage(time, nextTime);
+        }
+        catch (Exception &e)
+        {
+            // Try an 'emergency' reset if this is a CVODE cell.
+            // See #2594 for why we think this may be necessary.
+            if (dynamic_cast<AbstractCvodeCell*>(p_cell))
+            {
+                // Reset the CVODE cell, this leads to a call to CVodeReInit.
+                static_cast<AbstractCvodeCell*>(p_cell)->ResetSolver();
+                p_cell->ComputeExceptVoltage(time, nextTime);
+#ifdef CHASTE_OPENMP
+#pragma omp critical(ChasteWarnings)
+#endif // CHASTE_OPENMP
+                WARNING("Global node " << globalIndex << " had an ODE solving problem in t = [" << time <<
+                        ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
+                        " step should be reduced, or CVODE tolerances relaxed.");
+            }
+            else
+            {
+                throw e;
+            }
+        }
+#endif // CHASTE_CVODE
+    }
+    else
+    {
+        // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
+        p_cell->SolveAndUpdateState(time, nextTime);
+        rVoltage = p_cell->GetVoltage();
+    }
+
+    // update the Iionic and stimulus caches
+    UpdateCaches(globalIndex, localIndex, nextTime);
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::ReportCellSystemSolveFailure(unsigned globalIndex, unsigned localIndex,
+                                                                                double voltageBeforeUpdate,
+                                                                                double time, double nextTime)
+{
+    AbstractCardiacCellInterface* p_cell = mCellsDistributed[localIndex];
+
+    std::cout << std::setprecision(16);
+    std::cout << "Global node " << globalIndex << " had problems with ODE solve between "
+            "t = " << time << " and " << nextTime << "ms.\n";
+
+    std::cout << "Voltage at this node before solve was " << voltageBeforeUpdate << "mV\n"
+            "(this SHOULD NOT necessarily be the same as the one in the state variables,\n"
+            "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
+
+    std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
+        << p_cell->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
+        << p_cell->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
+
+    AbstractUntemplatedParameterisedSystem* p_system = dynamic_cast<AbstractUntemplatedParameterisedSystem*>(p_cell);
+    if (p_system)
+    {
+        std::cout << "Cell model: " << p_system->GetSystemName() << "\n";
+    }
+
+    std::cout << "All state variables are now:\n";
+    std::vector<double> state_vars = p_cell->GetStdVecStateVariables();
+    std::vector<std::string> state_var_names = p_cell->rGetStateVariableNames();
+    for (unsigned i=0; i<state_vars.size(); i++)
+    {
+        std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
+    }
+    std::cout << std::flush;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::DetectBatchedCells()
+{
+    mpBatchedCells.reset();
+    if (mCellsDistributed.empty())
+    {
+        return;
+    }
+    BatchedCardiacCellView* p_first_view = dynamic_cast<BatchedCardiacCellView*>(mCellsDistributed[0]);
+    if (!p_first_view || p_first_view->GetBatch()->GetNumCells() != mCellsDistributed.size() + mHaloCellsDistributed.size())
+    {
+        return;
+    }
+    boost::shared_ptr<AbstractBatchedCardiacCells> p_batch = p_first_view->GetBatch();
+    for (unsigned local_index=0; local_index<mCellsDistributed.size(); local_index++)
+    {
+        BatchedCardiacCellView* p_view = dynamic_cast<BatchedCardiacCellView*>(mCellsDistributed[local_index]);
+        if (!p_view || p_view->GetBatch() != p_batch || p_view->GetIndexInBatch() != local_index)
+        {
+            return;
+        }
+    }
+    // Any halo cells in the batch follow the owned cells, so are not solved (their state is communicated)
+    for (unsigned halo_index=0; halo_index<mHaloCellsDistributed.size(); halo_index++)
+    {
+        BatchedCardiacCellView* p_view = dynamic_cast<BatchedCardiacCellView*>(mHaloCellsDistributed[halo_index]);
+        if (!p_view || p_view->GetBatch() != p_batch || p_view->GetIndexInBatch() != mCellsDistributed.size() + halo_index)
+        {
+            return;
+        }
+    }
+    p_batch->SetUsedInTissueSimulation();
+    mpBatchedCells = p_batch;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveBatchedCellSystems(DistributedVector::Stripe& rVoltage,
+                                                                           double time, double nextTime, bool updateVoltage)
+{
+    const unsigned lo = mpDistributedVectorFactory->GetLow();
+    const unsigned num_local_nodes = mCellsDistributed.size();
+    assert(mpBatchedCells->GetNumCells() == num_local_nodes + mHaloCellsDistributed.size());
+
+    for (unsigned local_index=0; local_index<num_local_nodes; local_index++)
+    {
+        mpBatchedCells->SetVoltage(local_index, rVoltage[lo + local_index]);
+    }
+
+    // Each thread works on a contiguous block of cells, so that the batch loops stay long
+    const unsigned num_blocks = std::min(mNumOdeThreads, std::max(num_local_nodes, 1u));
+    std::vector<boost::shared_ptr<Exception> > block_exceptions(num_blocks);
+    std::vector<unsigned> block_failed_cell(num_blocks, UNSIGNED_UNSET);
+    std::vector<double> block_iionic(num_local_nodes);
+    std::vector<double> block_times(num_blocks, 0.0);
+
+    // With one block per thread and a static schedule, block i is solved by thread i
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for num_threads(num_blocks) schedule(static, 1)
+#endif // CHASTE_OPENMP
+    for (int block=0; block<(int)num_blocks; block++)
+    {
+#ifdef CHASTE_OPENMP
+        const double start_time = omp_get_wtime();
+#endif // CHASTE_OPENMP
+        const unsigned begin = (block*num_local_nodes)/num_blocks;
+        const unsigned end = ((block+1)*num_local_nodes)/num_blocks;
+        try
+        {
+            if (updateVoltage)
+            {
+                mpBatchedCells->SolveAndUpdateState(begin, end, time, nextTime);
+            }
+            else
+            {
+                mpBatchedCells->ComputeExceptVoltage(begin, end, time, nextTime);
+            }
+            if (begin < end)
+            {
+                mpBatchedCells->ComputeIIonic(begin, end, &block_iionic[begin]);
+            }
+        }
+        catch (Exception& e)
+        {
+            // Blame the first cell that went invalid, or the start of the block if none did
+            const unsigned failed_cell = mpBatchedCells->FindFirstInvalidCell(begin, end);
+            block_failed_cell[block] = (failed_cell < end) ? failed_cell : begin;
+            block_exceptions[block].reset(new Exception(e));
+        }
+#ifdef CHASTE_OPENMP
+        block_times[block] = omp_get_wtime() - start_time;
+#endif // CHASTE_OPENMP
+    }
+
+    if (mNumOdeThreads > 1u)
+    {
+        for (unsigned block=0; block<num_blocks; block++)
+        {
+            HeartEventHandler::AddThreadTime(HeartEventHandler::SOLVE_ODES, block, block_times[block]);
+        }
+    }
+
+    // Report the failure at the lowest index, as the loop over unbatched cells would have done.
+    // Blocks are in order of cell index, and the voltage stripe has not been updated yet.
+    for (unsigned block=0; block<num_blocks; block++)
+    {
+        if (block_exceptions[block])
+        {
+            const unsigned local_index = block_failed_cell[block];
+            ReportCellSystemSolveFailure(lo + local_index, local_index, rVoltage[lo + local_index], time, nextTime);
+            throw *(block_exceptions[block]);
+        }
+    }
+
+    for (unsigned local_index=0; local_index<num_local_nodes; local_index++)
+    {
+        const unsigned global_index = lo + local_index;
+        if (updateVoltage)
+        {
+            rVoltage[global_index] = mpBatchedCells->GetVoltage(local_index);
+        }
+        mIionicCacheReplicated[global_index] = block_iionic[local_index];
+        mIntracellularStimulusCacheReplicated[global_index] = mCellsDistributed[local_index]->GetIntracellularStimulus(nextTime);
+    }
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpCacheStorage()
+{
+    const unsigned problem_size = mpDistributedVectorFactory->GetProblemSize();
+    if (mExchangeHalos || !mDoCacheReplication)
+    {
+        // Only store what this process reads: owned nodes, plus halo nodes if they are replicated
+        std::vector<unsigned> halo_nodes;
+        std::vector<std::vector<unsigned> > nodes_to_send(PetscTools::GetNumProcs());
+        std::vector<std::vector<unsigned> > nodes_to_receive(PetscTools::GetNumProcs());
+        if (mExchangeHalos && mDoCacheReplication)
+        {
+            halo_nodes = mHaloNodes;
+            nodes_to_send = mNodesToSendPerProcess;
+            nodes_to_receive = mNodesToReceivePerProcess;
+        }
+        mIionicCacheReplicated.SetUpHalos(problem_size, mpDistributedVectorFactory->GetLow(), mpDistributedVectorFactory->GetHigh(),
+                                          halo_nodes, nodes_to_send, nodes_to_receive);
+        mIntracellularStimulusCacheReplicated.SetUpHalos(problem_size, mpDistributedVectorFactory->GetLow(), mpDistributedVectorFactory->GetHigh(),
+                                                         halo_nodes, nodes_to_send, nodes_to_receive);
+    }
+    else
+    {
+        mIionicCacheReplicated.Resize(problem_size);
+        mIntracellularStimulusCacheReplicated.Resize(problem_size);
+    }
+}
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::UpdateCaches(unsigned globalIndex, unsigned localIndex, double nextTime)
 {
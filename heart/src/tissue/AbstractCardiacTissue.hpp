@@ -51,11 +51,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/split_member.hpp>
 
 #include "AbstractCardiacCellInterface.hpp"
+#include "AbstractBatchedCardiacCells.hpp"
+#include "DistributedVector.hpp"
 #include "FakeBathCell.hpp"
 #include "AbstractCardiacCellFactory.hpp"
 #include "AbstractConductivityTensors.hpp"
 #include "AbstractPurkinjeCellFactory.hpp"
 #include "ReplicatableVector.hpp"
+#include "HaloedVector.hpp"
 #include "HeartConfig.hpp"
 #include "ArchiveLocationInfo.hpp"
 #include "AbstractDynamicallyLoadableEntity.hpp"
@@ -212,6 +215,8 @@ private:
         assert(mpDistributedVectorFactory->GetLocalOwnership()==mpMesh->GetDistributedVectorFactory()->GetLocalOwnership());
         // archive & mMeshUnarchived; Not archived since set to true when archiving constructor is called.
 
+        SetUpCacheStorage();
+
         // not archiving mpConductivityModifier for the time being (mechanics simulations are only use-case at the moment, and they
         // do not get archived...). mpConductivityModifier has to be reset to NULL upon load.
         mpConductivityModifier = NULL;
@@ -240,10 +245,11 @@ protected:
     std::vector< AbstractCardiacCellInterface* > mPurkinjeCellsDistributed;
 
     /**
-     *  Cache containing all the ionic currents for each node,
-     *  replicated over all processes.
+     *  Cache containing the ionic currents for each node.  Replicated over all processes,
+     *  unless the tissue exchanges halos or doesn't need replicated caches (see
+     *  SetUpCacheStorage()), in which case only owned and halo nodes are stored.
      */
-    ReplicatableVector mIionicCacheReplicated;
+    HaloedVector mIionicCacheReplicated;
 
     /**
      *  Cache containing all the ionic currents for each purkinje node,
@@ -252,10 +258,10 @@ protected:
     ReplicatableVector mPurkinjeIionicCacheReplicated;
 
     /**
-     *  Cache containing all the stimulus currents for each node,
-     *  replicated over all processes.
+     *  Cache containing the stimulus currents for each node.  Stored in the same way
+     *  as #mIionicCacheReplicated.
      */
-    ReplicatableVector mIntracellularStimulusCacheReplicated;
+    HaloedVector mIntracellularStimulusCacheReplicated;
 
     /**
      *  Cache containing all the stimulus currents for each Purkinje node,
@@ -302,6 +308,16 @@ protected:
      */
     bool mDoCacheReplication;
 
+    /** The number of OpenMP threads used to solve the cell model ODEs in SolveCellSystems(). Defaults to 1. */
+    unsigned mNumOdeThreads;
+
+    /**
+     * If every cell owned by this process is a BatchedCardiacCellView onto the same
+     * batch, in local index order, then this points to that batch and SolveCellSystems()
+     * solves all the owned cells with calls to the batch.  Otherwise it is empty.
+     */
+    boost::shared_ptr<AbstractBatchedCardiacCells> mpBatchedCells;
+
     /**
      * Whether the mesh was unarchived or got from elsewhere.
      */
@@ -350,6 +366,62 @@ protected:
      */
     void SetUpHaloCells(AbstractCardiacCellFactory<ELEMENT_DIM,SPACE_DIM>* pCellFactory);
 
+    /**
+     * Solve the cell model at a single node owned by this process, and update the
+     * Iionic and stimulus caches for that node.  Helper method for SolveCellSystems(),
+     * which may be called concurrently for different nodes.
+     *
+     * @param globalIndex  global index of the node
+     * @param localIndex  local index of the node
+     * @param rVoltage  the transmembrane potential at the node; updated if updateVoltage is true
+     * @param time  the current time
+     * @param nextTime  when to simulate the cell until
+     * @param updateVoltage  whether to also solve for the voltage
+     */
+    void SolveCellSystemAtNode(unsigned globalIndex, unsigned localIndex, double& rVoltage,
+                               double time, double nextTime, bool updateVoltage);
+
+    /**
+     * Print diagnostic information to std::cout about a cell model whose ODE solve failed.
+     *
+     * @param globalIndex  global index of the node
+     * @param localIndex  local index of the node
+     * @param voltageBeforeUpdate  the transmembrane potential at the node before the solve
+     * @param time  the start time of the failed solve
+     * @param nextTime  the end time of the failed solve
+     */
+    void ReportCellSystemSolveFailure(unsigned globalIndex, unsigned localIndex, double voltageBeforeUpdate,
+                                      double time, double nextTime);
+
+    /**
+     * Set #mpBatchedCells if the cells owned by this process are all views onto a single
+     * batch of cells (see BatchedCardiacCellView), with cell i of the batch at local index i.
+     * Any halo cells must be views onto the same batch, following the owned cells.  Must be
+     * called after SetUpHaloCells().
+     */
+    void DetectBatchedCells();
+
+    /**
+     * Solve all the cells owned by this process with calls to #mpBatchedCells, and update
+     * the Iionic and stimulus caches.  Helper method for SolveCellSystems().  If more than
+     * one ODE thread is in use, each thread solves a contiguous block of cells.
+     *
+     * @param rVoltage  the transmembrane potential stripe of the current solution
+     * @param time  the current time
+     * @param nextTime  when to simulate the cells until
+     * @param updateVoltage  whether to also solve for the voltage
+     */
+    void SolveBatchedCellSystems(DistributedVector::Stripe& rVoltage, double time, double nextTime, bool updateVoltage);
+
+    /**
+     * Decide how much of the Iionic and intracellular stimulus caches to store on this process.
+     * If #mDoCacheReplication is false, only entries for owned nodes are stored.  Otherwise, if
+     * #mExchangeHalos is true, entries for owned and halo nodes are stored and ReplicateCaches()
+     * just exchanges halo values; if not, every entry is stored and replicated.
+     * Cache contents are not preserved when the storage changes.
+     */
+    void SetUpCacheStorage();
+
 public:
     /**
      * This constructor is called from the Initialise() method of the CardiacProblem class.
@@ -378,6 +450,8 @@ public:
 
     /**
      * Set whether or not to replicate the caches across all processors.
+     * Unless halos are exchanged, this also changes how much of the caches is stored
+     * (see SetUpCacheStorage()), so should be called before solving.
      *
      * See also mDoCacheReplication.
      * @param doCacheReplication - true if the cache needs to be replicated
@@ -391,6 +465,28 @@ public:
      */
     bool GetDoCacheReplication();
 
+    /**
+     * Set the number of threads to share the cell model ODE solves between in
+     * SolveCellSystems().  This requires Chaste to be built with OpenMP support
+     * (the CMake option Chaste_USE_OPENMP).
+     *
+     * Each cell is still solved exactly as in the serial loop, so results do not depend
+     * on the number of threads.  Cells must not share a stateful ODE solver object between
+     * threads: shared EulerIvpOdeSolver objects are replaced here by one solver per cell,
+     * and any other shared solver results in an exception.  Purkinje cells are always
+     * solved serially.
+     *
+     * Time spent by each thread is recorded against HeartEventHandler::SOLVE_ODES.
+     *
+     * @param numThreads  the number of threads to use (1 for a serial loop)
+     */
+    void SetNumberOfOdeThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used to solve the cell model ODEs.
+     */
+    unsigned GetNumberOfOdeThreads() const;
+
     /** @return the intracellular conductivity tensor for the given element
      * @param elementIndex  index of the element of interest
      */
@@ -446,11 +542,14 @@ public:
      */
     virtual void SolveCellSystems(Vec existingSolution, double time, double nextTime, bool updateVoltage=false);
 
-    /** @return the entire ionic current cache */
-    ReplicatableVector& rGetIionicCacheReplicated();
+    /**
+     * @return the ionic current cache.  Entries for nodes not owned by this process are only
+     * available if cache replication is on, and (if halos are exchanged) only for halo nodes.
+     */
+    HaloedVector& rGetIionicCacheReplicated();
 
-    /** @return the entire stimulus current cache */
-    ReplicatableVector& rGetIntracellularStimulusCacheReplicated();
+    /** @return the stimulus current cache; see rGetIionicCacheReplicated() */
+    HaloedVector& rGetIntracellularStimulusCacheReplicated();
 
     /** @return the entire Purkinje ionic current cache */
     ReplicatableVector& rGetPurkinjeIionicCacheReplicated();
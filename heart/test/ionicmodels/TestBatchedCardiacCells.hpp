@@ -0,0 +1,430 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTBATCHEDCARDIACCELLS_HPP_
+#define TESTBATCHEDCARDIACCELLS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <boost/shared_ptr.hpp>
+
+#include "BatchedFitzHughNagumo1961Cells.hpp"
+#include "AbstractBatchedRushLarsenCardiacCells.hpp"
+#include "OdeSystemInformation.hpp"
+#include "BatchedCardiacCellView.hpp"
+#include "FitzHughNagumo1961OdeSystem.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "SimpleStimulus.hpp"
+#include "ZeroStimulus.hpp"
+#include "AbstractCardiacCellFactory.hpp"
+#include "MonodomainTissue.hpp"
+#include "MonodomainProblem.hpp"
+#include "TetrahedralMesh.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "ReplicatableVector.hpp"
+#include "HeartConfig.hpp"
+#include "PetscTools.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * Cell factory creating either ordinary FitzHugh-Nagumo cells, or views onto a single
+ * batch of FitzHugh-Nagumo cells, with a stimulus at the left end of the mesh.
+ */
+class BatchedOrNotFhnCellFactory : public AbstractCardiacCellFactory<1>
+{
+private:
+    bool mUseBatch;
+    boost::shared_ptr<BatchedFitzHughNagumo1961Cells> mpBatch;
+    boost::shared_ptr<SimpleStimulus> mpStimulus;
+
+public:
+    BatchedOrNotFhnCellFactory(bool useBatch)
+        : AbstractCardiacCellFactory<1>(),
+          mUseBatch(useBatch),
+          mpBatch(new BatchedFitzHughNagumo1961Cells),
+          mpStimulus(new SimpleStimulus(-600, 0.5))
+    {
+    }
+
+    AbstractCardiacCellInterface* CreateCardiacCellForTissueNode(Node<1>* pNode)
+    {
+        boost::shared_ptr<AbstractStimulusFunction> p_stimulus = mpZeroStimulus;
+        if (pNode->rGetLocation()[0] < 0.15)
+        {
+            p_stimulus = mpStimulus;
+        }
+        if (mUseBatch)
+        {
+            return new BatchedCardiacCellView(mpBatch, p_stimulus);
+        }
+        return new FitzHughNagumo1961OdeSystem(mpSolver, p_stimulus);
+    }
+};
+
+/**
+ * Batched cells with a decaying voltage and two gates with constant rates, one given by
+ * a time constant and steady state (in the model's time units of seconds), and one by
+ * opening and closing rates, so that the Rush-Larsen updates are exact.
+ */
+class BatchedConstantGatesCells : public AbstractBatchedRushLarsenCardiacCells
+{
+protected:
+    void EvaluateYDerivatives(double time, unsigned begin, unsigned end)
+    {
+        for (unsigned c=begin; c<end; c++)
+        {
+            mDerivatives[0][c] = -0.1*mStateVariables[0][c];
+            mAlphaOrTau[1][c] = 0.002;
+            mBetaOrInf[1][c] = 0.8;
+            mAlphaOrTau[2][c] = 0.3;
+            mBetaOrInf[2][c] = 0.1;
+        }
+    }
+
+public:
+    BatchedConstantGatesCells()
+        : AbstractBatchedRushLarsenCardiacCells(OdeSystemInformation<BatchedConstantGatesCells>::Instance(), 0)
+    {
+        SetRushLarsenVariable(1, false, 0.001);
+        SetRushLarsenVariable(2, true);
+    }
+
+    void ComputeIIonic(unsigned begin, unsigned end, double* pIIonic)
+    {
+        for (unsigned c=begin; c<end; c++)
+        {
+            pIIonic[c-begin] = 0.0;
+        }
+    }
+};
+
+template<>
+void OdeSystemInformation<BatchedConstantGatesCells>::Initialise(void)
+{
+    this->mVariableNames.push_back("V");
+    this->mVariableUnits.push_back("mV");
+    this->mInitialConditions.push_back(-80.0);
+
+    this->mVariableNames.push_back("m");
+    this->mVariableUnits.push_back("");
+    this->mInitialConditions.push_back(0.0);
+
+    this->mVariableNames.push_back("h");
+    this->mVariableUnits.push_back("");
+    this->mInitialConditions.push_back(1.0);
+
+    this->mSystemName = "ConstantGates";
+
+    this->mInitialised = true;
+}
+
+class TestBatchedCardiacCells : public CxxTest::TestSuite
+{
+public:
+    void TestBatchAgainstSingleCells() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        const double dt = 0.01;
+        const unsigned num_cells = 7u;
+
+        boost::shared_ptr<EulerIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        boost::shared_ptr<BatchedFitzHughNagumo1961Cells> p_batch(new BatchedFitzHughNagumo1961Cells);
+        p_batch->SetTimestep(dt);
+        TS_ASSERT_EQUALS(p_batch->GetNumberOfStateVariables(), 2u);
+        TS_ASSERT_EQUALS(p_batch->GetNumberOfParameters(), 0u);
+        TS_ASSERT_EQUALS(p_batch->GetSystemInformation()->GetSystemName(), "FitzHughNagumo1961");
+
+        std::vector<FitzHughNagumo1961OdeSystem*> single_cells;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            // Give the cells different stimulus magnitudes so that they diverge
+            boost::shared_ptr<SimpleStimulus> p_stimulus(new SimpleStimulus(0.1*i, 0.5, 0.1));
+            TS_ASSERT_EQUALS(p_batch->AddCell(p_stimulus), i);
+            single_cells.push_back(new FitzHughNagumo1961OdeSystem(p_solver, p_stimulus));
+            single_cells.back()->SetTimestep(dt);
+        }
+        TS_ASSERT_EQUALS(p_batch->GetNumCells(), num_cells);
+
+        // Solve the first part of the batch separately from the rest, as a thread would
+        p_batch->SolveAndUpdateState(0, 3, 0.0, 20.0);
+        p_batch->SolveAndUpdateState(3, num_cells, 0.0, 20.0);
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            single_cells[i]->SolveAndUpdateState(0.0, 20.0);
+        }
+
+        // Now keep the voltage fixed
+        p_batch->ComputeExceptVoltage(0, num_cells, 20.0, 25.0);
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            single_cells[i]->ComputeExceptVoltage(20.0, 25.0);
+        }
+
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            std::vector<double> state = p_batch->GetStdVecStateVariables(i);
+            std::vector<double> expected = single_cells[i]->GetStdVecStateVariables();
+            TS_ASSERT_EQUALS(state.size(), 2u);
+            TS_ASSERT_DELTA(state[0], expected[0], 1e-12);
+            TS_ASSERT_DELTA(state[1], expected[1], 1e-12);
+            TS_ASSERT_DELTA(p_batch->GetIIonic(i), single_cells[i]->GetIIonic(), 1e-12);
+            delete single_cells[i];
+        }
+        TS_ASSERT_DIFFERS(p_batch->GetVoltage(0), p_batch->GetVoltage(num_cells-1));
+
+        // Bad input
+        TS_ASSERT_THROWS_THIS(p_batch->GetStateVariable(0, 2), "The index passed in must be less than the number of state variables.");
+        TS_ASSERT_THROWS_THIS(p_batch->GetParameter(0, 0), "The index passed in must be less than the number of parameters.");
+        TS_ASSERT_THROWS_THIS(p_batch->SetStateVariables(0, std::vector<double>(3, 0.0)), "2 state variables expected, but 3 were given.");
+
+        p_batch->SetStateVariable(1, 1, std::numeric_limits<double>::quiet_NaN());
+        TS_ASSERT_THROWS_THIS(p_batch->ComputeExceptVoltage(0, 2, 25.0, 25.1),
+                              "State variable w of batched cell 1 is not a number at t = 25.1.");
+    }
+
+    void TestRushLarsen() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        const double dt = 0.25;
+
+        boost::shared_ptr<ZeroStimulus> p_stimulus(new ZeroStimulus);
+        BatchedConstantGatesCells batch;
+        batch.SetTimestep(dt);
+        batch.AddCell(p_stimulus);
+        batch.AddCell(p_stimulus);
+        batch.SetStateVariable(1, 1, 1.0);
+
+        batch.SolveAndUpdateState(0, 2, 0.0, 5.0);
+
+        // The voltage uses forward Euler
+        TS_ASSERT_DELTA(batch.GetVoltage(0), -80.0*pow(1.0 - 0.1*dt, 20), 1e-9);
+        TS_ASSERT_DELTA(batch.GetVoltage(1), -80.0*pow(1.0 - 0.1*dt, 20), 1e-9);
+
+        // The gates are exact, whatever the timestep
+        for (unsigned c=0; c<2; c++)
+        {
+            const double m0 = (c == 0) ? 0.0 : 1.0;
+            TS_ASSERT_DELTA(batch.GetStateVariable(c, 1), 0.8 + (m0 - 0.8)*exp(-5.0*0.001/0.002), 1e-12);
+            TS_ASSERT_DELTA(batch.GetStateVariable(c, 2), 0.75 + 0.25*exp(-5.0*0.4), 1e-12);
+        }
+
+        // The gates are still updated when the voltage is fixed
+        batch.ComputeExceptVoltage(0, 1, 5.0, 10.0);
+        TS_ASSERT_DELTA(batch.GetVoltage(0), -80.0*pow(1.0 - 0.1*dt, 20), 1e-9);
+        TS_ASSERT_DELTA(batch.GetStateVariable(0, 2), 0.75 + 0.25*exp(-10.0*0.4), 1e-12);
+    }
+
+    void TestView() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        boost::shared_ptr<BatchedFitzHughNagumo1961Cells> p_batch(new BatchedFitzHughNagumo1961Cells);
+        boost::shared_ptr<ZeroStimulus> p_zero_stimulus(new ZeroStimulus);
+        boost::shared_ptr<SimpleStimulus> p_stimulus(new SimpleStimulus(0.5, 0.5, 0.1));
+
+        BatchedCardiacCellView unstimulated(p_batch, p_zero_stimulus);
+        BatchedCardiacCellView stimulated(p_batch, p_stimulus);
+        TS_ASSERT_EQUALS(unstimulated.GetIndexInBatch(), 0u);
+        TS_ASSERT_EQUALS(stimulated.GetIndexInBatch(), 1u);
+        TS_ASSERT_EQUALS(stimulated.GetBatch(), p_batch);
+        TS_ASSERT_EQUALS(stimulated.GetNumberOfStateVariables(), 2u);
+        TS_ASSERT_EQUALS(stimulated.rGetStateVariableNames()[1], "w");
+        TS_ASSERT(!stimulated.GetSolver());
+
+        stimulated.SetTimestep(0.01);
+        TS_ASSERT_DELTA(p_batch->GetTimestep(), 0.01, 1e-15);
+
+        // Compute() only advances its own cell
+        OdeSolution solution = stimulated.Compute(0.0, 2.0, 0.1);
+        TS_ASSERT_EQUALS(solution.GetNumberOfTimeSteps(), 20u);
+        TS_ASSERT_DELTA(solution.rGetTimes().back(), 2.0, 1e-12);
+        TS_ASSERT_DELTA(solution.rGetSolutions().back()[0], stimulated.GetVoltage(), 1e-15);
+        TS_ASSERT_DELTA(unstimulated.GetVoltage(), 0.0, 1e-15);
+        TS_ASSERT_LESS_THAN(0.0, stimulated.GetVoltage());
+
+        stimulated.SetStateVariable("w", 0.25);
+        TS_ASSERT_DELTA(stimulated.GetAnyVariable("w"), 0.25, 1e-15);
+        TS_ASSERT_DELTA(p_batch->GetStateVariable(1, 1), 0.25, 1e-15);
+        unstimulated.SetVoltage(0.5);
+        TS_ASSERT_DELTA(p_batch->GetVoltage(0), 0.5, 1e-15);
+        TS_ASSERT_DELTA(unstimulated.GetIIonic(), 0.5*(0.5+0.08)*0.5, 1e-12);
+
+        // The current may also be computed at another state (as for state variable interpolation),
+        // leaving the state of the cell unchanged
+        std::vector<double> state = unstimulated.GetStdVecStateVariables();
+        TS_ASSERT_DELTA(unstimulated.GetIIonic(&state), unstimulated.GetIIonic(), 1e-15);
+        boost::shared_ptr<EulerIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        FitzHughNagumo1961OdeSystem single_cell(p_solver, p_zero_stimulus);
+        state[0] = 0.2;
+        state[1] = 0.1;
+        TS_ASSERT_DELTA(unstimulated.GetIIonic(&state), single_cell.GetIIonic(&state), 1e-12);
+        TS_ASSERT_DELTA(unstimulated.GetVoltage(), 0.5, 1e-15);
+        TS_ASSERT_DELTA(unstimulated.GetIIonic(), 0.5*(0.5+0.08)*0.5, 1e-12);
+
+        // Changing the stimulus of a view, including through the base class, also changes it in the batch
+        AbstractCardiacCellInterface* p_cell = &unstimulated;
+        p_cell->SetIntracellularStimulusFunction(p_stimulus);
+        TS_ASSERT_EQUALS(p_batch->GetStimulusFunction(0), p_stimulus);
+        TS_ASSERT_EQUALS(unstimulated.GetStimulusFunction(), p_stimulus);
+        unstimulated.SetStimulusFunction(p_zero_stimulus);
+        TS_ASSERT_EQUALS(p_batch->GetStimulusFunction(0), p_zero_stimulus);
+    }
+
+    void TestTissueWithBatchedCells() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        HeartConfig::Instance()->SetOdeTimeStep(0.01);
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0); // 11 nodes
+
+        BatchedOrNotFhnCellFactory single_factory(false);
+        single_factory.SetMesh(&mesh);
+        BatchedOrNotFhnCellFactory batched_factory(true);
+        batched_factory.SetMesh(&mesh);
+
+        MonodomainTissue<1> single_tissue(&single_factory);
+        MonodomainTissue<1> batched_tissue(&batched_factory);
+
+        Vec single_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), 0.0);
+        Vec batched_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), 0.0);
+        single_tissue.SolveCellSystems(single_voltage, 0.0, 0.5, false);
+        batched_tissue.SolveCellSystems(batched_voltage, 0.0, 0.5, false);
+        single_tissue.SolveCellSystems(single_voltage, 0.5, 1.0, true);
+        batched_tissue.SolveCellSystems(batched_voltage, 0.5, 1.0, true);
+
+        ReplicatableVector single_voltage_repl(single_voltage);
+        ReplicatableVector batched_voltage_repl(batched_voltage);
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(batched_voltage_repl[i], single_voltage_repl[i], 1e-12);
+            TS_ASSERT_DELTA(batched_tissue.rGetIionicCacheReplicated()[i], single_tissue.rGetIionicCacheReplicated()[i], 1e-12);
+            TS_ASSERT_DELTA(batched_tissue.rGetIntracellularStimulusCacheReplicated()[i],
+                            single_tissue.rGetIntracellularStimulusCacheReplicated()[i], 1e-12);
+        }
+        TS_ASSERT_DIFFERS(batched_voltage_repl[0], batched_voltage_repl[mesh.GetNumNodes()-1]);
+
+        // A failed solve is blamed on the cell that went wrong, and leaves the voltage alone
+        const std::vector<AbstractCardiacCellInterface*>& r_cells = batched_tissue.rGetCellsDistributed();
+        if (!r_cells.empty())
+        {
+            r_cells.back()->SetStateVariable(1u, std::numeric_limits<double>::quiet_NaN());
+        }
+        std::stringstream expected_message;
+        expected_message << "of batched cell " << r_cells.size() - 1 << " is not a number at t = 1.5.";
+        TS_ASSERT_THROWS_CONTAINS(batched_tissue.SolveCellSystems(batched_voltage, 1.0, 1.5, true), expected_message.str());
+        ReplicatableVector voltage_after_failure(batched_voltage);
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(voltage_after_failure[i], batched_voltage_repl[i], 1e-15);
+        }
+
+        PetscTools::Destroy(single_voltage);
+        PetscTools::Destroy(batched_voltage);
+    }
+
+    void TestTissueWithBatchedCellsAndHaloExchange() throw(Exception)
+    {
+        // In parallel, the halo cells (as used in state variable interpolation) are added to the same
+        // batch, and their state is communicated at the end of each solve
+        HeartConfig::Instance()->Reset();
+        HeartConfig::Instance()->SetOdeTimeStep(0.01);
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0);
+
+        BatchedOrNotFhnCellFactory single_factory(false);
+        single_factory.SetMesh(&mesh);
+        BatchedOrNotFhnCellFactory batched_factory(true);
+        batched_factory.SetMesh(&mesh);
+
+        MonodomainTissue<1> single_tissue(&single_factory, true);
+        MonodomainTissue<1> batched_tissue(&batched_factory, true);
+
+        Vec single_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), 0.0);
+        Vec batched_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), 0.0);
+        for (unsigned i=0; i<2; i++)
+        {
+            single_tissue.SolveCellSystems(single_voltage, 0.5*i, 0.5*(i+1), true);
+            batched_tissue.SolveCellSystems(batched_voltage, 0.5*i, 0.5*(i+1), true);
+        }
+
+        ReplicatableVector single_voltage_repl(single_voltage);
+        ReplicatableVector batched_voltage_repl(batched_voltage);
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(batched_voltage_repl[i], single_voltage_repl[i], 1e-12);
+        }
+
+        PetscTools::Destroy(single_voltage);
+        PetscTools::Destroy(batched_voltage);
+    }
+
+    void TestMonodomainWithSviAndBatchedCells() throw(Exception)
+    {
+        // With state variable interpolation the ionic current is computed at interpolated states
+        HeartConfig::Instance()->Reset();
+        HeartConfig::Instance()->SetSimulationDuration(2.0);
+        HeartConfig::Instance()->SetOdePdeAndPrintingTimeSteps(0.01, 0.01, 0.1);
+        HeartConfig::Instance()->SetUseStateVariableInterpolation();
+
+        ReplicatableVector solutions[2];
+        for (unsigned use_batch=0; use_batch<2; use_batch++)
+        {
+            DistributedTetrahedralMesh<1,1> mesh;
+            mesh.ConstructRegularSlabMesh(0.1, 1.0);
+
+            HeartConfig::Instance()->SetOutputDirectory(use_batch ? "TestBatchedCellsSvi" : "TestSingleCellsSvi");
+            HeartConfig::Instance()->SetOutputFilenamePrefix("results");
+
+            BatchedOrNotFhnCellFactory cell_factory(use_batch == 1u);
+            MonodomainProblem<1> problem(&cell_factory);
+            problem.SetMesh(&mesh);
+            problem.Initialise();
+            problem.Solve();
+            solutions[use_batch].ReplicatePetscVector(problem.GetSolution());
+        }
+
+        TS_ASSERT_EQUALS(solutions[1].GetSize(), solutions[0].GetSize());
+        for (unsigned i=0; i<solutions[0].GetSize(); i++)
+        {
+            TS_ASSERT_DELTA(solutions[1][i], solutions[0][i], 1e-10);
+        }
+        TS_ASSERT_DIFFERS(solutions[1][0], solutions[1][solutions[1].GetSize()-1]);
+    }
+};
+
+#endif /*TESTBATCHEDCARDIACCELLS_HPP_*/
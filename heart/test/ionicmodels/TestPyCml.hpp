@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _TESTPYCML_HPP_
 
 #include <cxxtest/TestSuite.h>
+#include <cmath>
 #include <iostream>
 #include <string>
 
@@ -55,6 +56,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LuoRudy1991.hpp"
 #include "LuoRudy1991Opt.hpp"
 #include "LuoRudy1991BackwardEuler.hpp"
+#include "LuoRudy1991Batched.hpp"
 #include "LuoRudy1991.hpp"
 
 #include "DiFrancescoNoble1985.hpp"
@@ -500,6 +502,57 @@ public:
         n98opt.UseCellMLDefaultStimulus();
         CheckCai(n98opt, false);
     }
+
+    void TestBatchedCodeGeneration() throw(Exception)
+    {
+        // A batch translated from CellML should match the standard translation cell by cell
+        const double dt = 0.01;
+        const unsigned num_cells = 3u;
+        boost::shared_ptr<EulerIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        CellLuoRudy1991FromCellMLBatched batch;
+        batch.SetTimestep(dt);
+        TS_ASSERT_EQUALS(batch.GetSystemInformation()->GetSystemName(), "luo_rudy_1991");
+
+        std::vector<boost::shared_ptr<CellLuoRudy1991FromCellML> > single_cells;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            // Stimulate the cells at different times so that they diverge
+            boost::shared_ptr<SimpleStimulus> p_stimulus(new SimpleStimulus(-25.5, 2.0, 1.0 + i));
+            TS_ASSERT_EQUALS(batch.AddCell(p_stimulus), i);
+            single_cells.push_back(boost::shared_ptr<CellLuoRudy1991FromCellML>(new CellLuoRudy1991FromCellML(p_solver, p_stimulus)));
+            single_cells.back()->SetTimestep(dt);
+        }
+
+        // Parameters are per cell
+        TS_ASSERT_EQUALS(batch.GetNumberOfParameters(), single_cells[0]->GetNumberOfParameters());
+        TS_ASSERT_EQUALS(batch.GetParameter(1, 1u), single_cells[1]->GetParameter(1u));
+        batch.SetParameter(1, 1u, 20.0);
+        single_cells[1]->SetParameter(1u, 20.0);
+        TS_ASSERT_DELTA(batch.GetParameter(0, 1u), 23.0, 1e-12);
+
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            TS_ASSERT_DELTA(batch.GetIIonic(i), single_cells[i]->GetIIonic(), 1e-12);
+        }
+
+        batch.SolveAndUpdateState(0, num_cells, 0.0, 10.0);
+        batch.ComputeExceptVoltage(0, num_cells, 10.0, 12.0);
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            single_cells[i]->SolveAndUpdateState(0.0, 10.0);
+            single_cells[i]->ComputeExceptVoltage(10.0, 12.0);
+
+            std::vector<double> state = batch.GetStdVecStateVariables(i);
+            std::vector<double> expected = single_cells[i]->GetStdVecStateVariables();
+            TS_ASSERT_EQUALS(state.size(), expected.size());
+            for (unsigned j=0; j<expected.size(); j++)
+            {
+                TS_ASSERT_DELTA(state[j], expected[j], 1e-9*(1.0 + std::fabs(expected[j])));
+            }
+            TS_ASSERT_DELTA(batch.GetIIonic(i), single_cells[i]->GetIIonic(), 1e-9);
+        }
+        TS_ASSERT_DIFFERS(batch.GetVoltage(0), batch.GetVoltage(num_cells-1));
+    }
 };
 
 
@@ -59,6 +59,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ArchiveOpener.hpp"
 #include "DiFrancescoNoble1985.hpp"
 #include "MonodomainProblem.hpp"
+#include "HeartEventHandler.hpp"
+#include "ThreadedTestHelpers.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -322,6 +324,63 @@ public:
         PetscTools::Destroy(voltage2);
     }
 
+    void TestSolveCellSystemsOnMultipleThreads() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0); // 11 nodes
+
+        MyCardiacCellFactory cell_factory;
+        cell_factory.SetMesh(&mesh);
+
+        MonodomainTissue<1> serial_tissue( &cell_factory );
+        TS_ASSERT_EQUALS(serial_tissue.GetNumberOfOdeThreads(), 1u);
+        TS_ASSERT_THROWS_THIS(serial_tissue.SetNumberOfOdeThreads(0u), "The number of ODE threads must be at least one.");
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(serial_tissue.SetNumberOfOdeThreads(2u), "cell models cannot be solved");
+        TS_ASSERT_EQUALS(serial_tissue.GetNumberOfOdeThreads(), 1u);
+
+        Vec serial_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -75.0);
+        serial_tissue.SolveCellSystems(serial_voltage, 0, 1, false);
+        serial_tissue.SolveCellSystems(serial_voltage, 1, 2, true);
+        ReplicatableVector serial_voltage_repl(serial_voltage);
+
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest();
+        for (unsigned t=0; t<numbers_of_threads.size(); t++)
+        {
+            const unsigned num_threads = numbers_of_threads[t];
+            MonodomainTissue<1> threaded_tissue( &cell_factory );
+            threaded_tissue.SetNumberOfOdeThreads(num_threads);
+            TS_ASSERT_EQUALS(threaded_tissue.GetNumberOfOdeThreads(), num_threads);
+
+            // The shared Euler solver has been replaced by one solver per cell
+            DistributedVectorFactory* p_factory = mesh.GetDistributedVectorFactory();
+            if (p_factory->GetLocalOwnership() > 1u)
+            {
+                unsigned lo = p_factory->GetLow();
+                TS_ASSERT_DIFFERS(threaded_tissue.GetCardiacCell(lo)->GetSolver(), threaded_tissue.GetCardiacCell(lo+1)->GetSolver());
+            }
+
+            // Each cell is solved exactly as in the serial loop
+            Vec threaded_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -75.0);
+            threaded_tissue.SolveCellSystems(threaded_voltage, 0, 1, false);
+            threaded_tissue.SolveCellSystems(threaded_voltage, 1, 2, true);
+
+            ReplicatableVector threaded_voltage_repl(threaded_voltage);
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                TS_ASSERT_EQUALS(serial_voltage_repl[i], threaded_voltage_repl[i]);
+                TS_ASSERT_EQUALS(serial_tissue.rGetIionicCacheReplicated()[i], threaded_tissue.rGetIionicCacheReplicated()[i]);
+            }
+
+            // Per-thread timings are recorded against the ODE solve event
+            TS_ASSERT_EQUALS(HeartEventHandler::GetThreadTimes(HeartEventHandler::SOLVE_ODES).size(), num_threads);
+
+            PetscTools::Destroy(threaded_voltage);
+        }
+
+        PetscTools::Destroy(serial_voltage);
+    }
+
     void TestNodeExchange() throw(Exception)
     {
         HeartConfig::Instance()->Reset();
@@ -443,6 +502,23 @@ public:
             TS_ASSERT_DELTA(voltage2_repl[0], monodomain_tissue.GetCardiacCellOrHaloCell(0)->GetVoltage(), 1e-10);
         }
 
+        // With halo exchange the caches only hold owned and halo nodes, and the halo entries are up to date
+        HaloedVector& r_iionic_cache = monodomain_tissue.rGetIionicCacheReplicated();
+        TS_ASSERT_EQUALS(r_iionic_cache.GetSize(), 2u);
+        if (PetscTools::IsParallel())
+        {
+            TS_ASSERT(r_iionic_cache.HasHalos());
+            TS_ASSERT_EQUALS(r_iionic_cache.GetNumStoredEntries(), 2u);
+        }
+        for (unsigned node_index=0; node_index<2u; node_index++)
+        {
+            TS_ASSERT_DELTA(r_iionic_cache[node_index], monodomain_tissue.GetCardiacCellOrHaloCell(node_index)->GetIIonic(), 1e-12);
+        }
+
+        // Without cache replication only owned nodes are stored
+        monodomain_tissue.SetCacheReplication(false);
+        TS_ASSERT_EQUALS(r_iionic_cache.GetNumStoredEntries(), mesh.GetDistributedVectorFactory()->GetLocalOwnership());
+
         PetscTools::Destroy(voltage);
         PetscTools::Destroy(voltage2);
     }
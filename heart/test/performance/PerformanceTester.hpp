@@ -150,6 +150,16 @@ public:
                DIM, mNumElements, mNumNodes, PdeTimeStep, OdeTimeStep, PrintingTimeStep, SimTime);
     }
 
+    unsigned GetNumNodes() const
+    {
+        return mNumNodes;
+    }
+
+    unsigned GetNumElements() const
+    {
+        return mNumElements;
+    }
+
 
 public:
     double OdeTimeStep;
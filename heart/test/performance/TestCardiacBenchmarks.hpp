@@ -0,0 +1,112 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCARDIACBENCHMARKS_HPP_
+#define TESTCARDIACBENCHMARKS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include "BidomainProblem.hpp"
+#include "MonodomainProblem.hpp"
+
+#include "BenchmarkReport.hpp"
+#include "HeartEventHandler.hpp"
+#include "LuoRudy1991BackwardEuler.hpp"
+#include "PerformanceTester.hpp"
+
+/**
+ * Benchmarks of monodomain and bidomain simulations on a 3D slab at several mesh
+ * resolutions, using PerformanceTester.
+ *
+ * The results are written to CHASTE_TEST_OUTPUT/CardiacBenchmarks as JSON, with
+ * the HeartEventHandler breakdown of each run, and can be compared against a
+ * stored baseline with python/utils/CompareBenchmarks.py.  Run with different
+ * numbers of processes to benchmark the parallel code.
+ */
+class TestCardiacBenchmarks : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Run a cardiac problem at several mesh resolutions and record the results.
+     *
+     * @param rReport  the report to add the runs to
+     * @param rRunName  the name of the runs
+     */
+    template<class CARDIAC_PROBLEM>
+    void RunBenchmark(BenchmarkReport& rReport, const std::string& rRunName)
+    {
+        PerformanceTester<CellLuoRudy1991FromCellMLBackwardEuler, CARDIAC_PROBLEM, 3> tester("CardiacBenchmarks/" + rRunName);
+        tester.SimTime = 2.0;
+        for (unsigned mesh_num=1; mesh_num<=3; mesh_num++)
+        {
+            tester.MeshNum = mesh_num;
+            HeartEventHandler::Reset();
+
+            rReport.BeginRun(rRunName);
+            rReport.AddParameter("mesh_num", mesh_num);
+            tester.Run();
+            rReport.AddParameter("num_nodes", tester.GetNumNodes());
+            rReport.AddEventTimes("HeartEventHandler", HeartEventHandler::Instance());
+            rReport.EndRun();
+
+            HeartEventHandler::Report();
+        }
+    }
+
+public:
+
+    void TestMonodomainSlabBenchmark() throw(Exception)
+    {
+        BenchmarkReport report("MonodomainSlab");
+        HeartEventHandler::Headings();
+        RunBenchmark<MonodomainProblem<3> >(report, "MonodomainSlab");
+        report.WriteFile("CardiacBenchmarks");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 3u);
+    }
+
+    void TestBidomainSlabBenchmark() throw(Exception)
+    {
+        HeartConfig::Instance()->SetKSPSolver("symmlq");
+        HeartConfig::Instance()->SetKSPPreconditioner("bjacobi");
+
+        BenchmarkReport report("BidomainSlab");
+        HeartEventHandler::Headings();
+        RunBenchmark<BidomainProblem<3> >(report, "BidomainSlab");
+        report.WriteFile("CardiacBenchmarks");
+        TS_ASSERT_EQUALS(report.GetNumRuns(), 3u);
+    }
+};
+
+#endif /*TESTCARDIACBENCHMARKS_HPP_*/
@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cxxtest/TestSuite.h>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
 #include "PropagationPropertiesCalculator.hpp"
 
 
@@ -251,6 +252,46 @@ public:
 
     }
 
+    void TestVoltagesAreReadInBlocksOfNodes() throw(Exception)
+    {
+        Hdf5DataReader simulation_data("heart/test/data/Monodomain1d", "MonodomainLR91_1d", false);
+        unsigned num_nodes = simulation_data.GetNumberOfRows();
+
+        // By default whole chunks are read, and this small dataset fits in one block
+        PropagationPropertiesCalculator ppc_default(&simulation_data);
+        unsigned rows_per_chunk = simulation_data.GetNumberOfRowsPerChunk();
+        TS_ASSERT_LESS_THAN_EQUALS(1u, rows_per_chunk);
+        TS_ASSERT_EQUALS(ppc_default.GetNumNodesPerBlock(), num_nodes);
+
+        // Blocks which don't line up with the chunks, and single nodes, give the same answers
+        PropagationPropertiesCalculator ppc_blocks(&simulation_data);
+        ppc_blocks.SetNumNodesPerBlock(7u);
+        TS_ASSERT_EQUALS(ppc_blocks.GetNumNodesPerBlock(), 7u);
+        PropagationPropertiesCalculator ppc_single(&simulation_data);
+        ppc_single.SetNumNodesPerBlock(1u);
+
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            std::vector<double> times = simulation_data.GetVariableOverTime("V", node_index);
+            double expected_peak = *std::max_element(times.begin(), times.end());
+            TS_ASSERT_EQUALS(ppc_default.CalculatePeakMembranePotential(node_index), expected_peak);
+            TS_ASSERT_EQUALS(ppc_blocks.CalculatePeakMembranePotential(node_index), expected_peak);
+            TS_ASSERT_EQUALS(ppc_single.CalculatePeakMembranePotential(node_index), expected_peak);
+        }
+
+        // The near node of a conduction velocity is cached separately, so far nodes in other blocks don't evict it
+        for (unsigned far_node=21; far_node<=40; far_node++)
+        {
+            double distance = 0.01*(far_node-20.0);
+            TS_ASSERT_EQUALS(ppc_blocks.CalculateAllConductionVelocities(20, far_node, distance),
+                             ppc_single.CalculateAllConductionVelocities(20, far_node, distance));
+        }
+        TS_ASSERT_DELTA(ppc_blocks.CalculateConductionVelocity(20,40,0.2), 0.0498, 0.01);
+
+        // Nodes which aren't in the file are still reported
+        TS_ASSERT_THROWS_CONTAINS(ppc_blocks.CalculatePeakMembranePotential(num_nodes), "doesn't contain info for node");
+    }
+
     void TestEadCalculation() throw(Exception)
     {
        Hdf5DataReader ead_file("heart/test/data/PostProcessingWriter", "Ead", false);
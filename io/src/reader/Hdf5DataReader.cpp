@@ -444,6 +444,23 @@ unsigned Hdf5DataReader::GetNumberOfRows()
     return mDatasetDims[1];
 }
 
+unsigned Hdf5DataReader::GetNumberOfRowsPerChunk()
+{
+    unsigned rows_per_chunk = 1u;
+    hid_t create_plist = H5Dget_create_plist(mVariablesDatasetId);
+    if (H5Pget_layout(create_plist) == H5D_CHUNKED)
+    {
+        hsize_t chunk_dims[3];
+        int chunk_rank = H5Pget_chunk(create_plist, 3, chunk_dims);
+        if (chunk_rank >= 2)
+        {
+            rows_per_chunk = chunk_dims[1];
+        }
+    }
+    H5Pclose(create_plist);
+    return rows_per_chunk;
+}
+
 std::vector<std::string> Hdf5DataReader::GetVariableNames()
 {
     return mVariableNames;
@@ -132,6 +132,12 @@ public:
      */
     unsigned GetNumberOfRows();
 
+    /**
+     * @return the number of rows (nodes) in each chunk of the main dataset, or 1 if it isn't chunked.
+     * Reading whole chunks at once is much faster than reading a single row over all time steps.
+     */
+    unsigned GetNumberOfRowsPerChunk();
+
     /**
      * @return the variable names.
      */
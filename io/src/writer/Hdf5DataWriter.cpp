@@ -39,7 +39,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <set>
 #include <cstring> //For strcmp etc. Needed in gcc-4.4
+#include <stdint.h>
 #include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "Hdf5DataWriter.hpp"
 
@@ -48,6 +50,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscTools.hpp"
 #include "Version.hpp"
 #include "MathsCustomFunctions.hpp"
+#include "Warnings.hpp"
+
+const unsigned Hdf5DataWriter::FULL_PRECISION;
+const unsigned Hdf5DataWriter::FLOAT_PRECISION;
 
 Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
                                const std::string& rDirectory,
@@ -81,7 +87,9 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
       mChunkTargetSize(0x20000), // 128 K
       mAlignment(0), // No alignment
       mUseCache(useCache),
-      mCacheFirstTimeStep(0u)
+      mCacheFirstTimeStep(0u),
+      mDeflateLevel(0u),
+      mUseShuffleFilter(false)
 {
     mChunkSize[0] = 0;
     mChunkSize[1] = 0;
@@ -175,6 +183,8 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
                 var.mVariableName = column_name_unit.substr(0, name_length);
                 var.mVariableUnits = column_name_unit.substr(name_length+1, unit_length);
                 mVariables.push_back(var);
+                // Rounding isn't recorded in the file, so extra data are written at full precision
+                mVariablePrecisions.push_back(FULL_PRECISION);
             }
 
             // Free memory, release ids
@@ -513,6 +523,13 @@ void Hdf5DataWriter::ComputeIncompleteOffset()
 
 int Hdf5DataWriter::DefineVariable(const std::string& rVariableName,
                                    const std::string& rVariableUnits)
+{
+    return DefineVariable(rVariableName, rVariableUnits, FULL_PRECISION);
+}
+
+int Hdf5DataWriter::DefineVariable(const std::string& rVariableName,
+                                   const std::string& rVariableUnits,
+                                   unsigned precision)
 {
     if (!mIsInDefineMode)
     {
@@ -536,8 +553,14 @@ int Hdf5DataWriter::DefineVariable(const std::string& rVariableName,
     new_variable.mVariableUnits = rVariableUnits;
     int variable_id;
 
+    if (precision == 0u || precision > FULL_PRECISION)
+    {
+        EXCEPTION("Variable precision must be between 1 and " << FULL_PRECISION << " mantissa bits.");
+    }
+
     // Add the variable to the variable vector
     mVariables.push_back(new_variable);
+    mVariablePrecisions.push_back(precision);
 
     // Use the index of the variable vector as the variable ID.
     // This is ok since there is no way to remove variables.
@@ -619,8 +642,28 @@ void Hdf5DataWriter::EndDefineMode()
     // Create chunked dataset and clean up
     hid_t cparms = H5Pcreate (H5P_DATASET_CREATE);
     H5Pset_chunk( cparms, DATASET_DIMS, mChunkSize);
+    if (mDeflateLevel > 0u)
+    {
+        if (!H5Zfilter_avail(H5Z_FILTER_DEFLATE))
+        {
+            EXCEPTION("The HDF5 library was built without the deflate filter, so output cannot be compressed.");
+        }
+#if !H5_VERSION_GE(1,10,2)
+        if (!PetscTools::IsSequential())
+        {
+            EXCEPTION("Writing compressed HDF5 output in parallel requires HDF5 1.10.2 or later.");
+        }
+#endif
+        if (mUseShuffleFilter)
+        {
+            H5Pset_shuffle(cparms);
+        }
+        H5Pset_deflate(cparms, mDeflateLevel);
+    }
     hid_t filespace = H5Screate_simple(DATASET_DIMS, mDatasetDims, dataset_max_dims);
-    mVariablesDatasetId = H5Dcreate(mFileId, mDatasetName.c_str(), H5T_NATIVE_DOUBLE, filespace,
+    // Values are written from doubles in memory; HDF5 converts them if the file holds floats
+    hid_t file_type = IsStoredAsFloat() ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+    mVariablesDatasetId = H5Dcreate(mFileId, mDatasetName.c_str(), file_type, filespace,
                                     H5P_DEFAULT, cparms, H5P_DEFAULT);
     SetMainDatasetRawChunkCache(); // Set large cache (even though parallel drivers don't currently use it!)
     H5Sclose(filespace);
@@ -819,42 +862,51 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         MatMult(mSinglePermutation, petscVector, output_petsc_vector);
     }
 
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
+    // Define memspace and hyperslab (cached data is written later, by WriteCache())
+    hid_t memspace = 0;
+    hid_t hyperslab_space = 0;
+    hid_t property_list_id = 0;
+    if (!mUseCache)
     {
-        hsize_t v_size[1] = {mNumberOwned};
-        memspace = H5Screate_simple(1, v_size, nullptr);
+        if (mNumberOwned != 0)
+        {
+            hsize_t v_size[1] = {mNumberOwned};
+            memspace = H5Screate_simple(1, v_size, nullptr);
 
-        hsize_t count[DATASET_DIMS] = {1, mNumberOwned, 1};
-        hsize_t offset_dims[DATASET_DIMS] = {mCurrentTimeStep, mOffset, (unsigned)(variableID)};
+            hsize_t count[DATASET_DIMS] = {1, mNumberOwned, 1};
+            hsize_t offset_dims[DATASET_DIMS] = {mCurrentTimeStep, mOffset, (unsigned)(variableID)};
 
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset_dims, nullptr, count, nullptr);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
+            hyperslab_space = H5Dget_space(mVariablesDatasetId);
+            H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset_dims, nullptr, count, nullptr);
+        }
+        else
+        {
+            memspace = H5Screate(H5S_NULL);
+            hyperslab_space = H5Screate(H5S_NULL);
+        }
 
-    // Create property list for collective dataset
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+        // Create property list for collective dataset
+        property_list_id = H5Pcreate(H5P_DATASET_XFER);
+        H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+    }
 
     double* p_petsc_vector;
     VecGetArray(output_petsc_vector, &p_petsc_vector);
 
+    // Holds a rounded copy of the data if this variable was defined with reduced precision
+    std::vector<double> rounded_data;
+
     if (mIsDataComplete)
     {
+        double* p_output = RoundToVariablePrecisions(p_petsc_vector, mNumberOwned, variableID, 1u, rounded_data);
         if (mUseCache)
         {
             //Covered by TestHdf5DataWriterSingleColumnCached
-            mDataCache.insert(mDataCache.end(), p_petsc_vector, p_petsc_vector+mNumberOwned);
+            mDataCache.insert(mDataCache.end(), p_output, p_output+mNumberOwned);
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_output);
         }
     }
     else
@@ -869,6 +921,7 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
 
             double* p_petsc_vector_incomplete;
             VecGetArray(output_petsc_vector, &p_petsc_vector_incomplete);
+            p_petsc_vector_incomplete = RoundToVariablePrecisions(p_petsc_vector_incomplete, mNumberOwned, variableID, 1u, rounded_data);
 
             if (mUseCache)
             {
@@ -889,23 +942,27 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
                 local_data[i] = p_petsc_vector[ mIncompleteNodeIndices[mOffset+i]-mLo ];
 
             }
+            double* p_local_output = RoundToVariablePrecisions(local_data.get(), mNumberOwned, variableID, 1u, rounded_data);
             if (mUseCache)
             {
                 //Covered by TestHdf5DataWriterFullFormatIncompleteCached
-                mDataCache.insert(mDataCache.end(), local_data.get(), local_data.get()+mNumberOwned);
+                mDataCache.insert(mDataCache.end(), p_local_output, p_local_output+mNumberOwned);
             }
             else
             {
-                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_local_output);
             }
         }
     }
 
     VecRestoreArray(output_petsc_vector, &p_petsc_vector);
 
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
+    if (!mUseCache)
+    {
+        H5Sclose(memspace);
+        H5Sclose(hyperslab_space);
+        H5Pclose(property_list_id);
+    }
 
     if (petscVector != output_petsc_vector)
     {
@@ -981,44 +1038,53 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         // Apply the permutation matrix
         MatMult(mDoublePermutation, petscVector, output_petsc_vector);
     }
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
+    // Define memspace and hyperslab (cached data is written later, by WriteCache())
+    hid_t memspace = 0;
+    hid_t hyperslab_space = 0;
+    hid_t property_list_id = 0;
+    if (!mUseCache)
     {
-        hsize_t v_size[1] = {mNumberOwned*NUM_STRIPES};
-        memspace = H5Screate_simple(1, v_size, nullptr);
+        if (mNumberOwned != 0)
+        {
+            hsize_t v_size[1] = {mNumberOwned*NUM_STRIPES};
+            memspace = H5Screate_simple(1, v_size, nullptr);
 
-        hsize_t start[DATASET_DIMS] = {mCurrentTimeStep, mOffset, (unsigned)(firstVariableID)};
-        hsize_t stride[DATASET_DIMS] = {1, 1, 1};//we are imposing contiguous variables, hence the stride is 1 (3rd component)
-        hsize_t block_size[DATASET_DIMS] = {1, mNumberOwned, 1};
-        hsize_t number_blocks[DATASET_DIMS] = {1, 1, NUM_STRIPES};
+            hsize_t start[DATASET_DIMS] = {mCurrentTimeStep, mOffset, (unsigned)(firstVariableID)};
+            hsize_t stride[DATASET_DIMS] = {1, 1, 1};//we are imposing contiguous variables, hence the stride is 1 (3rd component)
+            hsize_t block_size[DATASET_DIMS] = {1, mNumberOwned, 1};
+            hsize_t number_blocks[DATASET_DIMS] = {1, 1, NUM_STRIPES};
 
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, stride, number_blocks, block_size);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
+            hyperslab_space = H5Dget_space(mVariablesDatasetId);
+            H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, stride, number_blocks, block_size);
+        }
+        else
+        {
+            memspace = H5Screate(H5S_NULL);
+            hyperslab_space = H5Screate(H5S_NULL);
+        }
 
-    // Create property list for collective dataset write, and write! Finally.
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+        // Create property list for collective dataset write, and write! Finally.
+        property_list_id = H5Pcreate(H5P_DATASET_XFER);
+        H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+    }
 
     double* p_petsc_vector;
     VecGetArray(output_petsc_vector, &p_petsc_vector);
 
+    // Holds a rounded copy of the data if any of these variables were defined with reduced precision
+    std::vector<double> rounded_data;
+
     if (mIsDataComplete)
     {
+        double* p_output = RoundToVariablePrecisions(p_petsc_vector, mNumberOwned*NUM_STRIPES, firstVariableID, NUM_STRIPES, rounded_data);
         if (mUseCache)
         {
             // Covered by TestHdf5DataWriterStripedCached
-            mDataCache.insert(mDataCache.end(), p_petsc_vector, p_petsc_vector+mNumberOwned*NUM_STRIPES);
+            mDataCache.insert(mDataCache.end(), p_output, p_output+mNumberOwned*NUM_STRIPES);
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_output);
         }
     }
     else
@@ -1035,6 +1101,7 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
 
                 double* p_petsc_vector_incomplete;
                 VecGetArray(output_petsc_vector, &p_petsc_vector_incomplete);
+                p_petsc_vector_incomplete = RoundToVariablePrecisions(p_petsc_vector_incomplete, 2*mNumberOwned, firstVariableID, 2u, rounded_data);
 
                 if (mUseCache)
                 {
@@ -1056,15 +1123,16 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
                     local_data[NUM_STRIPES*i]   = p_petsc_vector[ local_node_number*NUM_STRIPES ];
                     local_data[NUM_STRIPES*i+1] = p_petsc_vector[ local_node_number*NUM_STRIPES + 1];
                 }
+                double* p_local_output = RoundToVariablePrecisions(local_data.get(), 2*mNumberOwned, firstVariableID, 2u, rounded_data);
 
                 if (mUseCache)
                 {
                     //Covered by TestHdf5DataWriterFullFormatStripedIncompleteCached
-                    mDataCache.insert(mDataCache.end(), local_data.get(), local_data.get()+2*mNumberOwned);
+                    mDataCache.insert(mDataCache.end(), p_local_output, p_local_output+2*mNumberOwned);
                 }
                 else
                 {
-                    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_local_output);
                 }
             }
         }
@@ -1076,9 +1144,12 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
 
     VecRestoreArray(output_petsc_vector, &p_petsc_vector);
 
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
+    if (!mUseCache)
+    {
+        H5Sclose(memspace);
+        H5Sclose(hyperslab_space);
+        H5Pclose(property_list_id);
+    }
 
     if (petscVector != output_petsc_vector)
     {
@@ -1103,20 +1174,46 @@ void Hdf5DataWriter::WriteCache()
         return;
     }
 
-//    PRINT_3_VARIABLES(mCacheFirstTimeStep, mOffset, 0)
-//    PRINT_3_VARIABLES(mCurrentTimeStep-mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2])
-//    PRINT_VARIABLE(mDataCache.size())
+    hsize_t first_time_step = mCacheFirstTimeStep;
+    hsize_t num_time_steps = mCurrentTimeStep-mCacheFirstTimeStep;
+
+    if (mpWriteQueue)
+    {
+        // Hand the cache over as a staging buffer, and start a new cache of the same capacity
+        boost::shared_ptr<std::vector<double> > p_staging_buffer(new std::vector<double>);
+        p_staging_buffer->swap(mDataCache);
+        mDataCache.reserve(p_staging_buffer->capacity());
+
+        mpWriteQueue->Push([this, first_time_step, num_time_steps, p_staging_buffer]()
+        {
+            WriteCacheBlock(first_time_step, num_time_steps, *p_staging_buffer);
+        });
+    }
+    else
+    {
+        WriteCacheBlock(first_time_step, num_time_steps, mDataCache);
+    }
+
+    mCacheFirstTimeStep = mCurrentTimeStep; // Update where we got to
+    mDataCache.clear(); // Clear out cache
+}
+
+void Hdf5DataWriter::WriteCacheBlock(hsize_t firstTimeStep, hsize_t numTimeSteps, const std::vector<double>& rData)
+{
+//    PRINT_3_VARIABLES(firstTimeStep, mOffset, 0)
+//    PRINT_3_VARIABLES(numTimeSteps, mNumberOwned, mDatasetDims[2])
+//    PRINT_VARIABLE(rData.size())
 
     // Define memspace and hyperslab
     hid_t memspace, hyperslab_space;
     if (mNumberOwned != 0)
     {
-        hsize_t v_size[1] = {mDataCache.size()};
+        hsize_t v_size[1] = {rData.size()};
         memspace = H5Screate_simple(1, v_size, nullptr);
 
-        hsize_t start[DATASET_DIMS] = {mCacheFirstTimeStep, mOffset, 0};
-        hsize_t count[DATASET_DIMS] = {mCurrentTimeStep-mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2]};
-        assert((mCurrentTimeStep-mCacheFirstTimeStep)*mNumberOwned*mDatasetDims[2] == mDataCache.size()); // Got size right?
+        hsize_t start[DATASET_DIMS] = {firstTimeStep, mOffset, 0};
+        hsize_t count[DATASET_DIMS] = {numTimeSteps, mNumberOwned, mDatasetDims[2]};
+        assert(numTimeSteps*mNumberOwned*mDatasetDims[2] == rData.size()); // Got size right?
 
         hyperslab_space = H5Dget_space(mVariablesDatasetId);
         H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, nullptr, count, nullptr);
@@ -1132,15 +1229,42 @@ void Hdf5DataWriter::WriteCache()
     H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
 
     // Write!
-    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, &mDataCache[0]);
+    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, rData.empty() ? nullptr : &rData[0]);
 
     // Tidy up
     H5Sclose(memspace);
     H5Sclose(hyperslab_space);
     H5Pclose(property_list_id);
+}
 
-    mCacheFirstTimeStep = mCurrentTimeStep; // Update where we got to
-    mDataCache.clear(); // Clear out cache
+void Hdf5DataWriter::SetAsynchronousWriting(unsigned numStagingBuffers, bool blockWhenFull)
+{
+    if (!mUseCache)
+    {
+        EXCEPTION("Asynchronous writing requires the writer to be constructed with useCache=true.");
+    }
+
+    // Anything already waiting is written by the old queue before it goes
+    mpWriteQueue.reset();
+
+    int thread_level;
+    MPI_Query_thread(&thread_level);
+    bool use_thread = (thread_level == MPI_THREAD_MULTIPLE);
+    if (!use_thread)
+    {
+        WARN_ONCE_ONLY("MPI has not been initialised with MPI_THREAD_MULTIPLE, so HDF5 output will be written synchronously.");
+    }
+    mpWriteQueue.reset(new Hdf5WriteQueue(numStagingBuffers, blockWhenFull, use_thread));
+}
+
+bool Hdf5DataWriter::GetUsingAsynchronousWriting()
+{
+    return mpWriteQueue && mpWriteQueue->IsUsingThread();
+}
+
+unsigned Hdf5DataWriter::GetNumTimesStagingBuffersFull()
+{
+    return mpWriteQueue ? mpWriteQueue->GetNumTimesFull() : 0u;
 }
 
 void Hdf5DataWriter::PutUnlimitedVariable(double value)
@@ -1164,19 +1288,33 @@ void Hdf5DataWriter::PutUnlimitedVariable(double value)
         return;
     }
 
-    hsize_t size[1] = {1};
-    hid_t memspace = H5Screate_simple(1, size, nullptr);
+    hsize_t time_step = mCurrentTimeStep;
+    hid_t dataset_id = mUnlimitedDatasetId;
+    std::function<void()> write_value = [time_step, dataset_id, value]()
+    {
+        hsize_t size[1] = {1};
+        hid_t memspace = H5Screate_simple(1, size, nullptr);
 
-    // Select hyperslab in the file.
-    hsize_t count[1] = {1};
-    hsize_t offset[1] = {mCurrentTimeStep};
-    hid_t hyperslab_space = H5Dget_space(mUnlimitedDatasetId);
-    H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+        // Select hyperslab in the file.
+        hsize_t count[1] = {1};
+        hsize_t offset[1] = {time_step};
+        hid_t hyperslab_space = H5Dget_space(dataset_id);
+        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset, nullptr, count, nullptr);
 
-    H5Dwrite(mUnlimitedDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, H5P_DEFAULT, &value);
+        H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, H5P_DEFAULT, &value);
 
-    H5Sclose(hyperslab_space);
-    H5Sclose(memspace);
+        H5Sclose(hyperslab_space);
+        H5Sclose(memspace);
+    };
+
+    if (mpWriteQueue)
+    {
+        mpWriteQueue->Push(write_value, false);
+    }
+    else
+    {
+        write_value();
+    }
 }
 
 void Hdf5DataWriter::Close()
@@ -1190,6 +1328,12 @@ void Hdf5DataWriter::Close()
     {
         WriteCache();
     }
+    if (mpWriteQueue)
+    {
+        // Wait for the I/O thread to finish writing
+        mpWriteQueue->Flush();
+        mpWriteQueue.reset();
+    }
 
     H5Dclose(mVariablesDatasetId);
     if (mIsUnlimitedDimensionSet)
@@ -1256,8 +1400,23 @@ void Hdf5DataWriter::PossiblyExtend()
 {
     if (mNeedExtend)
     {
-        H5Dset_extent( mVariablesDatasetId, mDatasetDims );
-        H5Dset_extent( mUnlimitedDatasetId, mDatasetDims );
+        if (mpWriteQueue)
+        {
+            // Extend in turn with the writes on the I/O thread
+            std::vector<hsize_t> dims(mDatasetDims, mDatasetDims+DATASET_DIMS);
+            hid_t variables_dataset_id = mVariablesDatasetId;
+            hid_t unlimited_dataset_id = mUnlimitedDatasetId;
+            mpWriteQueue->Push([dims, variables_dataset_id, unlimited_dataset_id]()
+            {
+                H5Dset_extent( variables_dataset_id, &dims[0] );
+                H5Dset_extent( unlimited_dataset_id, &dims[0] );
+            }, false);
+        }
+        else
+        {
+            H5Dset_extent( mVariablesDatasetId, mDatasetDims );
+            H5Dset_extent( mUnlimitedDatasetId, mDatasetDims );
+        }
     }
     mNeedExtend = false;
 }
@@ -1406,13 +1565,19 @@ hsize_t Hdf5DataWriter::CalculateNumberOfChunks()
 void Hdf5DataWriter::CalculateChunkDims( unsigned targetSize, unsigned* pChunkSizeInBytes, bool* pAllOneChunk )
 {
     bool all_one_chunk = true;
-    unsigned chunk_size_in_bytes = 8u; // 8 bytes/double
+    unsigned chunk_size_in_bytes = IsStoredAsFloat() ? 4u : 8u; // 4 bytes/float or 8 bytes/double
     unsigned divisors[DATASET_DIMS];
     // Loop over dataset dimensions, dividing each dimension into the integer number of chunks that results
     // in the number of entries closest to the targetSize. This means the chunks will span the dataset with
     // as little waste as possible.
     for (unsigned i=0; i<DATASET_DIMS; ++i)
     {
+        if (i == DATASET_DIMS-1 && mDeflateLevel > 0u)
+        {
+            // Compressed chunks hold a single variable, so that they contain similar values
+            mChunkSize[i] = 1u;
+            continue;
+        }
         // What do I divide the dataset by to get targetSize entries per chunk?
         divisors[i] = CeilDivide(mDatasetDims[i], targetSize);
         // If I divide my dataset into divisors pieces, how big is each chunk?
@@ -1485,6 +1650,74 @@ void Hdf5DataWriter::SetTargetChunkSize(hsize_t targetSize)
     mChunkTargetSize = targetSize;
 }
 
+void Hdf5DataWriter::SetCompression(unsigned deflateLevel, bool useShuffle)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set compression when not in define mode.");
+    }
+    if (deflateLevel > 9u)
+    {
+        EXCEPTION("The deflate level must be between 0 and 9.");
+    }
+    mDeflateLevel = deflateLevel;
+    mUseShuffleFilter = useShuffle;
+}
+
+bool Hdf5DataWriter::IsStoredAsFloat() const
+{
+    if (mVariablePrecisions.empty())
+    {
+        return false;
+    }
+    for (unsigned i=0; i<mVariablePrecisions.size(); i++)
+    {
+        if (mVariablePrecisions[i] > FLOAT_PRECISION)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double* Hdf5DataWriter::RoundToVariablePrecisions(double* pData, unsigned numValues,
+                                                  unsigned firstVariableID, unsigned numVariables,
+                                                  std::vector<double>& rBuffer)
+{
+    bool all_full_precision = true;
+    for (unsigned var=firstVariableID; var<firstVariableID+numVariables && var<mVariablePrecisions.size(); var++)
+    {
+        all_full_precision = all_full_precision && (mVariablePrecisions[var] == FULL_PRECISION);
+    }
+    if (all_full_precision)
+    {
+        return pData;
+    }
+
+    const uint64_t exponent_mask = 0x7ff0000000000000ULL;
+    rBuffer.assign(pData, pData+numValues);
+    for (unsigned i=0; i<numValues; i++)
+    {
+        unsigned bits = mVariablePrecisions[firstVariableID + i%numVariables];
+        if (bits == FULL_PRECISION)
+        {
+            continue;
+        }
+        uint64_t u;
+        memcpy(&u, &rBuffer[i], sizeof(u));
+        if ((u & exponent_mask) == exponent_mask)
+        {
+            // Leave infinities and NaNs alone
+            continue;
+        }
+        // Round to nearest by adding half the last kept bit, then clear the dropped bits
+        unsigned drop = FULL_PRECISION - bits;
+        u = (u + (1ULL << (drop-1))) & ~((1ULL << drop) - 1ULL);
+        memcpy(&rBuffer[i], &u, sizeof(u));
+    }
+    return &rBuffer[0];
+}
+
 void Hdf5DataWriter::SetAlignment(hsize_t alignment)
 {
     /* Note: calling this method after OpenFile() is pointless as that's where
@@ -37,10 +37,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define HDF5DATAWRITER_HPP_
 
 #include <vector>
+#include <boost/scoped_ptr.hpp>
 
 #include "AbstractHdf5Access.hpp"
 #include "DataWriterVariable.hpp"
 #include "DistributedVectorFactory.hpp"
+#include "Hdf5WriteQueue.hpp"
 
 /**
  * A concrete HDF5 data writer class.
@@ -90,6 +92,11 @@ private:
     bool mUseCache;                                 /**< Whether to use a cache */
     long unsigned mCacheFirstTimeStep;              /**< Coordinate to keep track of cache writes */
     std::vector<double> mDataCache;                 /**< Cache results here before writing */
+    boost::scoped_ptr<Hdf5WriteQueue> mpWriteQueue; /**< Writes waiting for the I/O thread, if writing asynchronously */
+
+    unsigned mDeflateLevel;                         /**< Deflate (gzip) level for the main dataset; zero means no compression */
+    bool mUseShuffleFilter;                         /**< Whether to shuffle bytes before deflating */
+    std::vector<unsigned> mVariablePrecisions;      /**< The number of mantissa bits kept for each variable */
 
     /**
      * Check name of variable is allowed, i.e. contains only alphanumeric & _, and isn't blank.
@@ -143,6 +150,35 @@ private:
      */
     void SetChunkSize();
 
+    /**
+     * Write a block of whole time steps from the cache to the dataset.
+     * This may be run on the I/O thread when writing asynchronously.
+     *
+     * @param firstTimeStep  the first time step in the block
+     * @param numTimeSteps  the number of time steps in the block
+     * @param rData  the cached data for these time steps
+     */
+    void WriteCacheBlock(hsize_t firstTimeStep, hsize_t numTimeSteps, const std::vector<double>& rData);
+
+    /**
+     * @return whether the main dataset is stored as single precision floats, which is the
+     *     case when every variable is stored with at most #FLOAT_PRECISION mantissa bits.
+     */
+    bool IsStoredAsFloat() const;
+
+    /**
+     * Round the data for a write to the precision of their variables, if any of them are lossy.
+     *
+     * @param pData  the data to write, with numVariables interleaved values per node
+     * @param numValues  the number of values in pData
+     * @param firstVariableID  the ID of the first variable
+     * @param numVariables  the number of (consecutive) variables in the data
+     * @param rBuffer  storage for rounded data, if it is needed
+     * @return either pData, if all the variables are stored at full precision, or the rounded data in rBuffer
+     */
+    double* RoundToVariablePrecisions(double* pData, unsigned numValues, unsigned firstVariableID,
+                                      unsigned numVariables, std::vector<double>& rBuffer);
+
 public:
 
     /**
@@ -214,6 +250,22 @@ public:
      */
     int DefineVariable(const std::string& rVariableName, const std::string& rVariableUnits);
 
+    /**
+     * Define a variable which may be stored with reduced precision.
+     *
+     * The values of the variable are rounded to the given number of mantissa bits before they are
+     * written, which is lossy but makes them far more compressible (see SetCompression()).  If all
+     * variables have at most #FLOAT_PRECISION bits, the dataset is stored as single precision floats.
+     * Readers convert the values back to doubles transparently.
+     *
+     * @param rVariableName The name of the dimension
+     * @param rVariableUnits The physical units of the dimension
+     * @param precision The number of mantissa bits to keep, from 1 to #FULL_PRECISION (lossless)
+     *
+     * @return The identifier of the variable
+     */
+    int DefineVariable(const std::string& rVariableName, const std::string& rVariableUnits, unsigned precision);
+
     /**
      * Check whether writer is in define mode.
      *
@@ -266,10 +318,40 @@ public:
     bool GetUsingCache();
 
     /**
-     * Write the cache to disk.
+     * Write the cache to disk.  When writing asynchronously, the cache is handed over to the
+     * I/O thread as a staging buffer and written while the caller carries on.
      */
     void WriteCache();
 
+    /**
+     * Write cached data asynchronously.  Whenever the cache fills a chunk in the time dimension
+     * it becomes a staging buffer which a dedicated I/O thread writes out, and all other HDF5
+     * calls made after the end of define mode are passed to the same thread, in order.  The
+     * writer must have been constructed with useCache=true.
+     *
+     * All processes make collective HDF5 calls from their I/O threads at the same time as the
+     * caller may be using MPI, so this needs MPI initialised with MPI_THREAD_MULTIPLE, which the
+     * test and executable setup request when given the -mpi_thread_multiple command line option
+     * (see PetscSetupUtils::InitialiseMpiAndPetsc()).  Otherwise a warning is given and the
+     * staging buffers are written immediately, as with the cache.
+     *
+     * @param numStagingBuffers  the number of staging buffers which may be waiting to be written
+     * @param blockWhenFull  whether to wait for a write to finish when all the staging buffers are
+     *     in use (otherwise more staging buffers are allocated)
+     */
+    void SetAsynchronousWriting(unsigned numStagingBuffers=2u, bool blockWhenFull=true);
+
+    /**
+     * @return whether writes are made on a dedicated I/O thread.
+     */
+    bool GetUsingAsynchronousWriting();
+
+    /**
+     * @return the number of times all the staging buffers were in use when more data was
+     *     ready to write (zero if not writing asynchronously).
+     */
+    unsigned GetNumTimesStagingBuffersFull();
+
     /**
      * Write a single value for the unlimited variable (e.g. time) to the dataset.
      *
@@ -410,6 +492,26 @@ public:
      * @param alignment Alignment (bytes)
      */
     void SetAlignment(hsize_t alignment);
+
+    /**
+     * Compress the main dataset with the deflate (gzip) filter, optionally after the shuffle filter
+     * which groups bytes of equal significance together and so helps with smooth data.  When the
+     * chunk dimensions are chosen automatically, each chunk holds a single variable so that similar
+     * values are compressed together.
+     *
+     * This method only has an effect when creating a NEW DATASET. Must be called in define mode.
+     * Writing compressed data in parallel needs HDF5 1.10.2 or later.
+     *
+     * @param deflateLevel  the deflate level, from 1 (fastest) to 9 (smallest); zero turns compression off
+     * @param useShuffle  whether to shuffle bytes before deflating
+     */
+    void SetCompression(unsigned deflateLevel, bool useShuffle=true);
+
+    /** The number of mantissa bits in a double, i.e. lossless storage for DefineVariable(). */
+    static const unsigned FULL_PRECISION = 52u;
+
+    /** The number of mantissa bits in a float, i.e. float32 storage for DefineVariable(). */
+    static const unsigned FLOAT_PRECISION = 23u;
 };
 
 #endif /*HDF5DATAWRITER_HPP_*/
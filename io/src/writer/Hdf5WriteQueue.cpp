@@ -0,0 +1,184 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "Hdf5WriteQueue.hpp"
+
+#include "Exception.hpp"
+
+Hdf5WriteQueue::Hdf5WriteQueue(unsigned numStagingBuffers, bool blockWhenFull, bool useThread)
+    : mNumStagingBuffers(numStagingBuffers),
+      mBlockWhenFull(blockWhenFull),
+      mUseThread(useThread),
+      mBusy(false),
+      mNumStagingBuffersInUse(0u),
+      mStop(false),
+      mNumTimesFull(0u)
+{
+    if (mNumStagingBuffers == 0)
+    {
+        EXCEPTION("The number of staging buffers must be at least one.");
+    }
+    if (mUseThread)
+    {
+        mThread = std::thread(&Hdf5WriteQueue::RunOperations, this);
+    }
+}
+
+Hdf5WriteQueue::~Hdf5WriteQueue()
+{
+    if (mUseThread)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mOperationPushed.notify_one();
+        mThread.join();
+    }
+}
+
+void Hdf5WriteQueue::RunOperations()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mOperationPushed.wait(lock, [this]{ return mStop || !mOperations.empty(); });
+        if (mOperations.empty())
+        {
+            // Only stop once everything has been written
+            break;
+        }
+
+        std::function<void()> operation = mOperations.front().first;
+        bool holds_staging_buffer = mOperations.front().second;
+        mOperations.pop_front();
+        mBusy = true;
+        lock.unlock();
+
+        std::exception_ptr p_exception;
+        try
+        {
+            operation();
+        }
+        catch (...)
+        {
+            p_exception = std::current_exception();
+        }
+
+        lock.lock();
+        if (p_exception && !mpException)
+        {
+            mpException = p_exception;
+        }
+        mBusy = false;
+        if (holds_staging_buffer)
+        {
+            mNumStagingBuffersInUse--;
+        }
+        mOperationFinished.notify_all();
+    }
+}
+
+void Hdf5WriteQueue::RethrowException()
+{
+    if (mpException)
+    {
+        std::exception_ptr p_exception = mpException;
+        mpException = nullptr;
+        std::rethrow_exception(p_exception);
+    }
+}
+
+void Hdf5WriteQueue::Push(const std::function<void()>& rOperation, bool holdsStagingBuffer)
+{
+    if (!mUseThread)
+    {
+        rOperation();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    RethrowException();
+    if (holdsStagingBuffer)
+    {
+        if (mNumStagingBuffersInUse >= mNumStagingBuffers)
+        {
+            mNumTimesFull++;
+            if (mBlockWhenFull)
+            {
+                mOperationFinished.wait(lock, [this]{ return mNumStagingBuffersInUse < mNumStagingBuffers; });
+                RethrowException();
+            }
+        }
+        mNumStagingBuffersInUse++;
+    }
+    mOperations.push_back(std::make_pair(rOperation, holdsStagingBuffer));
+    lock.unlock();
+    mOperationPushed.notify_one();
+}
+
+void Hdf5WriteQueue::Flush()
+{
+    if (mUseThread)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mOperationFinished.wait(lock, [this]{ return mOperations.empty() && !mBusy; });
+        RethrowException();
+    }
+}
+
+unsigned Hdf5WriteQueue::GetNumPending()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mOperations.size() + (mBusy ? 1u : 0u);
+}
+
+unsigned Hdf5WriteQueue::GetNumStagingBuffersInUse()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNumStagingBuffersInUse;
+}
+
+unsigned Hdf5WriteQueue::GetNumTimesFull()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNumTimesFull;
+}
+
+bool Hdf5WriteQueue::IsUsingThread() const
+{
+    return mUseThread;
+}
@@ -0,0 +1,163 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef HDF5WRITEQUEUE_HPP_
+#define HDF5WRITEQUEUE_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <boost/utility.hpp>
+
+/**
+ * A first-in first-out queue of HDF5 operations, used by Hdf5DataWriter for asynchronous output.
+ *
+ * Operations are run in order on a dedicated I/O thread while the caller carries on, so that
+ * HDF5 is only ever called from one thread and collective writes are issued in the same order
+ * on every process.  Pending writes of cached output data each hold a staging buffer, and the
+ * number of staging buffers bounds how many of them may be pending at once.  When they are all
+ * in use, pushing another such write either blocks until a write has finished (back-pressure on
+ * the caller) or lets the queue grow beyond its nominal size.  Small operations which do not
+ * hold a staging buffer, such as extending a dataset, never wait.
+ *
+ * If the queue is not using a thread, each operation is run as soon as it is pushed.
+ */
+class Hdf5WriteQueue : private boost::noncopyable
+{
+private:
+
+    /** The number of staging buffers, i.e. how many writes of cached data may be pending before the queue is full. */
+    unsigned mNumStagingBuffers;
+
+    /** Whether Push() blocks when the queue is full, rather than letting it grow. */
+    bool mBlockWhenFull;
+
+    /** Whether operations are run on a dedicated I/O thread. */
+    bool mUseThread;
+
+    /** Operations waiting to be run, each with whether it holds a staging buffer. */
+    std::deque<std::pair<std::function<void()>, bool> > mOperations;
+
+    /** Whether the I/O thread is currently running an operation. */
+    bool mBusy;
+
+    /** The number of operations queued or running which hold a staging buffer. */
+    unsigned mNumStagingBuffersInUse;
+
+    /** Set to tell the I/O thread to finish. */
+    bool mStop;
+
+    /** The number of times Push() found the queue full. */
+    unsigned mNumTimesFull;
+
+    /** The first exception thrown by an operation on the I/O thread, to be rethrown to the caller. */
+    std::exception_ptr mpException;
+
+    /** Protects all the members above. */
+    std::mutex mMutex;
+
+    /** Signalled when an operation is added to the queue (or the thread should stop). */
+    std::condition_variable mOperationPushed;
+
+    /** Signalled when the I/O thread finishes an operation. */
+    std::condition_variable mOperationFinished;
+
+    /** The I/O thread. */
+    std::thread mThread;
+
+    /** The body of the I/O thread. */
+    void RunOperations();
+
+    /** Rethrow any exception from the I/O thread.  Must be called with #mMutex held. */
+    void RethrowException();
+
+public:
+
+    /**
+     * Constructor.  Starts the I/O thread, if there is to be one.
+     *
+     * @param numStagingBuffers  the number of writes of cached data which may be pending before the queue is full (at least one)
+     * @param blockWhenFull  whether Push() should wait for a write to finish when the queue is full
+     * @param useThread  whether to run operations on a dedicated I/O thread
+     */
+    Hdf5WriteQueue(unsigned numStagingBuffers, bool blockWhenFull, bool useThread);
+
+    /**
+     * Destructor.  Waits for all pending operations to finish and stops the I/O thread.
+     */
+    ~Hdf5WriteQueue();
+
+    /**
+     * Add an operation to the back of the queue.
+     *
+     * @param rOperation  the operation
+     * @param holdsStagingBuffer  whether the operation holds a staging buffer, and so counts
+     *     towards the queue being full (defaults to true)
+     */
+    void Push(const std::function<void()>& rOperation, bool holdsStagingBuffer=true);
+
+    /**
+     * Wait until all pending operations have finished.  Any exception thrown by an operation
+     * is rethrown here (or by the next Push()).
+     */
+    void Flush();
+
+    /**
+     * @return the number of operations queued or running.
+     */
+    unsigned GetNumPending();
+
+    /**
+     * @return the number of staging buffers held by operations queued or running.
+     */
+    unsigned GetNumStagingBuffersInUse();
+
+    /**
+     * @return the number of times Push() found the queue full.
+     */
+    unsigned GetNumTimesFull();
+
+    /**
+     * @return whether operations are run on a dedicated I/O thread.
+     */
+    bool IsUsingThread() const;
+};
+
+#endif // HDF5WRITEQUEUE_HPP_
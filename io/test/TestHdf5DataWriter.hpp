@@ -38,9 +38,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cxxtest/TestSuite.h>
 
+#include <cmath>
 #include <cstring> // For strcpy
 
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <boost/lexical_cast.hpp>
+
 #include "Hdf5DataWriter.hpp"
+#include "Hdf5WriteQueue.hpp"
 #include "Hdf5DataReader.hpp"
 #include "PetscSetupAndFinalize.hpp"
 #include "OutputFileHandler.hpp"
@@ -869,6 +876,255 @@ public:
         PetscTools::Destroy(petsc_data_long);
     }
 
+    void TestHdf5DataWriterStripedAsynchronous() throw(Exception)
+    {
+        int number_nodes = 100;
+        DistributedVectorFactory vec_factory(number_nodes);
+
+        {
+            Hdf5DataWriter writer(vec_factory, "TestHdf5DataWriter", "hdf5_test_striped_uncached");
+            TS_ASSERT_THROWS_THIS(writer.SetAsynchronousWriting(),
+                                  "Asynchronous writing requires the writer to be constructed with useCache=true.");
+        }
+
+        Hdf5DataWriter writer(vec_factory,
+                              "TestHdf5DataWriter",
+                              "hdf5_test_striped_asynchronous",
+                              false,
+                              false,
+                              "Data",
+                              true); // use cache
+        writer.DefineFixedDimension(number_nodes);
+        writer.SetFixedChunkSize(3, 10, 2);
+
+        int vm_id = writer.DefineVariable("V_m", "millivolts");
+        int phi_e_id = writer.DefineVariable("Phi_e", "millivolts");
+
+        std::vector<int> striped_variable_IDs;
+        striped_variable_IDs.push_back(vm_id);
+        striped_variable_IDs.push_back(phi_e_id);
+
+        writer.DefineUnlimitedDimension("Time", "msec");
+
+        writer.EndDefineMode();
+
+        // A single staging buffer gives the most back-pressure
+        writer.SetAsynchronousWriting(1u);
+        int thread_level;
+        MPI_Query_thread(&thread_level);
+        TS_ASSERT_EQUALS(writer.GetUsingAsynchronousWriting(), thread_level == MPI_THREAD_MULTIPLE);
+        Warnings::QuietDestroy();
+
+        Vec petsc_data_long = vec_factory.CreateVec(2);
+        DistributedVector distributed_vector_long = vec_factory.CreateDistributedVector(petsc_data_long);
+        DistributedVector::Stripe vm_stripe(distributed_vector_long, 0);
+        DistributedVector::Stripe phi_e_stripe(distributed_vector_long, 1);
+
+        for (unsigned time_step=0; time_step<10; time_step++)
+        {
+            for (DistributedVector::Iterator index = distributed_vector_long.Begin();
+                 index!= distributed_vector_long.End();
+                 ++index)
+            {
+                vm_stripe[index] =  time_step*1000 + index.Global*2;
+                phi_e_stripe[index] =  time_step*1000 + index.Global*2+1;
+            }
+            distributed_vector_long.Restore();
+
+            // The data are copied into the cache, so the vector may be overwritten straight away
+            writer.PutStripedVector(striped_variable_IDs, petsc_data_long);
+            writer.PutUnlimitedVariable(time_step);
+            writer.AdvanceAlongUnlimitedDimension();
+
+            // The cache is handed over to the I/O thread on whole chunks
+            unsigned expected_cache_size = ((time_step+1) % 3) * writer.mNumberOwned * 2;
+            TS_ASSERT_EQUALS(writer.mDataCache.size(), expected_cache_size);
+        }
+
+        // Waits for the I/O thread
+        writer.Close();
+
+        // The file is the same as with synchronous cached writes
+        TS_ASSERT(CompareFilesViaHdf5DataReader("TestHdf5DataWriter", "hdf5_test_striped_asynchronous", true,
+                                                "io/test/data", "hdf5_test_striped_with_cache", false));
+
+        PetscTools::Destroy(petsc_data_long);
+    }
+
+    void TestHdf5WriteQueue() throw(Exception)
+    {
+        TS_ASSERT_THROWS_THIS(Hdf5WriteQueue(0u, true, true), "The number of staging buffers must be at least one.");
+
+        // Without a thread, operations run straight away
+        {
+            std::vector<unsigned> results;
+            Hdf5WriteQueue queue(2u, true, false);
+            TS_ASSERT(!queue.IsUsingThread());
+            queue.Push([&results]() { results.push_back(1u); });
+            TS_ASSERT_EQUALS(results.size(), 1u);
+            TS_ASSERT_EQUALS(queue.GetNumPending(), 0u);
+        }
+
+        // With a thread, operations run in order; blocking keeps at most two pending
+        for (unsigned block=0; block<2; block++)
+        {
+            std::vector<unsigned> results;
+            Hdf5WriteQueue queue(2u, block == 1u, true);
+            TS_ASSERT(queue.IsUsingThread());
+            for (unsigned i=0; i<20; i++)
+            {
+                queue.Push([&results, i]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    results.push_back(i);
+                });
+                if (block == 1u)
+                {
+                    TS_ASSERT_LESS_THAN_EQUALS(queue.GetNumPending(), 2u);
+                }
+            }
+            queue.Flush();
+            TS_ASSERT_EQUALS(queue.GetNumPending(), 0u);
+            TS_ASSERT_LESS_THAN(0u, queue.GetNumTimesFull());
+            TS_ASSERT_EQUALS(results.size(), 20u);
+            for (unsigned i=0; i<results.size(); i++)
+            {
+                TS_ASSERT_EQUALS(results[i], i);
+            }
+        }
+
+        // Operations without a staging buffer never wait, even when all the buffers are in use
+        {
+            std::mutex release_mutex;
+            release_mutex.lock();
+            std::vector<unsigned> results;
+            Hdf5WriteQueue queue(1u, true, true);
+            queue.Push([&results, &release_mutex]()
+            {
+                std::lock_guard<std::mutex> release_lock(release_mutex);
+                results.push_back(0u);
+            });
+            TS_ASSERT_EQUALS(queue.GetNumStagingBuffersInUse(), 1u);
+            for (unsigned i=1; i<5; i++)
+            {
+                queue.Push([&results, i]() { results.push_back(i); }, false);
+            }
+            TS_ASSERT_EQUALS(queue.GetNumStagingBuffersInUse(), 1u);
+            TS_ASSERT_EQUALS(queue.GetNumPending(), 5u);
+            TS_ASSERT_EQUALS(queue.GetNumTimesFull(), 0u);
+            release_mutex.unlock();
+
+            queue.Flush();
+            TS_ASSERT_EQUALS(queue.GetNumStagingBuffersInUse(), 0u);
+            TS_ASSERT_EQUALS(results.size(), 5u);
+            for (unsigned i=0; i<results.size(); i++)
+            {
+                TS_ASSERT_EQUALS(results[i], i);
+            }
+        }
+
+        // Exceptions on the I/O thread are passed back to the caller
+        {
+            Hdf5WriteQueue queue(2u, true, true);
+            queue.Push([]() { EXCEPTION("Write failed"); });
+            TS_ASSERT_THROWS_THIS(queue.Flush(), "Write failed");
+            TS_ASSERT_THROWS_NOTHING(queue.Flush());
+        }
+    }
+
+    void TestHdf5DataWriterCompressedAndReducedPrecision() throw(Exception)
+    {
+        int number_nodes = 100;
+        unsigned number_time_steps = 5;
+        DistributedVectorFactory vec_factory(number_nodes);
+
+        // Files: 0 plain; 1 lossless compression; 2 both variables as floats; 3 V_m exact and Phi_e with 10 bits
+        const unsigned vm_precisions[4] = {Hdf5DataWriter::FULL_PRECISION, Hdf5DataWriter::FULL_PRECISION,
+                                           Hdf5DataWriter::FLOAT_PRECISION, Hdf5DataWriter::FULL_PRECISION};
+        const unsigned phi_e_precisions[4] = {Hdf5DataWriter::FULL_PRECISION, Hdf5DataWriter::FULL_PRECISION,
+                                              Hdf5DataWriter::FLOAT_PRECISION, 10u};
+
+        for (unsigned file=0; file<4; file++)
+        {
+            Hdf5DataWriter writer(vec_factory, "TestHdf5DataWriter", "hdf5_test_compressed_" + boost::lexical_cast<std::string>(file));
+            writer.DefineFixedDimension(number_nodes);
+
+            TS_ASSERT_THROWS_THIS(writer.SetCompression(10u), "The deflate level must be between 0 and 9.");
+            TS_ASSERT_THROWS_THIS(writer.DefineVariable("V_m", "millivolts", 0u),
+                                  "Variable precision must be between 1 and 52 mantissa bits.");
+            if (file > 0)
+            {
+                writer.SetCompression(6u);
+            }
+
+            int vm_id = writer.DefineVariable("V_m", "millivolts", vm_precisions[file]);
+            int phi_e_id = writer.DefineVariable("Phi_e", "millivolts", phi_e_precisions[file]);
+            std::vector<int> striped_variable_IDs;
+            striped_variable_IDs.push_back(vm_id);
+            striped_variable_IDs.push_back(phi_e_id);
+            writer.DefineUnlimitedDimension("Time", "msec");
+            writer.EndDefineMode();
+
+            TS_ASSERT_THROWS_THIS(writer.SetCompression(1u), "Cannot set compression when not in define mode.");
+            TS_ASSERT_EQUALS(writer.IsStoredAsFloat(), file == 2u);
+            if (file > 0)
+            {
+                // Compressed chunks hold one variable each
+                TS_ASSERT_EQUALS(writer.mChunkSize[2], 1u);
+            }
+
+            Vec petsc_data = vec_factory.CreateVec(2);
+            DistributedVector distributed_vector = vec_factory.CreateDistributedVector(petsc_data);
+            DistributedVector::Stripe vm_stripe(distributed_vector, 0);
+            DistributedVector::Stripe phi_e_stripe(distributed_vector, 1);
+            for (unsigned time_step=0; time_step<number_time_steps; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_vector.Begin();
+                     index!= distributed_vector.End();
+                     ++index)
+                {
+                    vm_stripe[index] = -85.0 + sin(0.1*index.Global + time_step);
+                    phi_e_stripe[index] = cos(0.1*index.Global - time_step)/3.0;
+                }
+                distributed_vector.Restore();
+
+                writer.PutStripedVector(striped_variable_IDs, petsc_data);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+            }
+            writer.Close();
+            PetscTools::Destroy(petsc_data);
+        }
+
+        // Lossless compression doesn't change the data
+        TS_ASSERT(CompareFilesViaHdf5DataReader("TestHdf5DataWriter", "hdf5_test_compressed_0", true,
+                                                "TestHdf5DataWriter", "hdf5_test_compressed_1", true));
+
+        // Reduced precision files are read back as doubles, to within the requested precision
+        for (unsigned file=2; file<4; file++)
+        {
+            Hdf5DataReader reader("TestHdf5DataWriter", "hdf5_test_compressed_" + boost::lexical_cast<std::string>(file));
+            std::vector<std::vector<double> > vm = reader.GetVariableOverTimeOverMultipleNodes("V_m", 0, number_nodes);
+            std::vector<std::vector<double> > phi_e = reader.GetVariableOverTimeOverMultipleNodes("Phi_e", 0, number_nodes);
+            for (int node=0; node<number_nodes; node++)
+            {
+                for (unsigned time_step=0; time_step<number_time_steps; time_step++)
+                {
+                    double expected_vm = -85.0 + sin(0.1*node + time_step);
+                    double expected_phi_e = cos(0.1*node - time_step)/3.0;
+                    TS_ASSERT_DELTA(vm[node][time_step], expected_vm, fabs(expected_vm)*pow(2.0, -(double)vm_precisions[file]));
+                    TS_ASSERT_DELTA(phi_e[node][time_step], expected_phi_e, fabs(expected_phi_e)*pow(2.0, -(double)phi_e_precisions[file]));
+                }
+            }
+            if (file == 3u)
+            {
+                // V_m was stored exactly, Phi_e was not
+                TS_ASSERT_EQUALS(vm[7][2], -85.0 + sin(0.1*7 + 2));
+                TS_ASSERT_DIFFERS(phi_e[7][2], cos(0.1*7 - 2)/3.0);
+            }
+        }
+    }
+
     void TestHdf5DataWriterStripedNoTimeCachedFails() throw(Exception)
     {
         int number_nodes = 100;
@@ -36,9 +36,23 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SimpleImpedanceProblem.hpp"
 #include "TrianglesMeshReader.hpp"
 #include "ReplicatableVector.hpp"
+#include "PetscTools.hpp"
+#include "ThreadTools.hpp"
 
+#include <algorithm>
 #include <cmath>
 
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * The number of frequencies whose impedances are calculated together in each pass over the tree.
+ * Large enough for the arithmetic on each airway to vectorise, and small enough for the stack of
+ * subtree impedances to stay in cache.
+ */
+static const unsigned FREQUENCY_BLOCK_SIZE = 16u;
+
 SimpleImpedanceProblem::SimpleImpedanceProblem(TetrahedralMesh<1,3>& rAirwaysMesh, unsigned rootIndex)
     : mrMesh(rAirwaysMesh),
       mOutletNodeIndex(rootIndex),
@@ -46,10 +60,14 @@ SimpleImpedanceProblem::SimpleImpedanceProblem(TetrahedralMesh<1,3>& rAirwaysMes
       mRho(1.1500),                   //air density in Kg/m^3
       mMu(1.9e-5),                    //air viscosity in Pa s
       mH(5.8*98.0665*1e3),            //Tissue elastance in Pa/m^3 (5.8 cmH2O/L)
-      mLengthScaling(1.0)
+      mLengthScaling(1.0),
+      mNumThreads(1u),
+      mMaxNumPendingImpedances(0u)
 {
     mAcinarH = mH*(mrMesh.GetNumBoundaryNodes() - 1);
 
+    CalculatePostOrder();
+
     mFrequencies.push_back(1.0);
     mFrequencies.push_back(2.0);
     mFrequencies.push_back(3.0);
@@ -87,15 +105,219 @@ void SimpleImpedanceProblem::SetElastance(double elastance)
 }
 
 void SimpleImpedanceProblem::Solve()
+{
+    // The resistance and inertance of each airway do not depend on the frequency, so are calculated once here
+    const unsigned num_elements = mPostOrderElementIndices.size();
+    mElementResistances.resize(num_elements);
+    mElementInertances.resize(num_elements);
+    for (unsigned position = 0; position < num_elements; ++position)
+    {
+        Element<1,3>* p_element = mrMesh.GetElement(mPostOrderElementIndices[position]);
+
+        double radius = (p_element->GetNode(0)->rGetNodeAttributes()[0] + p_element->GetNode(1)->rGetNodeAttributes()[0])/2.0; //Use average radius
+        radius *= mLengthScaling;
+
+        //For a 1D in 3D mesh, the element determinant == the element length
+        c_matrix<double, 3, 1> jacobian; //not used
+        double length;
+        p_element->CalculateJacobian(jacobian, length);
+        length *= mLengthScaling;
+
+        mElementResistances[position] = CalculateElementResistance(radius, length);
+        mElementInertances[position] = CalculateElementInertance(radius, length);
+    }
+
+    const unsigned num_frequencies = mFrequencies.size();
+    mImpedances.assign(num_frequencies, std::complex<double>(0, 0));
+
+    // In parallel, each process calculates the impedances for a contiguous range of the frequencies
+    unsigned lo_frequency_index = 0;
+    unsigned hi_frequency_index = num_frequencies;
+    if (!PetscTools::IsSequential())
+    {
+        lo_frequency_index = (num_frequencies*PetscTools::GetMyRank())/PetscTools::GetNumProcs();
+        hi_frequency_index = (num_frequencies*(PetscTools::GetMyRank() + 1))/PetscTools::GetNumProcs();
+    }
+
+    const int num_blocks = (hi_frequency_index - lo_frequency_index + FREQUENCY_BLOCK_SIZE - 1)/FREQUENCY_BLOCK_SIZE;
+
+    // Each block of frequencies writes only to its own entries of mImpedances
+#ifdef CHASTE_OPENMP
+#pragma omp parallel num_threads(mNumThreads)
+#endif // CHASTE_OPENMP
+    {
+        std::vector<double> stack_real(mMaxNumPendingImpedances*FREQUENCY_BLOCK_SIZE);
+        std::vector<double> stack_imag(mMaxNumPendingImpedances*FREQUENCY_BLOCK_SIZE);
+
+#ifdef CHASTE_OPENMP
+#pragma omp for schedule(static)
+#endif // CHASTE_OPENMP
+        for (int block_index = 0; block_index < num_blocks; ++block_index)
+        {
+            unsigned first_frequency_index = lo_frequency_index + block_index*FREQUENCY_BLOCK_SIZE;
+            unsigned num_block_frequencies = std::min(FREQUENCY_BLOCK_SIZE, hi_frequency_index - first_frequency_index);
+            CalculateFrequencyBlockImpedances(first_frequency_index, num_block_frequencies, stack_real, stack_imag);
+        }
+    }
+
+    // Share the impedances between processes; each entry is zero on all but one process
+    if (!PetscTools::IsSequential() && num_frequencies > 0)
+    {
+        std::vector<double> local_impedances(2*num_frequencies, 0.0);
+        for (unsigned frequency_index = lo_frequency_index; frequency_index < hi_frequency_index; ++frequency_index)
+        {
+            local_impedances[2*frequency_index] = real(mImpedances[frequency_index]);
+            local_impedances[2*frequency_index + 1] = imag(mImpedances[frequency_index]);
+        }
+
+        std::vector<double> global_impedances(2*num_frequencies);
+        MPI_Allreduce(&local_impedances[0], &global_impedances[0], 2*num_frequencies, MPI_DOUBLE, MPI_SUM, PetscTools::GetWorld());
+
+        for (unsigned frequency_index = 0; frequency_index < num_frequencies; ++frequency_index)
+        {
+            mImpedances[frequency_index] = std::complex<double>(global_impedances[2*frequency_index], global_impedances[2*frequency_index + 1]);
+        }
+    }
+}
+
+void SimpleImpedanceProblem::SetNumberOfThreads(unsigned numThreads)
+{
+    ThreadTools::CheckNumberOfThreads(numThreads, "impedances cannot be calculated");
+    mNumThreads = numThreads;
+}
+
+unsigned SimpleImpedanceProblem::GetNumberOfThreads() const
+{
+    return mNumThreads;
+}
+
+void SimpleImpedanceProblem::CalculatePostOrder()
 {
     Node<3>* p_node = mrMesh.GetNode(mOutletNodeIndex);
     Element<1,3>* p_element = mrMesh.GetElement(*(p_node->ContainingElementsBegin()));
 
-    mImpedances.resize(mFrequencies.size());
+    // A pre-order traversal that visits the children of each element in reverse order is the
+    // reverse of the required post-order traversal
+    mPostOrderElementIndices.clear();
+    mPostOrderNumChildren.clear();
+
+    std::vector<Element<1,3>* > elements_to_visit(1, p_element);
+    while (!elements_to_visit.empty())
+    {
+        Element<1,3>* p_current_element = elements_to_visit.back();
+        elements_to_visit.pop_back();
+
+        std::vector<Element<1,3>* > child_eles = mWalker.GetChildElements(p_current_element);
+        assert(child_eles.size() <= 2u);
+
+        mPostOrderElementIndices.push_back(p_current_element->GetIndex());
+        mPostOrderNumChildren.push_back(child_eles.size());
+
+        for (unsigned i = 0; i < child_eles.size(); ++i)
+        {
+            assert(child_eles[i] != p_current_element);
+            elements_to_visit.push_back(child_eles[i]);
+        }
+    }
+
+    std::reverse(mPostOrderElementIndices.begin(), mPostOrderElementIndices.end());
+    std::reverse(mPostOrderNumChildren.begin(), mPostOrderNumChildren.end());
+
+    // Each element replaces the impedances of its children with its own
+    unsigned num_pending = 0;
+    mMaxNumPendingImpedances = 0;
+    for (unsigned position = 0; position < mPostOrderNumChildren.size(); ++position)
+    {
+        num_pending = num_pending + 1 - mPostOrderNumChildren[position];
+        mMaxNumPendingImpedances = std::max(mMaxNumPendingImpedances, num_pending);
+    }
+}
+
+void SimpleImpedanceProblem::CalculateFrequencyBlockImpedances(unsigned firstFrequencyIndex,
+                                                               unsigned numFrequencies,
+                                                               std::vector<double>& rStackReal,
+                                                               std::vector<double>& rStackImag)
+{
+    assert(numFrequencies <= FREQUENCY_BLOCK_SIZE);
+    assert(rStackReal.size() >= mMaxNumPendingImpedances*FREQUENCY_BLOCK_SIZE);
+    assert(rStackImag.size() >= mMaxNumPendingImpedances*FREQUENCY_BLOCK_SIZE);
+
+    double omega[FREQUENCY_BLOCK_SIZE];
+    double acinus_imag[FREQUENCY_BLOCK_SIZE];
+    for (unsigned f = 0; f < numFrequencies; ++f)
+    {
+        omega[f] = 2*M_PI*mFrequencies[firstFrequencyIndex + f];
+
+        // As in CalculateAcinusImpedance(), whose real part is zero
+        acinus_imag[f] = (omega[f] == 0.0) ? 0.0 : -mAcinarH/omega[f];
+    }
+
+    double sum_real[FREQUENCY_BLOCK_SIZE];
+    double sum_imag[FREQUENCY_BLOCK_SIZE];
+
+    unsigned num_pending = 0;
+    for (unsigned position = 0; position < mPostOrderElementIndices.size(); ++position)
+    {
+        // The impedances of the children of this element are the top entries of the stack, and are
+        // replaced by the impedance of this element
+        const unsigned num_children = mPostOrderNumChildren[position];
+        num_pending -= num_children;
+        double* p_z_real = &rStackReal[num_pending*FREQUENCY_BLOCK_SIZE];
+        double* p_z_imag = &rStackImag[num_pending*FREQUENCY_BLOCK_SIZE];
+
+        if (num_children == 0u) //Branch is terminal, hence consider to be an acinus
+        {
+            for (unsigned f = 0; f < numFrequencies; ++f)
+            {
+                p_z_real[f] = 0.0;
+                p_z_imag[f] = acinus_imag[f];
+            }
+        }
+        else
+        {
+            //Add up admittances of child elements, ignoring any with zero impedance
+            for (unsigned f = 0; f < numFrequencies; ++f)
+            {
+                sum_real[f] = 0.0;
+                sum_imag[f] = 0.0;
+            }
+            for (unsigned i = 0; i < num_children; ++i)
+            {
+                const double* p_child_real = p_z_real + i*FREQUENCY_BLOCK_SIZE;
+                const double* p_child_imag = p_z_imag + i*FREQUENCY_BLOCK_SIZE;
+                for (unsigned f = 0; f < numFrequencies; ++f)
+                {
+                    double modulus_squared = p_child_real[f]*p_child_real[f] + p_child_imag[f]*p_child_imag[f];
+                    double scale = (modulus_squared != 0.0) ? 1.0/modulus_squared : 0.0;
+                    sum_real[f] += p_child_real[f]*scale;
+                    sum_imag[f] -= p_child_imag[f]*scale;
+                }
+            }
+
+            for (unsigned f = 0; f < numFrequencies; ++f)
+            {
+                double modulus_squared = sum_real[f]*sum_real[f] + sum_imag[f]*sum_imag[f];
+                double scale = (modulus_squared != 0.0) ? 1.0/modulus_squared : 0.0;
+                p_z_real[f] = sum_real[f]*scale;
+                p_z_imag[f] = -sum_imag[f]*scale;
+            }
+        }
+
+        const double resistance = mElementResistances[position];
+        const double inertance = mElementInertances[position];
+        for (unsigned f = 0; f < numFrequencies; ++f)
+        {
+            p_z_real[f] += resistance;
+            p_z_imag[f] += omega[f]*inertance;
+        }
+        num_pending++;
+    }
 
-    for (unsigned frequency_index = 0; frequency_index < mFrequencies.size(); ++frequency_index)
+    // The only remaining entry is the impedance of the whole tree
+    assert(num_pending == 1u);
+    for (unsigned f = 0; f < numFrequencies; ++f)
     {
-        mImpedances[frequency_index] = CalculateElementImpedance(p_element, mFrequencies[frequency_index]);
+        mImpedances[firstFrequencyIndex + f] = std::complex<double>(rStackReal[f], rStackImag[f]);
     }
 }
 
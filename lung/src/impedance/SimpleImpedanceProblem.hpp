@@ -60,6 +60,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Z = -i*E/omega
  *
  * where E is the elastance of the acinus.
+ *
+ * Solve() evaluates the impedance at every frequency in a single pass over the tree. The order
+ * in which the airways are visited (each airway after its children) is found once on construction,
+ * and the resistance and inertance of each airway are calculated once per solve rather than once
+ * per frequency. The frequencies are then processed in blocks, so that the complex arithmetic for
+ * each airway is done over a contiguous array of frequencies. In parallel, each process evaluates
+ * a contiguous range of the frequencies, and the blocks on each process may be shared between
+ * several threads (see SetNumberOfThreads()).
  */
 class SimpleImpedanceProblem
 {
@@ -121,10 +129,23 @@ public:
 
     /**
      *  Performs a depth first iteration over the tree to
-     *  calculate total impedance
+     *  calculate total impedance at each frequency
      */
     void Solve();
 
+    /**
+     * Set the number of threads used to evaluate blocks of frequencies in Solve(). Requires
+     * Chaste to be built with OpenMP support (Chaste_USE_OPENMP) for values greater than 1.
+     *
+     * @param numThreads the number of threads
+     */
+    void SetNumberOfThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used to evaluate blocks of frequencies in Solve()
+     */
+    unsigned GetNumberOfThreads() const;
+
     /**
      * Used to set mRadiusOnEdge flag.
      * This is false by default in the constructor (conic pipes with radius defined at nodes).  When true pipes are cylindrical.
@@ -140,6 +161,8 @@ public:
 
     /**
      * Recursively calculates the impedance of an element (and all its children)
+     * at a single frequency. Solve() does not use this method, but gives the same
+     * result for the outlet element.
      *
      * @param pElement The root element to calculate impedance for
      * @param frequency The input frequency in Hz
@@ -213,6 +236,49 @@ private:
      std::vector<double> mFrequencies; /**<The applied frequency in Hz */
      std::vector<std::complex<double> > mImpedances; /**< The calculated impedance for the network */
 
+     /** The number of OpenMP threads used to evaluate blocks of frequencies. Defaults to 1. */
+     unsigned mNumThreads;
+
+     /** The indices of the elements of the tree, ordered so that each element comes after its children. */
+     std::vector<unsigned> mPostOrderElementIndices;
+
+     /** The number of child elements of each element, in the order of mPostOrderElementIndices. */
+     std::vector<unsigned> mPostOrderNumChildren;
+
+     /**
+      * The largest number of subtree impedances that are pending (that is, calculated but
+      * not yet combined into their parent's impedance) at any point of the post-order traversal.
+      */
+     unsigned mMaxNumPendingImpedances;
+
+     /** The resistance of each element, in the order of mPostOrderElementIndices. Updated by Solve(). */
+     std::vector<double> mElementResistances;
+
+     /** The inertance of each element, in the order of mPostOrderElementIndices. Updated by Solve(). */
+     std::vector<double> mElementInertances;
+
+    /**
+     * Find the order in which the elements of the tree are visited by Solve(), such that each
+     * element comes after its children, and the children of each element are in the order given
+     * by the tree walker. Called on construction.
+     */
+    void CalculatePostOrder();
+
+    /**
+     * Calculate the impedance of the tree for a contiguous block of frequencies, storing the
+     * result in mImpedances. The impedances of subtrees that have not yet been combined into
+     * their parent are kept on a stack, with the values for each subtree stored contiguously.
+     *
+     * @param firstFrequencyIndex the index of the first frequency in the block
+     * @param numFrequencies the number of frequencies in the block
+     * @param rStackReal storage for the real parts of the stack of subtree impedances
+     * @param rStackImag storage for the imaginary parts of the stack of subtree impedances
+     */
+    void CalculateFrequencyBlockImpedances(unsigned firstFrequencyIndex,
+                                           unsigned numFrequencies,
+                                           std::vector<double>& rStackReal,
+                                           std::vector<double>& rStackImag);
+
     /**
      * Calculate the Poiseille flow resistance of an element
      *
@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscSetupAndFinalize.hpp"
 #include "ReplicatableVector.hpp"
 #include "SimpleImpedanceProblem.hpp"
+#include "ThreadedTestHelpers.hpp"
 
 
 class TestSimpleImpedanceProblem : public CxxTest::TestSuite
@@ -201,6 +202,56 @@ public:
         TS_ASSERT_DELTA(real(impedances[6])*1e-3/98, 5.77, 1e-2);
         TS_ASSERT_DELTA(imag(impedances[6])*1e-3/98, 4.12, 1e-2);
     }
+
+    void TestFrequencySweep() throw(Exception)
+    {
+        TetrahedralMesh<1,3> mesh;
+        TrianglesMeshReader<1,3> mesh_reader("lung/test/data/TestSubtreeProperties");
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Enough frequencies to fill several blocks, including a partial one
+        std::vector<double> test_frequencies;
+        for (unsigned i = 0; i < 50; ++i)
+        {
+            test_frequencies.push_back(0.5*i);
+        }
+
+        SimpleImpedanceProblem problem(mesh, 0u);
+        problem.SetFrequencies(test_frequencies);
+
+        TS_ASSERT_EQUALS(problem.GetNumberOfThreads(), 1u);
+
+        problem.Solve();
+        std::vector<std::complex<double> > impedances = problem.rGetImpedances();
+        TS_ASSERT_EQUALS(impedances.size(), 50u);
+
+        // The sweep gives the same impedances as recursing through the tree once per frequency
+        Element<1,3>* p_outlet_element = mesh.GetElement(*(mesh.GetNode(0u)->ContainingElementsBegin()));
+        for (unsigned i = 0; i < test_frequencies.size(); ++i)
+        {
+            std::complex<double> recursive_impedance = problem.CalculateElementImpedance(p_outlet_element, test_frequencies[i]);
+            TS_ASSERT_DELTA(real(impedances[i]), real(recursive_impedance), 1e-12*std::abs(recursive_impedance));
+            TS_ASSERT_DELTA(imag(impedances[i]), imag(recursive_impedance), 1e-12*std::abs(recursive_impedance));
+        }
+
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest();
+        for (unsigned t = 0; t < numbers_of_threads.size(); ++t)
+        {
+            const unsigned num_threads = numbers_of_threads[t];
+            problem.SetNumberOfThreads(num_threads);
+            TS_ASSERT_EQUALS(problem.GetNumberOfThreads(), num_threads);
+
+            problem.Solve();
+
+            // Each block of frequencies is calculated in the same way on any thread
+            for (unsigned i = 0; i < test_frequencies.size(); ++i)
+            {
+                TS_ASSERT_EQUALS(real(problem.rGetImpedances()[i]), real(impedances[i]));
+                TS_ASSERT_EQUALS(imag(problem.rGetImpedances()[i]), imag(impedances[i]));
+            }
+        }
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(problem.SetNumberOfThreads(2u), "impedances cannot be calculated");
+    }
 };
 
 #endif /*_TESTIMPEDANCEPROBLEM_HPP_*/
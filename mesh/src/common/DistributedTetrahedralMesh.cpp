@@ -185,6 +185,25 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ComputeMeshPartitioning
                                 rNodesOwned.begin(), rNodesOwned.end(),
                                 std::inserter(rHaloNodesOwned, rHaloNodesOwned.begin()));
         }
+        else if (PetscTools::IsParallel())
+        {
+            /*
+             * Rather than every process scanning the whole element file, each process reads
+             * a contiguous slice of it and sends each element on to the processes owning its nodes.
+             */
+            unsigned first_local_element;
+            unsigned nodes_per_element;
+            std::vector<unsigned> local_element_nodes;
+            ReadElementSlice(rMeshReader, first_local_element, nodes_per_element, local_element_nodes);
+
+            std::vector<unsigned> element_node_owners;
+            ComputeNodeOwners(rNodesOwned, local_element_nodes, element_node_owners);
+
+            std::vector<unsigned> received_elements;
+            DistributeItemSlice(first_local_element, local_element_nodes, nodes_per_element, element_node_owners,
+                                std::vector<unsigned>(), received_elements);
+            AddReceivedElements(received_elements, nodes_per_element, rNodesOwned, rElementsOwned, rHaloNodesOwned);
+        }
         else
         {
             for (unsigned element_number = 0; element_number < mTotalNumElements; element_number++)
@@ -350,12 +369,72 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
         }
     }
 
+    /*
+     * Binary face files can be read at random, so rather than every process scanning the whole
+     * face file, each process reads a contiguous slice of it and passes each face on to the
+     * processes owning its nodes.  Only the faces found this way are then read in full.
+     * (In 2D the face file may contain internal edges which are skipped, so face records can't
+     * be located by index.)
+     */
+    const bool read_faces_by_index = (ELEMENT_DIM == 3 && rMeshReader.IsFileFormatBinary() && PetscTools::IsParallel());
+    std::vector<unsigned> faces_to_read;
+    if (read_faces_by_index)
+    {
+        unsigned num_local_faces = mTotalNumBoundaryElements / PetscTools::GetNumProcs();
+        unsigned first_local_face = num_local_faces * PetscTools::GetMyRank();
+        if (PetscTools::AmTopMost())
+        {
+            // Take the excess faces
+            num_local_faces += mTotalNumBoundaryElements - (num_local_faces * PetscTools::GetNumProcs());
+        }
+
+        std::vector<unsigned> local_face_nodes;
+        unsigned local_nodes_per_face = 0;
+        try
+        {
+            for (unsigned face_index=0; face_index<num_local_faces; face_index++)
+            {
+                ElementData face_data = (face_index == 0) ? rMeshReader.GetFaceData(first_local_face) : rMeshReader.GetNextFaceData();
+                if (face_index == 0)
+                {
+                    local_nodes_per_face = face_data.NodeIndices.size();
+                    local_face_nodes.reserve(num_local_faces*local_nodes_per_face);
+                }
+                assert(face_data.NodeIndices.size() == local_nodes_per_face);
+                local_face_nodes.insert(local_face_nodes.end(), face_data.NodeIndices.begin(), face_data.NodeIndices.end());
+            }
+        }
+        catch (Exception &e)
+        {
+            PetscTools::ReplicateException(true);
+            throw e;
+        }
+        PetscTools::ReplicateException(false);
+
+        // Faces may be quadratic, so agree on their size (a process may have an empty slice)
+        unsigned nodes_per_face;
+        MPI_Allreduce(&local_nodes_per_face, &nodes_per_face, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+
+        std::vector<unsigned> face_node_owners;
+        ComputeNodeOwners(nodes_owned, local_face_nodes, face_node_owners);
+
+        std::vector<unsigned> received_faces;
+        DistributeItemSlice(first_local_face, local_face_nodes, nodes_per_face, face_node_owners,
+                            std::vector<unsigned>(), received_faces);
+        for (unsigned offset=0; offset<received_faces.size(); offset += nodes_per_face+1)
+        {
+            faces_to_read.push_back(received_faces[offset]);
+        }
+    }
+    const unsigned num_faces_to_read = read_faces_by_index ? faces_to_read.size() : mTotalNumBoundaryElements;
+
     // Boundary nodes and elements
     try
     {
-        for (unsigned face_index=0; face_index<mTotalNumBoundaryElements; face_index++)
+        for (unsigned face_number=0; face_number<num_faces_to_read; face_number++)
         {
-            ElementData face_data = rMeshReader.GetNextFaceData();
+            const unsigned face_index = read_faces_by_index ? faces_to_read[face_number] : face_number;
+            ElementData face_data = read_faces_by_index ? rMeshReader.GetFaceData(face_index) : rMeshReader.GetNextFaceData();
             std::vector<unsigned> node_indices = face_data.NodeIndices;
 
             bool own = false;
@@ -1346,31 +1425,22 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ParMetisLibraryNodeAndE
     boost::scoped_array<idxtype> eind(new idxtype[num_local_elements*(ELEMENT_DIM+1)]);
     boost::scoped_array<idxtype> eptr(new idxtype[num_local_elements+1]);
 
-    if (rMeshReader.IsFileFormatBinary() && first_local_element > 0)
-    {
-        // Advance the file pointer to the first element before the ones I own.
-        rMeshReader.GetElementData(first_local_element - 1);
-    }
-    else
-    {
-        // Advance the file pointer to the first element before the ones I own.
-        for (idxtype element_index = 0; element_index < first_local_element; element_index++)
-        {
-            rMeshReader.GetNextElementData();
-        }
-    }
+    // The slice is kept to work out node ownership and halos without re-reading the element file
+    unsigned first_slice_element;
+    unsigned nodes_per_element;
+    std::vector<unsigned> local_element_nodes;
+    ReadElementSlice(rMeshReader, first_slice_element, nodes_per_element, local_element_nodes);
+    assert(first_slice_element == (unsigned)first_local_element);
+    assert(local_element_nodes.size() == (unsigned)num_local_elements*nodes_per_element);
 
     unsigned counter = 0;
     for (idxtype element_index = 0; element_index < num_local_elements; element_index++)
     {
-        ElementData element_data;
-
-        element_data = rMeshReader.GetNextElementData();
-
+        // Only the vertices are used to build the dual graph
         eptr[element_index] = counter;
         for (unsigned i=0; i<ELEMENT_DIM+1; i++)
         {
-            eind[counter++] = element_data.NodeIndices[i];
+            eind[counter++] = local_element_nodes[element_index*nodes_per_element + i];
         }
     }
     eptr[num_local_elements] = counter;
@@ -1455,159 +1525,375 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ParMetisLibraryNodeAndE
     MPI_Allgatherv(local_partition.get(), num_local_elements, mpi_idxtype,
                    global_element_partition.get(), element_counts.get(), int_element_distribution.get(), mpi_idxtype, PETSC_COMM_WORLD);
 
+    // Keep the k-way partition of the local slice, so its elements can be sent to their new owners
+    std::vector<unsigned> local_element_owners(local_partition.get(), local_partition.get() + num_local_elements);
     local_partition.reset();
 
-    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
-    {
-        if ((unsigned) global_element_partition[elem_index] == local_proc_index)
-        {
-            rElementsOwned.insert(elem_index);
-        }
-    }
-
     rMeshReader.Reset();
     free(xadj);
     free(adjncy);
 
     unsigned num_nodes = rMeshReader.GetNumNodes();
 
-    // Initialise with no nodes known
-    std::vector<unsigned> global_node_partition(num_nodes, UNASSIGNED_NODE);
-
     assert(rProcessorsOffset.size() == 0); // Making sure the vector is empty. After calling resize() only newly created memory will be initialised to 0.
     rProcessorsOffset.resize(PetscTools::GetNumProcs(), 0);
 
     /*
      *  Work out node distribution based on initial element distribution returned by ParMETIS
      *
-     *  In this loop we handle 4 different data structures:
-     *      global_node_partition and rProcessorsOffset are global,
-     *      rNodesOwned and rHaloNodesOwned are local.
+     *  Each node is assigned to the owner of the first element (in file order) which contains it.
+     *  Rather than every process reading the entire element file to find these, each process finds
+     *  the first containing element of each node within its own slice and we take the minimum over
+     *  all processes.
+     *
+     *  Unlike ComputeNodeOwners(), this reduces over arrays the size of the whole mesh.  That is
+     *  deliberate: the element partition gathered above and the node permutation computed below are
+     *  already needed in full on every process, so a directory exchange would not reduce the memory
+     *  used here below O(num_nodes + num_elements) per process.
      */
+    std::vector<unsigned> local_first_element(num_nodes, UINT_MAX);
+    for (unsigned element_index = 0; element_index < (unsigned)num_local_elements; element_index++)
+    {
+        for (unsigned i=0; i<nodes_per_element; i++)
+        {
+            unsigned node_index = local_element_nodes[element_index*nodes_per_element + i];
+            local_first_element[node_index] = std::min(local_first_element[node_index], first_slice_element + element_index);
+        }
+    }
+    std::vector<unsigned> global_first_element(num_nodes);
+    MPI_Allreduce(&local_first_element[0], &global_first_element[0], num_nodes, MPI_UNSIGNED, MPI_MIN, PETSC_COMM_WORLD);
+    local_first_element.clear();
+
+    // Initialise with no nodes known
+    std::vector<unsigned> global_node_partition(num_nodes, UNASSIGNED_NODE);
+
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        if (global_first_element[node_index] != UINT_MAX)
+        {
+            unsigned node_owner = global_element_partition[global_first_element[node_index]];
+            global_node_partition[node_index] = node_owner;
+            if (node_owner == local_proc_index)
+            {
+                rNodesOwned.insert(node_index);
+            }
+
+            // Offset is defined as the first node owned by a processor. We compute it incrementally.
+            // i.e. if node_index belongs to proc 3 (of 6) we have to shift the processors 4, 5, and 6
+            // offset a position.
+            for (unsigned proc=node_owner+1; proc<PetscTools::GetNumProcs(); proc++)
+            {
+                rProcessorsOffset[proc]++;
+            }
+        }
+    }
+    global_first_element.clear();
 
     /*
-     * Note that at this point each process has to read the entire element file in order to compute
-     * the node partition form the initial element distribution.
-     *  * Previously we randomly permuted the BIN file element access order on each process so that the processes
-     *    weren't reading the same file sectors at the same time
-     *  * We noted that with large files (above about 0.5 GigaByte) on HECToR the random access file reader
-     *    was spending all its time in fseekg.  This is presumably because each fseekg from the start of the file
-     *    involves multiple levels of indirect file block pointers.
-     *  * Hence the use of random element reading is only useful for the niche of moderately large meshes with
-     *    process counts in the thousands.
-     *  Hence BIN file element permuting is deprecated - we just read the file in order.
-     *  See
-     *  https://chaste.cs.ox.ac.uk/trac/browser/trunk/mesh/src/common/DistributedTetrahedralMesh.cpp?rev=19291#L1459
+     * Work out the element distribution and halo nodes. Each element in the slice is sent to the
+     * processes owning its nodes, so that all the system matrix rows are assembled locally, and to
+     * its owner in the k-way partition, whose halo also includes the element's nodes.
+     * It may be that an element in the original k-way partition is no longer needed by the new
+     * node partition, so it is only owned if it contains an owned node.
      */
+    std::vector<unsigned> element_node_owners(local_element_nodes.size());
+    for (unsigned i=0; i<local_element_nodes.size(); i++)
+    {
+        element_node_owners[i] = global_node_partition[local_element_nodes[i]];
+    }
+    std::vector<unsigned> received_elements;
+    DistributeItemSlice(first_slice_element, local_element_nodes, nodes_per_element, element_node_owners,
+                        local_element_owners, received_elements);
+    AddReceivedElements(received_elements, nodes_per_element, rNodesOwned, rElementsOwned, rHaloNodesOwned);
+
+    rMeshReader.Reset();
 
-    for (unsigned element_number = 0; element_number < mTotalNumElements; element_number++)
+    /*
+     *  Once we know the offsets we can compute the permutation vector
+     */
+    std::vector<unsigned> local_index(PetscTools::GetNumProcs(), 0);
+
+    this->mNodePermutation.resize(this->GetNumNodes());
+
+    for (unsigned node_index=0; node_index<this->GetNumNodes(); node_index++)
     {
-        unsigned element_owner = global_element_partition[element_number];
+        unsigned partition = global_node_partition[node_index];
+        assert(partition != UNASSIGNED_NODE);
+
+        this->mNodePermutation[node_index] = rProcessorsOffset[partition] + local_index[partition];
 
-        ElementData element_data;
+        local_index[partition]++;
+    }
+}
 
-        element_data = rMeshReader.GetNextElementData();
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ComputeNodeOwners(
+        const std::set<unsigned>& rNodesOwned,
+        const std::vector<unsigned>& rQueryNodes,
+        std::vector<unsigned>& rQueryOwners)
+{
+    const unsigned num_procs = PetscTools::GetNumProcs();
 
-        for (std::vector<unsigned>::const_iterator node_it = element_data.NodeIndices.begin();
-             node_it != element_data.NodeIndices.end();
-             ++node_it)
+    /*
+     * The node indices are split into contiguous blocks, in the same way as the element slices,
+     * and each process acts as the directory for one block: it is told the owner of each node in
+     * its block, and then answers queries about them.
+     */
+    const unsigned block_size = mTotalNumNodes / num_procs;
+    const unsigned first_block_node = block_size * PetscTools::GetMyRank();
+    unsigned num_block_nodes = block_size;
+    if (PetscTools::AmTopMost())
+    {
+        // Take the excess nodes
+        num_block_nodes += mTotalNumNodes - (block_size * num_procs);
+    }
+
+    // Tell each directory about the nodes this process owns in its block
+    std::vector<std::vector<unsigned> > send_buffers(num_procs);
+    for (std::set<unsigned>::const_iterator it = rNodesOwned.begin(); it != rNodesOwned.end(); ++it)
+    {
+        send_buffers[GetDirectoryProcess(*it, block_size)].push_back(*it);
+    }
+    std::vector<unsigned> received;
+    std::vector<int> receive_counts;
+    ExchangeUnsignedBuffers(send_buffers, received, receive_counts);
+
+    std::vector<unsigned> block_owners(num_block_nodes, UNASSIGNED_NODE);
+    unsigned offset = 0;
+    for (unsigned proc=0; proc<num_procs; proc++)
+    {
+        for (int i=0; i<receive_counts[proc]; i++, offset++)
         {
-            /*
-             * For each node in this element, check whether it hasn't been assigned to another processor yet.
-             * If so, assign it to the owner of the element. Otherwise, consider it halo.
-             */
-            if (global_node_partition[*node_it] == UNASSIGNED_NODE)
-            {
-                if (element_owner == local_proc_index)
-                {
-                    rNodesOwned.insert(*node_it);
-                }
+            assert(received[offset] - first_block_node < num_block_nodes);
+            block_owners[received[offset] - first_block_node] = proc;
+        }
+    }
 
-                global_node_partition[*node_it] = element_owner;
+    // Ask the directories about each distinct node queried
+    std::vector<unsigned> distinct_nodes(rQueryNodes);
+    std::sort(distinct_nodes.begin(), distinct_nodes.end());
+    distinct_nodes.erase(std::unique(distinct_nodes.begin(), distinct_nodes.end()), distinct_nodes.end());
 
-                // Offset is defined as the first node owned by a processor. We compute it incrementally.
-                // i.e. if node_index belongs to proc 3 (of 6) we have to shift the processors 4, 5, and 6
-                // offset a position.
-                for (unsigned proc=element_owner+1; proc<PetscTools::GetNumProcs(); proc++)
-                {
-                    rProcessorsOffset[proc]++;
-                }
+    for (unsigned proc=0; proc<num_procs; proc++)
+    {
+        send_buffers[proc].clear();
+    }
+    for (unsigned i=0; i<distinct_nodes.size(); i++)
+    {
+        assert(distinct_nodes[i] < mTotalNumNodes);
+        send_buffers[GetDirectoryProcess(distinct_nodes[i], block_size)].push_back(distinct_nodes[i]);
+    }
+    std::vector<unsigned> queries;
+    ExchangeUnsignedBuffers(send_buffers, queries, receive_counts);
+
+    // Answer the queries in the order they were asked
+    offset = 0;
+    for (unsigned proc=0; proc<num_procs; proc++)
+    {
+        send_buffers[proc].resize(receive_counts[proc]);
+        for (int i=0; i<receive_counts[proc]; i++, offset++)
+        {
+            send_buffers[proc][i] = block_owners[queries[offset] - first_block_node];
+        }
+    }
+    std::vector<unsigned> answers;
+    ExchangeUnsignedBuffers(send_buffers, answers, receive_counts);
+
+    // Directory processes are in increasing node order, so the answers line up with distinct_nodes
+    assert(answers.size() == distinct_nodes.size());
+    rQueryOwners.resize(rQueryNodes.size());
+    for (unsigned i=0; i<rQueryNodes.size(); i++)
+    {
+        unsigned position = std::lower_bound(distinct_nodes.begin(), distinct_nodes.end(), rQueryNodes[i]) - distinct_nodes.begin();
+        rQueryOwners[i] = answers[position];
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetDirectoryProcess(unsigned nodeIndex, unsigned blockSize)
+{
+    const unsigned top_most = PetscTools::GetNumProcs() - 1;
+    if (blockSize == 0)
+    {
+        return top_most;
+    }
+    return std::min(nodeIndex / blockSize, top_most);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ExchangeUnsignedBuffers(
+        const std::vector<std::vector<unsigned> >& rSendBuffers,
+        std::vector<unsigned>& rReceived,
+        std::vector<int>& rReceiveCounts)
+{
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    assert(rSendBuffers.size() == num_procs);
+
+    std::vector<int> send_counts(num_procs);
+    std::vector<int> send_displacements(num_procs, 0);
+    std::vector<unsigned> send_data;
+    for (unsigned proc=0; proc<num_procs; proc++)
+    {
+        send_counts[proc] = rSendBuffers[proc].size();
+        send_displacements[proc] = send_data.size();
+        send_data.insert(send_data.end(), rSendBuffers[proc].begin(), rSendBuffers[proc].end());
+    }
+
+    rReceiveCounts.resize(num_procs);
+    MPI_Alltoall(&send_counts[0], 1, MPI_INT, &rReceiveCounts[0], 1, MPI_INT, PETSC_COMM_WORLD);
+
+    std::vector<int> receive_displacements(num_procs, 0);
+    for (unsigned proc=1; proc<num_procs; proc++)
+    {
+        receive_displacements[proc] = receive_displacements[proc-1] + rReceiveCounts[proc-1];
+    }
+    rReceived.resize(receive_displacements[num_procs-1] + rReceiveCounts[num_procs-1]);
+
+    MPI_Alltoallv(send_data.empty() ? nullptr : &send_data[0], &send_counts[0], &send_displacements[0], MPI_UNSIGNED,
+                  rReceived.empty() ? nullptr : &rReceived[0], &rReceiveCounts[0], &receive_displacements[0], MPI_UNSIGNED,
+                  PETSC_COMM_WORLD);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ReadElementSlice(
+        AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>& rMeshReader,
+        unsigned& rFirstLocalElement,
+        unsigned& rNodesPerElement,
+        std::vector<unsigned>& rLocalElementNodes)
+{
+    const unsigned num_elements = rMeshReader.GetNumElements();
+    const unsigned num_procs = PetscTools::GetNumProcs();
+
+    unsigned num_local_elements = num_elements / num_procs;
+    rFirstLocalElement = num_local_elements * PetscTools::GetMyRank();
+    if (PetscTools::AmTopMost())
+    {
+        // Take the excess elements
+        num_local_elements += num_elements - (num_local_elements * num_procs);
+    }
+
+    rLocalElementNodes.clear();
+    unsigned local_nodes_per_element = 0;
+
+    // Processes read different parts of the file, so make sure they all fail together
+    try
+    {
+        for (unsigned element_index = 0; element_index < num_local_elements; element_index++)
+        {
+            ElementData element_data;
+            if (element_index == 0 && rMeshReader.IsFileFormatBinary())
+            {
+                // Seek straight to the first element in the slice
+                element_data = rMeshReader.GetElementData(rFirstLocalElement);
             }
             else
             {
-                if (element_owner == local_proc_index)
+                if (element_index == 0)
                 {
-                    //if (rNodesOwned.find(*node_it) == rNodesOwned.end())
-                    if (global_node_partition[*node_it] != local_proc_index)
+                    // Advance the file pointer to the first element in the slice
+                    for (unsigned skipped_index = 0; skipped_index < rFirstLocalElement; skipped_index++)
                     {
-                        rHaloNodesOwned.insert(*node_it);
+                        rMeshReader.GetNextElementData();
                     }
                 }
+                element_data = rMeshReader.GetNextElementData();
+            }
+            if (element_index == 0)
+            {
+                local_nodes_per_element = element_data.NodeIndices.size();
+                rLocalElementNodes.reserve(num_local_elements*local_nodes_per_element);
             }
+            assert(element_data.NodeIndices.size() == local_nodes_per_element);
+            rLocalElementNodes.insert(rLocalElementNodes.end(), element_data.NodeIndices.begin(), element_data.NodeIndices.end());
         }
     }
+    catch (Exception &e)
+    {
+        PetscTools::ReplicateException(true);
+        throw e;
+    }
+    PetscTools::ReplicateException(false);
 
+    // Elements may be quadratic, so agree on their size (a process may have an empty slice)
+    MPI_Allreduce(&local_nodes_per_element, &rNodesPerElement, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+}
 
-    /*
-     * Refine element distribution. Add extra elements that parMETIS didn't consider initially but
-     * include any node owned by the processor. This ensures that all the system matrix rows are
-     * assembled locally.
-     * It may be that some of these elements are in the set of owned nodes erroneously.
-     * The original set of owned elements (from the k-way partition) informed a
-     * node partition.  It may be that an element near the edge of this new node
-     * partition may no longer be needed.
-     *
-     * Note that rather than clearing the set we could remove elements to the original element partition set
-     * with erase(), if (!element_owned) below.
-     */
-    rElementsOwned.clear();
-    rMeshReader.Reset();
-    for (unsigned element_number = 0; element_number < mTotalNumElements; element_number++)
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::DistributeItemSlice(
+        unsigned firstLocalItem,
+        const std::vector<unsigned>& rLocalItemNodes,
+        unsigned nodesPerItem,
+        const std::vector<unsigned>& rItemNodeOwners,
+        const std::vector<unsigned>& rExtraItemOwners,
+        std::vector<unsigned>& rReceivedItems)
+{
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    const unsigned num_local_items = rLocalItemNodes.size()/nodesPerItem;
+    assert(rItemNodeOwners.size() == rLocalItemNodes.size());
+    assert(rExtraItemOwners.empty() || rExtraItemOwners.size() == num_local_items);
+
+    // Pack each item (its global index followed by its nodes) once for every process that needs it
+    std::vector<std::vector<unsigned> > send_buffers(num_procs);
+    std::vector<unsigned> destinations;
+    for (unsigned item_index = 0; item_index < num_local_items; item_index++)
     {
-        ElementData element_data = rMeshReader.GetNextElementData();
+        const unsigned* p_item_nodes = &rLocalItemNodes[item_index*nodesPerItem];
 
-        bool element_owned = false;
-        std::set<unsigned> temp_halo_nodes;
+        destinations.clear();
+        for (unsigned i=0; i<nodesPerItem; i++)
+        {
+            destinations.push_back(rItemNodeOwners[item_index*nodesPerItem + i]);
+        }
+        if (!rExtraItemOwners.empty())
+        {
+            destinations.push_back(rExtraItemOwners[item_index]);
+        }
+        std::sort(destinations.begin(), destinations.end());
+        destinations.erase(std::unique(destinations.begin(), destinations.end()), destinations.end());
 
-        for (std::vector<unsigned>::const_iterator node_it = element_data.NodeIndices.begin();
-             node_it != element_data.NodeIndices.end();
-             ++node_it)
+        for (std::vector<unsigned>::const_iterator it = destinations.begin(); it != destinations.end(); ++it)
+        {
+            assert(*it < num_procs);
+            send_buffers[*it].push_back(firstLocalItem + item_index);
+            send_buffers[*it].insert(send_buffers[*it].end(), p_item_nodes, p_item_nodes + nodesPerItem);
+        }
+    }
+
+    std::vector<int> receive_counts;
+    ExchangeUnsignedBuffers(send_buffers, rReceivedItems, receive_counts);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::AddReceivedElements(
+        const std::vector<unsigned>& rReceivedElements,
+        unsigned nodesPerElement,
+        const std::set<unsigned>& rNodesOwned,
+        std::set<unsigned>& rElementsOwned,
+        std::set<unsigned>& rHaloNodesOwned)
+{
+    const unsigned record_size = nodesPerElement+1;
+    assert(rReceivedElements.size() % record_size == 0);
+
+    for (unsigned offset = 0; offset < rReceivedElements.size(); offset += record_size)
+    {
+        bool element_owned = false;
+        for (unsigned i=1; i<record_size; i++)
         {
-            if (rNodesOwned.find(*node_it) != rNodesOwned.end())
+            unsigned node_index = rReceivedElements[offset + i];
+            if (rNodesOwned.find(node_index) != rNodesOwned.end())
             {
                 element_owned = true;
-                rElementsOwned.insert(element_number);
             }
             else
             {
-                temp_halo_nodes.insert(*node_it);
+                rHaloNodesOwned.insert(node_index);
             }
         }
-
         if (element_owned)
         {
-            rHaloNodesOwned.insert(temp_halo_nodes.begin(), temp_halo_nodes.end());
+            rElementsOwned.insert(rReceivedElements[offset]);
         }
     }
-
-    rMeshReader.Reset();
-
-    /*
-     *  Once we know the offsets we can compute the permutation vector
-     */
-    std::vector<unsigned> local_index(PetscTools::GetNumProcs(), 0);
-
-    this->mNodePermutation.resize(this->GetNumNodes());
-
-    for (unsigned node_index=0; node_index<this->GetNumNodes(); node_index++)
-    {
-        unsigned partition = global_node_partition[node_index];
-        assert(partition != UNASSIGNED_NODE);
-
-        this->mNodePermutation[node_index] = rProcessorsOffset[partition] + local_index[partition];
-
-        local_index[partition]++;
-    }
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
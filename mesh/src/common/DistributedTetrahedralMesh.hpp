@@ -429,6 +429,96 @@ private:
                                           std::set<unsigned>& rHaloNodesOwned,
                                           std::vector<unsigned>& rProcessorsOffset);
 
+    /**
+     * Work out which process owns each of a list of nodes, given the set of nodes owned by
+     * this process.  This is a collective call.
+     *
+     * No process holds an array over the whole mesh: each process is the directory for one
+     * contiguous block of node indices, learns the owners of the nodes in its block, and then
+     * answers queries about them, so the memory and communication used are proportional to the
+     * number of nodes owned and queried.
+     *
+     * @param rNodesOwned the indices of nodes owned by this process
+     * @param rQueryNodes the indices of the nodes whose owners are wanted, possibly repeated
+     * @param rQueryOwners a vector to be filled with the owning process of each node in rQueryNodes
+     */
+    void ComputeNodeOwners(const std::set<unsigned>& rNodesOwned,
+                           const std::vector<unsigned>& rQueryNodes,
+                           std::vector<unsigned>& rQueryOwners);
+
+    /**
+     * Helper method for ComputeNodeOwners().
+     *
+     * @param nodeIndex the global index of a node
+     * @param blockSize the number of nodes in the directory block of each process but the top-most
+     * @return the process acting as the directory for the node
+     */
+    unsigned GetDirectoryProcess(unsigned nodeIndex, unsigned blockSize);
+
+    /**
+     * Send a buffer of unsigned integers to each process, and receive the buffers sent to this
+     * process.  This is a collective call.
+     *
+     * @param rSendBuffers the data to send to each process
+     * @param rReceived is filled with the data received, in process order
+     * @param rReceiveCounts is filled with the amount of data received from each process
+     */
+    void ExchangeUnsignedBuffers(const std::vector<std::vector<unsigned> >& rSendBuffers,
+                                 std::vector<unsigned>& rReceived,
+                                 std::vector<int>& rReceiveCounts);
+
+    /**
+     * Read a contiguous slice of the element file into memory.  The elements are split
+     * evenly between processes, with the top-most process taking any excess.  For binary
+     * files the reader seeks straight to the start of the slice.
+     *
+     * @param rMeshReader is the reader pointing to the mesh (which must be at the start of the element file)
+     * @param rFirstLocalElement is filled with the index of the first element in the slice
+     * @param rNodesPerElement is filled with the number of nodes in each element (agreed between processes)
+     * @param rLocalElementNodes is filled with the node indices of each element in the slice, rNodesPerElement per element
+     */
+    void ReadElementSlice(AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>& rMeshReader,
+                          unsigned& rFirstLocalElement,
+                          unsigned& rNodesPerElement,
+                          std::vector<unsigned>& rLocalElementNodes);
+
+    /**
+     * Send each item (element or face) in a contiguous slice to every process which owns one
+     * of its nodes, and optionally to one extra process per item.  This is a collective call.
+     *
+     * Slices are contiguous and in process order, so the items received are in increasing index order.
+     *
+     * @param firstLocalItem the global index of the first item in this process's slice
+     * @param rLocalItemNodes the node indices of each item in the slice, nodesPerItem per item
+     * @param nodesPerItem the number of nodes in each item
+     * @param rItemNodeOwners the owning process of each node in rLocalItemNodes, in the same layout
+     * @param rExtraItemOwners either empty or an extra destination process for each item in the slice
+     * @param rReceivedItems is filled with the items sent to this process, as the global index followed by the node indices
+     */
+    void DistributeItemSlice(unsigned firstLocalItem,
+                             const std::vector<unsigned>& rLocalItemNodes,
+                             unsigned nodesPerItem,
+                             const std::vector<unsigned>& rItemNodeOwners,
+                             const std::vector<unsigned>& rExtraItemOwners,
+                             std::vector<unsigned>& rReceivedItems);
+
+    /**
+     * Fill in the owned elements and halo nodes from the items received by DistributeItemSlice().
+     * An element is owned if one of its nodes is owned, and all nodes of a received element which
+     * are not owned are halo nodes.
+     *
+     * @param rReceivedElements the elements received, as the global index followed by the node indices
+     * @param nodesPerElement the number of nodes in each element
+     * @param rNodesOwned the indices of nodes owned by this process
+     * @param rElementsOwned is a set to be filled with the indices of elements owned by this process
+     * @param rHaloNodesOwned is a set to be filled with the indices of halo nodes owned by this process
+     */
+    void AddReceivedElements(const std::vector<unsigned>& rReceivedElements,
+                             unsigned nodesPerElement,
+                             const std::set<unsigned>& rNodesOwned,
+                             std::set<unsigned>& rElementsOwned,
+                             std::set<unsigned>& rHaloNodesOwned);
+
     /**
      * Reorder the node indices in this mesh by applying the permutation
      * give in mNodePermutation.
@@ -34,7 +34,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <map>
+#include <algorithm>
 #include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <climits>
 
 #include "MutableMesh.hpp"
 #include "OutputFileHandler.hpp"
@@ -50,13 +54,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableMesh<ELEMENT_DIM, SPACE_DIM>::MutableMesh()
-    : mAddedNodes(false)
+    : mAddedNodes(false),
+      mUseIncrementalReMesh(false)
 {
     this->mMeshChangesDuringSimulation = true;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableMesh<ELEMENT_DIM, SPACE_DIM>::MutableMesh(std::vector<Node<SPACE_DIM> *> nodes)
+    : mAddedNodes(false),
+      mUseIncrementalReMesh(false)
 {
     this->mMeshChangesDuringSimulation = true;
     Clear();
@@ -76,10 +83,30 @@ MutableMesh<ELEMENT_DIM, SPACE_DIM>::~MutableMesh()
     Clear();
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableMesh<ELEMENT_DIM, SPACE_DIM>::SetUseIncrementalReMesh(bool useIncrementalReMesh)
+{
+    if (useIncrementalReMesh && (ELEMENT_DIM != 2 || SPACE_DIM != 2))
+    {
+        EXCEPTION("Incremental remeshing is only implemented for 2D meshes.");
+    }
+    mUseIncrementalReMesh = useIncrementalReMesh;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::GetUseIncrementalReMesh() const
+{
+    return mUseIncrementalReMesh;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNewNode)
 {
-    if (mDeletedNodeIndices.empty())
+    /*
+     * When remeshing incrementally, deleted nodes are still referenced by
+     * elements until the next ReMesh(), so their indices must not be reused.
+     */
+    if (mDeletedNodeIndices.empty() || mUseIncrementalReMesh)
     {
         pNewNode->SetIndex(this->mNodes.size());
         this->mNodes.push_back(pNewNode);
@@ -662,8 +689,11 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReIndex(NodeMap& map)
 
     for (unsigned i=0; i<this->mElements.size(); i++)
     {
-
-        this->mElements[i]->ResetIndex(i);
+        // Only elements after a deleted one move, and re-registering them with their nodes is costly
+        if (this->mElements[i]->GetIndex() != i)
+        {
+            this->mElements[i]->ResetIndex(i);
+        }
     }
 
     for (unsigned i=0; i<this->mBoundaryElements.size(); i++)
@@ -776,6 +806,12 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
     }
     else if (SPACE_DIM==2)  // In 2D, remesh using triangle via library calls
     {
+        // If requested, first try to repair the existing triangulation
+        if (mUseIncrementalReMesh && ReMeshIncrementally(map))
+        {
+            return;
+        }
+
         struct triangulateio mesher_input, mesher_output;
         this->InitialiseTriangulateIo(mesher_input);
         this->InitialiseTriangulateIo(mesher_output);
@@ -805,6 +841,788 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
     }
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double MutableMesh<ELEMENT_DIM, SPACE_DIM>::WorkingTriangulation::CalculateOrientation(unsigned nodeA, unsigned nodeB, unsigned nodeC) const
+{
+    const c_vector<double, SPACE_DIM>& r_a = mLocations[nodeA];
+    const c_vector<double, SPACE_DIM>& r_b = mLocations[nodeB];
+    const c_vector<double, SPACE_DIM>& r_c = mLocations[nodeC];
+
+    return (r_b[0] - r_a[0])*(r_c[1] - r_a[1]) - (r_b[1] - r_a[1])*(r_c[0] - r_a[0]);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::WorkingTriangulation::IsInCircumcircle(unsigned nodeA, unsigned nodeB, unsigned nodeC, unsigned nodeD) const
+{
+    const c_vector<double, SPACE_DIM>& r_d = mLocations[nodeD];
+
+    double ad_x = mLocations[nodeA][0] - r_d[0];
+    double ad_y = mLocations[nodeA][1] - r_d[1];
+    double bd_x = mLocations[nodeB][0] - r_d[0];
+    double bd_y = mLocations[nodeB][1] - r_d[1];
+    double cd_x = mLocations[nodeC][0] - r_d[0];
+    double cd_y = mLocations[nodeC][1] - r_d[1];
+
+    double a_lift = ad_x*ad_x + ad_y*ad_y;
+    double b_lift = bd_x*bd_x + bd_y*bd_y;
+    double c_lift = cd_x*cd_x + cd_y*cd_y;
+
+    double term_a = a_lift*(bd_x*cd_y - cd_x*bd_y);
+    double term_b = b_lift*(cd_x*ad_y - ad_x*cd_y);
+    double term_c = c_lift*(ad_x*bd_y - bd_x*ad_y);
+
+    // Compare against the size of the terms so that (nearly) cocircular nodes are left alone
+    double tolerance = 1e-10*(fabs(term_a) + fabs(term_b) + fabs(term_c));
+
+    return (term_a + term_b + term_c > tolerance);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::FlipEdge(WorkingTriangulation& rTriangulation, unsigned triangle, unsigned localIndex)
+{
+    std::vector<c_vector<unsigned, 3> >& r_triangles = rTriangulation.mTriangles;
+    std::vector<c_vector<unsigned, 3> >& r_neighbours = rTriangulation.mNeighbours;
+
+    /*
+     * The triangle is (c, a, b) with the edge a-b opposite c, and its neighbour
+     * across this edge is (d, b, a). After the flip they become (c, a, d) and (d, b, c).
+     */
+    unsigned neighbour = r_neighbours[triangle][localIndex];
+    if (neighbour == UINT_MAX)
+    {
+        return false;
+    }
+
+    unsigned node_c = r_triangles[triangle][localIndex];
+    unsigned node_a = r_triangles[triangle][(localIndex+1)%3];
+    unsigned node_b = r_triangles[triangle][(localIndex+2)%3];
+
+    unsigned neighbour_local_index = 0;
+    while (r_neighbours[neighbour][neighbour_local_index] != triangle)
+    {
+        neighbour_local_index++;
+    }
+    assert(neighbour_local_index < 3);
+    unsigned node_d = r_triangles[neighbour][neighbour_local_index];
+
+    // The quadrilateral c-a-d-b must be strictly convex for the flip to be valid
+    if (rTriangulation.CalculateOrientation(node_c, node_a, node_d) <= 2.0*DBL_EPSILON
+        || rTriangulation.CalculateOrientation(node_d, node_b, node_c) <= 2.0*DBL_EPSILON)
+    {
+        return false;
+    }
+
+    unsigned outer_across_bc = r_neighbours[triangle][(localIndex+1)%3];
+    unsigned outer_across_ca = r_neighbours[triangle][(localIndex+2)%3];
+    unsigned outer_across_ad = r_neighbours[neighbour][(neighbour_local_index+1)%3];
+    unsigned outer_across_db = r_neighbours[neighbour][(neighbour_local_index+2)%3];
+
+    r_triangles[triangle][0] = node_c;
+    r_triangles[triangle][1] = node_a;
+    r_triangles[triangle][2] = node_d;
+    r_neighbours[triangle][0] = outer_across_ad;
+    r_neighbours[triangle][1] = neighbour;
+    r_neighbours[triangle][2] = outer_across_ca;
+
+    r_triangles[neighbour][0] = node_d;
+    r_triangles[neighbour][1] = node_b;
+    r_triangles[neighbour][2] = node_c;
+    r_neighbours[neighbour][0] = outer_across_bc;
+    r_neighbours[neighbour][1] = triangle;
+    r_neighbours[neighbour][2] = outer_across_db;
+
+    // Two of the outer triangles have swapped which of the pair they are adjacent to
+    if (outer_across_bc != UINT_MAX)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            if (r_neighbours[outer_across_bc][i] == triangle)
+            {
+                r_neighbours[outer_across_bc][i] = neighbour;
+            }
+        }
+    }
+    if (outer_across_ad != UINT_MAX)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            if (r_neighbours[outer_across_ad][i] == neighbour)
+            {
+                r_neighbours[outer_across_ad][i] = triangle;
+            }
+        }
+    }
+
+    rTriangulation.mNodeTriangles[node_a] = triangle;
+    rTriangulation.mNodeTriangles[node_c] = triangle;
+    rTriangulation.mNodeTriangles[node_d] = triangle;
+    rTriangulation.mNodeTriangles[node_b] = neighbour;
+
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::MakeLocallyDelaunay(WorkingTriangulation& rTriangulation)
+{
+    std::vector<c_vector<unsigned, 3> >& r_triangles = rTriangulation.mTriangles;
+    std::vector<c_vector<unsigned, 3> >& r_neighbours = rTriangulation.mNeighbours;
+    std::vector<std::pair<unsigned, unsigned> >& r_edges = rTriangulation.mEdgesToCheck;
+
+    // Lawson's algorithm terminates, but guard against slow progress on badly tangled meshes
+    unsigned max_num_flips = 10*r_triangles.size() + 100;
+    unsigned num_flips = 0;
+
+    while (!r_edges.empty())
+    {
+        unsigned triangle = r_edges.back().first;
+        unsigned node_index = r_edges.back().second;
+        r_edges.pop_back();
+
+        if (r_triangles[triangle][0] == UINT_MAX)
+        {
+            continue;
+        }
+
+        unsigned local_index = 0;
+        while (local_index < 3 && r_triangles[triangle][(local_index+1)%3] != node_index)
+        {
+            local_index++;
+        }
+        if (local_index == 3)
+        {
+            // The triangle has been altered since this edge was recorded
+            continue;
+        }
+
+        unsigned neighbour = r_neighbours[triangle][local_index];
+        if (neighbour == UINT_MAX)
+        {
+            continue;
+        }
+
+        unsigned opposite_local_index = 0;
+        while (r_neighbours[neighbour][opposite_local_index] != triangle)
+        {
+            opposite_local_index++;
+        }
+
+        if (rTriangulation.IsInCircumcircle(r_triangles[triangle][0], r_triangles[triangle][1], r_triangles[triangle][2],
+                             r_triangles[neighbour][opposite_local_index])
+            && FlipEdge(rTriangulation, triangle, local_index))
+        {
+            if (++num_flips > max_num_flips)
+            {
+                return false; // LCOV_EXCL_LINE
+            }
+
+            // The outer edges of the flipped pair may no longer be locally Delaunay
+            for (unsigned i=0; i<3; i++)
+            {
+                r_edges.push_back(std::make_pair(triangle, r_triangles[triangle][i]));
+                r_edges.push_back(std::make_pair(neighbour, r_triangles[neighbour][i]));
+            }
+        }
+    }
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::AreNodesConnected(const WorkingTriangulation& rTriangulation, unsigned nodeA, unsigned nodeB) const
+{
+    const std::vector<c_vector<unsigned, 3> >& r_triangles = rTriangulation.mTriangles;
+    const std::vector<c_vector<unsigned, 3> >& r_neighbours = rTriangulation.mNeighbours;
+
+    // Go round node A, first anticlockwise then, if we reach the boundary, clockwise
+    for (unsigned direction=1; direction<3; direction++)
+    {
+        unsigned triangle = rTriangulation.mNodeTriangles[nodeA];
+        do
+        {
+            unsigned local_index = 0;
+            while (r_triangles[triangle][local_index] != nodeA)
+            {
+                local_index++;
+            }
+            if (r_triangles[triangle][(local_index+1)%3] == nodeB || r_triangles[triangle][(local_index+2)%3] == nodeB)
+            {
+                return true;
+            }
+            triangle = r_neighbours[triangle][(local_index+direction)%3];
+        }
+        while (triangle != UINT_MAX && triangle != rTriangulation.mNodeTriangles[nodeA]);
+
+        if (triangle != UINT_MAX)
+        {
+            break;
+        }
+    }
+    return false;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::RemoveNodeFromTriangulation(WorkingTriangulation& rTriangulation, unsigned nodeIndex)
+{
+    std::vector<c_vector<unsigned, 3> >& r_triangles = rTriangulation.mTriangles;
+    std::vector<c_vector<unsigned, 3> >& r_neighbours = rTriangulation.mNeighbours;
+
+    /*
+     * Find the triangles (x, p_i, p_{i+1}) around the node x, going anticlockwise,
+     * along with the polygon p_0, p_1, ... formed by its neighbours and the
+     * triangles outside each edge of this polygon.
+     */
+    std::vector<unsigned> star;
+    std::vector<unsigned> polygon;
+    std::vector<unsigned> outer_triangles;
+
+    unsigned triangle = rTriangulation.mNodeTriangles[nodeIndex];
+    do
+    {
+        unsigned local_index = 0;
+        while (r_triangles[triangle][local_index] != nodeIndex)
+        {
+            local_index++;
+        }
+        star.push_back(triangle);
+        polygon.push_back(r_triangles[triangle][(local_index+1)%3]);
+        outer_triangles.push_back(r_neighbours[triangle][local_index]);
+
+        triangle = r_neighbours[triangle][(local_index+1)%3];
+        if (triangle == UINT_MAX || star.size() > r_triangles.size())
+        {
+            // The node is on the boundary
+            return false;
+        }
+    }
+    while (triangle != rTriangulation.mNodeTriangles[nodeIndex]);
+
+    unsigned num_vertices = polygon.size();
+
+    // Triangulate the polygon by repeatedly cutting off a positively oriented ear containing no other vertex
+    std::vector<c_vector<unsigned, 3> > new_triangles;
+    std::vector<unsigned> remaining(num_vertices);
+    for (unsigned i=0; i<num_vertices; i++)
+    {
+        remaining[i] = i;
+    }
+    while (remaining.size() > 2)
+    {
+        unsigned num_remaining = remaining.size();
+        bool found_ear = false;
+        for (unsigned i=0; i<num_remaining && !found_ear; i++)
+        {
+            unsigned node_a = polygon[remaining[(i+num_remaining-1)%num_remaining]];
+            unsigned node_b = polygon[remaining[i]];
+            unsigned node_c = polygon[remaining[(i+1)%num_remaining]];
+
+            // The diagonal a-c must not already be an edge of the triangulation outside the polygon
+            if (rTriangulation.CalculateOrientation(node_a, node_b, node_c) <= 2.0*DBL_EPSILON
+                || (num_remaining > 3 && AreNodesConnected(rTriangulation, node_a, node_c)))
+            {
+                continue;
+            }
+
+            found_ear = true;
+            for (unsigned j=0; j<num_remaining && found_ear; j++)
+            {
+                unsigned node_d = polygon[remaining[j]];
+                if (node_d != node_a && node_d != node_b && node_d != node_c
+                    && rTriangulation.CalculateOrientation(node_a, node_b, node_d) >= 0.0
+                    && rTriangulation.CalculateOrientation(node_b, node_c, node_d) >= 0.0
+                    && rTriangulation.CalculateOrientation(node_c, node_a, node_d) >= 0.0)
+                {
+                    found_ear = false;
+                }
+            }
+
+            if (found_ear)
+            {
+                c_vector<unsigned, 3> ear;
+                ear[0] = node_a;
+                ear[1] = node_b;
+                ear[2] = node_c;
+                new_triangles.push_back(ear);
+                remaining.erase(remaining.begin() + i);
+            }
+        }
+        if (!found_ear)
+        {
+            return false;
+        }
+    }
+    assert(new_triangles.size() == num_vertices - 2);
+
+    // Reuse the first triangles of the star and free the last two
+    for (unsigned k=0; k<new_triangles.size(); k++)
+    {
+        r_triangles[star[k]] = new_triangles[k];
+    }
+    for (unsigned k=new_triangles.size(); k<num_vertices; k++)
+    {
+        r_triangles[star[k]][0] = UINT_MAX;
+        rTriangulation.mFreeTriangles.push_back(star[k]);
+    }
+    rTriangulation.mNodeTriangles[nodeIndex] = UINT_MAX;
+
+    // Connect the new triangles to each other and to the triangles around the polygon
+    for (unsigned k=0; k<new_triangles.size(); k++)
+    {
+        unsigned new_triangle = star[k];
+        for (unsigned j=0; j<3; j++)
+        {
+            unsigned node_a = new_triangles[k][(j+1)%3];
+            unsigned node_b = new_triangles[k][(j+2)%3];
+            rTriangulation.mNodeTriangles[node_a] = new_triangle;
+            rTriangulation.mEdgesToCheck.push_back(std::make_pair(new_triangle, node_a));
+
+            unsigned polygon_index = std::find(polygon.begin(), polygon.end(), node_a) - polygon.begin();
+            if (polygon[(polygon_index+1)%num_vertices] == node_b)
+            {
+                // This is an edge of the polygon
+                unsigned outer = outer_triangles[polygon_index];
+                r_neighbours[new_triangle][j] = outer;
+                if (outer != UINT_MAX)
+                {
+                    for (unsigned i=0; i<3; i++)
+                    {
+                        if (r_triangles[outer][(i+1)%3] == node_b && r_triangles[outer][(i+2)%3] == node_a)
+                        {
+                            r_neighbours[outer][i] = new_triangle;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                // This is a diagonal, shared with another new triangle
+                for (unsigned other=0; other<new_triangles.size(); other++)
+                {
+                    for (unsigned i=0; i<3; i++)
+                    {
+                        if (new_triangles[other][(i+1)%3] == node_b && new_triangles[other][(i+2)%3] == node_a)
+                        {
+                            r_neighbours[new_triangle][j] = star[other];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::InsertNodeIntoTriangulation(WorkingTriangulation& rTriangulation, unsigned nodeIndex, unsigned startTriangle)
+{
+    std::vector<c_vector<unsigned, 3> >& r_triangles = rTriangulation.mTriangles;
+    std::vector<c_vector<unsigned, 3> >& r_neighbours = rTriangulation.mNeighbours;
+
+    // Walk towards the node, crossing any edge that has the node on its far side
+    unsigned triangle = startTriangle;
+    bool found = false;
+    for (unsigned num_steps=0; !found && num_steps<=r_triangles.size(); num_steps++)
+    {
+        found = true;
+        for (unsigned i=0; i<3; i++)
+        {
+            if (rTriangulation.CalculateOrientation(r_triangles[triangle][(i+1)%3], r_triangles[triangle][(i+2)%3], nodeIndex) < 0.0)
+            {
+                triangle = r_neighbours[triangle][i];
+                found = false;
+                break;
+            }
+        }
+        if (triangle == UINT_MAX)
+        {
+            // The node lies outside the triangulation
+            return false;
+        }
+    }
+    if (!found)
+    {
+        return false; // LCOV_EXCL_LINE
+    }
+
+    c_vector<unsigned, 3> old_nodes = r_triangles[triangle];
+    c_vector<unsigned, 3> old_neighbours = r_neighbours[triangle];
+    for (unsigned i=0; i<3; i++)
+    {
+        if (rTriangulation.CalculateOrientation(old_nodes[i], old_nodes[(i+1)%3], nodeIndex) <= 2.0*DBL_EPSILON)
+        {
+            // The node lies on (or very close to) an edge
+            return false;
+        }
+    }
+
+    // Split the triangle (a, b, c) into (a, b, x), (b, c, x) and (c, a, x)
+    c_vector<unsigned, 3> new_triangles;
+    new_triangles[0] = triangle;
+    for (unsigned i=1; i<3; i++)
+    {
+        if (rTriangulation.mFreeTriangles.empty())
+        {
+            new_triangles[i] = r_triangles.size();
+            r_triangles.push_back(c_vector<unsigned, 3>());
+            r_neighbours.push_back(c_vector<unsigned, 3>());
+        }
+        else
+        {
+            new_triangles[i] = rTriangulation.mFreeTriangles.back();
+            rTriangulation.mFreeTriangles.pop_back();
+        }
+    }
+
+    for (unsigned i=0; i<3; i++)
+    {
+        // Triangle i has the edge from old node i to old node i+1, which was opposite old node i+2
+        unsigned new_triangle = new_triangles[i];
+        r_triangles[new_triangle][0] = old_nodes[i];
+        r_triangles[new_triangle][1] = old_nodes[(i+1)%3];
+        r_triangles[new_triangle][2] = nodeIndex;
+        r_neighbours[new_triangle][0] = new_triangles[(i+1)%3];
+        r_neighbours[new_triangle][1] = new_triangles[(i+2)%3];
+        r_neighbours[new_triangle][2] = old_neighbours[(i+2)%3];
+        rTriangulation.mNodeTriangles[old_nodes[i]] = new_triangle;
+
+        unsigned outer = old_neighbours[(i+2)%3];
+        if (outer != UINT_MAX)
+        {
+            for (unsigned k=0; k<3; k++)
+            {
+                if (r_neighbours[outer][k] == triangle)
+                {
+                    r_neighbours[outer][k] = new_triangle;
+                }
+            }
+        }
+        rTriangulation.mEdgesToCheck.push_back(std::make_pair(new_triangle, old_nodes[i]));
+    }
+    rTriangulation.mNodeTriangles[nodeIndex] = triangle;
+
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMeshIncrementally(NodeMap& rMap)
+{
+    assert(ELEMENT_DIM == 2 && SPACE_DIM == 2); // LCOV_EXCL_LINE
+
+    // Start from a complete mesh, with no elements waiting to be removed
+    if (this->mElements.empty() || !mDeletedElementIndices.empty() || !mDeletedBoundaryElementIndices.empty())
+    {
+        return false;
+    }
+
+    // Take a working copy of the triangulation
+    unsigned num_old_triangles = this->mElements.size();
+    unsigned num_all_nodes = this->mNodes.size();
+
+    WorkingTriangulation triangulation;
+    std::vector<c_vector<unsigned, 3> >& r_triangles = triangulation.mTriangles;
+    std::vector<c_vector<unsigned, 3> >& r_neighbours = triangulation.mNeighbours;
+    r_triangles.resize(num_old_triangles);
+    r_neighbours.resize(num_old_triangles);
+    triangulation.mNodeTriangles.resize(num_all_nodes, UINT_MAX);
+
+    /*
+     * Nodes awaiting deletion are still in the triangulation, so we use GetPoint()
+     * rather than rGetLocation() to read their locations.
+     */
+    triangulation.mLocations.resize(num_all_nodes);
+    for (unsigned node_index=0; node_index<num_all_nodes; node_index++)
+    {
+        triangulation.mLocations[node_index] = this->mNodes[node_index]->GetPoint().rGetLocation();
+    }
+
+    for (unsigned t=0; t<num_old_triangles; t++)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            r_triangles[t][i] = this->mElements[t]->GetNodeGlobalIndex(i);
+            triangulation.mNodeTriangles[r_triangles[t][i]] = t;
+        }
+    }
+    // Find the neighbours of each triangle, using a list of the triangles containing each node
+    std::vector<unsigned> node_triangle_offsets(num_all_nodes+1, 0);
+    for (unsigned t=0; t<num_old_triangles; t++)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            node_triangle_offsets[r_triangles[t][i]+1]++;
+        }
+    }
+    for (unsigned node_index=0; node_index<num_all_nodes; node_index++)
+    {
+        node_triangle_offsets[node_index+1] += node_triangle_offsets[node_index];
+    }
+    std::vector<unsigned> node_triangle_list(3*num_old_triangles);
+    std::vector<unsigned> next_entry(node_triangle_offsets.begin(), node_triangle_offsets.end()-1);
+    for (unsigned t=0; t<num_old_triangles; t++)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            node_triangle_list[next_entry[r_triangles[t][i]]++] = t;
+        }
+    }
+
+    for (unsigned t=0; t<num_old_triangles; t++)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            // The neighbour opposite vertex i is the other triangle containing both remaining vertices
+            unsigned node_a = r_triangles[t][(i+1)%3];
+            unsigned node_b = r_triangles[t][(i+2)%3];
+            r_neighbours[t][i] = UINT_MAX;
+            for (unsigned k=node_triangle_offsets[node_a]; k<node_triangle_offsets[node_a+1]; k++)
+            {
+                unsigned other = node_triangle_list[k];
+                if (other != t && (r_triangles[other][0] == node_b || r_triangles[other][1] == node_b || r_triangles[other][2] == node_b))
+                {
+                    r_neighbours[t][i] = other;
+                    break;
+                }
+            }
+        }
+    }
+
+    /*
+     * The boundary is left alone, so it must still be the convex hull of the nodes:
+     * a single loop which turns anticlockwise through exactly one revolution, with
+     * no turns to the right (collinear boundary nodes are allowed).
+     */
+    std::vector<unsigned> next_boundary_node(num_all_nodes, UINT_MAX);
+    unsigned num_boundary_edges = 0;
+    unsigned first_boundary_node = UINT_MAX;
+    for (unsigned t=0; t<num_old_triangles; t++)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            if (r_neighbours[t][i] == UINT_MAX)
+            {
+                first_boundary_node = r_triangles[t][(i+1)%3];
+                next_boundary_node[first_boundary_node] = r_triangles[t][(i+2)%3];
+                num_boundary_edges++;
+            }
+        }
+    }
+    assert(first_boundary_node != UINT_MAX);
+
+    double total_turning_angle = 0.0;
+    unsigned node_index = first_boundary_node;
+    for (unsigned i=0; i<num_boundary_edges; i++)
+    {
+        unsigned next_node_index = next_boundary_node[node_index];
+        unsigned next_next_node_index = (next_node_index == UINT_MAX) ? UINT_MAX : next_boundary_node[next_node_index];
+        if (next_next_node_index == UINT_MAX)
+        {
+            return false; // LCOV_EXCL_LINE
+        }
+
+        double cross_product = triangulation.CalculateOrientation(node_index, next_node_index, next_next_node_index);
+        if (cross_product < 0.0)
+        {
+            return false;
+        }
+        c_vector<double, SPACE_DIM> edge = triangulation.mLocations[next_node_index] - triangulation.mLocations[node_index];
+        c_vector<double, SPACE_DIM> next_edge = triangulation.mLocations[next_next_node_index] - triangulation.mLocations[next_node_index];
+        double dot_product = inner_prod(edge, next_edge);
+        total_turning_angle += atan2(cross_product, dot_product);
+
+        node_index = next_node_index;
+    }
+    if (node_index != first_boundary_node || fabs(total_turning_angle - 2.0*M_PI) > 1e-6)
+    {
+        return false;
+    }
+
+    /*
+     * If a node has moved far enough to invert an element, take one of the
+     * element's nodes (preferably one due to be deleted anyway) out of the
+     * triangulation; it is put back in below. Once every triangle is positively
+     * oriented, the triangulation is valid since its boundary is convex.
+     */
+    for (unsigned t=0; t<r_triangles.size(); t++)
+    {
+        if (r_triangles[t][0] == UINT_MAX
+            || triangulation.CalculateOrientation(r_triangles[t][0], r_triangles[t][1], r_triangles[t][2]) > 2.0*DBL_EPSILON)
+        {
+            continue;
+        }
+
+        c_vector<unsigned, 3> nodes = r_triangles[t];
+        bool removed = false;
+        for (unsigned pass=0; pass<2 && !removed; pass++)
+        {
+            for (unsigned i=0; i<3 && !removed; i++)
+            {
+                if (next_boundary_node[nodes[i]] == UINT_MAX
+                    && this->mNodes[nodes[i]]->IsDeleted() == (pass == 0))
+                {
+                    removed = RemoveNodeFromTriangulation(triangulation, nodes[i]);
+                }
+            }
+        }
+        if (!removed)
+        {
+            return false;
+        }
+    }
+    triangulation.mEdgesToCheck.clear();
+
+    // Restore the Delaunay property after the nodes have moved
+    for (unsigned t=0; t<r_triangles.size(); t++)
+    {
+        for (unsigned i=0; i<3 && r_triangles[t][0] != UINT_MAX; i++)
+        {
+            if (r_neighbours[t][i] != UINT_MAX && r_neighbours[t][i] > t)
+            {
+                triangulation.mEdgesToCheck.push_back(std::make_pair(t, r_triangles[t][(i+1)%3]));
+            }
+        }
+    }
+    if (!MakeLocallyDelaunay(triangulation))
+    {
+        return false; // LCOV_EXCL_LINE
+    }
+
+    // Remove the nodes that have been marked as deleted
+    for (unsigned i=0; i<mDeletedNodeIndices.size(); i++)
+    {
+        unsigned node_index = mDeletedNodeIndices[i];
+        if (triangulation.mNodeTriangles[node_index] == UINT_MAX)
+        {
+            // This node is not in the triangulation
+            continue;
+        }
+        if (next_boundary_node[node_index] != UINT_MAX)
+        {
+            // Removing a boundary node would change the convex hull
+            return false;
+        }
+        if (!RemoveNodeFromTriangulation(triangulation, node_index) || !MakeLocallyDelaunay(triangulation))
+        {
+            return false; // LCOV_EXCL_LINE
+        }
+    }
+
+    // Insert each node that is not in the triangulation, including any taken out above
+    unsigned start_triangle = 0;
+    while (r_triangles[start_triangle][0] == UINT_MAX)
+    {
+        start_triangle++;
+    }
+    for (unsigned node_index=0; node_index<num_all_nodes; node_index++)
+    {
+        if (this->mNodes[node_index]->IsDeleted() || triangulation.mNodeTriangles[node_index] != UINT_MAX)
+        {
+            continue;
+        }
+        if (!InsertNodeIntoTriangulation(triangulation, node_index, start_triangle) || !MakeLocallyDelaunay(triangulation))
+        {
+            return false;
+        }
+        start_triangle = triangulation.mNodeTriangles[node_index];
+    }
+
+    /*
+     * Fill the gaps left by removing nodes with triangles from the end, so that
+     * the indices of as few elements as possible change.
+     */
+    std::vector<unsigned>& r_free_triangles = triangulation.mFreeTriangles;
+    std::sort(r_free_triangles.begin(), r_free_triangles.end());
+    for (unsigned i=0; i<r_free_triangles.size(); i++)
+    {
+        while (r_triangles.back()[0] == UINT_MAX)
+        {
+            r_triangles.pop_back();
+            r_neighbours.pop_back();
+        }
+
+        unsigned gap = r_free_triangles[i];
+        unsigned last = r_triangles.size() - 1;
+        if (gap >= last)
+        {
+            break;
+        }
+
+        r_triangles[gap] = r_triangles[last];
+        r_neighbours[gap] = r_neighbours[last];
+        r_triangles.pop_back();
+        r_neighbours.pop_back();
+
+        for (unsigned j=0; j<3; j++)
+        {
+            triangulation.mNodeTriangles[r_triangles[gap][j]] = gap;
+
+            unsigned neighbour = r_neighbours[gap][j];
+            if (neighbour != UINT_MAX)
+            {
+                for (unsigned k=0; k<3; k++)
+                {
+                    if (r_neighbours[neighbour][k] == last)
+                    {
+                        r_neighbours[neighbour][k] = gap;
+                    }
+                }
+            }
+        }
+    }
+    while (r_triangles.back()[0] == UINT_MAX)
+    {
+        r_triangles.pop_back();
+        r_neighbours.pop_back();
+    }
+
+    // Copy the working triangulation back into the mesh, only replacing elements whose nodes have changed
+    unsigned num_triangles = r_triangles.size();
+    for (unsigned t=0; t<std::max(num_triangles, num_old_triangles); t++)
+    {
+        if (t < num_old_triangles)
+        {
+            bool is_unchanged = (t < num_triangles);
+            for (unsigned i=0; i<3 && is_unchanged; i++)
+            {
+                is_unchanged = (this->mElements[t]->GetNodeGlobalIndex(i) == r_triangles[t][i]);
+            }
+            if (is_unchanged)
+            {
+                continue;
+            }
+
+            this->mElements[t]->MarkAsDeleted();
+            if (t >= num_triangles)
+            {
+                mDeletedElementIndices.push_back(t);
+                continue;
+            }
+            delete this->mElements[t];
+        }
+
+        std::vector<Node<SPACE_DIM>*> nodes;
+        for (unsigned i=0; i<3; i++)
+        {
+            nodes.push_back(this->mNodes[r_triangles[t][i]]);
+        }
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = new Element<ELEMENT_DIM, SPACE_DIM>(t, nodes);
+
+        if (t < num_old_triangles)
+        {
+            this->mElements[t] = p_element;
+        }
+        else
+        {
+            this->mElements.push_back(p_element);
+        }
+    }
+
+    // The boundary is unchanged, so we just need to tidy up the indices
+    this->RefreshJacobianCachedData();
+    mAddedNodes = false;
+    ReIndex(rMap);
+
+    return true;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh()
 {
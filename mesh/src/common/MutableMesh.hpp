@@ -150,8 +150,140 @@ protected:
     /** Whether any nodes have been added to the mesh. */
     bool mAddedNodes;
 
+    /**
+     * Whether ReMesh() should first try to repair the existing triangulation
+     * locally rather than rebuilding it from scratch. Defaults to false.
+     */
+    bool mUseIncrementalReMesh;
+
 private:
 
+    /**
+     * A working copy of a 2D triangulation, used by ReMeshIncrementally() so
+     * that the mesh itself is only altered once the update has succeeded.
+     * Triangles are stored anticlockwise by global node index, and a triangle
+     * whose first entry is UINT_MAX is not in use.
+     */
+    struct WorkingTriangulation
+    {
+        /**
+         * The location of each node, including those awaiting deletion, whose
+         * indices are not reused by AddNode() when remeshing incrementally.
+         */
+        std::vector<c_vector<double, SPACE_DIM> > mLocations;
+
+        /** The global node indices of each triangle. */
+        std::vector<c_vector<unsigned, 3> > mTriangles;
+
+        /** For each triangle, the triangle opposite each vertex (UINT_MAX on the boundary). */
+        std::vector<c_vector<unsigned, 3> > mNeighbours;
+
+        /** For each node, a triangle containing it (UINT_MAX if there is none). */
+        std::vector<unsigned> mNodeTriangles;
+
+        /** Triangles which are not in use and can be recycled. */
+        std::vector<unsigned> mFreeTriangles;
+
+        /**
+         * Edges which may not be locally Delaunay, each given by a triangle and
+         * the node at which the edge starts going anticlockwise around it.
+         */
+        std::vector<std::pair<unsigned, unsigned> > mEdgesToCheck;
+
+        /**
+         * @return twice the signed area of the triangle with the given vertices,
+         * which is positive if the vertices are ordered anticlockwise.
+         *
+         * @param nodeA global index of the first vertex
+         * @param nodeB global index of the second vertex
+         * @param nodeC global index of the third vertex
+         */
+        double CalculateOrientation(unsigned nodeA, unsigned nodeB, unsigned nodeC) const;
+
+        /**
+         * @return true if node D lies strictly inside the circumcircle of the
+         * anticlockwise triangle ABC, up to a small relative tolerance which stops
+         * cocircular configurations from being flipped back and forth.
+         *
+         * @param nodeA global index of the first vertex of the triangle
+         * @param nodeB global index of the second vertex of the triangle
+         * @param nodeC global index of the third vertex of the triangle
+         * @param nodeD global index of the node to test
+         */
+        bool IsInCircumcircle(unsigned nodeA, unsigned nodeB, unsigned nodeC, unsigned nodeD) const;
+    };
+
+    /**
+     * Flip the edge opposite a given vertex of a triangle, updating the
+     * neighbour information of the triangles involved.
+     *
+     * @param rTriangulation the working triangulation
+     * @param triangle the triangle containing the edge
+     * @param localIndex the local index of the vertex opposite the edge
+     * @return false (leaving the triangulation unchanged) if the edge lies on the
+     *     boundary or the two triangles sharing it do not form a strictly convex quadrilateral
+     */
+    bool FlipEdge(WorkingTriangulation& rTriangulation, unsigned triangle, unsigned localIndex);
+
+    /**
+     * Use Lawson's algorithm to flip edges until each edge waiting to be checked,
+     * and any edge affected by the flips, is locally Delaunay.
+     *
+     * @param rTriangulation the working triangulation
+     * @return false if the number of flips grew too large
+     */
+    bool MakeLocallyDelaunay(WorkingTriangulation& rTriangulation);
+
+    /**
+     * @return whether two nodes share an edge of the triangulation.
+     *
+     * @param rTriangulation the working triangulation
+     * @param nodeA the global index of the first node, which must be in the triangulation
+     * @param nodeB the global index of the second node
+     */
+    bool AreNodesConnected(const WorkingTriangulation& rTriangulation, unsigned nodeA, unsigned nodeB) const;
+
+    /**
+     * Remove an interior node from the triangulation, filling the polygon
+     * formed by its neighbours by ear clipping.
+     *
+     * @param rTriangulation the working triangulation
+     * @param nodeIndex the global index of the node
+     * @return false (leaving the triangulation unchanged) if the polygon
+     *     could not be filled with positively oriented triangles
+     */
+    bool RemoveNodeFromTriangulation(WorkingTriangulation& rTriangulation, unsigned nodeIndex);
+
+    /**
+     * Insert a node into the triangulation by splitting the triangle that
+     * contains it into three.
+     *
+     * @param rTriangulation the working triangulation
+     * @param nodeIndex the global index of the node
+     * @param startTriangle the triangle from which to start searching for the node
+     * @return false (leaving the triangulation unchanged) if the node lies
+     *     outside the triangulation or on one of its edges
+     */
+    bool InsertNodeIntoTriangulation(WorkingTriangulation& rTriangulation, unsigned nodeIndex, unsigned startTriangle);
+
+    /**
+     * Try to bring a 2D mesh up to date without calling triangle, by deleting
+     * nodes marked as deleted, inserting nodes that are not yet in any element,
+     * and restoring the Delaunay property with Lawson edge flips. A node that
+     * has moved far enough to invert an element is removed and reinserted.
+     * Elements whose nodes do not change are left untouched.
+     *
+     * The existing mesh is left unchanged, and false returned, if this cannot be
+     * done safely: for example if the boundary is no longer convex, or a node is
+     * to be added outside (or removed from the boundary of) the mesh. The caller
+     * should then remesh from scratch.
+     *
+     * @param rMap is a NodeMap which associates the indices of nodes in the old mesh
+     * with indices of nodes in the new mesh
+     * @return whether the mesh was updated
+     */
+    bool ReMeshIncrementally(NodeMap& rMap);
+
     /**
      * @return true if the mesh is Voronoi local to the given element.
      * Check whether any neighbouring node is inside the circumsphere of this element.
@@ -212,6 +344,26 @@ public:
      */
     void RescaleMeshFromBoundaryNode(ChastePoint<1> updatedPoint, unsigned boundaryNodeIndex);
 
+    /**
+     * Set whether ReMesh() should repair the existing triangulation locally where
+     * possible (2D only), falling back to a full remesh with triangle otherwise.
+     * Since the two approaches number the elements differently, results that
+     * depend on element ordering are not identical between them.
+     *
+     * This should be set before any nodes are added to or deleted from the mesh,
+     * since while it is set the indices of deleted nodes are not reused by AddNode().
+     * An exception is thrown if incremental remeshing is requested for a mesh which
+     * is not 2D, or for a mesh such as Cylindrical2dMesh which does not support it.
+     *
+     * @param useIncrementalReMesh whether to remesh incrementally
+     */
+    virtual void SetUseIncrementalReMesh(bool useIncrementalReMesh);
+
+    /**
+     * @return whether ReMesh() tries to repair the existing triangulation locally.
+     */
+    bool GetUseIncrementalReMesh() const;
+
     /**
      * Add a node to the mesh.
      *
@@ -309,7 +461,10 @@ public:
 
 
     /**
-     * Re-mesh a mesh using triangle (via library calls) or tetgen
+     * Re-mesh a mesh using triangle (via library calls) or tetgen.
+     * In 2D, if SetUseIncrementalReMesh() has been called, the existing
+     * triangulation is repaired locally instead whenever this is possible.
+     *
      * @param map is a NodeMap which associates the indices of nodes in the old mesh
      * with indices of nodes in the new mesh.  This should be created with the correct size (NumAllNodes)
      */
@@ -181,6 +181,15 @@ void Cylindrical2dMesh::CreateHaloNodes()
     }
 }
 
+void Cylindrical2dMesh::SetUseIncrementalReMesh(bool useIncrementalReMesh)
+{
+    if (useIncrementalReMesh)
+    {
+        EXCEPTION("Incremental remeshing is not supported by Cylindrical2dMesh, since its mirror image nodes need a full remesh.");
+    }
+    MutableMesh<2,2>::SetUseIncrementalReMesh(useIncrementalReMesh);
+}
+
 void Cylindrical2dMesh::ReMesh(NodeMap& rMap)
 {
     unsigned old_num_all_nodes = GetNumAllNodes();
@@ -249,6 +249,17 @@ public:
      */
     void ReMesh(NodeMap& rMap);
 
+    /**
+     * Overridden SetUseIncrementalReMesh() method.
+     *
+     * The mirror image nodes created before each remesh lie outside the existing
+     * triangulation, so it can't be repaired incrementally, and an exception is
+     * thrown if incremental remeshing is requested.
+     *
+     * @param useIncrementalReMesh whether to remesh incrementally
+     */
+    void SetUseIncrementalReMesh(bool useIncrementalReMesh);
+
     /**
      * Overridden GetVectorFromAtoB() method.
      *
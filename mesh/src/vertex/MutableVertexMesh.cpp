@@ -35,6 +35,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "MutableVertexMesh.hpp"
 
+#include <cfloat>
+
 #include "LogFile.hpp"
 #include "UblasCustomFunctions.hpp"
 #include "Warnings.hpp"
@@ -55,6 +57,7 @@ MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh(std::vector<Node<SP
           mProtorosetteResolutionProbabilityPerTimestep(protorosetteResolutionProbabilityPerTimestep),
           mRosetteResolutionProbabilityPerTimestep(rosetteResolutionProbabilityPerTimestep),
           mCheckForInternalIntersections(false),
+          mEdgeTopologyIsUpToDate(false),
           mDistanceForT3SwapChecking(5.0)
 {
     // Threshold parameters must be strictly positive
@@ -129,6 +132,7 @@ MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh()
       mProtorosetteResolutionProbabilityPerTimestep(0.0),
       mRosetteResolutionProbabilityPerTimestep(0.0),
       mCheckForInternalIntersections(false),
+      mEdgeTopologyIsUpToDate(false),
       mDistanceForT3SwapChecking(5.0)
 {
     // Note that the member variables initialised above will be overwritten as soon as archiving is complete
@@ -866,6 +870,9 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::RemoveDeletedNodes()
     {
         this->mNodes[i]->SetIndex(i);
     }
+
+    // The edges refer to nodes by their old indices
+    mEdgeTopologyIsUpToDate = false;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -887,12 +894,18 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElemen
          * mesh. Instead, we just remove any deleted elements and nodes.
          */
         RemoveDeletedNodesAndElements(rElementMap);
+
+        // Find the edges of the mesh once, then keep them up to date as swaps are performed
+        mEdgeTopology.Update(*this);
+        mEdgeTopologyIsUpToDate = true;
+
         bool recheck_mesh = true;
         while (recheck_mesh == true)
         {
             // We check for any short edges and perform swaps if necessary and possible.
             recheck_mesh = CheckForSwapsFromShortEdges();
         }
+        mEdgeTopologyIsUpToDate = false;
 
         // Check for element intersections
         recheck_mesh = true;
@@ -929,19 +942,32 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
 {
+    // Recompute the edges if a swap has left them out of date
+    if (!mEdgeTopologyIsUpToDate)
+    {
+        mEdgeTopology.Update(*this);
+        mEdgeTopologyIsUpToDate = true;
+    }
+
     // Loop over elements to check for T1 swaps
     for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
          elem_iter != this->GetElementIteratorEnd();
          ++elem_iter)
     {
-        ///\todo Could we search more efficiently by just iterating over edges? (see #2401)
-
+        unsigned elem_index = elem_iter->GetIndex();
         unsigned num_nodes = elem_iter->GetNumNodes();
         assert(num_nodes > 0);
 
         // Loop over the nodes contained in this element
         for (unsigned local_index=0; local_index<num_nodes; local_index++)
         {
+            // Check each edge only from the element with the lowest index containing it
+            unsigned neighbouring_elem_index = mEdgeTopology.GetNeighbouringElementIndex(elem_index, local_index);
+            if (neighbouring_elem_index != UNSIGNED_UNSET && neighbouring_elem_index < elem_index)
+            {
+                continue;
+            }
+
             // Find locations of the current node and anticlockwise node
             Node<SPACE_DIM>* p_current_node = elem_iter->GetNode(local_index);
             unsigned local_index_plus_one = (local_index+1)%num_nodes;    ///\todo Use iterators to tidy this up (see #2401)
@@ -953,28 +979,11 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
             // If the nodes are too close together...
             if (distance_between_nodes < mCellRearrangementThreshold)
             {
-                // ...then check if any triangular elements are shared by these nodes...
-                std::set<unsigned> elements_of_node_a = p_current_node->rGetContainingElementIndices();
-                std::set<unsigned> elements_of_node_b = p_anticlockwise_node->rGetContainingElementIndices();
-
-                std::set<unsigned> shared_elements;
-                std::set_intersection(elements_of_node_a.begin(), elements_of_node_a.end(),
-                               elements_of_node_b.begin(), elements_of_node_b.end(),
-                               std::inserter(shared_elements, shared_elements.begin()));
-
-                bool both_nodes_share_triangular_element = false;
-                for (std::set<unsigned>::const_iterator it = shared_elements.begin();
-                     it != shared_elements.end();
-                     ++it)
-                {
-                    if (this->GetElement(*it)->GetNumNodes() <= 3)
-                    {
-                        both_nodes_share_triangular_element = true;
-                        break;
-                    }
-                }
+                // ...then check if either of the elements sharing this edge is triangular...
+                bool both_nodes_share_triangular_element = (num_nodes <= 3)
+                    || (neighbouring_elem_index != UNSIGNED_UNSET && this->GetElement(neighbouring_elem_index)->GetNumNodes() <= 3);
 
-                // ...and if none are, then perform the required type of swap and halt the search, returning true
+                // ...and if neither is, then perform the required type of swap and halt the search, returning true
                 if (!both_nodes_share_triangular_element)
                 {
                     IdentifySwapType(p_current_node, p_anticlockwise_node);
@@ -1018,18 +1027,20 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
     // If checking for internal intersections as well as on the boundary, then check that no nodes have overlapped any elements...
     if (mCheckForInternalIntersections)
     {
-        ///\todo Change to only loop over neighbouring elements (see #2401)
+        // Only elements whose bounding boxes contain a node can include it
+        std::vector<std::vector<unsigned> > candidate_elements;
+        GetCandidateElementsForIntersections(candidate_elements);
+
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
              node_iter != this->GetNodeIteratorEnd();
              ++node_iter)
         {
             assert(!(node_iter->IsDeleted()));
 
-            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-                 elem_iter != this->GetElementIteratorEnd();
-                 ++elem_iter)
+            const std::vector<unsigned>& r_candidates = candidate_elements[node_iter->GetIndex()];
+            for (unsigned i=0; i<r_candidates.size(); i++)
             {
-                unsigned elem_index = elem_iter->GetIndex();
+                unsigned elem_index = r_candidates[i];
 
                 // Check that the node is not part of this element
                 if (node_iter->rGetContainingElementIndices().count(elem_index) == 0)
@@ -1104,22 +1115,243 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
     return false;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetCandidateElementsForIntersections(std::vector<std::vector<unsigned> >& rCandidateElements)
+{
+    rCandidateElements.assign(this->GetNumAllNodes(), std::vector<unsigned>());
+    if ((this->GetNumElements() == 0) || (this->GetNumNodes() == 0))
+    {
+        return;
+    }
+
+    // Points are mapped to their periodic image closest to this reference point (the identity for non-periodic meshes)
+    const c_vector<double, SPACE_DIM> reference_point = this->GetNodeIteratorBegin()->rGetLocation();
+
+    /*
+     * Compute the bounding box of each element. A box that crosses a periodic boundary is
+     * stored once for each periodic image of its corners, so that together the copies cover
+     * every point of the domain that the element may include.
+     */
+    std::vector<c_vector<double, SPACE_DIM> > box_min;
+    std::vector<c_vector<double, SPACE_DIM> > box_max;
+    std::vector<unsigned> box_element;
+    double total_box_width = 0.0;
+    for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        c_vector<double, SPACE_DIM> first_node_location = elem_iter->GetNodeLocation(0);
+        c_vector<double, SPACE_DIM> lower = zero_vector<double>(SPACE_DIM);
+        c_vector<double, SPACE_DIM> upper = zero_vector<double>(SPACE_DIM);
+        for (unsigned local_index=1; local_index<elem_iter->GetNumNodes(); local_index++)
+        {
+            c_vector<double, SPACE_DIM> node_location = this->GetVectorFromAtoB(first_node_location, elem_iter->GetNodeLocation(local_index));
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                lower[i] = std::min(lower[i], node_location[i]);
+                upper[i] = std::max(upper[i], node_location[i]);
+            }
+        }
+
+        // Pad the box slightly so that points on its boundary are not lost to rounding
+        double box_width = norm_inf(upper - lower);
+        total_box_width += box_width;
+        c_vector<double, SPACE_DIM> anchor = reference_point + this->GetVectorFromAtoB(reference_point, first_node_location);
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            lower[i] += anchor[i] - 1e-6*box_width - DBL_EPSILON;
+            upper[i] += anchor[i] + 1e-6*box_width + DBL_EPSILON;
+        }
+
+        std::vector<c_vector<double, SPACE_DIM> > shifts;
+        for (unsigned corner=0; corner<(1u<<SPACE_DIM); corner++)
+        {
+            c_vector<double, SPACE_DIM> corner_location;
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                corner_location[i] = (corner & (1u<<i)) ? upper[i] : lower[i];
+            }
+            c_vector<double, SPACE_DIM> shift = reference_point + this->GetVectorFromAtoB(reference_point, corner_location) - corner_location;
+
+            bool is_new_shift = true;
+            for (unsigned j=0; j<shifts.size(); j++)
+            {
+                if (norm_inf(shifts[j] - shift) <= 1e-6*box_width + DBL_EPSILON)
+                {
+                    is_new_shift = false;
+                    break;
+                }
+            }
+            if (is_new_shift)
+            {
+                shifts.push_back(shift);
+                box_min.push_back(lower + shift);
+                box_max.push_back(upper + shift);
+                box_element.push_back(elem_iter->GetIndex());
+            }
+        }
+    }
+
+    // Set up a uniform grid, with boxes about the size of an element, covering all the bounding boxes
+    const unsigned num_boxes = box_element.size();
+    c_vector<double, SPACE_DIM> grid_min = box_min[0];
+    c_vector<double, SPACE_DIM> grid_max = box_max[0];
+    for (unsigned box=1; box<num_boxes; box++)
+    {
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            grid_min[i] = std::min(grid_min[i], box_min[box][i]);
+            grid_max[i] = std::max(grid_max[i], box_max[box][i]);
+        }
+    }
+
+    double cell_width = total_box_width/this->GetNumElements();
+    if (cell_width <= 0.0)
+    {
+        cell_width = std::max(norm_inf(grid_max - grid_min), 1.0);
+    }
+
+    // Coarsen the grid if necessary so that it has no more cells than a small multiple of the number of boxes
+    c_vector<unsigned, SPACE_DIM> num_cells;
+    while (true)
+    {
+        double num_cells_as_double = 1.0;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            num_cells_as_double *= floor((grid_max[i] - grid_min[i])/cell_width) + 1.0;
+        }
+        if (num_cells_as_double <= 4.0*num_boxes + 16.0)
+        {
+            break;
+        }
+        cell_width *= 2.0;
+    }
+    unsigned total_num_cells = 1;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        num_cells[i] = (unsigned)((grid_max[i] - grid_min[i])/cell_width) + 1;
+        total_num_cells *= num_cells[i];
+    }
+
+    // Record which boxes overlap each grid cell
+    std::vector<std::vector<unsigned> > boxes_in_cell(total_num_cells);
+    for (unsigned box=0; box<num_boxes; box++)
+    {
+        c_vector<unsigned, SPACE_DIM> first_cell;
+        c_vector<unsigned, SPACE_DIM> last_cell;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            first_cell[i] = std::min((unsigned)((box_min[box][i] - grid_min[i])/cell_width), num_cells[i] - 1);
+            last_cell[i] = std::min((unsigned)((box_max[box][i] - grid_min[i])/cell_width), num_cells[i] - 1);
+        }
+
+        // Loop over the cells in the range, incrementing the multi-index like an odometer
+        c_vector<unsigned, SPACE_DIM> cell = first_cell;
+        bool done = false;
+        while (!done)
+        {
+            unsigned cell_index = 0;
+            for (unsigned i=SPACE_DIM; i-- > 0; )
+            {
+                cell_index = cell_index*num_cells[i] + cell[i];
+            }
+            boxes_in_cell[cell_index].push_back(box);
+
+            done = true;
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                if (cell[i] < last_cell[i])
+                {
+                    cell[i]++;
+                    done = false;
+                    break;
+                }
+                cell[i] = first_cell[i];
+            }
+        }
+    }
+
+    // Test each node against the boxes overlapping its grid cell
+    for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
+         node_iter != this->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        c_vector<double, SPACE_DIM> location = reference_point + this->GetVectorFromAtoB(reference_point, node_iter->rGetLocation());
+
+        bool is_in_grid = true;
+        unsigned cell_index = 0;
+        for (unsigned i=SPACE_DIM; i-- > 0; )
+        {
+            if ((location[i] < grid_min[i]) || (location[i] > grid_max[i]))
+            {
+                is_in_grid = false;
+                break;
+            }
+            cell_index = cell_index*num_cells[i] + std::min((unsigned)((location[i] - grid_min[i])/cell_width), num_cells[i] - 1);
+        }
+        if (!is_in_grid)
+        {
+            continue;
+        }
+
+        std::vector<unsigned>& r_candidates = rCandidateElements[node_iter->GetIndex()];
+        const std::vector<unsigned>& r_boxes = boxes_in_cell[cell_index];
+        for (unsigned j=0; j<r_boxes.size(); j++)
+        {
+            unsigned box = r_boxes[j];
+            bool box_contains_node = true;
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                if ((location[i] < box_min[box][i]) || (location[i] > box_max[box][i]))
+                {
+                    box_contains_node = false;
+                    break;
+                }
+            }
+            if (box_contains_node)
+            {
+                r_candidates.push_back(box_element[box]);
+            }
+        }
+
+        // Test candidates in increasing order of element index, as when looping over all elements
+        std::sort(r_candidates.begin(), r_candidates.end());
+        r_candidates.erase(std::unique(r_candidates.begin(), r_candidates.end()), r_candidates.end());
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
-    // Find the sets of elements containing nodes A and B
-    std::set<unsigned> nodeA_elem_indices = pNodeA->rGetContainingElementIndices();
-    std::set<unsigned> nodeB_elem_indices = pNodeB->rGetContainingElementIndices();
+    if (!mEdgeTopologyIsUpToDate)
+    {
+        mEdgeTopology.Update(*this);
+    }
 
-    // Form the set union
-    std::set<unsigned> all_indices, temp_union_set;
-    std::set_union(nodeA_elem_indices.begin(), nodeA_elem_indices.end(),
-                   nodeB_elem_indices.begin(), nodeB_elem_indices.end(),
-                   std::inserter(temp_union_set, temp_union_set.begin()));
-    all_indices.swap(temp_union_set); // temp_set will be deleted, all_indices now contains all the indices of elements
-                                      // that touch the potentially swapping nodes
+    // Find the numbers of elements containing nodes A and B
+    unsigned num_nodeA_elems = pNodeA->GetNumContainingElements();
+    unsigned num_nodeB_elems = pNodeB->GetNumContainingElements();
 
-    if ((nodeA_elem_indices.size()>3) || (nodeB_elem_indices.size()>3))
+    // Find the elements containing the edge between the nodes, and all the elements that touch either node
+    unsigned edge_index = mEdgeTopology.FindEdge(pNodeA->GetIndex(), pNodeB->GetIndex());
+    assert(edge_index != UNSIGNED_UNSET); // the nodes are neighbours
+    std::set<unsigned> all_indices;
+    unsigned node_indices[2] = {pNodeA->GetIndex(), pNodeB->GetIndex()};
+    for (unsigned j=0; j<2; j++)
+    {
+        unsigned node_index = node_indices[j];
+        for (unsigned i=0; i<mEdgeTopology.GetNumEdgesOfNode(node_index); i++)
+        {
+            unsigned node_edge_index = mEdgeTopology.GetNodeEdgeIndex(node_index, i);
+            all_indices.insert(mEdgeTopology.GetEdgeElementIndex(node_edge_index, 0));
+            if (!mEdgeTopology.IsBoundaryEdge(node_edge_index))
+            {
+                all_indices.insert(mEdgeTopology.GetEdgeElementIndex(node_edge_index, 1));
+            }
+        }
+    }
+
+    if ((num_nodeA_elems>3) || (num_nodeB_elems>3))
     {
         /*
          * Looks like
@@ -1134,8 +1366,10 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
 
         /*
          * This case is handled in a separate method to allow child classes to implement different
-         * functionality for high-order-junction remodelling events (see #2664).
+         * functionality for high-order-junction remodelling events (see #2664). Such events do not
+         * update the edges.
          */
+        mEdgeTopologyIsUpToDate = false;
         this->HandleHighOrderJunctions(pNodeA, pNodeB);
     }
     else // each node is contained in at most three elements
@@ -1161,7 +1395,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
             }
             case 2:
             {
-                if (nodeA_elem_indices.size()==2 && nodeB_elem_indices.size()==2)
+                if (num_nodeA_elems==2 && num_nodeB_elems==2)
                 {
                     if (pNodeA->IsBoundaryNode() && pNodeB->IsBoundaryNode())
                     {
@@ -1204,7 +1438,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
                          */
                         EXCEPTION("There are non-boundary nodes contained only in two elements; something has gone wrong.");
                     }
-                }// from [if (nodeA_elem_indices.size()==2 && nodeB_elem_indices.size()==2)]
+                }// from [if (num_nodeA_elems==2 && num_nodeB_elems==2)]
                 else
                 {
                     /*
@@ -1228,7 +1462,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
             }
             case 3:
             {
-                if (nodeA_elem_indices.size()==1 || nodeB_elem_indices.size()==1)
+                if (num_nodeA_elems==1 || num_nodeB_elems==1)
                 {
                     /*
                      * One node is contained in one element and the other node is contained in three elements.
@@ -1248,7 +1482,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
 
                     EXCEPTION("There is a boundary node contained in three elements something has gone wrong.");
                 }
-                else if (nodeA_elem_indices.size()==2 && nodeB_elem_indices.size()==2)
+                else if (num_nodeA_elems==2 && num_nodeB_elems==2)
                 {
                     // The short edge must be at the boundary. We need to check whether this edge is
                     // adjacent to a triangular void before we swap. If it is a triangular void, we perform a T2-type swap.
@@ -1256,24 +1490,29 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
                     // element in nodeA_elem_indices which is not in nodeB_elem_indices contains a shared node
                     // with the element in nodeB_elem_indices which is not in nodeA_elem_indices.
 
-                    std::set<unsigned> element_A_not_B, temp_set;
-                    std::set_difference(all_indices.begin(), all_indices.end(), nodeB_elem_indices.begin(),
-                            nodeB_elem_indices.end(), std::inserter(temp_set, temp_set.begin()));
-                    element_A_not_B.swap(temp_set);
-
-                    // There must be only one such element
-                    assert(element_A_not_B.size() == 1);
-
-                    std::set<unsigned> element_B_not_A;
-                    std::set_difference(all_indices.begin(), all_indices.end(), nodeA_elem_indices.begin(),
-                            nodeA_elem_indices.end(), std::inserter(temp_set, temp_set.begin()));
-                    element_B_not_A.swap(temp_set);
-
-                    // There must be only one such element
-                    assert(element_B_not_A.size() == 1);
+                    // The edge between the nodes is on the boundary, so each node is in one other element
+                    assert(mEdgeTopology.IsBoundaryEdge(edge_index));
+                    unsigned shared_elem_index = mEdgeTopology.GetEdgeElementIndex(edge_index, 0);
+                    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element_A_not_B = nullptr;
+                    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element_B_not_A = nullptr;
+                    for (std::set<unsigned>::const_iterator it = all_indices.begin(); it != all_indices.end(); ++it)
+                    {
+                        if (*it != shared_elem_index)
+                        {
+                            if (pNodeA->rGetContainingElementIndices().count(*it) > 0)
+                            {
+                                p_element_A_not_B = this->mElements[*it];
+                            }
+                            else
+                            {
+                                p_element_B_not_A = this->mElements[*it];
+                            }
+                        }
+                    }
 
-                    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element_A_not_B = this->mElements[*element_A_not_B.begin()];
-                    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element_B_not_A = this->mElements[*element_B_not_A.begin()];
+                    // There must be only one such element for each node
+                    assert(p_element_A_not_B != nullptr);
+                    assert(p_element_B_not_A != nullptr);
 
                     unsigned local_index_1 = p_element_A_not_B->GetNodeLocalIndex(pNodeA->GetIndex());
                     unsigned next_node_1 = p_element_A_not_B->GetNodeGlobalIndex((local_index_1 + 1)%(p_element_A_not_B->GetNumNodes()));
@@ -1358,12 +1597,12 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
 
                         PerformT1Swap(pNodeA, pNodeB, all_indices);
                     }
-                } // from else if (nodeA_elem_indices.size()==2 && nodeB_elem_indices.size()==2)
+                } // from else if (num_nodeA_elems==2 && num_nodeB_elems==2)
                 else
                 {
                     // In this case, one node must be contained in two elements and the other in three elements.
-                    assert (   (nodeA_elem_indices.size()==2 && nodeB_elem_indices.size()==3)
-                            || (nodeA_elem_indices.size()==3 && nodeB_elem_indices.size()==2) );
+                    assert (   (num_nodeA_elems==2 && num_nodeB_elems==3)
+                            || (num_nodeA_elems==3 && num_nodeB_elems==2) );
 
                     // They can't both be boundary nodes
                     assert(!(pNodeA->IsBoundaryNode() && pNodeB->IsBoundaryNode()));
@@ -1530,16 +1769,23 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT1Swap(Node<SPACE_DIM>* p
     pNodeA->rGetModifiableLocation() = nodeC_location;
     pNodeB->rGetModifiableLocation() = nodeD_location;
 
-    // Find the sets of elements containing nodes A and B
-    std::set<unsigned> nodeA_elem_indices = pNodeA->rGetContainingElementIndices();
-    std::set<unsigned> nodeB_elem_indices = pNodeB->rGetContainingElementIndices();
+    // The elements containing both nodes A and B are those on either side of the edge joining them
+    if (!mEdgeTopologyIsUpToDate)
+    {
+        mEdgeTopology.Update(*this);
+    }
+    unsigned edge_index = mEdgeTopology.FindEdge(pNodeA->GetIndex(), pNodeB->GetIndex());
+    assert(edge_index != UNSIGNED_UNSET);
 
     for (std::set<unsigned>::const_iterator it = rElementsContainingNodes.begin();
          it != rElementsContainingNodes.end();
          ++it)
     {
+        bool contains_both_nodes = (*it == mEdgeTopology.GetEdgeElementIndex(edge_index, 0))
+                                   || (*it == mEdgeTopology.GetEdgeElementIndex(edge_index, 1));
+
         // If, as in element 3 above, this element does not contain node A (now C)...
-        if (nodeA_elem_indices.find(*it) == nodeA_elem_indices.end())
+        if (!contains_both_nodes && this->mElements[*it]->GetNodeLocalIndex(pNodeA->GetIndex()) == UINT_MAX)
         {
             // ...then add it to the element just after node B (now D), going anticlockwise
             unsigned nodeB_local_index = this->mElements[*it]->GetNodeLocalIndex(pNodeB->GetIndex());
@@ -1547,7 +1793,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT1Swap(Node<SPACE_DIM>* p
 
             this->mElements[*it]->AddNode(pNodeA, nodeB_local_index);
         }
-        else if (nodeB_elem_indices.find(*it) == nodeB_elem_indices.end())
+        else if (!contains_both_nodes)
         {
             // Do similarly if the element does not contain node B (now D), as in element 4 above
             unsigned nodeA_local_index = this->mElements[*it]->GetNodeLocalIndex(pNodeA->GetIndex());
@@ -1611,6 +1857,12 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT1Swap(Node<SPACE_DIM>* p
             pNodeB->SetAsBoundaryNode(true);
         }
     }
+
+    // Only the elements involved in the swap have changed, so update just their edges
+    if (mEdgeTopologyIsUpToDate)
+    {
+        mEdgeTopology.UpdateElements(*this, rElementsContainingNodes);
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -49,6 +49,7 @@ class VertexMeshWriter;
 #include <boost/serialization/split_member.hpp>
 
 #include "VertexMesh.hpp"
+#include "VertexMeshEdgeTopology.hpp"
 #include "RandomNumberGenerator.hpp"
 
 /**
@@ -100,6 +101,19 @@ protected:
     /** Indices of elements that have been deleted. These indices can be reused when adding new elements. */
     std::vector<unsigned> mDeletedElementIndices;
 
+    /**
+     * The edges of the mesh and the elements on either side of each, used when checking for and
+     * performing swaps. Computed once per call to ReMesh() and updated by PerformT1Swap(); any
+     * other swap marks it as out of date, so that it is recomputed before it is next used. Not archived.
+     */
+    VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM> mEdgeTopology;
+
+    /**
+     * Whether mEdgeTopology is being kept up to date with the elements of the mesh. This is only
+     * the case while ReMesh() checks for swaps from short edges. Not archived.
+     */
+    bool mEdgeTopologyIsUpToDate;
+
     /**
      * Distance for T3 swap checking. At each time step we check for each boundary node whether
      * it intersects with any boundary elements (cells) whose centroids lie within this distance
@@ -150,6 +164,10 @@ protected:
      * call IdentifySwapType(), which in turn implements the appropriate local remeshing operation
      * (a T1 swap, void removal, or node merge).
      *
+     * The elements are looped over in turn, and each edge is checked once, from the element with the
+     * lowest index containing it, using mEdgeTopology to find the element on the other side of it. The
+     * edges are recomputed here only if mEdgeTopology is out of date.
+     *
      * @return whether we need to check for, and implement, any further local remeshing operations
      *                   (true if any swaps are performed).
      */
@@ -165,12 +183,31 @@ protected:
      */
     bool CheckForIntersections();
 
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Find, for each node, the elements whose bounding boxes contain it, by binning the element
+     * bounding boxes into a uniform grid. Any element that includes a node (in the sense of
+     * ElementIncludesPoint()) is among that node's candidates, so each node need only be tested
+     * against nearby elements rather than against every element (see #2401).
+     *
+     * As in ElementIncludesPoint(), each bounding box is computed relative to the first node of
+     * the element using GetVectorFromAtoB(), and points are mapped into a single copy of the domain
+     * relative to a reference node, so that periodic meshes are handled.
+     *
+     * @param rCandidateElements filled with the candidate element indices for each node index,
+     *     in increasing order
+     */
+    void GetCandidateElementsForIntersections(std::vector<std::vector<unsigned> >& rCandidateElements);
+
     /**
      * Helper method for ReMesh(), called by CheckForSwapsFromShortEdges() when
      * neighbouring nodes in an element have been found to be closer than the mCellRearrangementThreshold
      * and do not share any triangular elements.
      *
      * Identify the type of local remeshing operation required (T1 swap, void removal, or node merge).
+     * The elements containing either node are found from the edges of each node in mEdgeTopology,
+     * which is recomputed first if it is out of date.
      *
      * @param pNodeA one of the nodes to perform the swap with
      * @param pNodeB the other node to perform the swap
@@ -198,6 +235,10 @@ protected:
      * is the perpendicular bisector of the previous shared edge, and 'just larger' (by a
      * factor mCellRearrangementRatio) than mThresholdDistance.
      *
+     * The elements containing both nodes are those on either side of the edge joining them in
+     * mEdgeTopology, which is recomputed first if it is out of date, and otherwise updated
+     * for the elements involved once the swap is complete.
+     *
      * @param pNodeA one of the nodes to perform the swap with
      * @param pNodeB the other node to perform the swap
      * @param rElementsContainingNodes set of common elements
@@ -410,22 +410,23 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetEdgeLength(unsigned elementIndex1,
 {
     assert(SPACE_DIM == 2);    // LCOV_EXCL_LINE - code will be removed at compile time
 
-    std::set<unsigned> node_indices_1;
-    for (unsigned i=0; i<mElements[elementIndex1]->GetNumNodes(); i++)
+    // Elements have few nodes, so compare them pairwise rather than building sets
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element_1 = mElements[elementIndex1];
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element_2 = mElements[elementIndex2];
+    std::vector<unsigned> shared_nodes;
+    for (unsigned i=0; i<p_element_1->GetNumNodes(); i++)
     {
-        node_indices_1.insert(mElements[elementIndex1]->GetNodeGlobalIndex(i));
-    }
-    std::set<unsigned> node_indices_2;
-    for (unsigned i=0; i<mElements[elementIndex2]->GetNumNodes(); i++)
-    {
-        node_indices_2.insert(mElements[elementIndex2]->GetNodeGlobalIndex(i));
+        unsigned node_index = p_element_1->GetNodeGlobalIndex(i);
+        for (unsigned j=0; j<p_element_2->GetNumNodes(); j++)
+        {
+            if (p_element_2->GetNodeGlobalIndex(j) == node_index)
+            {
+                shared_nodes.push_back(node_index);
+                break;
+            }
+        }
     }
 
-    std::set<unsigned> shared_nodes;
-    std::set_intersection(node_indices_1.begin(), node_indices_1.end(),
-                          node_indices_2.begin(), node_indices_2.end(),
-                          std::inserter(shared_nodes, shared_nodes.begin()));
-
     if (shared_nodes.size() == 1)
     {
         // It's possible that these two elements are actually infinite but are on the edge of the domain
@@ -433,8 +434,8 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetEdgeLength(unsigned elementIndex1,
     }
     assert(shared_nodes.size() == 2);
 
-    unsigned index1 = *(shared_nodes.begin());
-    unsigned index2 = *(++(shared_nodes.begin()));
+    unsigned index1 = std::min(shared_nodes[0], shared_nodes[1]);
+    unsigned index2 = std::max(shared_nodes[0], shared_nodes[1]);
 
     double edge_length = this->GetDistanceBetweenNodes(index1, index2);
     return edge_length;
@@ -594,6 +595,233 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
     this->mNodes.clear();
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateVoronoiTessellation()
+{
+    assert(ELEMENT_DIM == 2 && SPACE_DIM == 2);    // LCOV_EXCL_LINE - code will be removed at compile time
+    assert(mpDelaunayMesh != nullptr);
+
+    unsigned num_elements = mpDelaunayMesh->GetNumAllNodes();
+    unsigned num_nodes = mpDelaunayMesh->GetNumAllElements();
+    unsigned old_num_elements = mElements.size();
+    unsigned old_num_nodes = this->mNodes.size();
+
+    /*
+     * Move each node to the circumcentre of the corresponding Delaunay element,
+     * creating nodes for any new Delaunay elements. Surplus nodes are deleted
+     * once the elements containing them have been removed.
+     */
+    c_matrix<double, SPACE_DIM, ELEMENT_DIM> jacobian;
+    c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
+    double jacobian_det;
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        mpDelaunayMesh->GetInverseJacobianForElement(i, jacobian, jacobian_det, inverse_jacobian);
+        c_vector<double, SPACE_DIM+1> circumsphere = mpDelaunayMesh->GetElement(i)->CalculateCircumsphere(jacobian, inverse_jacobian);
+
+        c_vector<double, SPACE_DIM> circumcentre;
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            circumcentre(j) = circumsphere(j);
+        }
+
+        if (i < old_num_nodes)
+        {
+            this->mNodes[i]->rGetModifiableLocation() = circumcentre;
+        }
+        else
+        {
+            this->mNodes.push_back(new Node<SPACE_DIM>(i, circumcentre));
+        }
+    }
+
+    // Match each Delaunay node with an existing element where possible
+    std::vector<unsigned> old_element_indices(num_elements, UINT_MAX);
+    std::vector<bool> is_reused(old_num_elements, false);
+    std::vector<std::vector<unsigned> > new_element_node_indices(num_elements);
+    std::vector<std::pair<double, unsigned> > index_angle_list;
+    std::vector<unsigned> candidates;
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        Node<SPACE_DIM>* p_delaunay_node = mpDelaunayMesh->GetNode(elem_index);
+        c_vector<double, SPACE_DIM> vectorA = p_delaunay_node->rGetLocation();
+        const std::set<unsigned>& r_containing_elements = p_delaunay_node->rGetContainingElementIndices();
+
+        /*
+         * Usually the element with the same index is still correct, which can be checked
+         * without sorting: each of its nodes must correspond to a different Delaunay element
+         * containing this Delaunay node, and their angles must already be strictly increasing.
+         */
+        if (elem_index < old_num_elements && !is_reused[elem_index]
+            && mElements[elem_index]->GetNumNodes() == r_containing_elements.size())
+        {
+            VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = mElements[elem_index];
+            bool is_up_to_date = true;
+            double previous_angle = -DBL_MAX;
+            for (unsigned local_index=0; is_up_to_date && local_index<p_element->GetNumNodes(); local_index++)
+            {
+                unsigned delaunay_elem_index = p_element->GetNodeGlobalIndex(local_index);
+                if (delaunay_elem_index >= num_nodes)
+                {
+                    is_up_to_date = false;
+                }
+                else
+                {
+                    Element<ELEMENT_DIM, SPACE_DIM>* p_delaunay_element = mpDelaunayMesh->GetElement(delaunay_elem_index);
+                    is_up_to_date = (p_delaunay_element->GetNodeGlobalIndex(0) == elem_index
+                                     || p_delaunay_element->GetNodeGlobalIndex(1) == elem_index
+                                     || p_delaunay_element->GetNodeGlobalIndex(2) == elem_index);
+
+                    c_vector<double, SPACE_DIM> centre_to_vertex = mpDelaunayMesh->GetVectorFromAtoB(vectorA, p_element->GetNodeLocation(local_index));
+                    double angle = atan2(centre_to_vertex(1), centre_to_vertex(0));
+                    is_up_to_date = is_up_to_date && (angle > previous_angle);
+                    previous_angle = angle;
+                }
+            }
+            if (is_up_to_date)
+            {
+                old_element_indices[elem_index] = elem_index;
+                is_reused[elem_index] = true;
+                continue;
+            }
+        }
+
+        // Otherwise order the Delaunay elements containing this node by angle, as in the 'Voronoi' constructor
+        index_angle_list.clear();
+        for (std::set<unsigned>::const_iterator iter = r_containing_elements.begin();
+             iter != r_containing_elements.end();
+             ++iter)
+        {
+            c_vector<double, SPACE_DIM> centre_to_vertex = mpDelaunayMesh->GetVectorFromAtoB(vectorA, this->mNodes[*iter]->rGetLocation());
+            double angle = atan2(centre_to_vertex(1), centre_to_vertex(0));
+            index_angle_list.push_back(std::pair<double, unsigned>(angle, *iter));
+        }
+        sort(index_angle_list.begin(), index_angle_list.end());
+
+        /*
+         * Look for an existing element with exactly these nodes in this order. Since
+         * deleting Delaunay nodes shifts the indices of later nodes, such an element
+         * may previously have had another index; any element containing the first
+         * node is a candidate. The node sets are left untouched until every element
+         * has been matched.
+         */
+        candidates.clear();
+        if (elem_index < old_num_elements)
+        {
+            candidates.push_back(elem_index);
+        }
+        if (!index_angle_list.empty() && index_angle_list[0].second < old_num_nodes)
+        {
+            const std::set<unsigned>& r_node_elements = this->mNodes[index_angle_list[0].second]->rGetContainingElementIndices();
+            candidates.insert(candidates.end(), r_node_elements.begin(), r_node_elements.end());
+        }
+
+        for (unsigned i=0; i<candidates.size(); i++)
+        {
+            VertexElement<ELEMENT_DIM, SPACE_DIM>* p_candidate = mElements[candidates[i]];
+            bool is_match = !is_reused[candidates[i]] && p_candidate->GetNumNodes() == index_angle_list.size();
+            for (unsigned local_index=0; is_match && local_index<index_angle_list.size(); local_index++)
+            {
+                is_match = (p_candidate->GetNodeGlobalIndex(local_index) == index_angle_list[local_index].second);
+            }
+            if (is_match)
+            {
+                old_element_indices[elem_index] = candidates[i];
+                is_reused[candidates[i]] = true;
+                break;
+            }
+        }
+
+        if (old_element_indices[elem_index] == UINT_MAX)
+        {
+            for (unsigned count=0; count<index_angle_list.size(); count++)
+            {
+                new_element_node_indices[elem_index].push_back(index_angle_list[count].second);
+            }
+        }
+    }
+
+    // Delete any elements that have not been matched
+    for (unsigned old_index=0; old_index<old_num_elements; old_index++)
+    {
+        if (!is_reused[old_index])
+        {
+            for (unsigned local_index=0; local_index<mElements[old_index]->GetNumNodes(); local_index++)
+            {
+                mElements[old_index]->GetNode(local_index)->RemoveElement(old_index);
+            }
+            delete mElements[old_index];
+        }
+    }
+
+    /*
+     * Give each matched element its new index. No node may ever have two elements
+     * registered with the same index, so if the new index is still in use by an
+     * element that has yet to move, go via an index that no other element can have.
+     */
+    unsigned temporary_index_offset = std::max(old_num_elements, num_elements);
+    std::vector<bool> is_index_in_use(is_reused);
+    is_index_in_use.resize(temporary_index_offset, false);
+    std::vector<unsigned> deferred_elem_indices;
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        unsigned old_index = old_element_indices[elem_index];
+        if (old_index != UINT_MAX && old_index != elem_index)
+        {
+            is_index_in_use[old_index] = false;
+            if (is_index_in_use[elem_index])
+            {
+                mElements[old_index]->ResetIndex(temporary_index_offset + old_index);
+                deferred_elem_indices.push_back(elem_index);
+            }
+            else
+            {
+                mElements[old_index]->ResetIndex(elem_index);
+                is_index_in_use[elem_index] = true;
+            }
+        }
+    }
+    for (unsigned i=0; i<deferred_elem_indices.size(); i++)
+    {
+        mElements[old_element_indices[deferred_elem_indices[i]]]->ResetIndex(deferred_elem_indices[i]);
+    }
+
+    std::vector<VertexElement<ELEMENT_DIM, SPACE_DIM>*> new_elements(num_elements);
+    unsigned num_recreated = 0;
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        unsigned old_index = old_element_indices[elem_index];
+        if (old_index == UINT_MAX)
+        {
+            std::vector<Node<SPACE_DIM>*> element_nodes;
+            for (unsigned count=0; count<new_element_node_indices[elem_index].size(); count++)
+            {
+                element_nodes.push_back(this->mNodes[new_element_node_indices[elem_index][count]]);
+            }
+            new_elements[elem_index] = new VertexElement<ELEMENT_DIM, SPACE_DIM>(elem_index, element_nodes);
+            num_recreated++;
+        }
+        else
+        {
+            new_elements[elem_index] = mElements[old_index];
+        }
+    }
+    mElements.swap(new_elements);
+
+    // Any surplus nodes are no longer in any element
+    for (unsigned i=num_nodes; i<old_num_nodes; i++)
+    {
+        assert(this->mNodes[i]->GetNumContainingElements() == 0);
+        delete this->mNodes[i];
+    }
+    if (old_num_nodes > num_nodes)
+    {
+        this->mNodes.resize(num_nodes);
+    }
+
+    return num_recreated;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNumNodes() const
 {
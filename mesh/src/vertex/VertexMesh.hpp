@@ -339,6 +339,21 @@ public:
      */
     virtual void Clear();
 
+    /**
+     * Bring a Voronoi tessellation, created using the 2D 'Voronoi' constructor,
+     * up to date after its Delaunay mesh has moved or been remeshed.
+     *
+     * Every node is moved to the circumcentre of the corresponding Delaunay
+     * element, but an element is only recreated if the Delaunay elements
+     * containing its Delaunay node, or their order about that node, have
+     * changed; elements whose Delaunay node has only been renumbered are
+     * kept and given their new index. The result is the same as constructing
+     * the tessellation afresh.
+     *
+     * @return the number of elements that were recreated
+     */
+    unsigned UpdateVoronoiTessellation();
+
     /**
      * @return the global index of the corresponding element in the Delaunay mesh,
      * given the global index of an element in the Voronoi mesh.
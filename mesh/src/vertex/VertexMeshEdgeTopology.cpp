@@ -0,0 +1,369 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "VertexMeshEdgeTopology.hpp"
+
+#include <algorithm>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::Update(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
+{
+    const unsigned num_elements = rMesh.GetNumAllElements();
+    const unsigned num_nodes = rMesh.GetNumAllNodes();
+
+    // Lay out the corners of each element contiguously, and make room for the edges of each node
+    mFirstCornerIndices.resize(num_elements);
+    mNumCornersOfElements.assign(num_elements, 0);
+    mNodeEdgeCapacities.assign(num_nodes, 0);
+    unsigned num_corners = 0;
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        mFirstCornerIndices[elem_index] = num_corners;
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = rMesh.GetElement(elem_index);
+        if (!p_element->IsDeleted())
+        {
+            unsigned num_nodes_elem = p_element->GetNumNodes();
+            for (unsigned local_index=0; local_index<num_nodes_elem; local_index++)
+            {
+                // Each edge of a node starts or ends at one of the corners at that node
+                mNodeEdgeCapacities[p_element->GetNodeGlobalIndex(local_index)] += 2;
+            }
+            mNumCornersOfElements[elem_index] = num_nodes_elem;
+            num_corners += num_nodes_elem;
+        }
+    }
+    mFirstNodeEdgeIndices.resize(num_nodes);
+    unsigned num_node_edges = 0;
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mFirstNodeEdgeIndices[node_index] = num_node_edges;
+        num_node_edges += mNodeEdgeCapacities[node_index];
+    }
+
+    mCornerEdgeIndices.resize(num_corners);
+    mNumNodeEdges.assign(num_nodes, 0);
+    mNodeEdgeIndices.resize(num_node_edges);
+    mEdgeNodeIndices.clear();
+    mEdgeElementIndices.clear();
+
+    // Visit each corner in turn, creating its edge if this has not already been reached from another element
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = rMesh.GetElement(elem_index);
+        if (p_element->IsDeleted())
+        {
+            continue;
+        }
+
+        unsigned num_nodes_elem = p_element->GetNumNodes();
+        for (unsigned local_index=0; local_index<num_nodes_elem; local_index++)
+        {
+            unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+            unsigned next_node_index = p_element->GetNodeGlobalIndex((local_index+1)%num_nodes_elem);
+
+            unsigned edge_index = FindEdge(node_index, next_node_index);
+            if (edge_index == UNSIGNED_UNSET)
+            {
+                edge_index = AddEdge(node_index, next_node_index, elem_index);
+            }
+            else if (mEdgeElementIndices[2*edge_index] != elem_index)
+            {
+                // In a valid mesh each edge is contained in at most two elements
+                assert(mEdgeElementIndices[2*edge_index + 1] == UNSIGNED_UNSET);
+                mEdgeElementIndices[2*edge_index + 1] = elem_index;
+            }
+            mCornerEdgeIndices[mFirstCornerIndices[elem_index] + local_index] = edge_index;
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::UpdateElements(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                                                                    const std::set<unsigned>& rElementIndices)
+{
+    // Make room for any new elements and nodes, which have no corners or edges as yet
+    const unsigned num_elements = rMesh.GetNumAllElements();
+    const unsigned num_nodes = rMesh.GetNumAllNodes();
+    mFirstCornerIndices.resize(num_elements, 0);
+    mNumCornersOfElements.resize(num_elements, 0);
+    mFirstNodeEdgeIndices.resize(num_nodes, 0);
+    mNodeEdgeCapacities.resize(num_nodes, 0);
+    mNumNodeEdges.resize(num_nodes, 0);
+
+    // Remove the elements from their old edges, noting any edges that are left in no element
+    std::set<unsigned> unused_edges;
+    for (std::set<unsigned>::const_iterator it = rElementIndices.begin(); it != rElementIndices.end(); ++it)
+    {
+        for (unsigned local_index=0; local_index<mNumCornersOfElements[*it]; local_index++)
+        {
+            unsigned edge_index = mCornerEdgeIndices[mFirstCornerIndices[*it] + local_index];
+            if (mEdgeElementIndices[2*edge_index] == *it)
+            {
+                mEdgeElementIndices[2*edge_index] = mEdgeElementIndices[2*edge_index + 1];
+            }
+            else if (mEdgeElementIndices[2*edge_index + 1] != *it)
+            {
+                // This edge has already been removed from the element
+                continue;
+            }
+            mEdgeElementIndices[2*edge_index + 1] = UNSIGNED_UNSET;
+
+            if (mEdgeElementIndices[2*edge_index] == UNSIGNED_UNSET)
+            {
+                unused_edges.insert(edge_index);
+            }
+        }
+    }
+
+    // Remove unused edges from the highest index down, so that no edge that is moved is itself to be removed
+    for (std::set<unsigned>::reverse_iterator it = unused_edges.rbegin(); it != unused_edges.rend(); ++it)
+    {
+        RemoveEdge(*it);
+    }
+
+    // Add the elements to their new edges, creating any edges that do not yet exist
+    for (std::set<unsigned>::const_iterator it = rElementIndices.begin(); it != rElementIndices.end(); ++it)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = rMesh.GetElement(*it);
+        unsigned num_nodes_elem = p_element->IsDeleted() ? 0 : p_element->GetNumNodes();
+
+        // If the element has gained corners, move them to the end of mCornerEdgeIndices
+        if (num_nodes_elem > mNumCornersOfElements[*it])
+        {
+            mFirstCornerIndices[*it] = mCornerEdgeIndices.size();
+            mCornerEdgeIndices.resize(mCornerEdgeIndices.size() + num_nodes_elem);
+        }
+        mNumCornersOfElements[*it] = num_nodes_elem;
+
+        for (unsigned local_index=0; local_index<num_nodes_elem; local_index++)
+        {
+            unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+            unsigned next_node_index = p_element->GetNodeGlobalIndex((local_index+1)%num_nodes_elem);
+
+            unsigned edge_index = FindEdge(node_index, next_node_index);
+            if (edge_index == UNSIGNED_UNSET)
+            {
+                edge_index = AddEdge(node_index, next_node_index, *it);
+            }
+            else if (mEdgeElementIndices[2*edge_index] != *it)
+            {
+                assert(mEdgeElementIndices[2*edge_index + 1] == UNSIGNED_UNSET);
+                mEdgeElementIndices[2*edge_index + 1] = *it;
+            }
+            mCornerEdgeIndices[mFirstCornerIndices[*it] + local_index] = edge_index;
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::AddEdge(unsigned nodeIndexA, unsigned nodeIndexB, unsigned elemIndex)
+{
+    unsigned edge_index = GetNumEdges();
+    mEdgeNodeIndices.push_back(nodeIndexA);
+    mEdgeNodeIndices.push_back(nodeIndexB);
+    mEdgeElementIndices.push_back(elemIndex);
+    mEdgeElementIndices.push_back(UNSIGNED_UNSET);
+
+    AddNodeEdge(nodeIndexA, edge_index);
+    AddNodeEdge(nodeIndexB, edge_index);
+    return edge_index;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::AddNodeEdge(unsigned nodeIndex, unsigned edgeIndex)
+{
+    if (mNumNodeEdges[nodeIndex] == mNodeEdgeCapacities[nodeIndex])
+    {
+        unsigned first_node_edge_index = mNodeEdgeIndices.size();
+        mNodeEdgeCapacities[nodeIndex] = std::max(2*mNodeEdgeCapacities[nodeIndex], 4u);
+        mNodeEdgeIndices.resize(first_node_edge_index + mNodeEdgeCapacities[nodeIndex]);
+        std::copy(mNodeEdgeIndices.begin() + mFirstNodeEdgeIndices[nodeIndex],
+                  mNodeEdgeIndices.begin() + mFirstNodeEdgeIndices[nodeIndex] + mNumNodeEdges[nodeIndex],
+                  mNodeEdgeIndices.begin() + first_node_edge_index);
+        mFirstNodeEdgeIndices[nodeIndex] = first_node_edge_index;
+    }
+    mNodeEdgeIndices[mFirstNodeEdgeIndices[nodeIndex] + mNumNodeEdges[nodeIndex]++] = edgeIndex;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::ReplaceNodeEdge(unsigned nodeIndex, unsigned edgeIndex, unsigned newEdgeIndex)
+{
+    unsigned* p_node_edges = &mNodeEdgeIndices[mFirstNodeEdgeIndices[nodeIndex]];
+    unsigned i = std::find(p_node_edges, p_node_edges + mNumNodeEdges[nodeIndex], edgeIndex) - p_node_edges;
+    assert(i < mNumNodeEdges[nodeIndex]);
+
+    if (newEdgeIndex == UNSIGNED_UNSET)
+    {
+        p_node_edges[i] = p_node_edges[--mNumNodeEdges[nodeIndex]];
+    }
+    else
+    {
+        p_node_edges[i] = newEdgeIndex;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::RemoveEdge(unsigned edgeIndex)
+{
+    assert(mEdgeElementIndices[2*edgeIndex] == UNSIGNED_UNSET);
+    ReplaceNodeEdge(mEdgeNodeIndices[2*edgeIndex], edgeIndex, UNSIGNED_UNSET);
+    ReplaceNodeEdge(mEdgeNodeIndices[2*edgeIndex + 1], edgeIndex, UNSIGNED_UNSET);
+
+    unsigned last_edge_index = GetNumEdges() - 1;
+    if (edgeIndex != last_edge_index)
+    {
+        // Renumber the last edge wherever it appears: at its nodes, and at its corners in the elements containing it
+        for (unsigned i=0; i<2; i++)
+        {
+            mEdgeNodeIndices[2*edgeIndex + i] = mEdgeNodeIndices[2*last_edge_index + i];
+            ReplaceNodeEdge(mEdgeNodeIndices[2*edgeIndex + i], last_edge_index, edgeIndex);
+
+            unsigned elem_index = mEdgeElementIndices[2*last_edge_index + i];
+            mEdgeElementIndices[2*edgeIndex + i] = elem_index;
+            if (elem_index != UNSIGNED_UNSET)
+            {
+                std::vector<unsigned>::iterator first_corner = mCornerEdgeIndices.begin() + mFirstCornerIndices[elem_index];
+                std::replace(first_corner, first_corner + mNumCornersOfElements[elem_index], last_edge_index, edgeIndex);
+            }
+        }
+    }
+    mEdgeNodeIndices.resize(2*last_edge_index);
+    mEdgeElementIndices.resize(2*last_edge_index);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetNumEdges() const
+{
+    return mEdgeNodeIndices.size()/2;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetEdgeNodeIndex(unsigned edgeIndex, unsigned i) const
+{
+    assert(edgeIndex < GetNumEdges());
+    assert(i < 2);
+    return mEdgeNodeIndices[2*edgeIndex + i];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetEdgeElementIndex(unsigned edgeIndex, unsigned i) const
+{
+    assert(edgeIndex < GetNumEdges());
+    assert(i < 2);
+    return mEdgeElementIndices[2*edgeIndex + i];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::IsBoundaryEdge(unsigned edgeIndex) const
+{
+    return GetEdgeElementIndex(edgeIndex, 1) == UNSIGNED_UNSET;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetNumCorners() const
+{
+    return mCornerEdgeIndices.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetNumCornersOfElement(unsigned elemIndex) const
+{
+    assert(elemIndex < mNumCornersOfElements.size());
+    return mNumCornersOfElements[elemIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetCornerIndex(unsigned elemIndex, unsigned localIndex) const
+{
+    assert(localIndex < GetNumCornersOfElement(elemIndex));
+    return mFirstCornerIndices[elemIndex] + localIndex;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetEdgeIndex(unsigned elemIndex, unsigned localIndex) const
+{
+    return mCornerEdgeIndices[GetCornerIndex(elemIndex, localIndex)];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetNeighbouringElementIndex(unsigned elemIndex, unsigned localIndex) const
+{
+    unsigned edge_index = GetEdgeIndex(elemIndex, localIndex);
+    if (mEdgeElementIndices[2*edge_index] == elemIndex)
+    {
+        return mEdgeElementIndices[2*edge_index + 1];
+    }
+    else
+    {
+        return mEdgeElementIndices[2*edge_index];
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetNumEdgesOfNode(unsigned nodeIndex) const
+{
+    assert(nodeIndex < mNumNodeEdges.size());
+    return mNumNodeEdges[nodeIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::GetNodeEdgeIndex(unsigned nodeIndex, unsigned i) const
+{
+    assert(i < GetNumEdgesOfNode(nodeIndex));
+    return mNodeEdgeIndices[mFirstNodeEdgeIndices[nodeIndex] + i];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMeshEdgeTopology<ELEMENT_DIM, SPACE_DIM>::FindEdge(unsigned nodeIndexA, unsigned nodeIndexB) const
+{
+    assert(nodeIndexA < mNumNodeEdges.size());
+    for (unsigned i=0; i<mNumNodeEdges[nodeIndexA]; i++)
+    {
+        unsigned edge_index = mNodeEdgeIndices[mFirstNodeEdgeIndices[nodeIndexA] + i];
+        if (mEdgeNodeIndices[2*edge_index] == nodeIndexB || mEdgeNodeIndices[2*edge_index + 1] == nodeIndexB)
+        {
+            return edge_index;
+        }
+    }
+    return UNSIGNED_UNSET;
+}
+
+// Explicit instantiation
+template class VertexMeshEdgeTopology<1,1>;
+template class VertexMeshEdgeTopology<1,2>;
+template class VertexMeshEdgeTopology<1,3>;
+template class VertexMeshEdgeTopology<2,2>;
+template class VertexMeshEdgeTopology<2,3>;
+template class VertexMeshEdgeTopology<3,3>;
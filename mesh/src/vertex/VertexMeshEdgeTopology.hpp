@@ -0,0 +1,241 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef VERTEXMESHEDGETOPOLOGY_HPP_
+#define VERTEXMESHEDGETOPOLOGY_HPP_
+
+#include <set>
+#include <vector>
+#include "VertexMesh.hpp"
+
+/**
+ * The edges of a 2D vertex mesh, stored in flat arrays alongside its elements.
+ *
+ * A VertexMesh records its topology only through the node lists of its elements and the
+ * sets of elements containing each node, so finding the elements on either side of an edge
+ * involves intersecting two sets. This class lists each edge once, together with the (one or
+ * two) elements containing it, so that the following queries take constant time:
+ *  - the edge from any node of an element to the next node (see GetEdgeIndex());
+ *  - the elements containing an edge, and hence the neighbour of an element across each of
+ *    its edges (see GetNeighbouringElementIndex());
+ *  - the edge, if any, joining two given nodes (see FindEdge(), which only searches the
+ *    edges of one node).
+ *
+ * Each (element, local node index) pair is called a corner, as in VertexMeshGeometryCache;
+ * the corners of each element are contiguous and in the element's node order. Update() numbers
+ * the edges in the order in which they are first reached by looping over the nodes of each
+ * element in turn, and stores the nodes of each edge in that order.
+ *
+ * The topology is not updated automatically. Update() recomputes it for the whole mesh, while
+ * UpdateElements() only revisits the edges of elements changed by a local operation such as a
+ * T1 swap, so that MutableVertexMesh can keep the edges up to date while remeshing. Edge and
+ * corner indices are not preserved by UpdateElements().
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VertexMeshEdgeTopology
+{
+private:
+
+    /** The global indices of the two nodes of each edge, stored consecutively. */
+    std::vector<unsigned> mEdgeNodeIndices;
+
+    /**
+     * The indices of the elements containing each edge, stored consecutively. The
+     * second entry is UNSIGNED_UNSET if the edge is on the boundary of the mesh.
+     */
+    std::vector<unsigned> mEdgeElementIndices;
+
+    /** The corner index of the first node of each element, indexed by element index. */
+    std::vector<unsigned> mFirstCornerIndices;
+
+    /** The number of corners of each element, indexed by element index (zero for deleted elements). */
+    std::vector<unsigned> mNumCornersOfElements;
+
+    /** The index of the edge from the node at each corner to the next node in its element. */
+    std::vector<unsigned> mCornerEdgeIndices;
+
+    /**
+     * The position in mNodeEdgeIndices of the first edge of each node, indexed by node index.
+     * Update() gives each node room for two edges per corner at that node.
+     */
+    std::vector<unsigned> mFirstNodeEdgeIndices;
+
+    /** The number of edges for which each node has room in mNodeEdgeIndices, indexed by node index. */
+    std::vector<unsigned> mNodeEdgeCapacities;
+
+    /** The number of edges of each node, indexed by node index. */
+    std::vector<unsigned> mNumNodeEdges;
+
+    /** The indices of the edges of each node (see mFirstNodeEdgeIndices). */
+    std::vector<unsigned> mNodeEdgeIndices;
+
+    /**
+     * Create an edge contained in a single element and list it at both of its nodes.
+     *
+     * @param nodeIndexA the global index of the first node of the edge
+     * @param nodeIndexB the global index of the second node of the edge
+     * @param elemIndex the index of the element containing the edge
+     * @return the index of the new edge
+     */
+    unsigned AddEdge(unsigned nodeIndexA, unsigned nodeIndexB, unsigned elemIndex);
+
+    /**
+     * Add an edge to the list of edges of a node, moving the list to the end of
+     * mNodeEdgeIndices if it is full.
+     *
+     * @param nodeIndex the global index of the node
+     * @param edgeIndex the index of the edge
+     */
+    void AddNodeEdge(unsigned nodeIndex, unsigned edgeIndex);
+
+    /**
+     * Replace an edge in the list of edges of a node by another edge, or remove it
+     * from the list if the other edge is UNSIGNED_UNSET.
+     *
+     * @param nodeIndex the global index of the node
+     * @param edgeIndex the index of the edge to replace
+     * @param newEdgeIndex the index of the edge replacing it, or UNSIGNED_UNSET
+     */
+    void ReplaceNodeEdge(unsigned nodeIndex, unsigned edgeIndex, unsigned newEdgeIndex);
+
+    /**
+     * Remove an edge that is no longer contained in any element, by moving the last
+     * edge into its place.
+     *
+     * @param edgeIndex the index of the edge
+     */
+    void RemoveEdge(unsigned edgeIndex);
+
+public:
+
+    /**
+     * Recompute the edges of a mesh.
+     *
+     * @param rMesh the mesh
+     */
+    void Update(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh);
+
+    /**
+     * Update the edges of some elements of a mesh, for example those changed by a T1 swap.
+     * Any other element must be unchanged since Update() or UpdateElements() was last called,
+     * and the indices of existing nodes must be unchanged. New elements and nodes are allowed.
+     *
+     * @param rMesh the mesh
+     * @param rElementIndices the indices of the elements that may have changed
+     */
+    void UpdateElements(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh, const std::set<unsigned>& rElementIndices);
+
+    /**
+     * @return the number of edges
+     */
+    unsigned GetNumEdges() const;
+
+    /**
+     * @param edgeIndex the index of an edge
+     * @param i 0 or 1
+     * @return the global index of node i of the edge
+     */
+    unsigned GetEdgeNodeIndex(unsigned edgeIndex, unsigned i) const;
+
+    /**
+     * @param edgeIndex the index of an edge
+     * @param i 0 or 1
+     * @return the index of element i containing the edge, or UNSIGNED_UNSET if i is 1
+     *     and the edge is on the boundary of the mesh
+     */
+    unsigned GetEdgeElementIndex(unsigned edgeIndex, unsigned i) const;
+
+    /**
+     * @param edgeIndex the index of an edge
+     * @return whether the edge is contained in only one element
+     */
+    bool IsBoundaryEdge(unsigned edgeIndex) const;
+
+    /**
+     * @return the number of corner indices, which after UpdateElements() may include
+     *     some that no longer belong to any element
+     */
+    unsigned GetNumCorners() const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @return the number of corners (that is, nodes and edges) of the element
+     */
+    unsigned GetNumCornersOfElement(unsigned elemIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @param localIndex the local index of a node in the element
+     * @return the index of the corresponding corner
+     */
+    unsigned GetCornerIndex(unsigned elemIndex, unsigned localIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @param localIndex the local index of a node in the element
+     * @return the index of the edge from this node to the next node in the element
+     */
+    unsigned GetEdgeIndex(unsigned elemIndex, unsigned localIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @param localIndex the local index of a node in the element
+     * @return the index of the other element containing the edge from this node to the next
+     *     node in the element, or UNSIGNED_UNSET if this edge is on the boundary of the mesh
+     */
+    unsigned GetNeighbouringElementIndex(unsigned elemIndex, unsigned localIndex) const;
+
+    /**
+     * @param nodeIndex the global index of a node
+     * @return the number of edges of the node
+     */
+    unsigned GetNumEdgesOfNode(unsigned nodeIndex) const;
+
+    /**
+     * @param nodeIndex the global index of a node
+     * @param i a number less than GetNumEdgesOfNode(nodeIndex)
+     * @return the index of edge i of the node
+     */
+    unsigned GetNodeEdgeIndex(unsigned nodeIndex, unsigned i) const;
+
+    /**
+     * @param nodeIndexA the global index of one node
+     * @param nodeIndexB the global index of another node
+     * @return the index of the edge joining the nodes, or UNSIGNED_UNSET if there is none
+     */
+    unsigned FindEdge(unsigned nodeIndexA, unsigned nodeIndexB) const;
+};
+
+#endif /*VERTEXMESHEDGETOPOLOGY_HPP_*/
@@ -0,0 +1,278 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "VertexMeshGeometryCache.hpp"
+#include "Exception.hpp"
+#include "ThreadTools.hpp"
+
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif
+
+template<unsigned DIM>
+VertexMeshGeometryCache<DIM>::VertexMeshGeometryCache()
+    : mNumThreads(1u),
+      mIsUpToDate(false)
+{
+}
+
+template<unsigned DIM>
+void VertexMeshGeometryCache<DIM>::SetNumberOfThreads(unsigned numThreads)
+{
+    ThreadTools::CheckNumberOfThreads(numThreads, "element geometry cannot be calculated");
+    mNumThreads = numThreads;
+}
+
+template<unsigned DIM>
+unsigned VertexMeshGeometryCache<DIM>::GetNumberOfThreads() const
+{
+    return mNumThreads;
+}
+
+template<unsigned DIM>
+void VertexMeshGeometryCache<DIM>::Update(VertexMesh<DIM, DIM>& rMesh)
+{
+    assert(DIM == 2);    // LCOV_EXCL_LINE - code will be removed at compile time
+
+    // Find the edges of the mesh, which also lays out the corners of each element contiguously
+    mEdgeTopology.Update(rMesh);
+
+    const unsigned num_elements = rMesh.GetNumAllElements();
+    const unsigned num_corners = mEdgeTopology.GetNumCorners();
+
+    mElementAreas.assign(num_elements, 0.0);
+    mElementPerimeters.assign(num_elements, 0.0);
+    mCornerNodeIndices.resize(num_corners);
+    mEdgeVectors.resize(num_corners);
+    mEdgeLengths.resize(num_corners);
+    mAreaGradients.resize(num_corners);
+    mNextEdgeGradients.resize(num_corners);
+    mIsUpToDate = true;
+
+    // Each element only writes to its own entries, so the elements may be processed in any order
+#ifdef CHASTE_OPENMP
+    if (mNumThreads > 1u)
+    {
+        const int num_elements_int = num_elements;
+#pragma omp parallel for num_threads(mNumThreads) schedule(static)
+        for (int elem_index=0; elem_index<num_elements_int; elem_index++)
+        {
+            VertexElement<DIM, DIM>* p_element = rMesh.GetElement(elem_index);
+            if (!p_element->IsDeleted())
+            {
+                ComputeElementGeometry(rMesh, p_element);
+            }
+        }
+        return;
+    }
+#endif // CHASTE_OPENMP
+
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        VertexElement<DIM, DIM>* p_element = rMesh.GetElement(elem_index);
+        if (!p_element->IsDeleted())
+        {
+            ComputeElementGeometry(rMesh, p_element);
+        }
+    }
+}
+
+template<unsigned DIM>
+void VertexMeshGeometryCache<DIM>::ComputeElementGeometry(VertexMesh<DIM, DIM>& rMesh, VertexElement<DIM, DIM>* pElement)
+{
+    const unsigned elem_index = pElement->GetIndex();
+    const unsigned num_nodes = pElement->GetNumNodes();
+    const unsigned first_corner = mEdgeTopology.GetCornerIndex(elem_index, 0);
+
+    mElementAreas[elem_index] = rMesh.GetVolumeOfElement(elem_index);
+
+    double perimeter = 0.0;
+    for (unsigned local_index=0; local_index<num_nodes; local_index++)
+    {
+        const unsigned corner = first_corner + local_index;
+        const unsigned next_local_index = (local_index+1)%num_nodes;
+        const unsigned previous_local_index = (num_nodes+local_index-1)%num_nodes;
+
+        Node<DIM>* p_node = pElement->GetNode(local_index);
+        Node<DIM>* p_next_node = pElement->GetNode(next_local_index);
+        mCornerNodeIndices[corner] = p_node->GetIndex();
+
+        // The next edge, its length and the gradient of its length at this node
+        mEdgeVectors[corner] = rMesh.GetVectorFromAtoB(p_node->rGetLocation(), p_next_node->rGetLocation());
+        mEdgeLengths[corner] = norm_2(mEdgeVectors[corner]);
+        assert(mEdgeLengths[corner] > DBL_EPSILON);
+        mNextEdgeGradients[corner] = -mEdgeVectors[corner]/mEdgeLengths[corner];
+        perimeter += mEdgeLengths[corner];
+
+        // The gradient of the area at this node
+        c_vector<double, DIM> difference_vector = rMesh.GetVectorFromAtoB(pElement->GetNodeLocation(previous_local_index),
+                                                                          p_next_node->rGetLocation());
+        mAreaGradients[corner][0] = 0.5*difference_vector[1];
+        mAreaGradients[corner][1] = -0.5*difference_vector[0];
+    }
+    mElementPerimeters[elem_index] = perimeter;
+}
+
+template<unsigned DIM>
+unsigned VertexMeshGeometryCache<DIM>::GetNumAllElements() const
+{
+    return mElementAreas.size();
+}
+
+template<unsigned DIM>
+double VertexMeshGeometryCache<DIM>::GetElementArea(unsigned elemIndex) const
+{
+    assert(elemIndex < mElementAreas.size());
+    return mElementAreas[elemIndex];
+}
+
+template<unsigned DIM>
+double VertexMeshGeometryCache<DIM>::GetElementPerimeter(unsigned elemIndex) const
+{
+    assert(elemIndex < mElementPerimeters.size());
+    return mElementPerimeters[elemIndex];
+}
+
+template<unsigned DIM>
+unsigned VertexMeshGeometryCache<DIM>::GetNumCornersOfElement(unsigned elemIndex) const
+{
+    return mEdgeTopology.GetNumCornersOfElement(elemIndex);
+}
+
+template<unsigned DIM>
+unsigned VertexMeshGeometryCache<DIM>::GetCornerIndex(unsigned elemIndex, unsigned localIndex) const
+{
+    return mEdgeTopology.GetCornerIndex(elemIndex, localIndex);
+}
+
+template<unsigned DIM>
+unsigned VertexMeshGeometryCache<DIM>::GetNodeGlobalIndex(unsigned cornerIndex) const
+{
+    assert(cornerIndex < mCornerNodeIndices.size());
+    return mCornerNodeIndices[cornerIndex];
+}
+
+template<unsigned DIM>
+const c_vector<double, DIM>& VertexMeshGeometryCache<DIM>::rGetEdgeVector(unsigned cornerIndex) const
+{
+    assert(cornerIndex < mEdgeVectors.size());
+    return mEdgeVectors[cornerIndex];
+}
+
+template<unsigned DIM>
+double VertexMeshGeometryCache<DIM>::GetEdgeLength(unsigned cornerIndex) const
+{
+    assert(cornerIndex < mEdgeLengths.size());
+    return mEdgeLengths[cornerIndex];
+}
+
+template<unsigned DIM>
+const c_vector<double, DIM>& VertexMeshGeometryCache<DIM>::rGetAreaGradient(unsigned cornerIndex) const
+{
+    assert(cornerIndex < mAreaGradients.size());
+    return mAreaGradients[cornerIndex];
+}
+
+template<unsigned DIM>
+const c_vector<double, DIM>& VertexMeshGeometryCache<DIM>::rGetNextEdgeGradient(unsigned cornerIndex) const
+{
+    assert(cornerIndex < mNextEdgeGradients.size());
+    return mNextEdgeGradients[cornerIndex];
+}
+
+template<unsigned DIM>
+unsigned VertexMeshGeometryCache<DIM>::GetNeighbouringElementIndex(unsigned elemIndex, unsigned localIndex) const
+{
+    return mEdgeTopology.GetNeighbouringElementIndex(elemIndex, localIndex);
+}
+
+template<unsigned DIM>
+void VertexMeshGeometryCache<DIM>::SetOutOfDate()
+{
+    mIsUpToDate = false;
+}
+
+template<unsigned DIM>
+bool VertexMeshGeometryCache<DIM>::IsUpToDate() const
+{
+    return mIsUpToDate;
+}
+
+template<unsigned DIM>
+void VertexMeshGeometryCache<DIM>::GetElementsContainingEdge(Node<DIM>* pNodeA, Node<DIM>* pNodeB, c_vector<unsigned, 2>& rElemIndices) const
+{
+    if (mIsUpToDate)
+    {
+        unsigned edge_index = mEdgeTopology.FindEdge(pNodeA->GetIndex(), pNodeB->GetIndex());
+        assert(edge_index != UNSIGNED_UNSET);
+        rElemIndices[0] = mEdgeTopology.GetEdgeElementIndex(edge_index, 0);
+        rElemIndices[1] = mEdgeTopology.GetEdgeElementIndex(edge_index, 1);
+        return;
+    }
+
+    // Intersect the sets of containing elements, without copying them
+    rElemIndices[0] = UNSIGNED_UNSET;
+    rElemIndices[1] = UNSIGNED_UNSET;
+    unsigned num_shared_elements = 0;
+    const std::set<unsigned>& r_elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
+    const std::set<unsigned>& r_elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
+    for (std::set<unsigned>::const_iterator iter = r_elements_containing_nodeA.begin();
+         iter != r_elements_containing_nodeA.end();
+         ++iter)
+    {
+        if (r_elements_containing_nodeB.find(*iter) != r_elements_containing_nodeB.end())
+        {
+            if (num_shared_elements == 2)
+            {
+                EXCEPTION("Nodes " << pNodeA->GetIndex() << " and " << pNodeB->GetIndex() << " are shared by more than two elements, so do not form an edge of the mesh.");
+            }
+            rElemIndices[num_shared_elements++] = *iter;
+        }
+    }
+
+    // Check that the nodes have a common edge
+    assert(num_shared_elements > 0);
+}
+
+template<unsigned DIM>
+const VertexMeshEdgeTopology<DIM, DIM>& VertexMeshGeometryCache<DIM>::rGetEdgeTopology() const
+{
+    return mEdgeTopology;
+}
+
+// Explicit instantiation
+template class VertexMeshGeometryCache<1>;
+template class VertexMeshGeometryCache<2>;
+template class VertexMeshGeometryCache<3>;
@@ -0,0 +1,241 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef VERTEXMESHGEOMETRYCACHE_HPP_
+#define VERTEXMESHGEOMETRYCACHE_HPP_
+
+#include <vector>
+#include "UblasVectorInclude.hpp"
+#include "VertexMesh.hpp"
+#include "VertexMeshEdgeTopology.hpp"
+
+/**
+ * A snapshot of the geometry of the elements of a 2D vertex mesh, stored in flat arrays.
+ *
+ * Vertex-based forces such as NagaiHondaForce need the area and perimeter of every element,
+ * together with the gradients of these quantities at every vertex and whether each edge is
+ * shared with another element. Update() computes all of these in a single pass over the
+ * elements, which may be spread over several OpenMP threads, so that the forces can then
+ * look them up rather than recompute them for each containing element of each vertex.
+ *
+ * Each (element, local node index) pair is called a corner, and is given a corner index
+ * such that the corners of each element are contiguous and in the element's node order.
+ * The 'next edge' of a corner joins its node to the next node in the element. The cache
+ * is not updated automatically: Update() must be called again whenever the mesh moves,
+ * and users which hold on to a cache between updates should call SetOutOfDate() once
+ * its elements may have changed.
+ */
+template<unsigned DIM>
+class VertexMeshGeometryCache
+{
+private:
+
+    /** The number of OpenMP threads used by Update(). Defaults to 1. */
+    unsigned mNumThreads;
+
+    /** The area of each element, indexed by element index (zero for deleted elements). */
+    std::vector<double> mElementAreas;
+
+    /** The perimeter of each element, indexed by element index (zero for deleted elements). */
+    std::vector<double> mElementPerimeters;
+
+    /** The edges of the mesh, which also determine the corner indices. */
+    VertexMeshEdgeTopology<DIM, DIM> mEdgeTopology;
+
+    /** The global index of the node at each corner. */
+    std::vector<unsigned> mCornerNodeIndices;
+
+    /** The vector along the next edge of each corner, computed using GetVectorFromAtoB(). */
+    std::vector<c_vector<double, DIM> > mEdgeVectors;
+
+    /** The length of the next edge of each corner. */
+    std::vector<double> mEdgeLengths;
+
+    /** The gradient of the element's area at the node of each corner. */
+    std::vector<c_vector<double, DIM> > mAreaGradients;
+
+    /** The gradient of the length of the next edge of each corner at the node of that corner. */
+    std::vector<c_vector<double, DIM> > mNextEdgeGradients;
+
+    /** Whether the cache has been updated and not since marked as out of date. */
+    bool mIsUpToDate;
+
+    /**
+     * Compute the geometry of a single element. Writes only to the entries of the
+     * member arrays belonging to this element, so may be called concurrently for
+     * different elements.
+     *
+     * @param rMesh the mesh
+     * @param pElement the element
+     */
+    void ComputeElementGeometry(VertexMesh<DIM, DIM>& rMesh, VertexElement<DIM, DIM>* pElement);
+
+public:
+
+    /**
+     * Constructor. The cache is empty until Update() is called.
+     */
+    VertexMeshGeometryCache();
+
+    /**
+     * Set the number of threads used by Update(). Requires Chaste to be built with
+     * OpenMP support (Chaste_USE_OPENMP) for values greater than 1.
+     *
+     * @param numThreads the number of threads
+     */
+    void SetNumberOfThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used by Update()
+     */
+    unsigned GetNumberOfThreads() const;
+
+    /**
+     * Recompute the geometry of every element of a mesh.
+     *
+     * The areas are computed using GetVolumeOfElement() and the edges using
+     * GetVectorFromAtoB(), so the cached values agree exactly with those of the
+     * corresponding VertexMesh methods, including on periodic meshes.
+     *
+     * @param rMesh the mesh
+     */
+    void Update(VertexMesh<DIM, DIM>& rMesh);
+
+    /**
+     * @return the number of elements (including any deleted elements) when Update() was last called
+     */
+    unsigned GetNumAllElements() const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @return the area of the element
+     */
+    double GetElementArea(unsigned elemIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @return the perimeter of the element
+     */
+    double GetElementPerimeter(unsigned elemIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @return the number of corners (that is, nodes) of the element
+     */
+    unsigned GetNumCornersOfElement(unsigned elemIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @param localIndex the local index of a node in the element
+     * @return the index of the corresponding corner
+     */
+    unsigned GetCornerIndex(unsigned elemIndex, unsigned localIndex) const;
+
+    /**
+     * @param cornerIndex the index of a corner
+     * @return the global index of the node at the corner
+     */
+    unsigned GetNodeGlobalIndex(unsigned cornerIndex) const;
+
+    /**
+     * @param cornerIndex the index of a corner
+     * @return the vector along the next edge of the corner
+     */
+    const c_vector<double, DIM>& rGetEdgeVector(unsigned cornerIndex) const;
+
+    /**
+     * @param cornerIndex the index of a corner
+     * @return the length of the next edge of the corner
+     */
+    double GetEdgeLength(unsigned cornerIndex) const;
+
+    /**
+     * As VertexMesh::GetAreaGradientOfElementAtNode().
+     *
+     * @param cornerIndex the index of a corner
+     * @return the gradient of the element's area at the node of the corner
+     */
+    const c_vector<double, DIM>& rGetAreaGradient(unsigned cornerIndex) const;
+
+    /**
+     * As VertexMesh::GetNextEdgeGradientOfElementAtNode().
+     *
+     * @param cornerIndex the index of a corner
+     * @return the gradient of the length of the next edge of the corner at the node of the corner
+     */
+    const c_vector<double, DIM>& rGetNextEdgeGradient(unsigned cornerIndex) const;
+
+    /**
+     * @param elemIndex the index of an element
+     * @param localIndex the local index of a node in the element
+     * @return the index of the other element containing the edge from this node to the next
+     *     node in the element, or UNSIGNED_UNSET if this edge is on the boundary of the mesh
+     */
+    unsigned GetNeighbouringElementIndex(unsigned elemIndex, unsigned localIndex) const;
+
+    /**
+     * Mark the cache as out of date, for example once the mesh may have changed since
+     * Update() was last called. GetElementsContainingEdge() then stops using the cached edges.
+     */
+    void SetOutOfDate();
+
+    /**
+     * @return whether Update() has been called since the cache was constructed or last
+     *     marked as out of date
+     */
+    bool IsUpToDate() const;
+
+    /**
+     * Find the elements containing the edge joining two nodes. If the cache is up to date
+     * this looks the edge up among the cached edges of the first node; otherwise it
+     * intersects the nodes' sets of containing elements.
+     *
+     * @param pNodeA one node of the edge
+     * @param pNodeB the other node of the edge
+     * @param rElemIndices filled with the indices of the (one or two) elements containing the
+     *     edge; the second is UNSIGNED_UNSET if the edge is on the boundary of the mesh
+     *
+     * An exception is thrown if the cache is out of date and the nodes are shared by more
+     * than two elements.
+     */
+    void GetElementsContainingEdge(Node<DIM>* pNodeA, Node<DIM>* pNodeB, c_vector<unsigned, 2>& rElemIndices) const;
+
+    /**
+     * @return the edges of the mesh when Update() was last called
+     */
+    const VertexMeshEdgeTopology<DIM, DIM>& rGetEdgeTopology() const;
+};
+
+#endif /*VERTEXMESHGEOMETRYCACHE_HPP_*/
@@ -533,6 +533,12 @@ void AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingParal
 {
     if (keepOriginalElementIndexing)
     {
+        // Use a collective write if this writer supports one
+        if (WriteFilesCollectively())
+        {
+            return;
+        }
+
         // Master goes on to write as usual
         if (PetscTools::AmMaster())
         {
@@ -641,6 +647,12 @@ void AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingParal
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesCollectively()
+{
+    return false;
+}
+
 // LCOV_EXCL_START
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>::CreateFilesWithHeaders()
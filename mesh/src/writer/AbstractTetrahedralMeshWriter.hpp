@@ -164,6 +164,16 @@ private:
     void WriteNclFile(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
                       bool invertMeshPermutation=false);
 
+    /**
+     * Write the files from a parallel mesh collectively, each process writing the nodes and
+     * elements it owns at computed offsets, rather than concentrating all the data on the master.
+     * Called by WriteFilesUsingParallelMesh() when keeping the original element indexing.
+     *
+     * @return whether the files were written (the default implementation writes nothing and
+     *     returns false, so that the data are concentrated on the master process instead)
+     */
+    virtual bool WriteFilesCollectively();
+
     /**
      * Create output files and add headers.
      */
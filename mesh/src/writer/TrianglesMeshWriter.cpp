@@ -36,9 +36,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TrianglesMeshWriter.hpp"
 
 #include "AbstractTetrahedralMesh.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "MixedDimensionMesh.hpp"
 #include "Version.hpp"
+#include "Exception.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <mpi.h> // For MPI-IO
 
 ///////////////////////////////////////////////////////////////////////////////////
 // Implementation
@@ -279,6 +285,218 @@ void TrianglesMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFiles()
     MeshEventHandler::EndEvent(MeshEventHandler::FACE);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool TrianglesMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesCollectively()
+{
+    assert(this->mpDistributedMesh != nullptr);
+    if (!this->mFilesAreBinary || this->GetNumElements() == 0)
+    {
+        return false;
+    }
+
+    std::string comment = "#\n# " + ChasteBuildInfo::GetProvenanceString();
+    std::vector<unsigned> indices;
+    std::vector<char> data;
+
+    // Nodes (no attributes are written to binary files; see #1949)
+    MeshEventHandler::BeginEvent(MeshEventHandler::NODE);
+    {
+        std::stringstream header;
+        header << this->GetNumNodes() << "\t" << SPACE_DIM << "\t" << 0 << "\t" << 0 << "\tBIN\n";
+
+        const unsigned item_size = SPACE_DIM*sizeof(double);
+        typedef typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator NodeIterType;
+        for (NodeIterType it = this->mpMesh->GetNodeIteratorBegin(); it != this->mpMesh->GetNodeIteratorEnd(); ++it)
+        {
+            double coords[SPACE_DIM];
+            for (unsigned j=0; j<SPACE_DIM; j++)
+            {
+                coords[j] = it->GetPoint()[j];
+            }
+            indices.push_back(it->GetIndex());
+            data.insert(data.end(), (char*)coords, (char*)coords + item_size);
+        }
+        WriteBinaryFileCollectively(this->mBaseName + ".node", header.str(), indices, data, item_size, this->GetNumNodes(), comment + "\n");
+    }
+    MeshEventHandler::EndEvent(MeshEventHandler::NODE);
+
+    // Elements, with their attributes
+    MeshEventHandler::BeginEvent(MeshEventHandler::ELE);
+    {
+        std::string element_file_name = this->mBaseName;
+        std::stringstream header;
+        header << this->GetNumElements() << "\t";
+        if (ELEMENT_DIM == SPACE_DIM)
+        {
+            element_file_name += ".ele";
+            header << this->mNodesPerElement << "\t";
+        }
+        else
+        {
+            // As in WriteElementsAsFaces()
+            element_file_name += (ELEMENT_DIM == 1) ? ".edge" : ".face";
+        }
+        header << 1 << "\tBIN\n";
+
+        indices.clear();
+        data.clear();
+        const unsigned item_size = this->mNodesPerElement*sizeof(unsigned) + sizeof(double);
+        typedef typename AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>::ElementIterator ElementIterType;
+        for (ElementIterType it = this->mpMesh->GetElementIteratorBegin(); it != this->mpMesh->GetElementIteratorEnd(); ++it)
+        {
+            unsigned index = it->GetIndex();
+            if (this->mpDistributedMesh->CalculateDesignatedOwnershipOfElement(index))
+            {
+                assert(it->GetNumNodes() == this->mNodesPerElement);
+                indices.push_back(index);
+                for (unsigned j=0; j<this->mNodesPerElement; j++)
+                {
+                    unsigned node_index = it->GetNodeGlobalIndex(j);
+                    data.insert(data.end(), (char*)&node_index, (char*)&node_index + sizeof(unsigned));
+                }
+                double attribute = it->GetAttribute();
+                data.insert(data.end(), (char*)&attribute, (char*)&attribute + sizeof(double));
+            }
+        }
+        WriteBinaryFileCollectively(element_file_name, header.str(), indices, data, item_size, this->GetNumElements(), comment + "\n");
+    }
+    MeshEventHandler::EndEvent(MeshEventHandler::ELE);
+
+    // Boundary elements, without attributes (there is no boundary file in 1D)
+    MeshEventHandler::BeginEvent(MeshEventHandler::FACE);
+    if (ELEMENT_DIM != 1)
+    {
+        std::string face_file_name = this->mBaseName + ((ELEMENT_DIM == 2) ? ".edge" : ".face");
+        std::stringstream header;
+        header << this->GetNumBoundaryFaces() << "\t" << 0 << "\tBIN\n";
+
+        indices.clear();
+        data.clear();
+        const unsigned item_size = ELEMENT_DIM*sizeof(unsigned);
+        typedef typename AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>::BoundaryElementIterator BoundaryElementIterType;
+        for (BoundaryElementIterType it = this->mpMesh->GetBoundaryElementIteratorBegin(); it != this->mpMesh->GetBoundaryElementIteratorEnd(); ++it)
+        {
+            unsigned index = (*it)->GetIndex();
+            if (this->mpDistributedMesh->CalculateDesignatedOwnershipOfBoundaryElement(index))
+            {
+                indices.push_back(index);
+                for (unsigned j=0; j<ELEMENT_DIM; j++)
+                {
+                    unsigned node_index = (*it)->GetNodeGlobalIndex(j);
+                    data.insert(data.end(), (char*)&node_index, (char*)&node_index + sizeof(unsigned));
+                }
+            }
+        }
+        WriteBinaryFileCollectively(face_file_name, header.str(), indices, data, item_size, this->GetNumBoundaryFaces(), comment + "\n");
+    }
+    MeshEventHandler::EndEvent(MeshEventHandler::FACE);
+
+    // Cable elements, with their attributes (radii), as in WriteFiles()
+    if ((ELEMENT_DIM == SPACE_DIM) && (ELEMENT_DIM != 1) && (this->GetNumCableElements() > 0))
+    {
+        assert(this->mpMixedMesh != nullptr);
+        std::stringstream header;
+        header << this->GetNumCableElements() << "\t" << 2 << "\t" << 1 << "\tBIN\n";
+
+        indices.clear();
+        data.clear();
+        const unsigned item_size = 2*sizeof(unsigned) + sizeof(double);
+        typedef typename MixedDimensionMesh<ELEMENT_DIM,SPACE_DIM>::CableElementIterator CableElementIterType;
+        for (CableElementIterType it = this->mpMixedMesh->GetCableElementIteratorBegin(); it != this->mpMixedMesh->GetCableElementIteratorEnd(); ++it)
+        {
+            unsigned index = (*it)->GetIndex();
+            if (this->mpMixedMesh->CalculateDesignatedOwnershipOfCableElement(index))
+            {
+                indices.push_back(index);
+                for (unsigned j=0; j<2; j++)
+                {
+                    unsigned node_index = (*it)->GetNodeGlobalIndex(j);
+                    data.insert(data.end(), (char*)&node_index, (char*)&node_index + sizeof(unsigned));
+                }
+                double attribute = (*it)->GetAttribute();
+                data.insert(data.end(), (char*)&attribute, (char*)&attribute + sizeof(double));
+            }
+        }
+        WriteBinaryFileCollectively(this->mBaseName + ".cable", header.str(), indices, data, item_size, this->GetNumCableElements(), comment);
+    }
+
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TrianglesMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteBinaryFileCollectively(const std::string& rFileName,
+                                                                              const std::string& rHeader,
+                                                                              const std::vector<unsigned>& rIndices,
+                                                                              const std::vector<char>& rData,
+                                                                              unsigned itemSize,
+                                                                              unsigned numItems,
+                                                                              const std::string& rFooter)
+{
+    assert(rData.size() == rIndices.size()*itemSize);
+
+    // Sort this process's items into file order, as MPI-IO file views must be monotonic
+    const unsigned num_local_items = rIndices.size();
+    std::vector<std::pair<unsigned, unsigned> > order(num_local_items);
+    for (unsigned i=0; i<num_local_items; i++)
+    {
+        order[i] = std::make_pair(rIndices[i], i);
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<int> displacements(num_local_items);
+    std::vector<char> sorted_data(rData.size());
+    for (unsigned i=0; i<num_local_items; i++)
+    {
+        assert(order[i].first < numItems);
+        displacements[i] = order[i].first;
+        memcpy(&sorted_data[i*itemSize], &rData[order[i].second*itemSize], itemSize);
+    }
+
+    std::string file_path = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + rFileName;
+    MPI_File file_handle;
+    if (MPI_File_open(PETSC_COMM_WORLD, const_cast<char*>(file_path.c_str()), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &file_handle) != MPI_SUCCESS)
+    {
+        PetscTools::ReplicateException(true);
+        EXCEPTION("Could not open " << file_path << " for writing.");
+    }
+    /*
+     * The open may succeed on some processes but not others, so all must agree before any
+     * goes on to the collective writes.  The file is not closed on processes where it opened,
+     * as MPI_File_close is collective and would hang without the processes that failed.
+     */
+    PetscTools::ReplicateException(false);
+    MPI_File_set_size(file_handle, 0);
+
+    MPI_Status status;
+    const MPI_Offset data_start = rHeader.size();
+    if (PetscTools::AmMaster())
+    {
+        MPI_File_write_at(file_handle, 0, const_cast<char*>(rHeader.c_str()), rHeader.size(), MPI_CHAR, &status);
+    }
+
+    // Each process sees only its own items through the file view, then all write together
+    MPI_Datatype item_type;
+    MPI_Type_contiguous(itemSize, MPI_BYTE, &item_type);
+    MPI_Type_commit(&item_type);
+    MPI_Datatype file_type;
+    MPI_Type_create_indexed_block(num_local_items, 1, num_local_items > 0 ? &displacements[0] : nullptr, item_type, &file_type);
+    MPI_Type_commit(&file_type);
+
+    MPI_File_set_view(file_handle, data_start, MPI_BYTE, file_type, const_cast<char*>("native"), MPI_INFO_NULL);
+    MPI_File_write_all(file_handle, num_local_items > 0 ? &sorted_data[0] : nullptr, sorted_data.size(), MPI_BYTE, &status);
+    MPI_File_set_view(file_handle, 0, MPI_BYTE, MPI_BYTE, const_cast<char*>("native"), MPI_INFO_NULL);
+
+    if (PetscTools::AmMaster())
+    {
+        MPI_Offset footer_start = data_start + (MPI_Offset)numItems*itemSize;
+        MPI_File_write_at(file_handle, footer_start, const_cast<char*>(rFooter.c_str()), rFooter.size(), MPI_CHAR, &status);
+    }
+
+    MPI_File_close(&file_handle);
+    MPI_Type_free(&file_type);
+    MPI_Type_free(&item_type);
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void TrianglesMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteElementsAsFaces()
 {
@@ -47,6 +47,39 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class TrianglesMeshWriter : public AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>
 {
+private:
+
+    /**
+     * Overridden WriteFilesCollectively() method.
+     *
+     * Binary files from a parallel mesh are written with MPI-IO: the master process writes the
+     * headers and footers, and every process writes the nodes, elements, boundary elements and
+     * cable elements it owns at their offsets in the files in a single collective call per file.
+     * The files are byte-for-byte the same as those written via the master process.
+     *
+     * @return whether the files were written (false for ascii files, or a mesh with no elements)
+     */
+    bool WriteFilesCollectively();
+
+    /**
+     * Helper method for WriteFilesCollectively(). Collectively write a binary file of fixed-size items.
+     *
+     * @param rFileName  the name of the file, relative to the output directory
+     * @param rHeader  the header, written at the start of the file by the master process
+     * @param rIndices  the global indices of the items owned by this process, in any order
+     * @param rData  the binary data of the items owned by this process, in the same order as rIndices
+     * @param itemSize  the size of each item in bytes
+     * @param numItems  the total number of items in the file
+     * @param rFooter  the footer, written after the items by the master process
+     */
+    void WriteBinaryFileCollectively(const std::string& rFileName,
+                                     const std::string& rHeader,
+                                     const std::vector<unsigned>& rIndices,
+                                     const std::vector<char>& rData,
+                                     unsigned itemSize,
+                                     unsigned numItems,
+                                     const std::string& rFooter);
+
 public:
 
     /**
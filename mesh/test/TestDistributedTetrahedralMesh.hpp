@@ -52,6 +52,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MeshalyzerMeshWriter.hpp"
 #include "CmguiMeshWriter.hpp"
 #include "FileComparison.hpp"
+#include "OutputFileHandler.hpp"
 
 #include "RandomNumberGenerator.hpp"
 #include "Warnings.hpp"
@@ -641,6 +642,68 @@ public:
         CompareMeshes( mesh, mesh_from_ncl );
     }
 
+    void TestWriteBinaryFilesCollectively()
+    {
+        // Write the same mesh as a distributed mesh (collectively) and as a sequential mesh (via the master)
+        std::string output_dir = "TestWriteBinaryFilesCollectively";
+        TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements");
+        DistributedTetrahedralMesh<3,3> distributed_mesh(DistributedTetrahedralMeshPartitionType::DUMB);
+        distributed_mesh.ConstructFromMeshReader(mesh_reader);
+        for (DistributedTetrahedralMesh<3,3>::ElementIterator iter = distributed_mesh.GetElementIteratorBegin();
+             iter != distributed_mesh.GetElementIteratorEnd();
+             ++iter)
+        {
+            iter->SetAttribute(iter->GetIndex() + 0.5);
+        }
+        TrianglesMeshWriter<3,3> distributed_writer(output_dir, "collective");
+        distributed_writer.SetWriteFilesAsBinary();
+        distributed_writer.WriteFilesUsingMesh(distributed_mesh);
+
+        mesh_reader.Reset();
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+        for (TetrahedralMesh<3,3>::ElementIterator iter = mesh.GetElementIteratorBegin();
+             iter != mesh.GetElementIteratorEnd();
+             ++iter)
+        {
+            iter->SetAttribute(iter->GetIndex() + 0.5);
+        }
+        TrianglesMeshWriter<3,3> writer(output_dir, "sequential", false);
+        writer.SetWriteFilesAsBinary();
+        writer.WriteFilesUsingMesh(mesh);
+
+        // The files should be byte-for-byte identical
+        if (PetscTools::AmMaster())
+        {
+            std::string extensions[3] = {".node", ".ele", ".face"};
+            for (unsigned i=0; i<3; i++)
+            {
+                std::ifstream collective_file((distributed_writer.GetOutputDirectory() + "collective" + extensions[i]).c_str(), std::ios::binary);
+                std::ifstream sequential_file((writer.GetOutputDirectory() + "sequential" + extensions[i]).c_str(), std::ios::binary);
+                TS_ASSERT(collective_file.is_open());
+                TS_ASSERT(sequential_file.is_open());
+                std::string collective_contents((std::istreambuf_iterator<char>(collective_file)), std::istreambuf_iterator<char>());
+                std::string sequential_contents((std::istreambuf_iterator<char>(sequential_file)), std::istreambuf_iterator<char>());
+                TS_ASSERT_LESS_THAN(0u, collective_contents.size());
+                TS_ASSERT(collective_contents == sequential_contents);
+            }
+        }
+
+        // The mesh can be read back in
+        TrianglesMeshReader<3,3> binary_reader(distributed_writer.GetOutputDirectory() + "collective");
+        TS_ASSERT_EQUALS(binary_reader.GetNumNodes(), 51u);
+        TS_ASSERT_EQUALS(binary_reader.GetNumElements(), 136u);
+        TS_ASSERT_EQUALS(binary_reader.GetNumFaces(), 96u);
+        TS_ASSERT_DELTA(binary_reader.GetElementData(7).AttributeValue, 7.5, 1e-12);
+
+        // If the file cannot be opened (here because a directory is in the way) every process fails together
+        TrianglesMeshWriter<3,3> blocked_writer(output_dir, "blocked", false);
+        blocked_writer.SetWriteFilesAsBinary();
+        OutputFileHandler blocking_handler(output_dir + "/blocked.node", false);
+        TS_ASSERT_THROWS_CONTAINS(blocked_writer.WriteFilesUsingMesh(distributed_mesh), "Could not open ");
+        MeshEventHandler::Reset();
+    }
+
     void TestRandomShuffle() throw (Exception)
     {
         unsigned num_elts = 200;
@@ -829,6 +892,79 @@ public:
         }
     }
 
+    void TestBinaryFilesAreReadInSlices()
+    {
+        // Each process only reads a slice of the element and face files, so check against a full scan
+        TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements_binary");
+        DistributedTetrahedralMesh<3,3> mesh(DistributedTetrahedralMeshPartitionType::DUMB);
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        unsigned lo = mesh.GetDistributedVectorFactory()->GetLow();
+        unsigned hi = mesh.GetDistributedVectorFactory()->GetHigh();
+
+        TrianglesMeshReader<3,3> full_reader("mesh/test/data/cube_136_elements_binary");
+        std::set<unsigned> expected_elements;
+        std::set<unsigned> expected_halo_nodes;
+        for (unsigned element_index=0; element_index<full_reader.GetNumElements(); element_index++)
+        {
+            std::vector<unsigned> node_indices = full_reader.GetNextElementData().NodeIndices;
+            bool owned = false;
+            for (unsigned i=0; i<node_indices.size(); i++)
+            {
+                owned = owned || (lo <= node_indices[i] && node_indices[i] < hi);
+            }
+            if (owned)
+            {
+                expected_elements.insert(element_index);
+                for (unsigned i=0; i<node_indices.size(); i++)
+                {
+                    if (node_indices[i] < lo || node_indices[i] >= hi)
+                    {
+                        expected_halo_nodes.insert(node_indices[i]);
+                    }
+                }
+            }
+        }
+        unsigned expected_num_boundary_elements = 0;
+        for (unsigned face_index=0; face_index<full_reader.GetNumFaces(); face_index++)
+        {
+            std::vector<unsigned> node_indices = full_reader.GetNextFaceData().NodeIndices;
+            bool owned = false;
+            for (unsigned i=0; i<node_indices.size(); i++)
+            {
+                owned = owned || (lo <= node_indices[i] && node_indices[i] < hi);
+            }
+            if (owned)
+            {
+                TS_ASSERT_THROWS_NOTHING(mesh.GetBoundaryElement(face_index));
+                expected_num_boundary_elements++;
+            }
+        }
+
+        TS_ASSERT_EQUALS(mesh.GetNumLocalElements(), expected_elements.size());
+        for (std::set<unsigned>::iterator it = expected_elements.begin(); it != expected_elements.end(); ++it)
+        {
+            TS_ASSERT_THROWS_NOTHING(mesh.GetElement(*it));
+        }
+        std::vector<unsigned> halo_indices;
+        mesh.GetHaloNodeIndices(halo_indices);
+        TS_ASSERT_EQUALS(std::set<unsigned>(halo_indices.begin(), halo_indices.end()), expected_halo_nodes);
+        TS_ASSERT_EQUALS(mesh.GetNumLocalBoundaryElements(), expected_num_boundary_elements);
+        CheckEverythingIsAssigned<3,3>(mesh);
+
+        // ParMETIS partitions of the ASCII and binary versions of the mesh should agree
+        TrianglesMeshReader<3,3> ascii_reader("mesh/test/data/cube_136_elements");
+        DistributedTetrahedralMesh<3,3> ascii_mesh(DistributedTetrahedralMeshPartitionType::PARMETIS_LIBRARY);
+        ascii_mesh.ConstructFromMeshReader(ascii_reader);
+
+        TrianglesMeshReader<3,3> binary_reader("mesh/test/data/cube_136_elements_binary");
+        DistributedTetrahedralMesh<3,3> binary_mesh(DistributedTetrahedralMeshPartitionType::PARMETIS_LIBRARY);
+        binary_mesh.ConstructFromMeshReader(binary_reader);
+
+        CompareMeshes(ascii_mesh, binary_mesh);
+        TS_ASSERT_EQUALS(ascii_mesh.GetNumHaloNodes(), binary_mesh.GetNumHaloNodes());
+        TS_ASSERT_EQUALS(ascii_mesh.GetNumLocalBoundaryElements(), binary_mesh.GetNumLocalBoundaryElements());
+    }
 
     void TestConstruct3DWithRegions() throw (Exception)
     {
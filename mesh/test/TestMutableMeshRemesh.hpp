@@ -38,8 +38,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TESTMUTABLEMESHREMESH_HPP_
 
 #include <cxxtest/TestSuite.h>
+#include <algorithm>
 #include <cmath>
+#include <set>
 #include "MutableMesh.hpp"
+#include "RandomNumberGenerator.hpp"
 #include "TrianglesMeshReader.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
@@ -679,12 +682,261 @@ public:
         TS_ASSERT_DELTA(mesh.GetVolume(), area, 1e-6);
     }
 
+    void TestIncrementalReMesh2d() throw (Exception)
+    {
+        // Create a Delaunay mesh on a 10 by 10 grid of nodes, with the interior nodes slightly perturbed
+        std::vector<Node<2>*> nodes;
+        for (unsigned j=0; j<10; j++)
+        {
+            for (unsigned i=0; i<10; i++)
+            {
+                bool is_boundary = (i==0 || i==9 || j==0 || j==9);
+                double x = is_boundary ? i : i + 0.1*sin(3.0*i + 7.0*j);
+                double y = is_boundary ? j : j + 0.1*cos(5.0*i + 2.0*j);
+                nodes.push_back(new Node<2>(nodes.size(), is_boundary, x, y));
+            }
+        }
+        MutableMesh<2,2> mesh(nodes);
+
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), false);
+        mesh.SetUseIncrementalReMesh(true);
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), true);
+
+        // Move the interior nodes, delete one and add another
+        for (unsigned index=0; index<mesh.GetNumNodes(); index++)
+        {
+            Node<2>* p_node = mesh.GetNode(index);
+            if (!p_node->IsBoundaryNode())
+            {
+                c_vector<double,2>& r_location = p_node->rGetModifiableLocation();
+                r_location[0] += 0.3*sin(11.0*index);
+                r_location[1] += 0.3*cos(13.0*index);
+            }
+        }
+        mesh.DeleteNodePriorToReMesh(44);
+        unsigned new_index = mesh.AddNode(new Node<2>(0, false, 4.5, 5.5));
+
+        // Deleted indices are not reused, so the new node is appended
+        TS_ASSERT_EQUALS(new_index, 100u);
+
+        Node<2>* p_first_node = mesh.GetNode(0);
+        Node<2>* p_last_node = mesh.GetNode(99);
+
+        NodeMap map(mesh.GetNumAllNodes());
+        mesh.ReMesh(map);
+
+        // The nodes are kept rather than being recreated by the triangle library
+        TS_ASSERT_EQUALS(mesh.GetNode(0), p_first_node);
+        TS_ASSERT_EQUALS(mesh.GetNode(98), p_last_node);
+
+        TS_ASSERT_EQUALS(map.GetSize(), 101u);
+        TS_ASSERT_EQUALS(map.GetNewIndex(43), 43u);
+        TS_ASSERT(map.IsDeleted(44));
+        TS_ASSERT_EQUALS(map.GetNewIndex(45), 44u);
+        TS_ASSERT_EQUALS(map.GetNewIndex(100), 99u);
+
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 100u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllNodes(), 100u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllElements(), mesh.GetNumElements());
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryNodes(), 36u);
+
+        // Euler's formula for a triangulation of 100 nodes with 36 on the convex hull
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), 2u*100u - 36u - 2u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), 81.0, 1e-10);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+
+        // A node outside the convex hull cannot be inserted incrementally, so the full remesh is used
+        mesh.AddNode(new Node<2>(0, true, 4.5, -1.0));
+        NodeMap map2(mesh.GetNumAllNodes());
+        mesh.ReMesh(map2);
+
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 101u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), 81.0 + 4.5, 1e-10);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+    }
+
+    void TestIncrementalReMeshRepairsInvertedElements() throw (Exception)
+    {
+        // A Delaunay mesh on a perturbed 8 by 8 grid of nodes
+        std::vector<Node<2>*> nodes;
+        for (unsigned j=0; j<8; j++)
+        {
+            for (unsigned i=0; i<8; i++)
+            {
+                bool is_boundary = (i==0 || i==7 || j==0 || j==7);
+                double x = is_boundary ? i : i + 0.1*sin(3.0*i + 7.0*j);
+                double y = is_boundary ? j : j + 0.1*cos(5.0*i + 2.0*j);
+                nodes.push_back(new Node<2>(nodes.size(), is_boundary, x, y));
+            }
+        }
+        MutableMesh<2,2> mesh(nodes);
+        mesh.SetUseIncrementalReMesh(true);
+
+        // Move node 27, at (3,3), past its neighbours to (4.6,4.4), which inverts the elements around it
+        unsigned num_inverted_elements = 0;
+        mesh.GetNode(27)->rGetModifiableLocation()[0] = 4.6;
+        mesh.GetNode(27)->rGetModifiableLocation()[1] = 4.4;
+        for (unsigned elem_index=0; elem_index<mesh.GetNumElements(); elem_index++)
+        {
+            Element<2,2>* p_element = mesh.GetElement(elem_index);
+            c_vector<double, 2> edge_a = p_element->GetNodeLocation(1) - p_element->GetNodeLocation(0);
+            c_vector<double, 2> edge_b = p_element->GetNodeLocation(2) - p_element->GetNodeLocation(0);
+            if (edge_a[0]*edge_b[1] - edge_a[1]*edge_b[0] <= 0.0)
+            {
+                num_inverted_elements++;
+            }
+        }
+        TS_ASSERT_LESS_THAN(0u, num_inverted_elements);
+
+        // An element in the far corner of the mesh should be left alone by the incremental remesh
+        unsigned far_element = *(mesh.GetNode(63)->ContainingElementsBegin());
+        std::vector<unsigned> far_element_nodes(3);
+        for (unsigned i=0; i<3; i++)
+        {
+            far_element_nodes[i] = mesh.GetElement(far_element)->GetNodeGlobalIndex(i);
+        }
+
+        Node<2>* p_corner_node = mesh.GetNode(0);
+        NodeMap map(mesh.GetNumAllNodes());
+        mesh.ReMesh(map);
+        TS_ASSERT(map.IsIdentityMap());
+        TS_ASSERT_EQUALS(mesh.GetNode(0), p_corner_node);
+        for (unsigned i=0; i<3; i++)
+        {
+            TS_ASSERT_EQUALS(mesh.GetElement(far_element)->GetNodeGlobalIndex(i), far_element_nodes[i]);
+        }
+
+        // The repaired mesh is a valid Delaunay triangulation of the moved nodes
+        for (unsigned elem_index=0; elem_index<mesh.GetNumElements(); elem_index++)
+        {
+            Element<2,2>* p_element = mesh.GetElement(elem_index);
+            c_vector<double, 2> edge_a = p_element->GetNodeLocation(1) - p_element->GetNodeLocation(0);
+            c_vector<double, 2> edge_b = p_element->GetNodeLocation(2) - p_element->GetNodeLocation(0);
+            TS_ASSERT_LESS_THAN(0.0, edge_a[0]*edge_b[1] - edge_a[1]*edge_b[0]);
+        }
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), 2u*64u - 28u - 2u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), 49.0, 1e-10);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+    }
+
+    void TestIncrementalReMeshMatchesFullReMesh() throw (Exception)
+    {
+        // Two copies of a Delaunay mesh on a perturbed 12 by 12 grid of nodes
+        std::vector<Node<2>*> nodes;
+        std::vector<Node<2>*> nodes_copy;
+        for (unsigned j=0; j<12; j++)
+        {
+            for (unsigned i=0; i<12; i++)
+            {
+                bool is_boundary = (i==0 || i==11 || j==0 || j==11);
+                double x = is_boundary ? i : i + 0.1*sin(3.0*i + 7.0*j);
+                double y = is_boundary ? j : j + 0.1*cos(5.0*i + 2.0*j);
+                nodes.push_back(new Node<2>(nodes.size(), is_boundary, x, y));
+                nodes_copy.push_back(new Node<2>(nodes_copy.size(), is_boundary, x, y));
+            }
+        }
+        MutableMesh<2,2> incremental_mesh(nodes);
+        incremental_mesh.SetUseIncrementalReMesh(true);
+        MutableMesh<2,2> full_mesh(nodes_copy);
+
+        /*
+         * Move the interior nodes randomly, alternately deleting and adding a node, and check
+         * that both approaches give the same triangulation.  Nodes are not added and deleted in
+         * the same step, since only the full remesh reuses the indices of deleted nodes.
+         */
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        for (unsigned step=0; step<40; step++)
+        {
+            for (unsigned node_index=0; node_index<full_mesh.GetNumNodes(); node_index++)
+            {
+                if (!full_mesh.GetNode(node_index)->IsBoundaryNode())
+                {
+                    c_vector<double, 2> location = full_mesh.GetNode(node_index)->rGetLocation();
+                    for (unsigned dim=0; dim<2; dim++)
+                    {
+                        location[dim] += 0.4*(p_gen->ranf() - 0.5);
+                        location[dim] = std::max(0.5, std::min(10.5, location[dim]));
+                    }
+                    full_mesh.GetNode(node_index)->rGetModifiableLocation() = location;
+                    incremental_mesh.GetNode(node_index)->rGetModifiableLocation() = location;
+                }
+            }
+
+            unsigned node_index = p_gen->randMod(full_mesh.GetNumNodes());
+            if (!full_mesh.GetNode(node_index)->IsBoundaryNode())
+            {
+                if (step%2 == 0)
+                {
+                    full_mesh.DeleteNodePriorToReMesh(node_index);
+                    incremental_mesh.DeleteNodePriorToReMesh(node_index);
+                }
+                else
+                {
+                    c_vector<double, 2> location = full_mesh.GetNode(node_index)->rGetLocation();
+                    location[0] += 0.05;
+                    full_mesh.AddNode(new Node<2>(0, false, location[0], location[1]));
+                    incremental_mesh.AddNode(new Node<2>(0, false, location[0], location[1]));
+                }
+            }
+
+            Node<2>* p_corner_node = incremental_mesh.GetNode(0);
+
+            NodeMap full_map(full_mesh.GetNumAllNodes());
+            full_mesh.ReMesh(full_map);
+            NodeMap incremental_map(incremental_mesh.GetNumAllNodes());
+            incremental_mesh.ReMesh(incremental_map);
+
+            // The incremental remesh keeps the existing nodes, so it didn't fall back to a full remesh
+            TS_ASSERT_EQUALS(incremental_mesh.GetNode(0), p_corner_node);
+
+            TS_ASSERT_EQUALS(incremental_map.GetSize(), full_map.GetSize());
+            for (unsigned i=0; i<full_map.GetSize(); i++)
+            {
+                TS_ASSERT_EQUALS(incremental_map.IsDeleted(i), full_map.IsDeleted(i));
+                if (!full_map.IsDeleted(i))
+                {
+                    TS_ASSERT_EQUALS(incremental_map.GetNewIndex(i), full_map.GetNewIndex(i));
+                }
+            }
+
+            // The elements are numbered differently, so compare them as sets of node indices
+            TS_ASSERT_EQUALS(incremental_mesh.GetNumNodes(), full_mesh.GetNumNodes());
+            TS_ASSERT_EQUALS(incremental_mesh.GetNumElements(), full_mesh.GetNumElements());
+            std::set<std::set<unsigned> > full_elements;
+            std::set<std::set<unsigned> > incremental_elements;
+            for (unsigned elem_index=0; elem_index<full_mesh.GetNumElements(); elem_index++)
+            {
+                std::set<unsigned> element_nodes;
+                for (unsigned i=0; i<3; i++)
+                {
+                    element_nodes.insert(full_mesh.GetElement(elem_index)->GetNodeGlobalIndex(i));
+                }
+                full_elements.insert(element_nodes);
+            }
+            for (unsigned elem_index=0; elem_index<incremental_mesh.GetNumElements(); elem_index++)
+            {
+                std::set<unsigned> element_nodes;
+                for (unsigned i=0; i<3; i++)
+                {
+                    element_nodes.insert(incremental_mesh.GetElement(elem_index)->GetNodeGlobalIndex(i));
+                }
+                incremental_elements.insert(element_nodes);
+            }
+            TS_ASSERT(incremental_elements == full_elements);
+            TS_ASSERT_DELTA(incremental_mesh.GetVolume(), 121.0, 1e-10);
+        }
+    }
+
     void TestRemeshWithLibraryMethod3D() throw (Exception)
     {
         TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements");
         MutableMesh<3,3> mesh;
         mesh.ConstructFromMeshReader(mesh_reader);
 
+        // Only 2D meshes can be remeshed incrementally
+        TS_ASSERT_THROWS_THIS(mesh.SetUseIncrementalReMesh(true), "Incremental remeshing is only implemented for 2D meshes.");
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), false);
+
         double volume = mesh.GetVolume();
         const int node_index = 17;
         const int target_index = 9;
@@ -247,6 +247,12 @@ public:
         TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), cells_across*cells_up);
         TS_ASSERT_EQUALS(p_mesh->GetNumElements(), 2*cells_across*(cells_up-1));
         TS_ASSERT_EQUALS(p_mesh->GetNumBoundaryElements(), 1u);  // No boundary elements now the halo nodes are removed
+
+        // The mirror image nodes always need a full remesh
+        TS_ASSERT_THROWS_THIS(p_mesh->SetUseIncrementalReMesh(true),
+                              "Incremental remeshing is not supported by Cylindrical2dMesh, since its mirror image nodes need a full remesh.");
+        TS_ASSERT_EQUALS(p_mesh->GetUseIncrementalReMesh(), false);
+        TS_ASSERT_THROWS_NOTHING(p_mesh->SetUseIncrementalReMesh(false));
     }
 
     /*
@@ -40,6 +40,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "VertexMeshWriter.hpp"
 #include "MutableVertexMesh.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
+#include "RandomNumberGenerator.hpp"
 #include "FileComparison.hpp"
 #include "Warnings.hpp"
 
@@ -2820,6 +2823,59 @@ public:
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(2), 2.7294, 1e-4);
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(3), 2.3062, 1e-4);
     }
+
+    void TestGetCandidateElementsForIntersections() throw(Exception)
+    {
+        // On a planar and a cylindrical mesh with randomly perturbed nodes...
+        HoneycombVertexMeshGenerator generator(10, 10);
+        CylindricalHoneycombVertexMeshGenerator cylindrical_generator(10, 10);
+        MutableVertexMesh<2,2>* meshes[2] = {generator.GetMesh(), cylindrical_generator.GetCylindricalMesh()};
+
+        for (unsigned m=0; m<2; m++)
+        {
+            MutableVertexMesh<2,2>* p_mesh = meshes[m];
+            for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+            {
+                ChastePoint<2> point = p_mesh->GetNode(node_index)->GetPoint();
+                point.SetCoordinate(0, point[0] + 0.8*(RandomNumberGenerator::Instance()->ranf() - 0.5));
+                point.SetCoordinate(1, point[1] + 0.8*(RandomNumberGenerator::Instance()->ranf() - 0.5));
+                p_mesh->SetNode(node_index, point);
+            }
+
+            std::vector<std::vector<unsigned> > candidate_elements;
+            p_mesh->GetCandidateElementsForIntersections(candidate_elements);
+            TS_ASSERT_EQUALS(candidate_elements.size(), p_mesh->GetNumNodes());
+
+            // ...every element that includes a node is among its candidates, which are in increasing order
+            unsigned num_intersections = 0;
+            unsigned num_candidates = 0;
+            for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+            {
+                const std::vector<unsigned>& r_candidates = candidate_elements[node_index];
+                num_candidates += r_candidates.size();
+                for (unsigned i=1; i<r_candidates.size(); i++)
+                {
+                    TS_ASSERT_LESS_THAN(r_candidates[i-1], r_candidates[i]);
+                }
+
+                for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+                {
+                    if ((p_mesh->GetNode(node_index)->rGetContainingElementIndices().count(elem_index) == 0)
+                        && p_mesh->ElementIncludesPoint(p_mesh->GetNode(node_index)->rGetLocation(), elem_index))
+                    {
+                        num_intersections++;
+                        TS_ASSERT(std::binary_search(r_candidates.begin(), r_candidates.end(), elem_index));
+                    }
+                }
+            }
+
+            // The perturbation is large enough to cause some intersections
+            TS_ASSERT_LESS_THAN(0u, num_intersections);
+
+            // Far fewer node-element pairs are tested than by a loop over all elements
+            TS_ASSERT_LESS_THAN(2*num_candidates, p_mesh->GetNumNodes()*p_mesh->GetNumElements());
+        }
+    }
 };
 
 #endif /*TESTMUTABLEVERTEXMESHREMESH_HPP_*/
@@ -184,6 +184,39 @@ private:
         return new VertexMesh<3,3>(nodes, elements);
     }
 
+    /**
+     * Check that a Voronoi tessellation is identical to one constructed afresh from a Delaunay mesh.
+     *
+     * @param rVoronoiMesh the tessellation
+     * @param rDelaunayMesh the Delaunay mesh
+     */
+    void CompareVoronoiTessellations(VertexMesh<2,2>& rVoronoiMesh, MutableMesh<2,2>& rDelaunayMesh)
+    {
+        VertexMesh<2,2> new_voronoi_mesh(rDelaunayMesh);
+
+        TS_ASSERT_EQUALS(rVoronoiMesh.GetNumNodes(), new_voronoi_mesh.GetNumNodes());
+        for (unsigned node_index=0; node_index<new_voronoi_mesh.GetNumNodes(); node_index++)
+        {
+            TS_ASSERT_EQUALS(rVoronoiMesh.GetNode(node_index)->GetIndex(), node_index);
+            TS_ASSERT_DELTA(rVoronoiMesh.GetNode(node_index)->rGetLocation()[0], new_voronoi_mesh.GetNode(node_index)->rGetLocation()[0], 1e-12);
+            TS_ASSERT_DELTA(rVoronoiMesh.GetNode(node_index)->rGetLocation()[1], new_voronoi_mesh.GetNode(node_index)->rGetLocation()[1], 1e-12);
+            TS_ASSERT(rVoronoiMesh.GetNode(node_index)->rGetContainingElementIndices() == new_voronoi_mesh.GetNode(node_index)->rGetContainingElementIndices());
+        }
+
+        TS_ASSERT_EQUALS(rVoronoiMesh.GetNumElements(), new_voronoi_mesh.GetNumElements());
+        for (unsigned elem_index=0; elem_index<new_voronoi_mesh.GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = rVoronoiMesh.GetElement(elem_index);
+            TS_ASSERT_EQUALS(p_element->GetIndex(), elem_index);
+            TS_ASSERT_EQUALS(p_element->GetNumNodes(), new_voronoi_mesh.GetElement(elem_index)->GetNumNodes());
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                TS_ASSERT_EQUALS(p_element->GetNodeGlobalIndex(local_index), new_voronoi_mesh.GetElement(elem_index)->GetNodeGlobalIndex(local_index));
+            }
+            TS_ASSERT_DELTA(rVoronoiMesh.GetVolumeOfElement(elem_index), new_voronoi_mesh.GetVolumeOfElement(elem_index), 1e-12);
+        }
+    }
+
 public:
 
     void TestNodeIterator() throw (Exception)
@@ -2004,6 +2037,60 @@ public:
         TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(4), 0.5, 1e-6);
     }
 
+    void TestUpdateVoronoiTessellation2d() throw (Exception)
+    {
+        // Create a Delaunay mesh on a 6 by 6 grid of nodes, with the interior nodes slightly perturbed
+        std::vector<Node<2>*> delaunay_nodes;
+        for (unsigned j=0; j<6; j++)
+        {
+            for (unsigned i=0; i<6; i++)
+            {
+                bool is_boundary = (i==0 || i==5 || j==0 || j==5);
+                double x = is_boundary ? i : i + 0.1*sin(3.0*i + 7.0*j);
+                double y = is_boundary ? j : j + 0.1*cos(5.0*i + 2.0*j);
+                delaunay_nodes.push_back(new Node<2>(delaunay_nodes.size(), is_boundary, x, y));
+            }
+        }
+        MutableMesh<2,2> delaunay_mesh(delaunay_nodes);
+        delaunay_mesh.SetUseIncrementalReMesh(true);
+
+        VertexMesh<2,2> voronoi_mesh(delaunay_mesh);
+
+        // Nothing has changed, so no elements are recreated
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVoronoiTessellation(), 0u);
+        CompareVoronoiTessellations(voronoi_mesh, delaunay_mesh);
+
+        // Move the interior nodes, delete one (which renumbers later nodes) and add another
+        for (unsigned index=0; index<delaunay_mesh.GetNumNodes(); index++)
+        {
+            Node<2>* p_node = delaunay_mesh.GetNode(index);
+            if (!p_node->IsBoundaryNode())
+            {
+                p_node->rGetModifiableLocation()[0] += 0.02*sin(11.0*index);
+                p_node->rGetModifiableLocation()[1] += 0.02*cos(13.0*index);
+            }
+        }
+        delaunay_mesh.DeleteNodePriorToReMesh(14);
+        delaunay_mesh.AddNode(new Node<2>(0, false, 2.5, 3.5));
+        NodeMap map(delaunay_mesh.GetNumAllNodes());
+        delaunay_mesh.ReMesh(map);
+
+        // Only the elements near the changes are recreated
+        unsigned num_recreated = voronoi_mesh.UpdateVoronoiTessellation();
+        TS_ASSERT_LESS_THAN(0u, num_recreated);
+        TS_ASSERT_LESS_THAN(num_recreated, voronoi_mesh.GetNumElements()/2);
+        CompareVoronoiTessellations(voronoi_mesh, delaunay_mesh);
+
+        // A full remesh renumbers the elements of the Delaunay mesh, but the result is still correct
+        delaunay_mesh.SetUseIncrementalReMesh(false);
+        delaunay_mesh.DeleteNodePriorToReMesh(20);
+        NodeMap map2(delaunay_mesh.GetNumAllNodes());
+        delaunay_mesh.ReMesh(map2);
+
+        voronoi_mesh.UpdateVoronoiTessellation();
+        CompareVoronoiTessellations(voronoi_mesh, delaunay_mesh);
+    }
+
     void TestGetEdgeLengthWithSimpleMesh() throw (Exception)
     {
         // Create a simple 2D tetrahedral mesh, the Delaunay triangulation
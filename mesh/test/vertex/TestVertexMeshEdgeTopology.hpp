@@ -0,0 +1,234 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXMESHEDGETOPOLOGY_HPP_
+#define TESTVERTEXMESHEDGETOPOLOGY_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "VertexMeshEdgeTopology.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+
+#include "FakePetscSetup.hpp"
+
+class TestVertexMeshEdgeTopology : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that the edges found agree with the node lists of the elements of the mesh.
+     *
+     * @param rTopology the edge topology
+     * @param rMesh the mesh
+     */
+    void CheckTopologyAgainstMesh(const VertexMeshEdgeTopology<2,2>& rTopology, MutableVertexMesh<2,2>& rMesh)
+    {
+        unsigned num_corners = 0;
+        unsigned num_boundary_edges = 0;
+        for (unsigned edge_index=0; edge_index<rTopology.GetNumEdges(); edge_index++)
+        {
+            if (rTopology.IsBoundaryEdge(edge_index))
+            {
+                num_boundary_edges++;
+            }
+        }
+
+        for (unsigned elem_index=0; elem_index<rMesh.GetNumAllElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = rMesh.GetElement(elem_index);
+            unsigned num_nodes = p_element->IsDeleted() ? 0 : p_element->GetNumNodes();
+            TS_ASSERT_EQUALS(rTopology.GetNumCornersOfElement(elem_index), num_nodes);
+            num_corners += num_nodes;
+
+            for (unsigned local_index=0; local_index<num_nodes; local_index++)
+            {
+                unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+                unsigned next_node_index = p_element->GetNodeGlobalIndex((local_index+1)%num_nodes);
+
+                // The edge from this node to the next joins the same pair of nodes
+                unsigned edge_index = rTopology.GetEdgeIndex(elem_index, local_index);
+                TS_ASSERT_EQUALS(rTopology.FindEdge(node_index, next_node_index), edge_index);
+                TS_ASSERT_EQUALS(rTopology.FindEdge(next_node_index, node_index), edge_index);
+                std::set<unsigned> edge_nodes;
+                edge_nodes.insert(rTopology.GetEdgeNodeIndex(edge_index, 0));
+                edge_nodes.insert(rTopology.GetEdgeNodeIndex(edge_index, 1));
+                TS_ASSERT_EQUALS(edge_nodes.count(node_index), 1u);
+                TS_ASSERT_EQUALS(edge_nodes.count(next_node_index), 1u);
+
+                // Find the other element containing this edge, if any
+                unsigned neighbouring_elem_index = UNSIGNED_UNSET;
+                std::set<unsigned>& r_containing_elements = rMesh.GetNode(node_index)->rGetContainingElementIndices();
+                for (std::set<unsigned>::iterator iter = r_containing_elements.begin();
+                     iter != r_containing_elements.end();
+                     ++iter)
+                {
+                    if (*iter != elem_index && rMesh.GetNode(next_node_index)->rGetContainingElementIndices().count(*iter) > 0)
+                    {
+                        neighbouring_elem_index = *iter;
+                    }
+                }
+                TS_ASSERT_EQUALS(rTopology.GetNeighbouringElementIndex(elem_index, local_index), neighbouring_elem_index);
+                TS_ASSERT_EQUALS(rTopology.IsBoundaryEdge(edge_index), neighbouring_elem_index == UNSIGNED_UNSET);
+            }
+        }
+
+        // Each interior edge is counted from both of its elements, and each boundary edge from one
+        TS_ASSERT_LESS_THAN_EQUALS(num_corners, rTopology.GetNumCorners());
+        TS_ASSERT_EQUALS(2*rTopology.GetNumEdges() - num_boundary_edges, num_corners);
+
+        // Each edge is listed at both of its nodes
+        unsigned num_node_edges = 0;
+        for (unsigned node_index=0; node_index<rMesh.GetNumAllNodes(); node_index++)
+        {
+            for (unsigned i=0; i<rTopology.GetNumEdgesOfNode(node_index); i++)
+            {
+                unsigned edge_index = rTopology.GetNodeEdgeIndex(node_index, i);
+                TS_ASSERT(rTopology.GetEdgeNodeIndex(edge_index, 0) == node_index
+                          || rTopology.GetEdgeNodeIndex(edge_index, 1) == node_index);
+            }
+            num_node_edges += rTopology.GetNumEdgesOfNode(node_index);
+        }
+        TS_ASSERT_EQUALS(num_node_edges, 2*rTopology.GetNumEdges());
+    }
+
+public:
+
+    void TestTopologyOfHoneycombMesh()
+    {
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        VertexMeshEdgeTopology<2,2> topology;
+        TS_ASSERT_EQUALS(topology.GetNumEdges(), 0u);
+
+        topology.Update(*p_mesh);
+        CheckTopologyAgainstMesh(topology, *p_mesh);
+        TS_ASSERT_EQUALS(topology.GetNumCorners(), 6*p_mesh->GetNumElements());
+
+        // By Euler's formula, a mesh of 16 elements with no holes has 15 more edges than nodes
+        TS_ASSERT_EQUALS(topology.GetNumEdges(), p_mesh->GetNumNodes() + 15);
+
+        // The edges are numbered in the order in which they are first reached
+        for (unsigned local_index=0; local_index<6; local_index++)
+        {
+            TS_ASSERT_EQUALS(topology.GetEdgeIndex(0, local_index), local_index);
+            TS_ASSERT_EQUALS(topology.GetEdgeElementIndex(local_index, 0), 0u);
+            TS_ASSERT_EQUALS(topology.GetEdgeNodeIndex(local_index, 0), p_mesh->GetElement(0)->GetNodeGlobalIndex(local_index));
+        }
+
+        // Element 5 is in the interior of the mesh, so none of its edges is on the boundary
+        for (unsigned local_index=0; local_index<6; local_index++)
+        {
+            TS_ASSERT_EQUALS(topology.IsBoundaryEdge(topology.GetEdgeIndex(5, local_index)), false);
+        }
+
+        // Nodes of the same element that are not adjacent are not joined by an edge
+        VertexElement<2,2>* p_element = p_mesh->GetElement(5);
+        TS_ASSERT_EQUALS(topology.FindEdge(p_element->GetNodeGlobalIndex(0), p_element->GetNodeGlobalIndex(3)), UNSIGNED_UNSET);
+    }
+
+    void TestTopologyAfterReMesh()
+    {
+        // Create a honeycomb mesh with an edge short enough to cause a T1 swap
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        p_mesh->SetCellRearrangementThreshold(0.1);
+
+        VertexElement<2,2>* p_element = p_mesh->GetElement(5);
+        c_vector<double, 2> midpoint = 0.5*(p_element->GetNodeLocation(0) + p_element->GetNodeLocation(1));
+        p_mesh->GetNode(p_element->GetNodeGlobalIndex(0))->rGetModifiableLocation() = midpoint;
+        p_mesh->GetNode(p_element->GetNodeGlobalIndex(1))->rGetModifiableLocation() = midpoint;
+        p_mesh->GetNode(p_element->GetNodeGlobalIndex(1))->rGetModifiableLocation()[0] += 0.01;
+
+        VertexMeshEdgeTopology<2,2> topology;
+        topology.Update(*p_mesh);
+        unsigned num_edges = topology.GetNumEdges();
+        unsigned old_num_nodes_of_element_5 = p_element->GetNumNodes();
+
+        // The elements changed by the swap are those containing either node of the short edge
+        std::set<unsigned> changed_elements = p_element->GetNode(0)->rGetContainingElementIndices();
+        changed_elements.insert(p_element->GetNode(1)->rGetContainingElementIndices().begin(),
+                                p_element->GetNode(1)->rGetContainingElementIndices().end());
+        TS_ASSERT_EQUALS(changed_elements.size(), 4u);
+
+        p_mesh->ReMesh();
+        TS_ASSERT_EQUALS(p_element->GetNumNodes(), old_num_nodes_of_element_5 - 1);
+
+        // Updating only the changed elements gives the same edges as recomputing them all
+        VertexMeshEdgeTopology<2,2> updated_topology = topology;
+        updated_topology.UpdateElements(*p_mesh, changed_elements);
+        CheckTopologyAgainstMesh(updated_topology, *p_mesh);
+        TS_ASSERT_EQUALS(updated_topology.GetNumEdges(), num_edges);
+
+        // A T1 swap does not change the number of edges, but it does change their elements
+        topology.Update(*p_mesh);
+        CheckTopologyAgainstMesh(topology, *p_mesh);
+        TS_ASSERT_EQUALS(topology.GetNumEdges(), num_edges);
+    }
+
+    void TestUpdateElementsAfterDivision()
+    {
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        unsigned num_nodes = p_mesh->GetNumNodes();
+        unsigned num_elements = p_mesh->GetNumElements();
+
+        VertexMeshEdgeTopology<2,2> topology;
+        topology.Update(*p_mesh);
+        unsigned num_edges = topology.GetNumEdges();
+
+        // Dividing an interior element adds two nodes, one element and three edges
+        p_mesh->DivideElementAlongShortAxis(p_mesh->GetElement(5));
+        TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), num_nodes + 2);
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), num_elements + 1);
+
+        // The elements changed are those containing the new nodes
+        std::set<unsigned> changed_elements;
+        for (unsigned node_index=num_nodes; node_index<num_nodes+2; node_index++)
+        {
+            std::set<unsigned>& r_containing_elements = p_mesh->GetNode(node_index)->rGetContainingElementIndices();
+            changed_elements.insert(r_containing_elements.begin(), r_containing_elements.end());
+        }
+        TS_ASSERT_EQUALS(changed_elements.size(), 4u);
+
+        topology.UpdateElements(*p_mesh, changed_elements);
+        CheckTopologyAgainstMesh(topology, *p_mesh);
+        TS_ASSERT_EQUALS(topology.GetNumEdges(), num_edges + 3);
+        TS_ASSERT_EQUALS(topology.GetNumEdgesOfNode(num_nodes), 3u);
+        TS_ASSERT_EQUALS(topology.GetNumEdgesOfNode(num_nodes + 1), 3u);
+    }
+};
+
+#endif /*TESTVERTEXMESHEDGETOPOLOGY_HPP_*/
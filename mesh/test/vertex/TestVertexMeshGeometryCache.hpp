@@ -0,0 +1,237 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXMESHGEOMETRYCACHE_HPP_
+#define TESTVERTEXMESHGEOMETRYCACHE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "VertexMeshGeometryCache.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
+#include "ThreadedTestHelpers.hpp"
+
+#include "FakePetscSetup.hpp"
+
+class TestVertexMeshGeometryCache : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that the cached geometry of each element agrees with that computed by the mesh.
+     *
+     * @param rCache the cache
+     * @param rMesh the mesh
+     */
+    void CheckCacheAgainstMesh(const VertexMeshGeometryCache<2>& rCache, VertexMesh<2,2>& rMesh)
+    {
+        TS_ASSERT_EQUALS(rCache.GetNumAllElements(), rMesh.GetNumAllElements());
+
+        for (unsigned elem_index=0; elem_index<rMesh.GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = rMesh.GetElement(elem_index);
+            unsigned num_nodes = p_element->GetNumNodes();
+
+            TS_ASSERT_DELTA(rCache.GetElementArea(elem_index), rMesh.GetVolumeOfElement(elem_index), 1e-12);
+            TS_ASSERT_DELTA(rCache.GetElementPerimeter(elem_index), rMesh.GetSurfaceAreaOfElement(elem_index), 1e-12);
+            TS_ASSERT_EQUALS(rCache.GetNumCornersOfElement(elem_index), num_nodes);
+
+            for (unsigned local_index=0; local_index<num_nodes; local_index++)
+            {
+                unsigned corner_index = rCache.GetCornerIndex(elem_index, local_index);
+                unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+                unsigned next_node_index = p_element->GetNodeGlobalIndex((local_index+1)%num_nodes);
+                TS_ASSERT_EQUALS(rCache.GetNodeGlobalIndex(corner_index), node_index);
+
+                c_vector<double, 2> edge_vector = rMesh.GetVectorFromAtoB(rMesh.GetNode(node_index)->rGetLocation(),
+                                                                          rMesh.GetNode(next_node_index)->rGetLocation());
+                c_vector<double, 2> area_gradient = rMesh.GetAreaGradientOfElementAtNode(p_element, local_index);
+                c_vector<double, 2> next_edge_gradient = rMesh.GetNextEdgeGradientOfElementAtNode(p_element, local_index);
+                for (unsigned i=0; i<2; i++)
+                {
+                    TS_ASSERT_DELTA(rCache.rGetEdgeVector(corner_index)[i], edge_vector[i], 1e-12);
+                    TS_ASSERT_DELTA(rCache.rGetAreaGradient(corner_index)[i], area_gradient[i], 1e-12);
+                    TS_ASSERT_DELTA(rCache.rGetNextEdgeGradient(corner_index)[i], next_edge_gradient[i], 1e-12);
+                }
+                TS_ASSERT_DELTA(rCache.GetEdgeLength(corner_index), rMesh.GetDistanceBetweenNodes(node_index, next_node_index), 1e-12);
+
+                // Find the other element containing this edge, if any
+                unsigned neighbouring_elem_index = UNSIGNED_UNSET;
+                std::set<unsigned>& r_containing_elements = rMesh.GetNode(node_index)->rGetContainingElementIndices();
+                for (std::set<unsigned>::iterator iter = r_containing_elements.begin();
+                     iter != r_containing_elements.end();
+                     ++iter)
+                {
+                    if (*iter != elem_index && rMesh.GetNode(next_node_index)->rGetContainingElementIndices().count(*iter) > 0)
+                    {
+                        neighbouring_elem_index = *iter;
+                    }
+                }
+                TS_ASSERT_EQUALS(rCache.GetNeighbouringElementIndex(elem_index, local_index), neighbouring_elem_index);
+
+                // The same elements are found from the edge's nodes
+                c_vector<unsigned, 2> elem_indices;
+                rCache.GetElementsContainingEdge(rMesh.GetNode(node_index), rMesh.GetNode(next_node_index), elem_indices);
+                TS_ASSERT(elem_indices[0] == elem_index || elem_indices[1] == elem_index);
+                TS_ASSERT_EQUALS(elem_indices[0] + elem_indices[1], elem_index + neighbouring_elem_index);
+            }
+        }
+    }
+
+public:
+
+    void TestCacheOnHoneycombMesh()
+    {
+        // Create a small honeycomb mesh and perturb its nodes
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            p_mesh->GetNode(node_index)->rGetModifiableLocation()[0] += 0.05*sin(3.0*node_index);
+            p_mesh->GetNode(node_index)->rGetModifiableLocation()[1] += 0.05*cos(5.0*node_index);
+        }
+
+        VertexMeshGeometryCache<2> cache;
+        TS_ASSERT_EQUALS(cache.GetNumAllElements(), 0u);
+        TS_ASSERT_EQUALS(cache.IsUpToDate(), false);
+
+        cache.Update(*p_mesh);
+        CheckCacheAgainstMesh(cache, *p_mesh);
+
+        // The corners of each element follow on from those of the previous element
+        TS_ASSERT_EQUALS(cache.GetCornerIndex(0, 0), 0u);
+        TS_ASSERT_EQUALS(cache.GetCornerIndex(1, 0), 6u);
+
+        // Element 5 is in the interior of the mesh, so each of its edges is shared with another element
+        for (unsigned local_index=0; local_index<6; local_index++)
+        {
+            TS_ASSERT_DIFFERS(cache.GetNeighbouringElementIndex(5, local_index), UNSIGNED_UNSET);
+        }
+
+        // Once out of date, the cache finds the elements containing an edge from the mesh instead
+        TS_ASSERT_EQUALS(cache.IsUpToDate(), true);
+        cache.SetOutOfDate();
+        TS_ASSERT_EQUALS(cache.IsUpToDate(), false);
+        VertexElement<2,2>* p_element = p_mesh->GetElement(5);
+        c_vector<unsigned, 2> elem_indices;
+        cache.GetElementsContainingEdge(p_element->GetNode(0), p_element->GetNode(1), elem_indices);
+        TS_ASSERT(elem_indices[0] == 5u || elem_indices[1] == 5u);
+        TS_ASSERT_EQUALS(elem_indices[0] + elem_indices[1], 5u + cache.GetNeighbouringElementIndex(5, 0));
+
+        // The cache is only updated on request
+        double old_area = cache.GetElementArea(5);
+        p_mesh->GetNode(p_mesh->GetElement(5)->GetNodeGlobalIndex(0))->rGetModifiableLocation()[0] += 0.1;
+        TS_ASSERT_DELTA(cache.GetElementArea(5), old_area, 1e-12);
+
+        cache.Update(*p_mesh);
+        TS_ASSERT_DIFFERS(cache.GetElementArea(5), old_area);
+        CheckCacheAgainstMesh(cache, *p_mesh);
+    }
+
+    void TestCacheOnPeriodicMesh()
+    {
+        // Edges across the periodic boundary should be measured the short way round
+        CylindricalHoneycombVertexMeshGenerator generator(4, 4);
+        Cylindrical2dVertexMesh* p_mesh = generator.GetCylindricalMesh();
+
+        VertexMeshGeometryCache<2> cache;
+        cache.Update(*p_mesh);
+        CheckCacheAgainstMesh(cache, *p_mesh);
+
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            for (unsigned local_index=0; local_index<cache.GetNumCornersOfElement(elem_index); local_index++)
+            {
+                TS_ASSERT_LESS_THAN(cache.GetEdgeLength(cache.GetCornerIndex(elem_index, local_index)), 1.0);
+            }
+        }
+    }
+
+    void TestElementsContainingEdgeWithOutOfDateCache()
+    {
+        // Make a mesh in which nodes 0 and 1 are shared by three elements
+        std::vector<Node<2>*> nodes;
+        nodes.push_back(new Node<2>(0, false, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, false, 1.0, 0.0));
+        nodes.push_back(new Node<2>(2, false, 0.5, 1.0));
+        nodes.push_back(new Node<2>(3, false, 0.5, -1.0));
+        nodes.push_back(new Node<2>(4, false, 0.5, 2.0));
+
+        std::vector<VertexElement<2,2>*> elements;
+        for (unsigned apex=2; apex<5; apex++)
+        {
+            std::vector<Node<2>*> element_nodes;
+            element_nodes.push_back(nodes[0]);
+            element_nodes.push_back(nodes[1]);
+            element_nodes.push_back(nodes[apex]);
+            elements.push_back(new VertexElement<2,2>(apex-2, element_nodes));
+        }
+        VertexMesh<2,2> mesh(nodes, elements);
+
+        // Without an up-to-date cache the containing elements are intersected, which finds all three
+        VertexMeshGeometryCache<2> cache;
+        TS_ASSERT_EQUALS(cache.IsUpToDate(), false);
+        c_vector<unsigned, 2> elem_indices;
+        TS_ASSERT_THROWS_THIS(cache.GetElementsContainingEdge(mesh.GetNode(0), mesh.GetNode(1), elem_indices),
+                              "Nodes 0 and 1 are shared by more than two elements, so do not form an edge of the mesh.");
+
+        // Nodes 1 and 2 are only shared by the first element
+        cache.GetElementsContainingEdge(mesh.GetNode(1), mesh.GetNode(2), elem_indices);
+        TS_ASSERT_EQUALS(elem_indices[0], 0u);
+        TS_ASSERT_EQUALS(elem_indices[1], UNSIGNED_UNSET);
+    }
+
+    void TestNumberOfThreads()
+    {
+        VertexMeshGeometryCache<2> cache;
+        TS_ASSERT_EQUALS(cache.GetNumberOfThreads(), 1u);
+
+        // The cache should be identical whatever the number of threads
+        HoneycombVertexMeshGenerator generator(6, 6);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<unsigned> numbers_of_threads = ThreadedTestHelpers::GetNumbersOfThreadsToTest();
+        for (unsigned t=0; t<numbers_of_threads.size(); t++)
+        {
+            cache.SetNumberOfThreads(numbers_of_threads[t]);
+            TS_ASSERT_EQUALS(cache.GetNumberOfThreads(), numbers_of_threads[t]);
+            cache.Update(*p_mesh);
+            CheckCacheAgainstMesh(cache, *p_mesh);
+        }
+        TS_ASSERT_THROWS_WITHOUT_OPENMP(cache.SetNumberOfThreads(2u), "element geometry cannot be calculated");
+    }
+};
+
+#endif /*TESTVERTEXMESHGEOMETRYCACHE_HPP_*/
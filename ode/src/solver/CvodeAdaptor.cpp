@@ -505,6 +505,11 @@ void CvodeAdaptor::CheckForStoppingEvents()
     mCheckForRoots = true;
 }
 
+bool CvodeAdaptor::GetCheckForStoppingEvents()
+{
+    return mCheckForRoots;
+}
+
 void CvodeAdaptor::SetMaxSteps(long int numSteps)
 {
     mMaxSteps = numSteps;
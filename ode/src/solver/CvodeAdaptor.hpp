@@ -298,6 +298,11 @@ public:
      */
     void CheckForStoppingEvents();
 
+    /**
+     * @return whether the solver checks for stopping events (see CheckForStoppingEvents()).
+     */
+    bool GetCheckForStoppingEvents();
+
     /**
      * Change the maximum number of steps to be taken by the solver
      * in its attempt to reach the next output time.  Default is 500.
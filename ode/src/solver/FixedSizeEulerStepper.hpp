@@ -0,0 +1,79 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _FIXEDSIZEEULERSTEPPER_HPP_
+#define _FIXEDSIZEEULERSTEPPER_HPP_
+
+#include "UblasVectorInclude.hpp"
+
+/**
+ * The forward Euler method for an ODE system of SIZE state variables, for use with
+ * FixedSizeOneStepIvpOdeSolver.  It gives the same results as EulerIvpOdeSolver.
+ */
+template<unsigned SIZE>
+class FixedSizeEulerStepper
+{
+public:
+
+    /** The number of state variables in the ODE system. */
+    static const unsigned NUM_STATE_VARIABLES = SIZE;
+
+    /**
+     * Calculate the solution to the ODE system at the next timestep.
+     *
+     * @param rRhs  functor which evaluates the derivatives, called as rRhs(time, rY, rDY)
+     * @param timeStep  dt
+     * @param time  the current time
+     * @param rCurrentYValues  the current (initial) state
+     * @param rNextYValues  the state at the next timestep
+     */
+    template<class RHS>
+    void CalculateNextYValue(RHS& rRhs,
+                             double timeStep,
+                             double time,
+                             c_vector<double, SIZE>& rCurrentYValues,
+                             c_vector<double, SIZE>& rNextYValues)
+    {
+        // dY/dt is stored in rNextYValues, as in EulerIvpOdeSolver
+        rRhs(time, rCurrentYValues, rNextYValues);
+
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            rNextYValues[i] = rCurrentYValues[i] + timeStep*rNextYValues[i];
+        }
+    }
+};
+
+#endif //_FIXEDSIZEEULERSTEPPER_HPP_
@@ -0,0 +1,228 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _FIXEDSIZEONESTEPIVPODESOLVER_HPP_
+#define _FIXEDSIZEONESTEPIVPODESOLVER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include <cassert>
+
+#include "AbstractOneStepIvpOdeSolver.hpp"
+#include "TimeStepper.hpp"
+#include "UblasVectorInclude.hpp"
+
+/**
+ * A one-step ODE solver for a particular ODE system class whose number of state
+ * variables is known at compile time.  The method is given by STEPPER (e.g.
+ * FixedSizeRungeKutta4Stepper<6>), which holds its working memory in fixed-size
+ * vectors, and the derivatives are evaluated through a non-virtual call, so solving
+ * does no heap allocation.  Results are the same as those of the corresponding
+ * AbstractOneStepIvpOdeSolver subclass.
+ *
+ * ODE_SYSTEM opts in by providing
+ *
+ *     void EvaluateFixedSizeYDerivatives(double time, const c_vector<double, N>& rY, c_vector<double, N>& rDY);
+ *
+ * where N is STEPPER::NUM_STATE_VARIABLES.  Stopping events are checked using the
+ * usual CalculateStoppingEvent() method.
+ *
+ * As for other templated classes, each instantiation must be exported with
+ * EXPORT_TEMPLATE_CLASS2 before it can be archived or used by the Solve() method
+ * which returns an OdeSolution, since that records the solver's identifier.
+ */
+template<class ODE_SYSTEM, class STEPPER>
+class FixedSizeOneStepIvpOdeSolver : public AbstractOneStepIvpOdeSolver
+{
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Archive the abstract IVP Solver, never used directly - boost uses this.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        // This calls serialize on the base class.
+        archive & boost::serialization::base_object<AbstractOneStepIvpOdeSolver>(*this);
+    }
+
+    /** The number of state variables in the ODE system. */
+    static const unsigned SIZE = STEPPER::NUM_STATE_VARIABLES;
+
+    /**
+     * Functor passed to the stepper, which evaluates the derivatives of the ODE system.
+     */
+    class FixedSizeRhs
+    {
+    private:
+        /** The ODE system. */
+        ODE_SYSTEM* mpOdeSystem;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param pOdeSystem  the ODE system
+         */
+        FixedSizeRhs(ODE_SYSTEM* pOdeSystem)
+            : mpOdeSystem(pOdeSystem)
+        {
+        }
+
+        /**
+         * Evaluate the derivatives.
+         *
+         * @param time  the time
+         * @param rY  the state
+         * @param rDY  filled in with the derivatives
+         */
+        void operator()(double time, const c_vector<double, SIZE>& rY, c_vector<double, SIZE>& rDY)
+        {
+            mpOdeSystem->EvaluateFixedSizeYDerivatives(time, rY, rDY);
+        }
+    };
+
+protected:
+
+    /**
+     * Method that actually performs the solving on behalf of the public Solve methods.
+     * Overridden to keep the state in fixed-size vectors.  rWorkingMemory is only used
+     * to pass the state to CalculateStoppingEvent().
+     *
+     * @param pAbstractOdeSystem  the ODE system to solve, which must be an ODE_SYSTEM
+     * @param rCurrentYValues  the current (initial) state; results will also be returned
+     *                         in here
+     * @param rWorkingMemory  working memory; same size as rCurrentYValues
+     * @param startTime  initial time
+     * @param endTime  time to solve to
+     * @param timeStep  dt
+     */
+    void InternalSolve(AbstractOdeSystem* pAbstractOdeSystem,
+                       std::vector<double>& rCurrentYValues,
+                       std::vector<double>& rWorkingMemory,
+                       double startTime,
+                       double endTime,
+                       double timeStep)
+    {
+        assert(rCurrentYValues.size() == SIZE);
+        assert(dynamic_cast<ODE_SYSTEM*>(pAbstractOdeSystem) != nullptr);
+        FixedSizeRhs rhs(static_cast<ODE_SYSTEM*>(pAbstractOdeSystem));
+        STEPPER method;
+
+        // The current solution alternates between these, as in AbstractOneStepIvpOdeSolver
+        c_vector<double, SIZE> y_values[2];
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            y_values[0][i] = rCurrentYValues[i];
+        }
+        unsigned curr = 0;
+
+        TimeStepper stepper(startTime, endTime, timeStep);
+
+        // should never get here if this bool has been set to true;
+        assert(!mStoppingEventOccurred);
+        while (!stepper.IsTimeAtEnd() && !mStoppingEventOccurred)
+        {
+            method.CalculateNextYValue(rhs, stepper.GetNextTimeStep(), stepper.GetTime(), y_values[curr], y_values[1-curr]);
+            curr = 1-curr;
+            stepper.AdvanceOneTimeStep();
+
+            for (unsigned i=0; i<SIZE; i++)
+            {
+                rWorkingMemory[i] = y_values[curr][i];
+            }
+            if (pAbstractOdeSystem->CalculateStoppingEvent(stepper.GetTime(), rWorkingMemory) == true)
+            {
+                mStoppingTime = stepper.GetTime();
+                mStoppingEventOccurred = true;
+            }
+        }
+
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            rCurrentYValues[i] = y_values[curr][i];
+        }
+    }
+
+    /**
+     * Calculate the solution to the ODE system at the next timestep.  Not used by
+     * InternalSolve(); provided so that this class may be used wherever an
+     * AbstractOneStepIvpOdeSolver is.
+     *
+     * @param pAbstractOdeSystem  the ODE system to solve, which must be an ODE_SYSTEM
+     * @param timeStep  dt
+     * @param time  the current time
+     * @param rCurrentYValues  the current (initial) state
+     * @param rNextYValues  the state at the next timestep
+     */
+    void CalculateNextYValue(AbstractOdeSystem* pAbstractOdeSystem,
+                             double timeStep,
+                             double time,
+                             std::vector<double>& rCurrentYValues,
+                             std::vector<double>& rNextYValues)
+    {
+        assert(dynamic_cast<ODE_SYSTEM*>(pAbstractOdeSystem) != nullptr);
+        FixedSizeRhs rhs(static_cast<ODE_SYSTEM*>(pAbstractOdeSystem));
+        STEPPER method;
+
+        c_vector<double, SIZE> current_y_values;
+        c_vector<double, SIZE> next_y_values;
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            current_y_values[i] = rCurrentYValues[i];
+        }
+        method.CalculateNextYValue(rhs, timeStep, time, current_y_values, next_y_values);
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            rNextYValues[i] = next_y_values[i];
+        }
+    }
+
+public:
+
+    /**
+     * Virtual destructor since we have virtual methods.
+     */
+    virtual ~FixedSizeOneStepIvpOdeSolver()
+    {}
+};
+
+#endif //_FIXEDSIZEONESTEPIVPODESOLVER_HPP_
@@ -0,0 +1,110 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _FIXEDSIZERUNGEKUTTA4STEPPER_HPP_
+#define _FIXEDSIZERUNGEKUTTA4STEPPER_HPP_
+
+#include "UblasVectorInclude.hpp"
+
+/**
+ * The Runge Kutta 4th order method (RK4) for an ODE system of SIZE state variables, for use
+ * with FixedSizeOneStepIvpOdeSolver.  It gives the same results as RungeKutta4IvpOdeSolver,
+ * but its working memory is held in fixed-size vectors.
+ */
+template<unsigned SIZE>
+class FixedSizeRungeKutta4Stepper
+{
+private:
+
+    c_vector<double, SIZE> mK1;  /**< Working memory: expression k1 in the RK4 method. */
+    c_vector<double, SIZE> mK2;  /**< Working memory: expression k2 in the RK4 method. */
+    c_vector<double, SIZE> mK3;  /**< Working memory: expression k3 in the RK4 method. */
+    c_vector<double, SIZE> mK4;  /**< Working memory: expression k4 in the RK4 method. */
+    c_vector<double, SIZE> mYki; /**< Working memory: expression yki in the RK4 method. */
+
+public:
+
+    /** The number of state variables in the ODE system. */
+    static const unsigned NUM_STATE_VARIABLES = SIZE;
+
+    /**
+     * Calculate the solution to the ODE system at the next timestep.
+     *
+     * @param rRhs  functor which evaluates the derivatives, called as rRhs(time, rY, rDY)
+     * @param timeStep  dt
+     * @param time  the current time
+     * @param rCurrentYValues  the current (initial) state
+     * @param rNextYValues  the state at the next timestep
+     */
+    template<class RHS>
+    void CalculateNextYValue(RHS& rRhs,
+                             double timeStep,
+                             double time,
+                             c_vector<double, SIZE>& rCurrentYValues,
+                             c_vector<double, SIZE>& rNextYValues)
+    {
+        c_vector<double, SIZE>& dy = rNextYValues; // re-use memory
+
+        rRhs(time, rCurrentYValues, dy);
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            mK1[i] = timeStep*dy[i];
+            mYki[i] = rCurrentYValues[i] + 0.5*mK1[i];
+        }
+
+        rRhs(time+0.5*timeStep, mYki, dy);
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            mK2[i] = timeStep*dy[i];
+            mYki[i] = rCurrentYValues[i] + 0.5*mK2[i];
+        }
+
+        rRhs(time+0.5*timeStep, mYki, dy);
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            mK3[i] = timeStep*dy[i];
+            mYki[i] = rCurrentYValues[i] + mK3[i];
+        }
+
+        rRhs(time+timeStep, mYki, dy);
+        for (unsigned i=0; i<SIZE; i++)
+        {
+            mK4[i] = timeStep*dy[i];
+            rNextYValues[i] = rCurrentYValues[i] + (mK1[i]+2*mK2[i]+2*mK3[i]+mK4[i])/6.0;
+        }
+    }
+};
+
+#endif //_FIXEDSIZERUNGEKUTTA4STEPPER_HPP_
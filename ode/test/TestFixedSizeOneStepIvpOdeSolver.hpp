@@ -0,0 +1,144 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTFIXEDSIZEONESTEPIVPODESOLVER_HPP_
+#define _TESTFIXEDSIZEONESTEPIVPODESOLVER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "FixedSizeOneStepIvpOdeSolver.hpp"
+#include "FixedSizeEulerStepper.hpp"
+#include "FixedSizeGRL1Stepper.hpp"
+#include "FixedSizeRungeKutta4Stepper.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "GRL1IvpOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "OdeSecondOrderWithEvents.hpp"
+#include "FakePetscSetup.hpp"
+
+/** The fixed-size solver used for the sampled solution test. */
+typedef FixedSizeOneStepIvpOdeSolver<OdeSecondOrderWithEvents, FixedSizeRungeKutta4Stepper<2> > FixedSizeRk4Solver;
+
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS2(FixedSizeOneStepIvpOdeSolver, OdeSecondOrderWithEvents, FixedSizeRungeKutta4Stepper<2>)
+
+class TestFixedSizeOneStepIvpOdeSolver : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that a fixed-size solver gives the same results as the corresponding
+     * vector-based solver, on an ODE whose solution is y0 = cos(t) and which stops when y0 < 0.
+     */
+    void CompareSolvers(AbstractIvpOdeSolver& rFixedSizeSolver, AbstractIvpOdeSolver& rSolver)
+    {
+        OdeSecondOrderWithEvents fixed_size_ode;
+        std::vector<double> fixed_size_y = fixed_size_ode.GetInitialConditions();
+        rFixedSizeSolver.Solve(&fixed_size_ode, fixed_size_y, 0.0, 2.0, 0.001);
+
+        OdeSecondOrderWithEvents ode;
+        std::vector<double> y = ode.GetInitialConditions();
+        rSolver.Solve(&ode, y, 0.0, 2.0, 0.001);
+
+        TS_ASSERT_EQUALS(rFixedSizeSolver.StoppingEventOccurred(), true);
+        TS_ASSERT_EQUALS(rSolver.StoppingEventOccurred(), true);
+        TS_ASSERT_DELTA(rFixedSizeSolver.GetStoppingTime(), rSolver.GetStoppingTime(), 1e-12);
+        TS_ASSERT_DELTA(rFixedSizeSolver.GetStoppingTime(), M_PI_2, 0.01);
+        TS_ASSERT_LESS_THAN(fixed_size_y[0], 0.0);
+        for (unsigned i=0; i<2; i++)
+        {
+            TS_ASSERT_DELTA(fixed_size_y[i], y[i], 1e-12);
+        }
+
+        // Without a stopping event, the state is updated to the end time
+        OdeSecondOrderWithEvents fixed_size_ode_2;
+        rFixedSizeSolver.SolveAndUpdateStateVariable(&fixed_size_ode_2, 0.0, 1.0, 0.01);
+        OdeSecondOrderWithEvents ode_2;
+        rSolver.SolveAndUpdateStateVariable(&ode_2, 0.0, 1.0, 0.01);
+        TS_ASSERT_EQUALS(rFixedSizeSolver.StoppingEventOccurred(), false);
+        for (unsigned i=0; i<2; i++)
+        {
+            TS_ASSERT_DELTA(fixed_size_ode_2.rGetStateVariables()[i], ode_2.rGetStateVariables()[i], 1e-12);
+        }
+        TS_ASSERT_DELTA(fixed_size_ode_2.rGetStateVariables()[0], cos(1.0), 0.01);
+    }
+
+public:
+
+    void TestFixedSizeSolversMatchVectorSolvers() throw(Exception)
+    {
+        FixedSizeOneStepIvpOdeSolver<OdeSecondOrderWithEvents, FixedSizeEulerStepper<2> > fixed_size_euler_solver;
+        EulerIvpOdeSolver euler_solver;
+        CompareSolvers(fixed_size_euler_solver, euler_solver);
+
+        FixedSizeRk4Solver fixed_size_rk4_solver;
+        RungeKutta4IvpOdeSolver rk4_solver;
+        CompareSolvers(fixed_size_rk4_solver, rk4_solver);
+
+        FixedSizeOneStepIvpOdeSolver<OdeSecondOrderWithEvents, FixedSizeGRL1Stepper<2> > fixed_size_grl1_solver;
+        GRL1IvpOdeSolver grl1_solver;
+        CompareSolvers(fixed_size_grl1_solver, grl1_solver);
+    }
+
+    void TestFixedSizeSolverWithSampling() throw(Exception)
+    {
+        FixedSizeRk4Solver fixed_size_solver;
+        RungeKutta4IvpOdeSolver solver;
+
+        OdeSecondOrderWithEvents fixed_size_ode;
+        std::vector<double> fixed_size_y = fixed_size_ode.GetInitialConditions();
+        OdeSolution fixed_size_solution = fixed_size_solver.Solve(&fixed_size_ode, fixed_size_y, 0.0, 2.0, 0.001, 0.01);
+
+        OdeSecondOrderWithEvents ode;
+        std::vector<double> y = ode.GetInitialConditions();
+        OdeSolution solution = solver.Solve(&ode, y, 0.0, 2.0, 0.001, 0.01);
+
+        TS_ASSERT_EQUALS(fixed_size_solution.GetNumberOfTimeSteps(), solution.GetNumberOfTimeSteps());
+        for (unsigned i=0; i<solution.rGetTimes().size(); i++)
+        {
+            TS_ASSERT_DELTA(fixed_size_solution.rGetTimes()[i], solution.rGetTimes()[i], 1e-12);
+            TS_ASSERT_DELTA(fixed_size_solution.rGetSolutions()[i][0], solution.rGetSolutions()[i][0], 1e-12);
+            TS_ASSERT_DELTA(fixed_size_solution.rGetSolutions()[i][1], solution.rGetSolutions()[i][1], 1e-12);
+        }
+
+        // A single step is accurate
+        std::vector<double> initial_y = ode.GetInitialConditions();
+        fixed_size_solver.Solve(&fixed_size_ode, initial_y, 0.0, 0.001, 0.001);
+        TS_ASSERT_DELTA(initial_y[0], cos(0.001), 1e-10);
+        TS_ASSERT_DELTA(initial_y[1], -sin(0.001), 1e-10);
+    }
+};
+
+#endif //_TESTFIXEDSIZEONESTEPIVPODESOLVER_HPP_
@@ -39,6 +39,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOdeSystem.hpp"
 #include "OdeSystemInformation.hpp"
+#include "UblasVectorInclude.hpp"
 
 /**
  * Solutions to this system form circles about the origin.
@@ -58,6 +59,12 @@ public:
         rDY[1] = -rY[0];
     }
 
+    void EvaluateFixedSizeYDerivatives(double time, const c_vector<double, 2>& rY, c_vector<double, 2>& rDY)
+    {
+        rDY[0] =  rY[1];
+        rDY[1] = -rY[0];
+    }
+
     bool CalculateStoppingEvent(double time, const std::vector<double>& rY)
     {
         return (rY[0] < 0);
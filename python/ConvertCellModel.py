@@ -107,6 +107,11 @@ parser.add_option('--grl1', action='store_true', default=False,
 parser.add_option('--grl2', action='store_true', default=False,
                   help="generate a version of the cell model that can be"
                   " solved using the GRL2 method.")           
+parser.add_option('--batched', action='store_true', default=False,
+                  help="generate a subclass of AbstractBatchedCardiacCells, i.e. a batch"
+                  " of cells stored in structure-of-arrays layout, for use with"
+                  " BatchedCardiacCellView.  Combine with --rush-larsen for a"
+                  " Rush-Larsen batch.")
 parser.add_option('--output-dir', action='store',
                   help="directory to place output files in")
 parser.add_option('--show-outputs', action='store_true', default=False,
@@ -132,7 +137,7 @@ parser.add_option('-q', '--quiet', action='store_true', default=False,
                   help="don't print the command(s) being run, and pass the option through to pycml")
 options, args = parser.parse_args()
 
-option_names = ['opt', 'normal', 'cvode', 'cvode_data_clamp', 'backward_euler', 'rush_larsen', 'grl1', 'grl2']
+option_names = ['opt', 'normal', 'cvode', 'cvode_data_clamp', 'backward_euler', 'rush_larsen', 'grl1', 'grl2', 'batched']
 def arg2name(arg):
     return str(arg)[2:].replace('-', '_')
 
@@ -230,6 +235,8 @@ if options.dynamically_loadable:
     if number_of_options > 1 and not dyn_opt and not options.cvode_data_clamp:
         print 'You asked for ', options
         parser.error("Only one output type may be specified if creating a dynamic library")
+    if options.batched:
+        parser.error("Batched cell models cannot be dynamically loaded")
         
     essential_options.append('-y')
 
@@ -370,6 +377,17 @@ def convert(model, output_dir):
                                     model_base, 'BackwardEuler')
         do_cmd(cmd, outputs)
     
+    if options.batched:
+        # A batch of cells, optionally solved with Rush-Larsen
+        batched_opts = ['-t', 'BatchedChaste']
+        batched_name = 'Batched'
+        if options.rush_larsen:
+            batched_opts.append('--rush-larsen')
+            batched_name = 'BatchedRushLarsen'
+        cmd, outputs = add_out_opts(command_base + batched_opts, output_dir,
+                                    class_name + batched_name, model_base, batched_name)
+        do_cmd(cmd, outputs)
+
     rush_larsen_variants = {'--rush-larsen': 'RushLarsen', '--grl1': 'GRL1', '--grl2': 'GRL2'}
     for rl_opt, rl_name in rush_larsen_variants.iteritems():
         if getattr(options, arg2name(rl_opt), False):
@@ -1561,15 +1561,12 @@ class CellMLToChasteTranslator(CellMLTranslator):
                 self.output_comment('abstract class by the constructor, and archived via that, instead of here.', subsidiary=True) 
             self.close_block(subsidiary=True)
        
-    def output_cell_parameters(self):
-        """Output declarations, set & get methods for cell parameters.
+    def find_cell_parameters(self):
+        """Find the cell parameters.
         
         Sets self.cell_parameters to be those constant variables annotated with
         pycml:modifiable-parameter.  These use the mParameters functionality in
         Chaste.
-        
-        Also collects any variables annotated with an RDF oxmeta name into
-        self.metadata_vars. Only constants and state variables are included.
         """
         # Find annotated parameters
         self.cell_parameters = filter(
@@ -1585,6 +1582,16 @@ class CellMLToChasteTranslator(CellMLTranslator):
             # Remember the var's index
             var._cml_param_index = i
 
+    def output_cell_parameters(self):
+        """Output declarations, set & get methods for cell parameters.
+        
+        Sets self.cell_parameters using find_cell_parameters.
+        
+        Also collects any variables annotated with an RDF oxmeta name into
+        self.metadata_vars. Only constants and state variables are included.
+        """
+        self.find_cell_parameters()
+
         # Create set of all oxmeta-annotated variables
         vars = cellml_metadata.find_variables(self.model, ('bqbiol:is', NSS[u'bqbiol']))
         # Keep only the variables with an oxmeta name
@@ -3610,6 +3617,255 @@ class CellMLToChasteTranslator(CellMLTranslator):
                     print >>sys.stderr, msg
 
 
+class CellMLToBatchedChasteTranslator(CellMLToChasteTranslator):
+    """Translate a CellML model to a batch of Chaste cells, stored in structure-of-arrays layout.
+    
+    The generated class inherits from AbstractBatchedCardiacCells, or from
+    AbstractBatchedRushLarsenCardiacCells if --rush-larsen is given, and evaluates
+    the model for a whole range of cells in a single loop.
+    
+    Lookup tables, modifiers, protocols, data clamp and dynamic loading are not
+    supported, and are turned off.
+    """
+    
+    def translate(self, *args, **kwargs):
+        """Generate code for the given model, turning off unsupported features."""
+        for key in ['use_modifiers', 'use_data_clamp', 'dynamically_loadable', 'use_protocol']:
+            kwargs[key] = False
+        return super(CellMLToBatchedChasteTranslator, self).translate(*args, **kwargs)
+    
+    def final_configuration_hook(self):
+        """Turn off lookup tables, which are not supported for batched cells."""
+        self.use_lookup_tables = False
+        return super(CellMLToBatchedChasteTranslator, self).final_configuration_hook()
+    
+    def output_includes(self, base_class=None):
+        """Output the start of each output file, with a batched cells base class."""
+        if self.options.rush_larsen:
+            base_class = 'AbstractBatchedRushLarsenCardiacCells'
+        else:
+            base_class = 'AbstractBatchedCardiacCells'
+        # Stop the base class choosing AbstractRushLarsenCardiacCell
+        rush_larsen = self.options.rush_larsen
+        self.options.rush_larsen = False
+        super(CellMLToBatchedChasteTranslator, self).output_includes(base_class=base_class)
+        self.options.rush_larsen = rush_larsen
+        if self.options.rush_larsen and not self.doc._cml_rush_larsen:
+            self.writeln('#include "Warnings.hpp"\n')
+    
+    def code_name(self, var, *args, **kwargs):
+        """
+        Return the full name of var in a form suitable for inclusion in a source file.
+        
+        Parameters are read from the current cell's entry in mParameters (see output_cell_loop_start).
+        """
+        if hasattr(var, '_cml_param_index'):
+            return 'p_parameter_' + str(var._cml_param_index) + '[c]'
+        return super(CellMLToBatchedChasteTranslator, self).code_name(var, *args, **kwargs)
+    
+    def get_stimulus_assignment(self):
+        """Return code for getting the current cell's stimulus current."""
+        expr = self.doc._cml_config.i_stim_var
+        get_stim = 'mAreaStimulus[c]'
+        if self.doc._cml_config.i_stim_negated:
+            get_stim = '-' + get_stim
+        return self.code_name(expr) + self.EQ_ASSIGN + get_stim + self.STMT_END
+    
+    def output_top_boilerplate(self):
+        """Output top boilerplate.
+        
+        This method outputs the includes, and the constructor and destructor of the cells class.
+        """
+        if self.v_index == -1:
+            self.error(['Batched cell models require the transmembrane potential to be a state variable.'])
+        self.include_serialization = False
+        self.use_backward_euler = False
+        self.use_analytic_jacobian = False
+        self.output_includes()
+        self.find_cell_parameters()
+        self.derived_quantities = []
+        # Default parameter values, for the base class constructor
+        if self.cell_parameters:
+            self.writeln('static std::vector<double> GetDefaultParameters()')
+            self.open_block()
+            self.writeln(self.vector_create('parameters', len(self.cell_parameters)))
+            for var in self.cell_parameters:
+                if var.get_type() == VarTypes.Constant:
+                    self.writeln(self.vector_index('parameters', var._cml_param_index),
+                                 self.EQ_ASSIGN, var.initial_value, self.STMT_END, ' ',
+                                 self.COMMENT_START, var.fullname(), ' [', var.units, ']')
+            self.writeln('return parameters', self.STMT_END)
+            self.close_block()
+        # Cells class
+        self.writeln_hpp('class ', self.class_name, self.class_inheritance)
+        self.open_block(subsidiary=True)
+        # Constructor
+        self.output_method_start(self.class_name, [], '', access='public')
+        self.writeln('    : ', self.base_class_name, '(OdeSystemInformation<', self.class_name, '>::Instance(),')
+        if self.cell_parameters:
+            self.writeln(self.unsigned_v_index, ',', indent_offset=3)
+            self.writeln('GetDefaultParameters())', indent_offset=3)
+        else:
+            self.writeln(self.unsigned_v_index, ')', indent_offset=3)
+        self.open_block()
+        self.output_comment('Time units: ', self.free_vars[0].units)
+        if self.options.rush_larsen:
+            if not self.doc._cml_rush_larsen:
+                self.writeln('WARNING("No elligible gating variables found for this Rush-Larsen cell model; using normal forward Euler.");')
+            for i, var in enumerate(self.state_vars):
+                if var in self.doc._cml_rush_larsen:
+                    form, _, _, conv = self.doc._cml_rush_larsen[var]
+                    args = [str(i), ['false', 'true'][form == 'ab']]
+                    if conv:
+                        args.append(str(conv))
+                    self.writeln('SetRushLarsenVariable(', ', '.join(args), ')', self.STMT_END)
+        self.close_block()
+        # Destructor
+        self.output_method_start('~'+self.class_name, [], '')
+        self.open_block()
+        self.close_block()
+    
+    def output_cell_loop_start(self, nodeset):
+        """Output the start of a loop over the cells in [begin, end).
+        
+        Pointers to the state variables and parameters used in nodeset are set up
+        before the loop, and the current cell's state variables are read at the start
+        of its body.
+        """
+        for i, var in enumerate(self.state_vars):
+            if var in nodeset:
+                self.writeln(self.TYPE_CONST_DOUBLE, '* p_', self.code_name(var), self.EQ_ASSIGN,
+                             '&(mStateVariables[', i, '][0])', self.STMT_END)
+        for var in self.cell_parameters:
+            if var in nodeset:
+                i = var._cml_param_index
+                self.writeln(self.TYPE_CONST_DOUBLE, '* p_parameter_', i, self.EQ_ASSIGN,
+                             '&(mParameters[', i, '][0])', self.STMT_END)
+        self.writeln()
+        self.writeln('for (unsigned c=begin; c<end; c++)')
+        self.open_block()
+        for var in self.state_vars:
+            if var in nodeset:
+                self.writeln(self.TYPE_CONST_DOUBLE, self.code_name(var), self.EQ_ASSIGN,
+                             'p_', self.code_name(var), '[c]', self.STMT_END)
+                self.writeln(self.COMMENT_START, 'Units: ', var.units, '; Initial value: ',
+                             getattr(var, u'initial_value', 'Unknown'))
+        self.writeln()
+    
+    def output_mathematics(self):
+        """Output the mathematics in this model.
+        
+        Two methods are needed:
+         * EvaluateYDerivatives computes the RHS of the ODE system for a range of cells,
+           together with the alpha/beta terms of Rush-Larsen variables
+         * ComputeIIonic computes the total ionic current for a range of cells
+        """
+        self.output_get_i_ionic()
+        self.output_evaluate_y_derivatives()
+    
+    def output_get_i_ionic(self):
+        """Output the ComputeIIonic method."""
+        self.output_method_start('ComputeIIonic', ['unsigned begin', 'unsigned end', 'double* pIIonic'],
+                                 'void', access='public')
+        self.open_block()
+        if not (hasattr(self.model, u'solver_info') and hasattr(self.model.solver_info, u'ionic_current')):
+            self.writeln('for (unsigned c=begin; c<end; c++)')
+            self.open_block()
+            self.writeln('pIIonic[c-begin] = 0.0;')
+            self.close_block(blank_line=False)
+            self.close_block()
+            return
+        if not hasattr(self.model.solver_info.ionic_current, u'var'):
+            raise ValueError('No ionic currents found; check your configuration file')
+        nodes = map(lambda elt: self.varobj(unicode(elt)),
+                    self.model.solver_info.ionic_current.var)
+        # The ionic current must not include the stimulus current
+        i_stim = self.doc._cml_config.i_stim_var
+        nodeset = self.calculate_extended_dependencies(nodes, prune_deps=[i_stim])
+        self.output_cell_loop_start(nodeset)
+        self.output_equations(nodeset, zero_stimulus=True)
+        self.writeln()
+        self.writeln('pIIonic[c-begin]', self.EQ_ASSIGN, nl=False)
+        if self.doc._cml_config.i_ionic_negated:
+            self.writeln('-(', nl=False, indent=False)
+        plus = False
+        for varelt in self.model.solver_info.ionic_current.var:
+            if plus: self.write('+')
+            else: plus = True
+            self.output_variable(varelt)
+        if self.doc._cml_config.i_ionic_negated:
+            self.writeln(')', nl=False, indent=False)
+        self.writeln(self.STMT_END, indent=False)
+        self.close_block(blank_line=False)
+        self.close_block()
+    
+    def output_evaluate_y_derivatives(self, method_name='EvaluateYDerivatives'):
+        """Output the EvaluateYDerivatives method.
+        
+        This fills in mDerivatives, and for Rush-Larsen variables mAlphaOrTau and mBetaOrInf instead.
+        """
+        self.output_method_start(method_name,
+                                 [self.TYPE_DOUBLE + self.code_name(self.free_vars[0]),
+                                  'unsigned begin', 'unsigned end'],
+                                 'void', access='protected')
+        self.open_block()
+        if self.options.rush_larsen:
+            rl_vars = self.doc._cml_rush_larsen
+        else:
+            rl_vars = {}
+        normal_vars = [v for v in self.state_vars if not v in rl_vars]
+        # Work out what equations are needed
+        derivs = set(map(lambda v: (v, self.free_vars[0]), normal_vars))
+        nodes = set()
+        for _, alpha_or_tau, beta_or_inf, _ in rl_vars.itervalues():
+            nodes.update(self._vars_in(alpha_or_tau))
+            nodes.update(self._vars_in(beta_or_inf))
+        if self.use_chaste_stimulus:
+            i_stim = [self.doc._cml_config.i_stim_var]
+        else:
+            i_stim = []
+        nodeset = self.calculate_extended_dependencies(derivs|nodes, prune_deps=i_stim)
+        # Pointers to the outputs
+        for i, var in enumerate(self.state_vars):
+            if var in rl_vars:
+                self.writeln(self.TYPE_DOUBLE, '* p_alpha_or_tau_', i, self.EQ_ASSIGN,
+                             '&(mAlphaOrTau[', i, '][0])', self.STMT_END)
+                self.writeln(self.TYPE_DOUBLE, '* p_beta_or_inf_', i, self.EQ_ASSIGN,
+                             '&(mBetaOrInf[', i, '][0])', self.STMT_END)
+            else:
+                self.writeln(self.TYPE_DOUBLE, '* p_', self.code_name(var, True), self.EQ_ASSIGN,
+                             '&(mDerivatives[', i, '][0])', self.STMT_END)
+        self.output_cell_loop_start(nodeset)
+        self.output_comment('Mathematics')
+        #907: dV/dt is declared separately
+        self.writeln(self.TYPE_DOUBLE, self.code_name(self.v_variable, ode=True), self.STMT_END)
+        self.output_equations(nodeset)
+        self.writeln()
+        # Store the results for this cell
+        for i, var in enumerate(self.state_vars):
+            if var in rl_vars:
+                self.writeln('p_alpha_or_tau_', i, '[c]', self.EQ_ASSIGN, nl=False)
+                self.output_expr(rl_vars[var][1], False)
+                self.writeln(self.STMT_END, indent=False)
+                self.writeln('p_beta_or_inf_', i, '[c]', self.EQ_ASSIGN, nl=False)
+                self.output_expr(rl_vars[var][2], False)
+                self.writeln(self.STMT_END, indent=False)
+            else:
+                self.writeln('p_', self.code_name(var, True), '[c]', self.EQ_ASSIGN,
+                             self.code_name(var, True), self.STMT_END)
+        self.close_block(blank_line=False)
+        self.close_block()
+    
+    def output_bottom_boilerplate(self):
+        """Output bottom boilerplate.
+        
+        As the base class, but batched cells are neither serialized nor dynamically loadable.
+        """
+        self.include_serialization = False
+        self.dynamically_loadable = False
+        super(CellMLToBatchedChasteTranslator, self).output_bottom_boilerplate()
+
+
 class CellMLToCvodeTranslator(CellMLToChasteTranslator):
     """Translate a CellML model to C++ code for use with Chaste+CVODE."""
 
@@ -5325,6 +5581,7 @@ setup(
 
 CellMLTranslator.register(CellMLTranslator, 'C++')
 CellMLTranslator.register(CellMLToChasteTranslator, 'Chaste')
+CellMLTranslator.register(CellMLToBatchedChasteTranslator, 'BatchedChaste')
 CellMLTranslator.register(CellMLToCvodeTranslator, 'CVODE')
 CellMLTranslator.register(CellMLToMapleTranslator, 'Maple')
 CellMLTranslator.register(CellMLToMatlabTranslator, 'Matlab')
@@ -6718,7 +6975,10 @@ def get_options(args, default_options=None):
         options.rush_larsen = False
         options.grl1 = False
         options.grl2 = False
-    if options.rush_larsen or options.backward_euler or options.grl1 or options.grl2:
+    if options.translate_type == 'BatchedChaste':
+        if options.backward_euler or options.grl1 or options.grl2:
+            parser.error("Batched cell models ('-t BatchedChaste') only support forward Euler and Rush-Larsen ('--rush-larsen').")
+    elif options.rush_larsen or options.backward_euler or options.grl1 or options.grl2:
         options.translate_type = 'Chaste'
     if options.use_data_clamp and not options.translate_type=='CVODE':
         parser.error("Data clamp option '--use-data-clamp' also requires CVODE ('-t CVODE'). If you are calling this via ConvertCellModel use '--cvode-data-clamp'.")
@@ -0,0 +1,142 @@
+#!/usr/bin/env python
+
+"""Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+"""
+
+"""Compare benchmark results written by BenchmarkReport against a stored baseline.
+
+Usage:
+    python/utils/CompareBenchmarks.py [options] baseline.json results.json
+
+Runs are matched by their name, parameters and number of processes.  For each
+matched run the total wall time, the memory increase and the maximum time of every
+event are compared, and any which have grown by more than the tolerance are
+reported as regressions.  Times below --min-time and memory use below --min-memory
+are ignored, since they are dominated by noise.  The exit status is 1 if there were
+any regressions, so this can be used in automated testing.
+"""
+
+import json
+import optparse
+import sys
+
+
+def RunKey(run):
+    """Return a string identifying a benchmark run."""
+    params = ','.join('%s=%g' % (name, value) for name, value in sorted(run['parameters'].items()))
+    return '%s[%s;np=%d]' % (run['name'], params, run['num_processes'])
+
+
+def LoadRuns(path):
+    """Load the runs in a benchmark results file, indexed by RunKey."""
+    with open(path) as results_file:
+        results = json.load(results_file)
+    return dict((RunKey(run), run) for run in results['runs'])
+
+
+def Compare(label, baseline, current, tolerance, minimum, units):
+    """Return a description of the regression if current is significantly worse than baseline."""
+    if max(baseline, current) < minimum:
+        return None
+    if current > baseline * (1.0 + tolerance):
+        change = 100.0 * (current - baseline) / baseline if baseline > 0 else float('inf')
+        return '%s: %.3f -> %.3f %s (+%.1f%%)' % (label, baseline, current, units, change)
+    return None
+
+
+def MemoryCheck(baseline_run, current_run, options):
+    """Return the memory comparison for two results of the same run.
+
+    The memory increase during the run is compared where both results have it, since
+    the peak memory use can include earlier runs in the same process.
+    """
+    if 'memory_increase' in baseline_run and 'memory_increase' in current_run:
+        return ('memory increase', baseline_run['memory_increase'], current_run['memory_increase'],
+                options.memory_tolerance, options.min_memory, 'MB')
+    return ('peak memory', baseline_run['peak_memory'], current_run['peak_memory'],
+            options.memory_tolerance, options.min_memory, 'MB')
+
+
+def CompareRuns(baseline_run, current_run, options):
+    """Return a list of the regressions between two results of the same run."""
+    regressions = []
+    checks = [('wall time', baseline_run['wall_time'], current_run['wall_time'],
+               options.tolerance, options.min_time / 1000.0, 's'),
+              MemoryCheck(baseline_run, current_run, options)]
+    for handler, events in sorted(current_run['events'].items()):
+        baseline_events = baseline_run['events'].get(handler, {})
+        for event, times in sorted(events.items()):
+            if event in baseline_events:
+                checks.append(('%s/%s' % (handler, event), baseline_events[event]['max'], times['max'],
+                               options.tolerance, options.min_time, 'ms'))
+    for check in checks:
+        regression = Compare(*check)
+        if regression:
+            regressions.append(regression)
+    return regressions
+
+
+def main(argv):
+    parser = optparse.OptionParser(usage='%prog [options] baseline.json results.json')
+    parser.add_option('-t', '--tolerance', type='float', default=0.1,
+                      help='relative increase in time counted as a regression [default: %default]')
+    parser.add_option('-m', '--memory-tolerance', type='float', default=0.1,
+                      help='relative increase in memory use counted as a regression [default: %default]')
+    parser.add_option('--min-memory', type='float', default=1.0,
+                      help='ignore memory use below this many megabytes [default: %default]')
+    parser.add_option('--min-time', type='float', default=100.0,
+                      help='ignore times below this many milliseconds [default: %default]')
+    options, args = parser.parse_args(argv)
+    if len(args) != 2:
+        parser.error('expected a baseline file and a results file')
+
+    baseline_runs = LoadRuns(args[0])
+    current_runs = LoadRuns(args[1])
+
+    num_regressions = 0
+    for key in sorted(current_runs):
+        if key not in baseline_runs:
+            print('%s: no baseline' % key)
+            continue
+        regressions = CompareRuns(baseline_runs[key], current_runs[key], options)
+        num_regressions += len(regressions)
+        for regression in regressions:
+            print('%s: SLOWER %s' % (key, regression))
+    for key in sorted(set(baseline_runs) - set(current_runs)):
+        print('%s: missing from results' % key)
+
+    print('%d regression(s) in %d run(s)' % (num_regressions, len(current_runs)))
+    return 1 if num_regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))